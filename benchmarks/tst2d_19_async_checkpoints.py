@@ -0,0 +1,89 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Drifting thermal plasma in a 2D periodic box, with the checkpoints written by a
+# separate thread (Checkpoints.dump_asynchronous). Meant to be validated with restarts
+# (option -r of validation.py): the simulation stops after a dump and restarts from it,
+# and the results must be identical to the run without restart.
+
+import math as m
+
+TkeV = 1.						# electron temperature in keV
+T   = TkeV/511.   				# electron temperature in me c^2
+dx  = 0.1
+dy  = dx
+dt  = 0.95 * dx/m.sqrt(2.)		# timestep (0.95 x CFL)
+
+Lx    = 64.*dx
+Ly    = 32.*dy
+Tsim  = 120.*dt
+
+Main(
+    geometry = "2Dcartesian",
+
+    interpolation_order = 2,
+
+    timestep = dt,
+    simulation_time = Tsim,
+
+    cell_length  = [dx, dy],
+    grid_length = [Lx, Ly],
+
+    number_of_patches = [8, 4],
+
+    EM_boundary_conditions = [ ["periodic"] ],
+
+    print_every = 20,
+
+    random_seed = 0
+)
+
+Species(
+    name = "ion",
+    position_initialization = "regular",
+    momentum_initialization = "cold",
+    particles_per_cell = 4,
+    mass = 1836.0,
+    charge = 1.0,
+    number_density = cosine(1., xamplitude=0.2, xnumber=2),
+    boundary_conditions = [
+    	["periodic", "periodic"],
+    	["periodic", "periodic"],
+    ],
+)
+Species(
+    name = "electron",
+    position_initialization = "regular",
+    momentum_initialization = "maxwell-juettner",
+    particles_per_cell = 4,
+    mass = 1.0,
+    charge = -1.0,
+    number_density = 1.,
+    mean_velocity = [0.2, 0.1, 0.],
+    temperature = [T],
+    boundary_conditions = [
+    	["periodic", "periodic"],
+    	["periodic", "periodic"],
+    ],
+)
+
+Checkpoints(
+    dump_step = 40,
+    dump_minutes = 0.0,
+    exit_after_dump = False,
+    keep_n_dumps = 2,
+    dump_asynchronous = True,
+)
+
+DiagScalar(every = 5)
+
+DiagParticleBinning(
+    deposited_quantity = "weight",
+    every = 30,
+    species = ["electron"],
+    axes = [
+    	["x", 0., Lx, 32],
+    	["px", -0.5, 1., 30],
+    ]
+)
@@ -0,0 +1,105 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Laser wake in 2D with a moving window, in a plasma of electrons and ions which fills the
+# window. The patches leaving the window at x_min are reused for the patches arriving at
+# x_max, with their fields zeroed and the capacity of their particle arrays kept.
+# The NUMA-aware mode (Main.numa_first_touch) is also on, with a frequent load balancing:
+# the arriving patches and the patches given to another thread are copied by the thread
+# which computes them. Meant to run with several OpenMP threads.
+# The results must be identical to a run where the arriving patches are all created and
+# numa_first_touch = False: the reference was generated this way, on 4 MPI processes.
+
+dx = 0.125
+dt = 0.12
+nx = 256
+Lx = nx * dx
+npatch_x = 16
+laser_fwhm = 8.
+
+Main(
+    geometry = "2Dcartesian",
+
+    interpolation_order = 2,
+
+    timestep = dt,
+    simulation_time = int(1.5*Lx/dt)*dt,
+
+    cell_length  = [dx, 0.5],
+    grid_length = [ Lx,  32.],
+
+    number_of_patches = [npatch_x, 4],
+
+    EM_boundary_conditions = [
+        ["silver-muller","silver-muller"],
+        ["silver-muller","silver-muller"],
+    ],
+
+    solve_poisson = False,
+    numa_first_touch = True,
+    print_every = 50,
+
+    random_seed = 0
+)
+
+MovingWindow(
+    time_start = Main.grid_length[0]*0.25,
+    velocity_x = 0.9997
+)
+
+LoadBalancing(
+    initial_balance = False,
+    every = 10,
+    cell_load = 1.,
+    frozen_particle_load = 0.1
+)
+
+for name, mass, charge in [["electron", 1., -1.], ["ion", 1836., 1.]]:
+	Species(
+	    name = name,
+	    position_initialization = "regular",
+	    momentum_initialization = "maxwell-juettner",
+	    temperature = [0.001],
+	    particles_per_cell = 4,
+	    mass = mass,
+	    charge = charge,
+	    charge_density = trapezoidal(0.01, xvacuum=0.1*Lx, xslope1=0.1*Lx, xplateau=10*Lx),
+	    pusher = "boris",
+	    boundary_conditions = [
+	        ["remove", "remove"],
+	        ["remove", "remove"],
+	    ],
+	)
+
+LaserGaussian2D(
+    box_side         = "xmin",
+    a0              = 2.,
+    focus           = [0., Main.grid_length[1]/2.],
+    waist           = 8.,
+    time_envelope   = tgaussian(center=2**0.5*laser_fwhm, fwhm=laser_fwhm)
+)
+
+DiagScalar(
+    every = 10,
+    vars=[
+        'Uelm','Ukin_electron','Ukin_ion',
+        'ExMax','ExMaxCell','EyMax','EyMaxCell','RhoMin','RhoMinCell',
+        'Ukin_bnd','Uelm_bnd','Ukin_out_mvw','Ukin_inj_mvw','Uelm_out_mvw','Uelm_inj_mvw'
+    ]
+)
+
+for species in ["electron", "ion"]:
+	DiagParticleBinning(
+	    deposited_quantity = "weight_charge",
+	    every = 50,
+	    species = [species],
+	    axes = [
+	        ["moving_x", 0, Lx, 64],
+	        ["px", -1, 4., 50]
+	    ]
+	)
+
+DiagPerformances(
+    every = 50,
+)
@@ -0,0 +1,96 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Two counter-streaming electron-positron plasmas in 2D, with several particle binning
+# diagnostics whose MPI reductions overlap the next timestep (Main.overlap_diag_reductions).
+# The outputs, including the one of the last timestep, must be identical to
+# overlap_diag_reductions = False.
+
+import math
+
+dx = 0.1
+dt = 0.07
+Lx = 25.6
+Ly = 6.4
+
+Main(
+    geometry = "2Dcartesian",
+
+    interpolation_order = 2,
+
+    cell_length = [dx, dx],
+    grid_length  = [Lx, Ly],
+
+    number_of_patches = [ 16, 4 ],
+
+    timestep = dt,
+    simulation_time = 200*dt,
+
+    EM_boundary_conditions = [
+        ['periodic'],
+        ['periodic'],
+    ],
+
+    overlap_diag_reductions = True,
+
+    print_every = 50,
+    random_seed = 0
+)
+
+for name, charge, velocity in [
+		["electron1", -1.,  0.3],
+		["positron1",  1.,  0.3],
+		["electron2", -1., -0.3],
+		["positron2",  1., -0.3]]:
+	Species(
+	    name = name,
+	    position_initialization = "regular",
+	    momentum_initialization = "maxwell-juettner",
+	    particles_per_cell = 4,
+	    mass = 1.0,
+	    charge = charge,
+	    number_density = 0.5,
+	    mean_velocity = [velocity, 0., 0.],
+	    temperature = [0.001],
+	    boundary_conditions = [
+	        ["periodic", "periodic"],
+	        ["periodic", "periodic"],
+	    ],
+	)
+
+DiagScalar(every = 10)
+
+# Reductions at every timestep
+DiagParticleBinning(
+    deposited_quantity = "weight",
+    every = 1,
+    species = ["electron1", "electron2"],
+    axes = [
+        ["x", 0., Lx, 64],
+        ["px", -1., 1., 40]
+    ]
+)
+
+# Time-averaged, flushed every other output
+DiagParticleBinning(
+    deposited_quantity = "weight_ekin",
+    every = 20,
+    time_average = 5,
+    flush_every = 2,
+    species = ["positron1", "positron2"],
+    axes = [
+        ["x", 0., Lx, 32],
+        ["y", 0., Ly, 8]
+    ]
+)
+
+# Several quantities, including the last timestep
+DiagParticleBinning(
+    deposited_quantity = "weight_charge_vx",
+    every = 25,
+    species = ["electron1", "positron1", "electron2", "positron2"],
+    axes = [
+        ["ekin", 0.01, 1., 30, "logscale"]
+    ]
+)
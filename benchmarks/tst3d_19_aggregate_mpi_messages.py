@@ -0,0 +1,113 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Drifting electrons in a 3D periodic box, with the halo messages of the patches
+# aggregated per neighbour process (Main.aggregate_mpi_messages) and the exchange of B
+# overlapped with the update of the patch interiors (Main.overlap_field_exchange).
+# Meant to run on several MPI processes, so that the fields, densities and particles
+# are exchanged along the 3 directions. An initial B field varies across all the patch
+# borders, so that the border cells are wrong if they are used before the exchange ends.
+# The results must be identical to aggregate_mpi_messages = overlap_field_exchange = False:
+# the reference was generated with both options off, on 4 MPI processes.
+
+import math as m
+
+TkeV = 10.						# electron & ion temperature in keV
+T   = TkeV/511.   				# electron & ion temperature in me c^2
+n0  = 1.
+Lde = m.sqrt(T)					# Debye length in units of c/\omega_{pe}
+dx  = 0.5*Lde 					# cell length (same in x, y & z)
+dy  = dx
+dz  = dx
+dt  = 0.95 * dx/m.sqrt(3.)		# timestep (0.95 x CFL)
+
+Lx    = 32.*dx
+Ly    = 32.*dy
+Lz    = 32.*dz
+Tsim  = 60.*dt
+
+def n0_(x,y,z):
+	if (0.1*Lx<x<0.6*Lx) and (0.2*Ly<y<0.7*Ly) and (0.3*Lz<z<0.8*Lz):
+		return n0
+	else:
+		return 0.
+
+
+Main(
+    geometry = "3Dcartesian",
+
+    interpolation_order = 2,
+
+    timestep = dt,
+    simulation_time = Tsim,
+
+    cell_length  = [dx,dy,dz],
+    grid_length = [Lx,Ly,Lz],
+
+    number_of_patches = [4,4,4],
+
+    EM_boundary_conditions = [ ["periodic"] ],
+
+    aggregate_mpi_messages = True,
+    overlap_field_exchange = True,
+
+    print_every = 10,
+
+    random_seed = 0
+)
+
+# Magnetic field with a non-zero curl, sampled at the patch borders in all directions
+B0 = 0.1
+ExternalField(
+    field = "By",
+    profile = lambda x,y,z: B0*m.sin(2.*m.pi*x/Lx)*m.cos(2.*m.pi*z/Lz)
+)
+ExternalField(
+    field = "Bz",
+    profile = lambda x,y,z: B0*m.cos(2.*m.pi*x/Lx)*m.sin(4.*m.pi*y/Ly)
+)
+
+Species(
+    name = "ion",
+    position_initialization = "regular",
+    momentum_initialization = "cold",
+    particles_per_cell = 8,
+    mass = 1836.0,
+    charge = 1.0,
+    charge_density = n0_,
+    boundary_conditions = [
+    	["periodic", "periodic"],
+    	["periodic", "periodic"],
+    	["periodic", "periodic"],
+    ],
+)
+Species(
+    name = "electron",
+    position_initialization = "regular",
+    momentum_initialization = "mj",
+    particles_per_cell = 8,
+    mass = 1.0,
+    charge = -1.0,
+    charge_density = n0_,
+    mean_velocity = [0.3, -0.2, 0.2],
+    temperature = [T],
+    pusher = "boris",
+    boundary_conditions = [
+    	["periodic", "periodic"],
+    	["periodic", "periodic"],
+    	["periodic", "periodic"],
+    ],
+)
+
+DiagScalar(every = 1)
+
+DiagParticleBinning(
+    deposited_quantity = "weight",
+    every = 20,
+    species = ["electron"],
+    axes = [
+    	["x", 0., Lx, 16],
+    	["z", 0., Lz, 16],
+    ]
+)
@@ -0,0 +1,93 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Thermal plasma in a 3D periodic box, with the vectorized particle operators
+# pipelined over blocks of particles (Vectorization.particle_block_size).
+# The species use the boris, vay, higueracary and borisnr pushers: only the boris one
+# is processed by blocks, the others must fall back to the whole-patch operators.
+# The results must be identical to particle_block_size = 0.
+
+import math as m
+
+TkeV = 10.						# electron & ion temperature in keV
+T   = TkeV/511.   				# electron & ion temperature in me c^2
+n0  = 1.
+Lde = m.sqrt(T)					# Debye length in units of c/\omega_{pe}
+dx  = 0.5*Lde 					# cell length (same in x, y & z)
+dy  = dx
+dz  = dx
+dt  = 0.95 * dx/m.sqrt(3.)		# timestep (0.95 x CFL)
+
+Lx    = 32.*dx
+Ly    = 32.*dy
+Lz    = 32.*dz
+Tsim  = 60.*dt
+
+def n0_(x,y,z):
+	if (0.1*Lx<x<0.9*Lx) and (0.1*Ly<y<0.9*Ly) and (0.1*Lz<z<0.9*Lz):
+		return n0
+	else:
+		return 0.
+
+
+Main(
+    geometry = "3Dcartesian",
+
+    interpolation_order = 2,
+
+    timestep = dt,
+    simulation_time = Tsim,
+
+    cell_length  = [dx,dy,dz],
+    grid_length = [Lx,Ly,Lz],
+
+    number_of_patches = [2,2,2],
+
+    EM_boundary_conditions = [ ["periodic"] ],
+
+    print_every = 10,
+
+    random_seed = 0
+)
+
+Vectorization(
+    mode = "on",
+    particle_block_size = 256,
+)
+
+for name, mass, charge, pusher in [
+		["proton"  , 1836., 1., "boris"      ],
+		["electron",    1., -1., "vay"        ],
+		["positron",    1., 1., "higueracary"],
+		["electron_nr", 1., -1., "borisnr"    ]]:
+	Species(
+	    name = name,
+	    position_initialization = "regular",
+	    momentum_initialization = "mj",
+	    particles_per_cell = 8,
+	    mass = mass,
+	    charge = charge,
+	    charge_density = n0_,
+	    mean_velocity = [0.1*charge, 0., 0.],
+	    temperature = [T],
+	    pusher = pusher,
+	    boundary_conditions = [
+	    	["periodic", "periodic"],
+	    	["periodic", "periodic"],
+	    	["periodic", "periodic"],
+	    ],
+	)
+
+DiagScalar(every = 1)
+
+for species in ["proton", "electron", "positron", "electron_nr"]:
+	DiagParticleBinning(
+	    deposited_quantity = "weight_ekin",
+	    every = 20,
+	    species = [species],
+	    axes = [
+	    	["x", 0., Lx, 16],
+	    	["px", -1., 1., 20],
+	    ]
+	)
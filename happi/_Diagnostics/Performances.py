@@ -77,6 +77,7 @@ class Performances(Diagnostic):
 		self._h5items = {}
 		self._availableQuantities_uint   = []
 		self._availableQuantities_double = []
+		self._availableQuantities_hardware = []
 		for path in self._results_path:
 			file = path+self._os.sep+'Performances.h5'
 			try:
@@ -93,6 +94,8 @@ class Performances(Diagnostic):
 				if self._availableQuantities_double and self._availableQuantities_double!=quantities_double: raise
 				self._availableQuantities_uint   = quantities_uint
 				self._availableQuantities_double = quantities_double
+				if "quantities_hardware" in f.attrs:
+					self._availableQuantities_hardware = [bytes.decode(a) for a in f.attrs["quantities_hardware"]]
 				if "patch_arrangement" in f.attrs:
 					self.patch_arrangement = f.attrs["patch_arrangement"].decode()
 			except:
@@ -190,6 +193,14 @@ class Performances(Diagnostic):
 				self._quantities_double.append(index_in_file)
 				used_quantities.append( q )
 				index_in_output += 1
+		self._quantities_hardware = []
+		for index_in_file, q in enumerate(self._availableQuantities_hardware):
+			if self._re.search(r"\b%s\b"%q,self._operation):
+				self._operation = self._re.sub(r"\b%s\b"%q,"C["+str(index_in_output)+"]",self._operation)
+				self._operationunits = self._operationunits.replace(q, "1")
+				self._quantities_hardware.append(index_in_file)
+				used_quantities.append( q )
+				index_in_output += 1
 
 		# Put data_log as object's variable
 		self._data_log = data_log
@@ -283,7 +294,7 @@ class Performances(Diagnostic):
 
 	# get all available quantities
 	def getAvailableQuantities(self):
-		return self._availableQuantities_uint + self._availableQuantities_double
+		return self._availableQuantities_uint + self._availableQuantities_double + self._availableQuantities_hardware
 
 	# Method to obtain the data only
 	def _getDataAtTime(self, t):
@@ -306,6 +317,12 @@ class Performances(Diagnostic):
 			B = self._np.empty((self._nprocs,), dtype="double")
 			h5item.read_direct( B, source_sel=self._np.s_[index_in_file,:] )
 			C.append( B )
+		if self._quantities_hardware:
+			h5item = self._h5items[index]["quantities_hardware"]
+			for index_in_file in self._quantities_hardware:
+				B = self._np.empty((self._nprocs,), dtype="double")
+				h5item.read_direct( B, source_sel=self._np.s_[index_in_file,:] )
+				C.append( B )
 
 		# Calculate the operation
 		# First patch performance information
@@ -9,6 +9,7 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <cstdio>
 
 #include <mpi.h>
 
@@ -48,7 +49,10 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     keep_n_dumps_max( 10000 ),
     dump_deflate( 0 ),
     dump_request( smpi->getSize() ),
-    file_grouping( 0 )
+    file_grouping( 0 ),
+    dump_asynchronous( false ),
+    dump_image_index( 0 ),
+    dump_writer_failed( false )
 {
 
     if( PyTools::nComponents( "Checkpoints" ) > 0 ) {
@@ -85,6 +89,11 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
             MESSAGE( 1, "Code will group checkpoint files by "<< file_grouping );
         }
         
+        PyTools::extract( "dump_asynchronous", dump_asynchronous, "Checkpoints"  );
+        if( dump_asynchronous ) {
+            MESSAGE( 1, "Code will write checkpoint files asynchronously" );
+        }
+        
         smpi->barrier();
         
         if( params.restart ) {
@@ -176,6 +185,13 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     nDim_particle=params.nDim_particle;
 }
 
+Checkpoint::~Checkpoint()
+{
+    if( dump_writer.joinable() ) {
+        dump_writer.join();
+    }
+}
+
 void Checkpoint::dump( VectorPatch &vecPatches, Region &region, unsigned int itime, SmileiMPI *smpi, SimWindow *simWindow, Params &params )
 {
 
@@ -229,14 +245,14 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
     nameDumpTmp << "dump-" << setfill( '0' ) << setw( 5 ) << num_dump << "-" << setfill( '0' ) << setw( 10 ) << smpi->getRank() << ".h5" ;
     std::string dumpName=nameDumpTmp.str();
     
-    
-    H5Write f( dumpName );
+    // In asynchronous mode, the file is only built in memory here
+    H5Write f( dumpName, false, true, dump_asynchronous );
     dump_number++;
     
 #ifdef  __DEBUG
-    MESSAGEALL( "Step " << itime << " : DUMP fields and particles " << dumpName );
+    MESSAGEALL( "Step " << itime << " : DUMP fields and particles " << dumpName << ( dump_asynchronous ? " (asynchronous)" : "" ) );
 #else
-    MESSAGE( "Step " << itime << " : DUMP fields and particles " << num_dump );
+    MESSAGE( "Step " << itime << " : DUMP fields and particles " << num_dump << ( dump_asynchronous ? " (asynchronous)" : "" ) );
 #endif
     
     
@@ -294,7 +310,9 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
         dumpPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, vecPatches( ipatch )->vecCollisions, params, g );
         
         // Random number generator state
-        g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
+        vector<unsigned int> random_state( Random::state_size );
+        vecPatches( ipatch )->rand_->getState( &random_state[0] );
+        g.attr( "random_state", random_state );
         
     }
 
@@ -321,6 +339,44 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
         dumpMovingWindow( f, simWin );
     }
     
+    if( dump_asynchronous ) {
+        // Copy the file image in the buffer which is not being written by the previous dump
+        dump_image_index = 1 - dump_image_index;
+        if( ! f.image( dump_image[dump_image_index] ) ) {
+            ERROR( "Cannot build the image of checkpoint file " << dumpName );
+        }
+        // The previous dump must be complete before starting the next one
+        waitDumpWriter();
+        dump_writer = std::thread( &Checkpoint::writeDumpImage, this, dumpName, dump_image_index );
+    }
+    
+}
+
+void Checkpoint::writeDumpImage( string name, unsigned int index )
+{
+    // Write in a temporary file first so that an interrupted write never leaves a corrupted dump
+    string tmp_name = name + ".tmp";
+    FILE *file = fopen( tmp_name.c_str(), "wb" );
+    bool success = ( file != NULL );
+    if( success ) {
+        success = fwrite( &dump_image[index][0], 1, dump_image[index].size(), file ) == dump_image[index].size();
+        success = ( fclose( file ) == 0 ) && success;
+    }
+    if( success ) {
+        success = ( rename( tmp_name.c_str(), name.c_str() ) == 0 );
+    }
+    dump_writer_file = name;
+    dump_writer_failed = ! success;
+}
+
+void Checkpoint::waitDumpWriter()
+{
+    if( dump_writer.joinable() ) {
+        dump_writer.join();
+        if( dump_writer_failed ) {
+            ERROR( "Cannot write checkpoint file " << dump_writer_file );
+        }
+    }
 }
 
 
@@ -453,20 +509,20 @@ void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpe
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Position-" << i;
-                s.vect( my_name.str(), vecSpecies[ispec]->particles->Position[i] );//, dump_deflate );
+                s.vect( my_name.str(), vecSpecies[ispec]->particles->Position[i][0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_DOUBLE );//, dump_deflate );
             }
             
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Momentum-" << i;
-                s.vect( my_name.str(), vecSpecies[ispec]->particles->Momentum[i] );//, dump_deflate );
+                s.vect( my_name.str(), vecSpecies[ispec]->particles->Momentum[i][0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_DOUBLE );//, dump_deflate );
             }
             
-            s.vect( "Weight", vecSpecies[ispec]->particles->Weight );//, dump_deflate );
-            s.vect( "Charge", vecSpecies[ispec]->particles->Charge );//, dump_deflate );
+            s.vect( "Weight", vecSpecies[ispec]->particles->Weight[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_DOUBLE );//, dump_deflate );
+            s.vect( "Charge", vecSpecies[ispec]->particles->Charge[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_SHORT );//, dump_deflate );
             
             if( vecSpecies[ispec]->particles->tracked ) {
-                s.vect( "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64 );//, dump_deflate );
+                s.vect( "Id", vecSpecies[ispec]->particles->Id[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_UINT64 );//, dump_deflate );
             }
             
             s.vect( "first_index", vecSpecies[ispec]->particles->first_index );
@@ -598,7 +654,11 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
         restartPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, vecPatches( ipatch )->vecCollisions, params, g );
         
         // Random number generator state
-        g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
+        vector<unsigned int> random_state;
+        g.attr( "random_state", random_state, H5T_NATIVE_UINT );
+        if( random_state.size() == Random::state_size ) {
+            vecPatches( ipatch )->rand_->setState( &random_state[0] );
+        }
         
     }
 
@@ -809,21 +869,21 @@ void Checkpoint::restartPatch( ElectroMagn *EMfields, std::vector<Species *> &ve
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++ ) {
                 ostringstream namePos( "" );
                 namePos << "Position-" << i;
-                s.vect( namePos.str(), vecSpecies[ispec]->particles->Position[i] );
+                s.vect( namePos.str(), vecSpecies[ispec]->particles->Position[i][0], H5T_NATIVE_DOUBLE );
             }
             
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++ ) {
                 ostringstream namePos( "" );
                 namePos << "Momentum-" << i;
-                s.vect( namePos.str(), vecSpecies[ispec]->particles->Momentum[i] );
+                s.vect( namePos.str(), vecSpecies[ispec]->particles->Momentum[i][0], H5T_NATIVE_DOUBLE );
             }
             
-            s.vect( "Weight", vecSpecies[ispec]->particles->Weight );
+            s.vect( "Weight", vecSpecies[ispec]->particles->Weight[0], H5T_NATIVE_DOUBLE );
             
-            s.vect( "Charge", vecSpecies[ispec]->particles->Charge );
+            s.vect( "Charge", vecSpecies[ispec]->particles->Charge[0], H5T_NATIVE_SHORT );
             
             if( vecSpecies[ispec]->particles->tracked ) {
-                s.vect( "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64 );
+                s.vect( "Id", vecSpecies[ispec]->particles->Id[0], H5T_NATIVE_UINT64 );
             }
             
             if( params.vectorization_mode == "off" || params.vectorization_mode == "on" || params.cell_sorting ) {
@@ -9,6 +9,7 @@
 
 #include <string>
 #include <vector>
+#include <thread>
 
 #include <hdf5.h>
 #include <Tools.h>
@@ -38,7 +39,7 @@ class Checkpoint
 public:
     Checkpoint( Params &params, SmileiMPI *smpi );
     //! Destructor for Checkpoint
-    virtual ~Checkpoint() {};
+    virtual ~Checkpoint();
     
     //! Space dimension of a particle
     unsigned int nDim_particle;
@@ -101,6 +102,9 @@ public:
     //! exit once dump done
     bool exit_after_dump;
     
+    //! wait until the asynchronous writer has finished writing the latest dump
+    void waitDumpWriter();
+    
 private:
 
     //! initialize the time zero of the simulation
@@ -146,6 +150,23 @@ private:
     //! restart file
     std::string restart_file;
     
+    //! dumps are built in memory, then written by a dedicated thread while the simulation continues
+    bool dump_asynchronous;
+    
+    //! thread writing a dump image to disk
+    std::thread dump_writer;
+    
+    //! in-memory images of the dump files (double buffer: one being written, one being filled)
+    std::vector<char> dump_image[2];
+    unsigned int dump_image_index;
+    
+    //! file being written by the asynchronous writer, and whether it failed
+    std::string dump_writer_file;
+    bool dump_writer_failed;
+    
+    //! write the dump image number `index` in the file `name` (runs in the writer thread)
+    void writeDumpImage( std::string name, unsigned int index );
+    
 };
 
 #endif /* CHECKPOINT_H_ */
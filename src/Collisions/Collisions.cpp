@@ -25,6 +25,7 @@ Collisions::Collisions(
     double coulomb_log_factor,
     bool intra_collisions,
     int debug_every,
+    unsigned int batch_size,
     CollisionalIonization *ionization,
     CollisionalNuclearReaction *nuclear_reaction,
     string filename
@@ -38,6 +39,7 @@ Collisions::Collisions(
     coulomb_log_factor_( coulomb_log_factor ),
     intra_collisions_( intra_collisions ),
     debug_every_( debug_every ),
+    batch_size_( batch_size ),
     filename_( filename )
 {
     coeff1_ = 4.046650232e-21*params.reference_angular_frequency_SI; // h*omega/(2*me*c^2)
@@ -61,6 +63,7 @@ Collisions::Collisions( Collisions *coll )
     coulomb_log_factor_ = coll->coulomb_log_factor_;
     intra_collisions_   = coll->intra_collisions_  ;
     debug_every_        = coll->debug_every_       ;
+    batch_size_         = coll->batch_size_        ;
     filename_           = coll->filename_          ;
     coeff1_             = coll->coeff1_            ;
     coeff2_             = coll->coeff2_            ;
@@ -176,14 +179,15 @@ void Collisions::calculate_debye_length( Params &params, Patch *patch )
 }
 
 // Calculates the collisions for a given Collisions object
-void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagnostic *> &localDiags )
+void Collisions::collide( Params &params, SmileiMPI *smpi, Patch *patch, int itime, vector<Diagnostic *> &localDiags )
 {
 
-    vector<unsigned int> *sg1, *sg2, index1, index2;
+    vector<unsigned int> *sg1, *sg2;
+    unsigned int *index1, *index2;
     unsigned int nspec1, nspec2; // numbers of species in each group
     unsigned int npart1, npart2; // numbers of macro-particles in each group
     unsigned int npairs; // number of pairs of macro-particles
-    vector<unsigned int> np1, np2; // numbers of macro-particles in each species, in each group
+    unsigned int *np1, *np2; // numbers of macro-particles in each species, in each group
     unsigned int i1=0, i2, ispec1, ispec2, N2max;
     Species   *s1, *s2;
     Particles *p1=NULL, *p2;
@@ -192,6 +196,15 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
     sg1 = &species_group1_;
     sg2 = &species_group2_;
     
+    // Temporary arrays in the scratch memory of this thread
+    ScratchArena &scratch = smpi->scratch();
+    ScratchArena::Scope scope( scratch );
+    np1 = scratch.allocate<unsigned int>( max( sg1->size(), sg2->size() ) );
+    np2 = scratch.allocate<unsigned int>( max( sg1->size(), sg2->size() ) );
+    PairBatch batch;
+    if( batch_size_ > 0 ) {
+        batch.allocate( scratch, batch_size_ );
+    }
     
     bool debug = ( debug_every_ > 0 && itime % debug_every_ == 0 ); // debug only every N timesteps
     
@@ -206,12 +219,12 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
     unsigned int nbin = patch->vecSpecies[0]->particles->first_index.size();
     for( unsigned int ibin = 0 ; ibin < nbin ; ibin++ ) {
     
+        ScratchArena::Scope bin_scope( scratch );
+        
         // get number of particles for all necessary species
         for( unsigned int i=0; i<2; i++ ) { // try twice to ensure group 1 has more macro-particles
             nspec1 = sg1->size();
             nspec2 = sg2->size();
-            np1.resize( nspec1 ); // number of particles in each species of group 1
-            np2.resize( nspec2 ); // number of particles in each species of group 2
             npart1 = 0;
             npart2 = 0;
             for( ispec1=0 ; ispec1<nspec1 ; ispec1++ ) {
@@ -244,7 +257,7 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         
         // Shuffle particles to have random pairs
         //    (It does not really exchange them, it is just a temporary re-indexing)
-        index1.resize( npart1 );
+        index1 = scratch.allocate<unsigned int>( npart1 );
         for( unsigned int i=0; i<npart1; i++ ) {
             index1[i] = i;    // first, we make an ordered array
         }
@@ -258,15 +271,15 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
                 continue;
             }
             npairs = ( npart1 + 1 ) / 2; // half as many pairs as macro-particles
-            index2.resize( npairs );
+            index2 = scratch.allocate<unsigned int>( npairs );
             for( unsigned int i=0; i<npairs; i++ ) {
                 index2[i] = index1[( i+npairs )%npart1];    // index2 is second half
             }
-            index1.resize( npairs ); // index1 is first half
+            // index1 is first half
             N2max = npart1 - npairs; // number of not-repeated particles (in group 2 only)
         } else { // In the case of collisions between two species
             npairs = npart1; // as many pairs as macro-particles in group 1 (most numerous)
-            index2.resize( npairs );
+            index2 = scratch.allocate<unsigned int>( npairs );
             for( unsigned int i=0; i<npart1; i++ ) {
                 index2[i] = i % npart2;
             }
@@ -314,6 +327,9 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         double n123 = pow( n1, 2./3. );
         double n223 = pow( n2, 2./3. );
         
+        // In batches, a particle of group 2 reappears every N2max pairs: batches cannot be longer
+        unsigned int max_batch = min( batch_size_, N2max );
+        
         // Now start the real loop on pairs of particles
         // See equations in http://dx.doi.org/10.1063/1.4742167
         // ----------------------------------------------------
@@ -344,6 +360,16 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
                 weight_correction *= weight_correction_1;
             }
             
+            ncol ++;
+            
+            if( batch_size_ > 0 ) {
+                batch.add( p1, i1, s1->mass_, p2, i2, s2->mass_, weight_correction );
+                if( batch.size == max_batch || i == npairs-1 ) {
+                    batch_collisions( patch, scratch, batch, coeff3, coeff4, n123, n223, debye2, dt_corr, debug );
+                }
+                continue;
+            }
+            
             logL = coulomb_log_;
             double U1  = patch->rand_->uniform();
             double U2  = patch->rand_->uniform();
@@ -354,7 +380,6 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             // Handle ionization
             Ionization->apply( patch, p1, i1, p2, i2, dt_corr*weight_correction );
             
-            ncol ++;
             if( debug ) {
                 smean_    += s;
                 logLmean_ += logL;
@@ -376,6 +401,268 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
 }
 
 
+void Collisions::PairBatch::allocate( ScratchArena &scratch, unsigned int max_size )
+{
+    p1 = scratch.allocate<Particles *>( max_size );
+    p2 = scratch.allocate<Particles *>( max_size );
+    i1 = scratch.allocate<unsigned int>( max_size );
+    i2 = scratch.allocate<unsigned int>( max_size );
+    m1 = scratch.allocate<double>( max_size );
+    m2 = scratch.allocate<double>( max_size );
+    weight_correction = scratch.allocate<double>( max_size );
+    size = 0;
+}
+
+
+// Collides all the pairs of a batch
+// Same equations as one_collision, split in passes over arrays of pairs:
+// gather, center-of-mass frame, nuclear reactions, deflection, scatter, and ionization
+void Collisions::batch_collisions(
+    Patch *patch,
+    ScratchArena &scratch,
+    PairBatch &batch,
+    double coeff3,
+    double coeff4,
+    double n123,
+    double n223,
+    double debye2,
+    double dt_corr,
+    bool debug
+)
+{
+    unsigned int n = batch.size;
+    if( n == 0 ) {
+        return;
+    }
+    ScratchArena::Scope scope( scratch );
+    
+    // Particle properties (the new momenta replace the old ones)
+    double *px1 = scratch.allocate<double>( n );
+    double *py1 = scratch.allocate<double>( n );
+    double *pz1 = scratch.allocate<double>( n );
+    double *px2 = scratch.allocate<double>( n );
+    double *py2 = scratch.allocate<double>( n );
+    double *pz2 = scratch.allocate<double>( n );
+    double *w1  = scratch.allocate<double>( n );
+    double *w2  = scratch.allocate<double>( n );
+    double *q1  = scratch.allocate<double>( n );
+    double *q2  = scratch.allocate<double>( n );
+    // Random numbers
+    double *U1  = scratch.allocate<double>( n );
+    double *U2  = scratch.allocate<double>( n );
+    double *phi = scratch.allocate<double>( n );
+    // Center-of-mass (COM) frame
+    double *gamma1     = scratch.allocate<double>( n );
+    double *gamma2     = scratch.allocate<double>( n );
+    double *COM_vx     = scratch.allocate<double>( n );
+    double *COM_vy     = scratch.allocate<double>( n );
+    double *COM_vz     = scratch.allocate<double>( n );
+    double *COM_gamma  = scratch.allocate<double>( n );
+    double *term1      = scratch.allocate<double>( n );
+    double *term3      = scratch.allocate<double>( n );
+    double *term5      = scratch.allocate<double>( n );
+    double *px_COM     = scratch.allocate<double>( n );
+    double *py_COM     = scratch.allocate<double>( n );
+    double *pz_COM     = scratch.allocate<double>( n );
+    double *p_COM      = scratch.allocate<double>( n );
+    double *gamma1_COM = scratch.allocate<double>( n );
+    double *gamma2_COM = scratch.allocate<double>( n );
+    double *vrel       = scratch.allocate<double>( n );
+    // Results
+    double *s    = scratch.allocate<double>( n );
+    double *logL = scratch.allocate<double>( n );
+    bool *active   = scratch.allocate<bool>( n );
+    bool *deflect1 = scratch.allocate<bool>( n );
+    bool *deflect2 = scratch.allocate<bool>( n );
+    
+    // Gather the particles of the pairs
+    for( unsigned int j=0; j<n; j++ ) {
+        Particles *p1 = batch.p1[j];
+        Particles *p2 = batch.p2[j];
+        unsigned int i1 = batch.i1[j];
+        unsigned int i2 = batch.i2[j];
+        px1[j] = p1->momentum( 0, i1 );
+        py1[j] = p1->momentum( 1, i1 );
+        pz1[j] = p1->momentum( 2, i1 );
+        w1 [j] = p1->weight( i1 );
+        q1 [j] = p1->charge( i1 );
+        px2[j] = p2->momentum( 0, i2 );
+        py2[j] = p2->momentum( 1, i2 );
+        pz2[j] = p2->momentum( 2, i2 );
+        w2 [j] = p2->weight( i2 );
+        q2 [j] = p2->charge( i2 );
+    }
+    
+    patch->rand_->uniform( U1, n );
+    patch->rand_->uniform( U2, n );
+    patch->rand_->uniform_2pi( phi, n );
+    
+    // Center-of-mass frame
+    // If one weight is zero, the pair is skipped. Can happen after nuclear reaction
+    #pragma omp simd
+    for( unsigned int j=0; j<n; j++ ) {
+        double m12 = batch.m1[j] / batch.m2[j];
+        active[j] = std::min( w1[j], w2[j] ) > 0.;
+        
+        gamma1[j] = sqrt( 1. + px1[j]*px1[j] + py1[j]*py1[j] + pz1[j]*pz1[j] );
+        gamma2[j] = sqrt( 1. + px2[j]*px2[j] + py2[j]*py2[j] + pz2[j]*pz2[j] );
+        double gamma12_inv = 1./( m12 * gamma1[j] + gamma2[j] );
+        
+        COM_vx[j] = ( m12 * px1[j] + px2[j] ) * gamma12_inv;
+        COM_vy[j] = ( m12 * py1[j] + py2[j] ) * gamma12_inv;
+        COM_vz[j] = ( m12 * pz1[j] + pz2[j] ) * gamma12_inv;
+        double COM_vsquare = COM_vx[j]*COM_vx[j] + COM_vy[j]*COM_vy[j] + COM_vz[j]*COM_vz[j];
+        
+        // When the COM is at rest, the terms below reduce to the identity transformation
+        COM_gamma[j] = 1./sqrt( 1.-COM_vsquare );
+        double safe_vsquare = COM_vsquare != 0. ? COM_vsquare : 1.;
+        term1[j] = COM_vsquare != 0. ? ( COM_gamma[j] - 1. ) / safe_vsquare : 0.5;
+        double vcv1  = ( COM_vx[j]*px1[j] + COM_vy[j]*py1[j] + COM_vz[j]*pz1[j] )/gamma1[j];
+        double vcv2  = ( COM_vx[j]*px2[j] + COM_vy[j]*py2[j] + COM_vz[j]*pz2[j] )/gamma2[j];
+        double term2 = ( term1[j]*vcv1 - COM_gamma[j] ) * gamma1[j];
+        px_COM[j] = px1[j] + term2*COM_vx[j];
+        py_COM[j] = py1[j] + term2*COM_vy[j];
+        pz_COM[j] = pz1[j] + term2*COM_vz[j];
+        gamma1_COM[j] = ( 1.-vcv1 )*COM_gamma[j]*gamma1[j];
+        gamma2_COM[j] = ( 1.-vcv2 )*COM_gamma[j]*gamma2[j];
+        double p2_COM = px_COM[j]*px_COM[j] + py_COM[j]*py_COM[j] + pz_COM[j]*pz_COM[j];
+        p_COM[j] = sqrt( p2_COM );
+        
+        term3[j] = COM_gamma[j] * gamma12_inv;
+        double term4 = gamma1_COM[j] * gamma2_COM[j];
+        term5[j] = term4/p2_COM + m12;
+        vrel[j] = p_COM[j]/term3[j]/term4;
+    }
+    
+    // Nuclear reactions, which replace the collision when a reactant is consumed
+    if( ! NuclearReaction->name().empty() ) {
+        for( unsigned int j=0; j<n; j++ ) {
+            if( ! active[j] ) {
+                continue;
+            }
+            Particles *p1 = batch.p1[j];
+            Particles *p2 = batch.p2[j];
+            unsigned int i1 = batch.i1[j];
+            unsigned int i2 = batch.i2[j];
+            if( nuclear_reaction( p1, i1, batch.m1[j], p2, i2, batch.m2[j], coeff3*batch.weight_correction[j],
+                                  U1[j], U2[j], phi[j], std::min( w1[j], w2[j] ),
+                                  COM_vx[j], COM_vy[j], COM_vz[j], COM_gamma[j], term1[j],
+                                  px_COM[j], py_COM[j], pz_COM[j], p_COM[j], vrel[j], gamma1_COM[j], gamma2_COM[j] ) ) {
+                active[j] = false;
+            }
+            w1[j] = p1->weight( i1 );
+            w2[j] = p2->weight( i2 );
+        }
+    }
+    
+    // Deflection
+    #pragma omp simd
+    for( unsigned int j=0; j<n; j++ ) {
+        double m1 = batch.m1[j];
+        double m12 = m1 / batch.m2[j];
+        double qqm  = q1[j] * q2[j] / m1;
+        double qqm2 = qqm * qqm;
+        
+        // Calculate coulomb log if necessary
+        double logLj = coulomb_log_;
+        if( logLj <= 0. && active[j] ) {
+            // Note : 0.00232282 is coeff2 / coeff1
+            double bmin = coeff1_ * std::max( 1./m1/p_COM[j], std::abs( 0.00232282*qqm*term3[j]*term5[j] ) ); // min impact parameter
+            logLj = 0.5*log( 1.+debye2/( bmin*bmin ) );
+            if( logLj < 2. ) {
+                logLj = 2.;
+            }
+        }
+        logL[j] = logLj;
+        
+        // Collision parameter s12, with the low-temperature correction
+        double sj = coeff3 * batch.weight_correction[j] * logLj * qqm2 * term3[j] * p_COM[j] * term5[j]*term5[j] / ( gamma1[j]*gamma2[j] );
+        double smax = coeff4 * batch.weight_correction[j] * ( m12+1. ) * vrel[j] / std::max( m12*n123, n223 );
+        if( sj>smax ) {
+            sj = smax;
+        }
+        s[j] = active[j] ? sj : 0.;
+        
+        // Deflection angle cosine, see one_collision
+        double cosX;
+        if( sj < 0.1 ) {
+            cosX = 1. + sj*log( std::max( U1[j], 0.0001 ) );
+        } else if( sj < 3. ) {
+            double invA = 0.00569578 +( 0.95602 + ( -0.508139 + ( 0.479139 + ( -0.12789 + 0.0238957*sj )*sj )*sj )*sj )*sj;
+            double A = 1./invA;
+            cosX = invA  * log( exp( -A ) + 2.*U1[j]*sinh( A ) );
+        } else if( sj < 6. ) {
+            double A = 3.*exp( -sj );
+            cosX = ( 1./A ) * log( exp( -A ) + 2.*U1[j]*sinh( A ) );
+        } else {
+            cosX = 2.*U1[j] - 1.;
+        }
+        double sinX = sqrt( 1. - cosX*cosX );
+        double sinXcosPhi = sinX*cos( phi[j] );
+        double sinXsinPhi = sinX*sin( phi[j] );
+        
+        // Apply the deflection
+        double newpx_COM, newpy_COM, newpz_COM;
+        double p_perp = sqrt( px_COM[j]*px_COM[j] + py_COM[j]*py_COM[j] );
+        if( p_perp > 1.e-10*p_COM[j] ) { // make sure p_perp is not too small
+            double inv_p_perp = 1./p_perp;
+            newpx_COM = ( px_COM[j] * pz_COM[j] * sinXcosPhi - py_COM[j] * p_COM[j] * sinXsinPhi ) * inv_p_perp + px_COM[j] * cosX;
+            newpy_COM = ( py_COM[j] * pz_COM[j] * sinXcosPhi + px_COM[j] * p_COM[j] * sinXsinPhi ) * inv_p_perp + py_COM[j] * cosX;
+            newpz_COM = -p_perp * sinXcosPhi  +  pz_COM[j] * cosX;
+        } else { // if p_perp is too small, we use the limit px->0, py=0
+            newpx_COM = p_COM[j] * sinXcosPhi;
+            newpy_COM = p_COM[j] * sinXsinPhi;
+            newpz_COM = p_COM[j] * cosX;
+        }
+        
+        // Go back to the lab frame; each particle is deflected with some probability
+        double vcp = COM_vx[j] * newpx_COM + COM_vy[j] * newpy_COM + COM_vz[j] * newpz_COM;
+        deflect1[j] = active[j] && U2[j] < w2[j]/w1[j];
+        deflect2[j] = active[j] && U2[j] < w1[j]/w2[j];
+        double term6 = term1[j]*vcp + gamma1_COM[j] * COM_gamma[j];
+        px1[j] = newpx_COM + COM_vx[j] * term6;
+        py1[j] = newpy_COM + COM_vy[j] * term6;
+        pz1[j] = newpz_COM + COM_vz[j] * term6;
+        term6 = -m12 * term1[j]*vcp + gamma2_COM[j] * COM_gamma[j];
+        px2[j] = -m12 * newpx_COM + COM_vx[j] * term6;
+        py2[j] = -m12 * newpy_COM + COM_vy[j] * term6;
+        pz2[j] = -m12 * newpz_COM + COM_vz[j] * term6;
+    }
+    
+    // Scatter the deflected particles
+    for( unsigned int j=0; j<n; j++ ) {
+        if( deflect1[j] ) {
+            Particles *p1 = batch.p1[j];
+            unsigned int i1 = batch.i1[j];
+            p1->momentum( 0, i1 ) = px1[j];
+            p1->momentum( 1, i1 ) = py1[j];
+            p1->momentum( 2, i1 ) = pz1[j];
+        }
+        if( deflect2[j] ) {
+            Particles *p2 = batch.p2[j];
+            unsigned int i2 = batch.i2[j];
+            p2->momentum( 0, i2 ) = px2[j];
+            p2->momentum( 1, i2 ) = py2[j];
+            p2->momentum( 2, i2 ) = pz2[j];
+        }
+    }
+    
+    // Handle ionization
+    for( unsigned int j=0; j<n; j++ ) {
+        Ionization->apply( patch, batch.p1[j], batch.i1[j], batch.p2[j], batch.i2[j], dt_corr*batch.weight_correction[j] );
+    }
+    
+    if( debug ) {
+        for( unsigned int j=0; j<n; j++ ) {
+            smean_    += s[j];
+            logLmean_ += logL[j];
+        }
+    }
+    
+    batch.size = 0;
+}
+
+
 void Collisions::debug( Params &params, int itime, unsigned int icoll, VectorPatch &vecPatches )
 {
 
@@ -14,6 +14,8 @@ class Patch;
 class Params;
 class Species;
 class VectorPatch;
+class SmileiMPI;
+class ScratchArena;
 
 class Collisions
 {
@@ -29,6 +31,7 @@ public:
         double coulomb_log_factor,
         bool intra_collisions,
         int debug_every,
+        unsigned int batch_size,
         CollisionalIonization *ionization,
         CollisionalNuclearReaction *nuclear_reaction,
         std::string
@@ -45,7 +48,7 @@ public:
     static bool debye_length_required;
     
     //! Method called in the main smilei loop to apply collisions at each timestep
-    virtual void collide( Params &, Patch *, int, std::vector<Diagnostic *> & );
+    virtual void collide( Params &, SmileiMPI *, Patch *, int, std::vector<Diagnostic *> & );
     
     //! Outputs the debug info if requested
     static void debug( Params &params, int itime, unsigned int icoll, VectorPatch &vecPatches );
@@ -77,6 +80,9 @@ protected:
     //! Number of timesteps between each dump of collisions debugging
     int debug_every_;
     
+    //! Number of pairs collided together by batch_collisions (0 means one pair at a time)
+    unsigned int batch_size_;
+    
     //! Hdf5 file name
     std::string filename_;
     
@@ -86,85 +92,76 @@ protected:
     const double twoPi = 2. * 3.14159265358979323846;
     double coeff1_, coeff2_;
     
-    // Collide one particle with another
-    // See equations in http://dx.doi.org/10.1063/1.4742167
-    inline double one_collision(
+    //! Pairs of particles waiting to be collided by batch_collisions
+    //! A particle may appear only once in a batch
+    struct PairBatch {
+        Particles **p1, **p2;
+        unsigned int *i1, *i2;
+        double *m1, *m2;
+        double *weight_correction;
+        unsigned int size;
+        
+        void allocate( ScratchArena &scratch, unsigned int max_size );
+        
+        inline void add( Particles *part1, unsigned int index1, double mass1, Particles *part2, unsigned int index2, double mass2, double correction )
+        {
+            p1[size] = part1;
+            i1[size] = index1;
+            m1[size] = mass1;
+            p2[size] = part2;
+            i2[size] = index2;
+            m2[size] = mass2;
+            weight_correction[size] = correction;
+            size++;
+        }
+    };
+    
+    //! Same as one_collision (followed by the ionization) for all the pairs of a batch, which is emptied.
+    //! The random numbers are drawn together and the kinematics are computed on arrays of the batch size.
+    void batch_collisions(
+        Patch *patch,
+        ScratchArena &scratch,
+        PairBatch &batch,
+        double coeff3,
+        double coeff4,
+        double n123,
+        double n223,
+        double debye2,
+        double dt_corr,
+        bool debug
+    );
+    
+    // Try a nuclear reaction between two particles, knowing their center-of-mass (COM) frame
+    // Returns true if one of the particles has been consumed, so that no collision must follow
+    // U2 is modified if the reaction occurs
+    inline bool nuclear_reaction(
         Particles *p1,
         unsigned int i1,
         double m1,
         Particles *p2,
         unsigned int i2,
         double m2,
-        double coeff1,
         double coeff3,
-        double coeff4,
-        double n123,
-        double n223,
-        double debye2,
-        double &logL,
         double U1,
-        double U2,
-        double phi
+        double &U2,
+        double phi,
+        double minW,
+        double COM_vx,
+        double COM_vy,
+        double COM_vz,
+        double COM_gamma,
+        double term1,
+        double px_COM,
+        double py_COM,
+        double pz_COM,
+        double p_COM,
+        double vrel,
+        double gamma1_COM,
+        double gamma2_COM
     )
     {
         double term6, cosX, sinX, sinXcosPhi, sinXsinPhi, p_perp, inv_p_perp,
                newpx_COM, newpy_COM, newpz_COM, vcp;
-        
-        double m12 = m1 / m2;
-        
-        // If one weight is zero, then skip. Can happen after nuclear reaction
-        double minW = std::min( p1->weight(i1), p2->weight(i2) );
-        if( minW <= 0. ) return 0.;
-        
-        // Get momenta and calculate gammas
-        double gamma1 = sqrt( 1. + p1->momentum( 0, i1 )*p1->momentum( 0, i1 ) + p1->momentum( 1, i1 )*p1->momentum( 1, i1 ) + p1->momentum( 2, i1 )*p1->momentum( 2, i1 ) );
-        double gamma2 = sqrt( 1. + p2->momentum( 0, i2 )*p2->momentum( 0, i2 ) + p2->momentum( 1, i2 )*p2->momentum( 1, i2 ) + p2->momentum( 2, i2 )*p2->momentum( 2, i2 ) );
-        double gamma12 = m12 * gamma1 + gamma2;
-        double gamma12_inv = 1./gamma12;
-        
-        // Calculate the center-of-mass (COM) frame
-        // Quantities starting with "COM" are those of the COM itself, expressed in the lab frame.
-        // They are NOT quantities relative to the COM.
-        double COM_vx = ( m12 * ( p1->momentum( 0, i1 ) ) + p2->momentum( 0, i2 ) ) * gamma12_inv;
-        double COM_vy = ( m12 * ( p1->momentum( 1, i1 ) ) + p2->momentum( 1, i2 ) ) * gamma12_inv;
-        double COM_vz = ( m12 * ( p1->momentum( 2, i1 ) ) + p2->momentum( 2, i2 ) ) * gamma12_inv;
-        double COM_vsquare = COM_vx*COM_vx + COM_vy*COM_vy + COM_vz*COM_vz;
-        
-        // Change the momentum to the COM frame (we work only on particle 1)
-        // Quantities ending with "COM" are quantities of the particle expressed in the COM frame.
-        double COM_gamma, term1, term2, vcv1, vcv2, px_COM, py_COM, pz_COM, gamma1_COM, gamma2_COM;
-        if( COM_vsquare != 0. ) {
-            COM_gamma = 1./sqrt( 1.-COM_vsquare );
-            term1 = ( COM_gamma - 1. ) / COM_vsquare;
-            vcv1  = ( COM_vx*( p1->momentum( 0, i1 ) ) + COM_vy*( p1->momentum( 1, i1 ) ) + COM_vz*( p1->momentum( 2, i1 ) ) )/gamma1;
-            vcv2  = ( COM_vx*( p2->momentum( 0, i2 ) ) + COM_vy*( p2->momentum( 1, i2 ) ) + COM_vz*( p2->momentum( 2, i2 ) ) )/gamma2;
-            term2 = ( term1*vcv1 - COM_gamma ) * gamma1;
-            px_COM = ( p1->momentum( 0, i1 ) ) + term2*COM_vx;
-            py_COM = ( p1->momentum( 1, i1 ) ) + term2*COM_vy;
-            pz_COM = ( p1->momentum( 2, i1 ) ) + term2*COM_vz;
-            gamma1_COM = ( 1.-vcv1 )*COM_gamma*gamma1;
-            gamma2_COM = ( 1.-vcv2 )*COM_gamma*gamma2;
-        } else {
-            COM_gamma = 1.;
-            term1 = 0.5;
-            term2 = gamma1;
-            px_COM = ( p1->momentum( 0, i1 ) );
-            py_COM = ( p1->momentum( 1, i1 ) );
-            pz_COM = ( p1->momentum( 2, i1 ) );
-            gamma1_COM = gamma1;
-            gamma2_COM = gamma2;
-        }
-        double p2_COM = px_COM*px_COM + py_COM*py_COM + pz_COM*pz_COM;
-        double p_COM  = sqrt( p2_COM );
-        
-        // Calculate some intermediate quantities
-        double term3 = COM_gamma * gamma12_inv;
-        double term4 = gamma1_COM * gamma2_COM;
-        double term5 = term4/p2_COM + m12;
-        double vrel = p_COM/term3/term4; // relative velocity
-        
-        // We first try to do a nuclear reaction
-        // If succesful, then no need to do a collision
         double E, logE;
         if( NuclearReaction->occurs( U1, vrel*coeff3, m1, m2, gamma1_COM, gamma2_COM, E, logE, minW ) ) {
             // Reduce the weight of both reactants
@@ -263,11 +260,96 @@ protected:
                 }
             }
             
-            if( p1->weight(i1) == 0. || p2->weight(i2) == 0. ) {
-                return 0.; // no collision
-            }
+            return p1->weight(i1) == 0. || p2->weight(i2) == 0.;
             
         } // end nuclear reaction
+        return false;
+    };
+    
+    // Collide one particle with another
+    // See equations in http://dx.doi.org/10.1063/1.4742167
+    inline double one_collision(
+        Particles *p1,
+        unsigned int i1,
+        double m1,
+        Particles *p2,
+        unsigned int i2,
+        double m2,
+        double coeff1,
+        double coeff3,
+        double coeff4,
+        double n123,
+        double n223,
+        double debye2,
+        double &logL,
+        double U1,
+        double U2,
+        double phi
+    )
+    {
+        double term6, cosX, sinX, sinXcosPhi, sinXsinPhi, p_perp, inv_p_perp,
+               newpx_COM, newpy_COM, newpz_COM, vcp;
+        
+        double m12 = m1 / m2;
+        
+        // If one weight is zero, then skip. Can happen after nuclear reaction
+        double minW = std::min( p1->weight(i1), p2->weight(i2) );
+        if( minW <= 0. ) return 0.;
+        
+        // Get momenta and calculate gammas
+        double gamma1 = sqrt( 1. + p1->momentum( 0, i1 )*p1->momentum( 0, i1 ) + p1->momentum( 1, i1 )*p1->momentum( 1, i1 ) + p1->momentum( 2, i1 )*p1->momentum( 2, i1 ) );
+        double gamma2 = sqrt( 1. + p2->momentum( 0, i2 )*p2->momentum( 0, i2 ) + p2->momentum( 1, i2 )*p2->momentum( 1, i2 ) + p2->momentum( 2, i2 )*p2->momentum( 2, i2 ) );
+        double gamma12 = m12 * gamma1 + gamma2;
+        double gamma12_inv = 1./gamma12;
+        
+        // Calculate the center-of-mass (COM) frame
+        // Quantities starting with "COM" are those of the COM itself, expressed in the lab frame.
+        // They are NOT quantities relative to the COM.
+        double COM_vx = ( m12 * ( p1->momentum( 0, i1 ) ) + p2->momentum( 0, i2 ) ) * gamma12_inv;
+        double COM_vy = ( m12 * ( p1->momentum( 1, i1 ) ) + p2->momentum( 1, i2 ) ) * gamma12_inv;
+        double COM_vz = ( m12 * ( p1->momentum( 2, i1 ) ) + p2->momentum( 2, i2 ) ) * gamma12_inv;
+        double COM_vsquare = COM_vx*COM_vx + COM_vy*COM_vy + COM_vz*COM_vz;
+        
+        // Change the momentum to the COM frame (we work only on particle 1)
+        // Quantities ending with "COM" are quantities of the particle expressed in the COM frame.
+        double COM_gamma, term1, term2, vcv1, vcv2, px_COM, py_COM, pz_COM, gamma1_COM, gamma2_COM;
+        if( COM_vsquare != 0. ) {
+            COM_gamma = 1./sqrt( 1.-COM_vsquare );
+            term1 = ( COM_gamma - 1. ) / COM_vsquare;
+            vcv1  = ( COM_vx*( p1->momentum( 0, i1 ) ) + COM_vy*( p1->momentum( 1, i1 ) ) + COM_vz*( p1->momentum( 2, i1 ) ) )/gamma1;
+            vcv2  = ( COM_vx*( p2->momentum( 0, i2 ) ) + COM_vy*( p2->momentum( 1, i2 ) ) + COM_vz*( p2->momentum( 2, i2 ) ) )/gamma2;
+            term2 = ( term1*vcv1 - COM_gamma ) * gamma1;
+            px_COM = ( p1->momentum( 0, i1 ) ) + term2*COM_vx;
+            py_COM = ( p1->momentum( 1, i1 ) ) + term2*COM_vy;
+            pz_COM = ( p1->momentum( 2, i1 ) ) + term2*COM_vz;
+            gamma1_COM = ( 1.-vcv1 )*COM_gamma*gamma1;
+            gamma2_COM = ( 1.-vcv2 )*COM_gamma*gamma2;
+        } else {
+            COM_gamma = 1.;
+            term1 = 0.5;
+            term2 = gamma1;
+            px_COM = ( p1->momentum( 0, i1 ) );
+            py_COM = ( p1->momentum( 1, i1 ) );
+            pz_COM = ( p1->momentum( 2, i1 ) );
+            gamma1_COM = gamma1;
+            gamma2_COM = gamma2;
+        }
+        double p2_COM = px_COM*px_COM + py_COM*py_COM + pz_COM*pz_COM;
+        double p_COM  = sqrt( p2_COM );
+        
+        // Calculate some intermediate quantities
+        double term3 = COM_gamma * gamma12_inv;
+        double term4 = gamma1_COM * gamma2_COM;
+        double term5 = term4/p2_COM + m12;
+        double vrel = p_COM/term3/term4; // relative velocity
+        
+        // We first try to do a nuclear reaction
+        // If succesful, then no need to do a collision
+        if( nuclear_reaction( p1, i1, m1, p2, i2, m2, coeff3, U1, U2, phi, minW,
+                              COM_vx, COM_vy, COM_vz, COM_gamma, term1,
+                              px_COM, py_COM, pz_COM, p_COM, vrel, gamma1_COM, gamma2_COM ) ) {
+            return 0.; // no collision
+        }
         
         // Calculate stuff
         double qqm  = p1->charge( i1 ) * p2->charge( i2 ) / m1;
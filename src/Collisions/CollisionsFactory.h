@@ -19,7 +19,7 @@ public:
         double clog;
         double clog_factor;
         bool intra;
-        int debug_every, Z, Z0, Z1, ionization_electrons;
+        int debug_every, batch_size, Z, Z0, Z1, ionization_electrons;
         std::string filename;
         std::ostringstream mystream;
         Species *s0, *s;
@@ -78,6 +78,13 @@ public:
         debug_every = 0; // default
         PyTools::extract( "debug_every", debug_every, "Collisions", n_collisions );
         
+        // Number of pairs of particles collided together (if 0 or unset, one pair at a time)
+        batch_size = 0; // default
+        PyTools::extract( "batch_size", batch_size, "Collisions", n_collisions );
+        if( batch_size < 0 ) {
+            ERROR( "In collisions #" << n_collisions << ": batch_size must be positive or zero" );
+        }
+        
         // Collisional ionization
         Z = 0; // default
         PyObject * ionizing = PyTools::extract_py( "ionizing", "Collisions", n_collisions );
@@ -257,6 +264,9 @@ public:
         if( debug_every>0 ) {
             MESSAGE( 2, "Debug every " << debug_every << " timesteps" );
         }
+        if( batch_size>0 ) {
+            MESSAGE( 2, "Pairs collided in batches of " << batch_size );
+        }
         mystream.str( "" ); // clear
         if( ionization_electrons>0 ) {
             MESSAGE( 2, "Collisional ionization with atomic number "<<Z<<" towards species `"<<vecSpecies[ionization_electrons]->name_ << "`" );
@@ -304,6 +314,7 @@ public:
                        sgroup[1],
                        clog, clog_factor, intra,
                        debug_every,
+                       batch_size,
                        Ionization,
                        NuclearReaction,
                        filename
@@ -316,6 +327,7 @@ public:
                        sgroup[1],
                        clog, clog_factor, intra,
                        debug_every,
+                       batch_size,
                        Ionization,
                        NuclearReaction,
                        filename
@@ -19,10 +19,10 @@ using namespace std;
 // The difference with Collisions::collide is that this version
 // does not handle more than 1 species on each side,
 // but is potentially faster
-void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<Diagnostic *> &localDiags )
+void CollisionsSingle::collide( Params &params, SmileiMPI *smpi, Patch *patch, int itime, vector<Diagnostic *> &localDiags )
 {
 
-    vector<unsigned int> index1;
+    unsigned int *index1;
     unsigned int npairs; // number of pairs of macro-particles
     unsigned int np1, np2; // numbers of macro-particles in each species
     unsigned int i1=0, i2, first_index1, first_index2, N2max;
@@ -44,10 +44,19 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
     
     NuclearReaction->prepare();
     
+    ScratchArena &scratch = smpi->scratch();
+    ScratchArena::Scope scope( scratch );
+    PairBatch batch;
+    if( batch_size_ > 0 ) {
+        batch.allocate( scratch, batch_size_ );
+    }
+    
     // Loop bins of particles (typically, cells, but may also be clusters)
     unsigned int nbin = patch->vecSpecies[0]->particles->first_index.size();
     for( unsigned int ibin = 0 ; ibin < nbin ; ibin++ ) {
     
+        ScratchArena::Scope bin_scope( scratch );
+        
         // get number of particles for all necessary species
         np1 = s1->particles->last_index[ibin] - s1->particles->first_index[ibin];
         np2 = s2->particles->last_index[ibin] - s2->particles->first_index[ibin];
@@ -85,7 +94,7 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             N2max = np2; // number of not-repeated particles (in species 2 only)
         }
         // Shuffle one particle in each pair
-        index1.resize( npairs );
+        index1 = scratch.allocate<unsigned int>( npairs );
         for( unsigned int i=0; i<npairs; i++ ) {
             index1[i] = first_index1 + i;
         }
@@ -93,7 +102,7 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             unsigned int p = patch->rand_->integer() % i;
             swap( index1[i-1], index1[p] );
         }
-        p1->swapParticles( index1 ); // exchange particles along the cycle defined by the shuffle
+        p1->swapParticles( index1, npairs ); // exchange particles along the cycle defined by the shuffle
         
         // Prepare the ionization
         Ionization->prepare1( s1->atomic_number_ );
@@ -125,6 +134,9 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
         double n123 = pow( n1, 2./3. );
         double n223 = pow( n2, 2./3. );
         
+        // In batches, a particle of group 2 reappears every N2max pairs: batches cannot be longer
+        unsigned int max_batch = min( batch_size_, N2max );
+        
         // Now start the real loop on pairs of particles
         // ----------------------------------------------------
         for( unsigned int i=0; i<npairs; i++ ) {
@@ -139,6 +151,16 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
                 weight_correction *= weight_correction_1;
             }
             
+            ncol ++;
+            
+            if( batch_size_ > 0 ) {
+                batch.add( p1, i1, s1->mass_, p2, i2, s2->mass_, weight_correction );
+                if( batch.size == max_batch || i == npairs-1 ) {
+                    batch_collisions( patch, scratch, batch, coeff3, coeff4, n123, n223, debye2, dt_corr, debug );
+                }
+                continue;
+            }
+            
             logL = coulomb_log_;
             double U1  = patch->rand_->uniform();
             double U2  = patch->rand_->uniform();
@@ -149,7 +171,6 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             // Handle ionization
             Ionization->apply( patch, p1, i1, p2, i2, dt_corr*weight_correction );
             
-            ncol ++;
             if( debug ) {
                 smean_    += s;
                 logLmean_ += logL;
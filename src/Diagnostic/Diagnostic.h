@@ -37,8 +37,14 @@ public :
     //! Prepares the diag and check whether it is time to run. Only by MPI master for global diags. Only by patch master for local diags.
     virtual bool prepare( int timestep ) = 0;
     
+    //! Work done once for all the patches of this MPI, by one thread, before run() for global diags.
+    virtual void prepareAllPatches( VectorPatch &vecPatches, int timestep ) {};
+    
     //! Runs the diag for a given patch for global diags.
-    virtual void run( Patch *patch, int timestep, SimWindow *simWindow ) {};
+    virtual void run( SmileiMPI *smpi, Patch *patch, int timestep, SimWindow *simWindow ) {};
+    
+    //! Sums the data accumulated separately by each thread in run(). Called by all threads for global diags.
+    virtual void reduceThreads() {};
     
     //! Runs the diag for all patches for local diags.
     virtual void run( SmileiMPI *smpi, VectorPatch &vecPatches, int timestep, SimWindow *simWindow, Timers &timers ) {};
@@ -46,6 +52,9 @@ public :
     //! Writes out a global diag diag.
     virtual void write( int timestep, SmileiMPI *smpi ) {};
     
+    //! Completes the MPI reduction of a global diag started during a previous timestep, then writes it out
+    virtual void finishReduction( SmileiMPI *smpi ) {};
+    
     //! Tells whether this diagnostic requires the pre-calculation of the particle J & Rho
     virtual bool needsRhoJs( int timestep )
     {
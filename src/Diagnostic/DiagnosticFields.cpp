@@ -1,5 +1,6 @@
 
 #include <string>
+#include <cmath>
 
 #include "DiagnosticFields.h"
 #include "VectorPatch.h"
@@ -19,6 +20,7 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
     memspace_reread = NULL;
     filespace = NULL;
     memspace = NULL;
+    aggregation_comm_ = MPI_COMM_NULL;
     
     // Extract the time_average parameter
     time_average = 1;
@@ -131,11 +133,48 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
         }
     }
     
+    // Extract the compression and aggregation of the output
+    deflate_ = 0;
+    PyTools::extract( "deflate", deflate_, "DiagFields", ndiag );
+    if( deflate_ < 0 || deflate_ > 9 ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `deflate` must be between 0 and 9" );
+    }
+    double absolute_error = 0.;
+    PyTools::extract( "absolute_error", absolute_error, "DiagFields", ndiag );
+    if( absolute_error < 0. ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `absolute_error` must be positive" );
+    }
+    // The quantization truncates the values to a multiple of 10^-decimal_digits
+    lossy_ = absolute_error > 0.;
+    decimal_digits_ = lossy_ ? ( int )ceil( -log10( absolute_error ) ) : 0;
+    if( deflate_ > 0 && ! H5Zfilter_avail( H5Z_FILTER_DEFLATE ) ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `deflate` requires an HDF5 library with the deflate filter" );
+    }
+    if( lossy_ && ! H5Zfilter_avail( H5Z_FILTER_SCALEOFFSET ) ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `absolute_error` requires an HDF5 library with the scale-offset filter" );
+    }
+    aggregators_ = 0;
+    PyTools::extract( "aggregators", aggregators_, "DiagFields", ndiag );
+    if( aggregators_ < 0 ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `aggregators` must be positive" );
+    }
+    
     // Some output
     ostringstream p( "" );
     p << "(time average = " << time_average << ")";
     MESSAGE( 1, "Diagnostic Fields #"<<ndiag<<" "<<( time_average>1?p.str():"" )<<" :" );
     MESSAGE( 2, ss.str() );
+    if( deflate_ > 0 || lossy_ ) {
+        ostringstream c( "" );
+        c << "Compression: deflate level " << deflate_;
+        if( lossy_ ) {
+            c << ", values truncated to multiples of 1e" << -decimal_digits_;
+        }
+        MESSAGE( 2, c.str() );
+    }
+    if( aggregators_ > 0 && aggregators_ < smpi->getSize() ) {
+        MESSAGE( 2, "Written by " << aggregators_ << " aggregator processes" );
+    }
     
     // Create new fields in each patch, for time-average storage
     if( ! smpi->test_mode ) {
@@ -204,6 +243,9 @@ DiagnosticFields::~DiagnosticFields()
     if( memspace ) {
         delete memspace;
     }
+    if( aggregation_comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &aggregation_comm_ );
+    }
     delete timeSelection;
     delete flush_timeSelection;
 }
@@ -378,6 +420,148 @@ bool DiagnosticFields::needsRhoJs( int itime )
     return hasRhoJs && (itime - timeSelection->previousTime( itime ) < time_average);
 }
 
+void DiagnosticFields::setFinalSpace( SmileiMPI *smpi, vector<hsize_t> final_array_size, vector<hsize_t> offset, vector<hsize_t> block, vector<unsigned int> number_of_patches )
+{
+    unsigned int ndim = final_array_size.size();
+    
+    // Define the chunk size
+    const hsize_t max_size = 4294967295/2/sizeof( double );
+    hsize_t final_size = 1;
+    for( unsigned int i=0; i<ndim; i++ ) {
+        final_size *= final_array_size[i];
+    }
+    if( deflate_ > 0 || lossy_ ) {
+        // Compressed dataset: chunks of about one patch, lengthened along the first axis up to 2^16 points
+        chunk_size.resize( ndim );
+        hsize_t chunk_points = 1;
+        for( unsigned int i=0; i<ndim; i++ ) {
+            chunk_size[i] = max( ( hsize_t )1, 1 + ( final_array_size[i]-1 ) / number_of_patches[i] );
+            chunk_points *= chunk_size[i];
+        }
+        while( chunk_points < 65536 && chunk_size[0] < final_array_size[0] ) {
+            chunk_points /= chunk_size[0];
+            chunk_size[0] = min( 2*chunk_size[0], final_array_size[0] );
+            chunk_points *= chunk_size[0];
+        }
+    } else if( final_size > max_size ) {
+        // Necessary above 2^28 points
+        hsize_t n_chunks = 1 + ( final_size-1 ) / max_size;
+        chunk_size = final_array_size;
+        chunk_size[0] = final_array_size[0] / n_chunks;
+        if( n_chunks * chunk_size[0] < final_array_size[0] ) {
+            chunk_size[0]++;
+        }
+    } else {
+        chunk_size.resize( 0 );
+    }
+    
+    block_points_ = 1;
+    for( unsigned int i=0; i<ndim; i++ ) {
+        block_points_ *= block[i];
+    }
+    
+    if( aggregators_ == 0 || aggregators_ >= smpi->getSize() ) {
+        // Each process writes its own block
+        filespace = new H5Space( final_array_size, offset, block, chunk_size );
+        memspace = new H5Space( block );
+    } else {
+        // Groups of consecutive processes, the first one of each group writes the blocks of the group
+        int group_size = 1 + ( smpi->getSize()-1 ) / aggregators_;
+        MPI_Comm_split( smpi->getGlobalComm(), smpi->getRank() / group_size, smpi->getRank(), &aggregation_comm_ );
+        int igroup, ngroup;
+        MPI_Comm_rank( aggregation_comm_, &igroup );
+        MPI_Comm_size( aggregation_comm_, &ngroup );
+        
+        vector<hsize_t> local_block( offset ), blocks( 2*ndim*ngroup );
+        local_block.insert( local_block.end(), block.begin(), block.end() );
+        MPI_Gather( &local_block[0], 2*ndim, MPI_UNSIGNED_LONG_LONG, &blocks[0], 2*ndim, MPI_UNSIGNED_LONG_LONG, 0, aggregation_comm_ );
+        
+        data_aggregated_.resize( 1 );
+        if( igroup == 0 ) {
+            aggregated_points_.resize( ngroup );
+            aggregated_displacement_.resize( ngroup );
+            aggregated_offset_.resize( ngroup );
+            aggregated_block_.resize( ngroup );
+            // Bounding box of the blocks
+            vector<hsize_t> box_min( ndim, final_size ), box_max( ndim, 0 );
+            int displacement = 0;
+            for( int iproc=0; iproc<ngroup; iproc++ ) {
+                aggregated_offset_[iproc].assign( blocks.begin() + 2*ndim*iproc, blocks.begin() + 2*ndim*iproc + ndim );
+                aggregated_block_ [iproc].assign( blocks.begin() + 2*ndim*iproc + ndim, blocks.begin() + 2*ndim*( iproc+1 ) );
+                aggregated_points_[iproc] = 1;
+                for( unsigned int i=0; i<ndim; i++ ) {
+                    aggregated_points_[iproc] *= aggregated_block_[iproc][i];
+                }
+                aggregated_displacement_[iproc] = displacement;
+                displacement += aggregated_points_[iproc];
+                if( aggregated_points_[iproc] > 0 ) {
+                    for( unsigned int i=0; i<ndim; i++ ) {
+                        box_min[i] = min( box_min[i], aggregated_offset_[iproc][i] );
+                        box_max[i] = max( box_max[i], aggregated_offset_[iproc][i] + aggregated_block_[iproc][i] );
+                    }
+                }
+            }
+            data_gathered_.resize( displacement );
+            // The blocks are placed in their bounding box, whose selection matches the selection in the file
+            hsize_t box_points = 1;
+            aggregated_size_.resize( ndim );
+            for( unsigned int i=0; i<ndim; i++ ) {
+                aggregated_size_[i] = box_max[i] > box_min[i] ? box_max[i] - box_min[i] : 1;
+                box_points *= aggregated_size_[i];
+            }
+            data_aggregated_.resize( box_points );
+            filespace = new H5Space( final_array_size, {}, {}, chunk_size );
+            filespace->selectBlocks( aggregated_offset_, aggregated_block_ );
+            for( int iproc=0; iproc<ngroup; iproc++ ) {
+                for( unsigned int i=0; i<ndim && aggregated_points_[iproc]>0; i++ ) {
+                    aggregated_offset_[iproc][i] -= box_min[i];
+                }
+            }
+            memspace = new H5Space( aggregated_size_ );
+            memspace->selectBlocks( aggregated_offset_, aggregated_block_ );
+        } else {
+            vector<vector<hsize_t> > none;
+            filespace = new H5Space( final_array_size, {}, {}, chunk_size );
+            filespace->selectBlocks( none, none );
+            memspace = new H5Space( vector<hsize_t>( ndim, 1 ) );
+            memspace->selectBlocks( none, none );
+        }
+    }
+    filespace->compress( deflate_, lossy_, decimal_digits_ );
+}
+
+H5Write DiagnosticFields::writeFinalArray( H5Write *loc, string name, double *block_data )
+{
+    if( aggregation_comm_ == MPI_COMM_NULL ) {
+        return loc->array( name, *block_data, filespace, memspace );
+    }
+    
+    // Gather the blocks in the aggregator, then place them in their bounding box
+    MPI_Gatherv( block_data, block_points_, MPI_DOUBLE, data_gathered_.data(), aggregated_points_.data(), aggregated_displacement_.data(), MPI_DOUBLE, 0, aggregation_comm_ );
+    unsigned int ndim = aggregated_size_.size();
+    for( unsigned int iproc=0; iproc<aggregated_block_.size(); iproc++ ) {
+        if( aggregated_points_[iproc] == 0 ) {
+            continue;
+        }
+        vector<hsize_t> &offset = aggregated_offset_[iproc], &block = aggregated_block_[iproc];
+        hsize_t row_size = block[ndim-1];
+        hsize_t nrows = aggregated_points_[iproc] / row_size;
+        for( hsize_t irow=0; irow<nrows; irow++ ) {
+            // Position of the row in the bounding box
+            hsize_t position = 0, stride = aggregated_size_[ndim-1], index = irow;
+            for( int i=ndim-2; i>=0; i-- ) {
+                position += ( offset[i] + index % block[i] ) * stride;
+                index /= block[i];
+                stride *= aggregated_size_[i];
+            }
+            position += offset[ndim-1];
+            double *row = &data_gathered_[aggregated_displacement_[iproc] + irow*row_size];
+            copy( row, row + row_size, &data_aggregated_[position] );
+        }
+    }
+    return loc->array( name, data_aggregated_[0], filespace, memspace );
+}
+
 // SUPPOSED TO BE EXECUTED ONLY BY MASTER MPI
 uint64_t DiagnosticFields::getDiskFootPrint( int istart, int istop, Patch *patch )
 {
@@ -85,6 +85,13 @@ protected :
     //! Copy patch field to current "data" buffer
     virtual void getField( Patch *patch, unsigned int ) = 0;
     
+    //! Define the spaces of the final dataset, where this process writes the block (offset, block) of the re-written data,
+    //! with the chunks and compression of the dataset and the aggregation of the blocks
+    void setFinalSpace( SmileiMPI *smpi, std::vector<hsize_t> final_array_size, std::vector<hsize_t> offset, std::vector<hsize_t> block, std::vector<unsigned int> number_of_patches );
+    
+    //! Write the block of the re-written data in the final dataset, through the aggregators if any
+    H5Write writeFinalArray( H5Write *loc, std::string name, double *block_data );
+    
     //! Temporary dataset that is used for folding the 2D hilbert curve
     H5Write * tmp_dset_;
     
@@ -103,6 +110,24 @@ protected :
     
     //! Save the field type (needed for OpenPMD units dimensionality)
     std::vector<unsigned int> field_type;
+    
+    //! Compression of the final datasets: deflate level, and decimal digits kept by the lossy quantization
+    int deflate_;
+    bool lossy_;
+    int decimal_digits_;
+    
+    //! Number of processes writing the final datasets (0: all)
+    int aggregators_;
+    //! Processes whose blocks are written by the same aggregator (rank 0), or MPI_COMM_NULL without aggregation
+    MPI_Comm aggregation_comm_;
+    //! Number of points of the block of this process
+    int block_points_;
+    //! Aggregator only: number of points, displacement, offset in the bounding box and size of the block of each process
+    std::vector<int> aggregated_points_, aggregated_displacement_;
+    std::vector<std::vector<hsize_t> > aggregated_offset_, aggregated_block_;
+    //! Aggregator only: size of the bounding box of the blocks
+    std::vector<hsize_t> aggregated_size_;
+    std::vector<double> data_gathered_, data_aggregated_;
 };
 
 #endif
@@ -137,23 +137,8 @@ DiagnosticFields2D::DiagnosticFields2D( Params &params, SmileiMPI *smpi, VectorP
         offset2[i] = rewrite_start_in_file[i];
         block2 [i] = rewrite_size[i];
     }
-    // Chunks for the second write
-    hsize_t final_size = final_array_size[0]
-                         *final_array_size[1];
-    if( final_size > max_size ) {
-        hsize_t n_chunks = 1 + ( final_size-1 ) / max_size;
-        chunk_size.resize( 2 );
-        chunk_size[0] = final_array_size[0] / n_chunks;
-        chunk_size[1] = final_array_size[1];
-        if( n_chunks * chunk_size[0] < final_array_size[0] ) {
-            chunk_size[0]++;
-        }
-    } else {
-        chunk_size.resize( 0 );
-    }
-    filespace = new H5Space( final_array_size, offset2, block2, chunk_size );
-    // Define space in memory for re-writing
-    memspace = new H5Space( block2 );
+    // Define the spaces for re-writing
+    setFinalSpace( smpi, final_array_size, offset2, block2, params.number_of_patches );
     data_rewrite.resize( rewrite_size[0]*rewrite_size[1] );
     
     tmp_dset_ = NULL;
@@ -272,6 +257,6 @@ H5Write DiagnosticFields2D::writeField( H5Write * loc, std::string name, int iti
     }
     
     // Rewrite the file with the previously defined partition
-    return loc->array( name, data_rewrite[0], filespace, memspace );
+    return writeFinalArray( loc, name, &data_rewrite[0] );
 }
 
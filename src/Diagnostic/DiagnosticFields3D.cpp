@@ -151,25 +151,8 @@ DiagnosticFields3D::DiagnosticFields3D( Params &params, SmileiMPI *smpi, VectorP
         offset2[i] = rewrite_start_in_file[i];
         block2 [i] = rewrite_size[i];
     }
-    // Chunks for the second write
-    hsize_t final_size = final_array_size[0]
-                         *final_array_size[1]
-                         *final_array_size[2];
-    if( final_size > max_size ) {
-        hsize_t n_chunks = 1 + ( final_size-1 ) / max_size;
-        chunk_size.resize( 3 );
-        chunk_size[0] = final_array_size[0] / n_chunks;
-        chunk_size[1] = final_array_size[1];
-        chunk_size[2] = final_array_size[2];
-        if( n_chunks * chunk_size[0] < final_array_size[0] ) {
-            chunk_size[0]++;
-        }
-    } else {
-        chunk_size.resize( 0 );
-    }
-    filespace = new H5Space( final_array_size, offset2, block2, chunk_size );
-    // Define space in memory for re-writing
-    memspace = new H5Space( block2 );
+    // Define the spaces for re-writing
+    setFinalSpace( smpi, final_array_size, offset2, block2, params.number_of_patches );
     data_rewrite.resize( rewrite_size[0]*rewrite_size[1]*rewrite_size[2] );
     
     tmp_dset_ = NULL;
@@ -293,6 +276,6 @@ H5Write DiagnosticFields3D::writeField( H5Write * loc, string name, int itime )
     }
     
     // Rewrite the file with the previously defined partition
-    return loc->array( name, data_rewrite[0], filespace, memspace );
+    return writeFinalArray( loc, name, &data_rewrite[0] );
 }
 
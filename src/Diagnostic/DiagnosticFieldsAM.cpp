@@ -165,23 +165,8 @@ DiagnosticFieldsAM::DiagnosticFieldsAM( Params &params, SmileiMPI *smpi, VectorP
     total_dataset_size = final_array_size[0] * final_array_size[1];
     offset2[1] *= factor_;
     block2 [1] *= factor_;
-    // Chunks for the second write
-    hsize_t final_size = final_array_size[0]
-                         *final_array_size[1];
-    if( final_size > max_size ) {
-        hsize_t n_chunks = 1 + ( final_size-1 ) / max_size;
-        chunk_size.resize( 2 );
-        chunk_size[0] = final_array_size[0] / n_chunks;
-        chunk_size[1] = final_array_size[1];
-        if( n_chunks * chunk_size[0] < final_array_size[0] ) {
-            chunk_size[0]++;
-        }
-    } else {
-        chunk_size.resize( 0 );
-    }
-    filespace = new H5Space( final_array_size, offset2, block2, chunk_size );
-    // Define space in memory for re-writing
-    memspace = new H5Space( block2 );
+    // Define the spaces for re-writing
+    setFinalSpace( smpi, final_array_size, offset2, block2, params.number_of_patches );
     if( factor_ == 2 ) {
         idata_rewrite.resize( rewrite_size[0]*rewrite_size[1] );
     } else {
@@ -330,6 +315,6 @@ H5Write DiagnosticFieldsAM::writeField( H5Write *loc, string name, int itime, F&
     }
     
     // Rewrite the file with the previously defined partition
-    return loc->array( name, final_data[0], H5T_NATIVE_DOUBLE, filespace, memspace );
+    return writeFinalArray( loc, name, reinterpret_cast<double *>( &final_data[0] ) );
 }
 
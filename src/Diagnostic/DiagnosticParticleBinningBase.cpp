@@ -3,6 +3,7 @@
 
 #include "DiagnosticParticleBinningBase.h"
 #include "HistogramFactory.h"
+#include "VectorPatch.h"
 
 
 using namespace std;
@@ -22,6 +23,9 @@ DiagnosticParticleBinningBase::DiagnosticParticleBinningBase(
 {
     int idiag = diagId;
     time_accumulate = time_accumulate_;
+    overlap_reduction_ = params.overlap_diag_reductions;
+    reduction_request_ = MPI_REQUEST_NULL;
+    reduction_timestep_ = 0;
     
     string pyDiag = Tools::merge( "Diag", diagName );
     string errorPrefix = Tools::merge( pyDiag, " #", to_string( idiag ) );
@@ -64,6 +68,10 @@ DiagnosticParticleBinningBase::DiagnosticParticleBinningBase(
     // verify that the species exist, remove duplicates and sort by number
     species = params.FindSpecies( patch->vecSpecies, species_names );
     
+    // get parameter "concatenate_patches" that groups the calls to python functions of all patches
+    concatenate_patches_ = false;
+    PyTools::extract( "concatenate_patches", concatenate_patches_, pyDiag, idiag );
+    
 //    // Temporarily set the spatial min and max to the simulation box size
 //    spatial_min.resize( params.nDim_particle, 0. );
 //    spatial_max = params.grid_length;
@@ -105,6 +113,14 @@ DiagnosticParticleBinningBase::DiagnosticParticleBinningBase(
     }
     output_size = ( unsigned int ) total_size;
     
+    // Private histograms of each thread
+#ifdef _OPENMP
+    unsigned int nthreads = omp_get_max_threads();
+#else
+    unsigned int nthreads = 1;
+#endif
+    thread_data_.resize( nthreads );
+    
     // Output info on diagnostics
     if( smpi->isMaster() ) {
         ostringstream mystream( "" );
@@ -212,12 +228,30 @@ bool DiagnosticParticleBinningBase::prepare( int timestep )
 } // END prepare
 
 
+// Call the python functions of the histogram for all patches at once
+void DiagnosticParticleBinningBase::prepareAllPatches( VectorPatch &vecPatches, int timestep )
+{
+#ifdef SMILEI_USE_NUMPY
+    if( ! concatenate_patches_ ) {
+        return;
+    }
+    vector<Particles *> containers;
+    for( unsigned int ispec=0 ; ispec < species.size() ; ispec++ ) {
+        for( unsigned int ipatch=0 ; ipatch < vecPatches.size() ; ipatch++ ) {
+            containers.push_back( vecPatches( ipatch )->vecSpecies[species[ispec]]->particles );
+        }
+    }
+    histogram->evaluate( containers );
+#endif
+}
+
+
 // run one particle binning diagnostic
-void DiagnosticParticleBinningBase::run( Patch *patch, int timestep, SimWindow *simWindow )
+void DiagnosticParticleBinningBase::run( SmileiMPI *smpi, Patch *patch, int timestep, SimWindow *simWindow )
 {
 
-    vector<int> int_buffer;
-    vector<double> double_buffer;
+    ScratchArena &scratch = smpi->scratch();
+    vector<double> &data = threadData();
     unsigned int npart;
     
 //    // Update spatial_min and spatial_max if needed
@@ -241,19 +275,58 @@ void DiagnosticParticleBinningBase::run( Patch *patch, int timestep, SimWindow *
     
         Species *s = patch->vecSpecies[species[ispec]];
         npart = s->particles->size();
-        int_buffer   .resize( npart );
-        double_buffer.resize( npart );
+        ScratchArena::Scope scope( scratch );
+        int *int_buffer = scratch.allocate<int>( npart );
+        double *double_buffer = scratch.allocate<double>( npart );
         
-        fill( int_buffer.begin(), int_buffer.end(), 0 );
+        fill( int_buffer, int_buffer+npart, 0 );
         
-        histogram->digitize( s, double_buffer, int_buffer, simWindow );
-        histogram->valuate( s, double_buffer, int_buffer );
-        histogram->distribute( double_buffer, int_buffer, data_sum );
+        histogram->digitize( s, double_buffer, int_buffer, npart, simWindow );
+        histogram->valuate( s, double_buffer, int_buffer, npart );
+        histogram->distribute( double_buffer, int_buffer, npart, data );
         
     }
     
 } // END run
 
+vector<double> &DiagnosticParticleBinningBase::threadData()
+{
+    vector<double> &data = thread_data_[threadIndex()];
+    if( data.size() != output_size ) {
+        data.assign( output_size, 0. );
+    }
+    return data;
+}
+
+// Sum the private histograms of all threads into data_sum.
+// Each thread sums a contiguous slice of the bins over all the private histograms,
+// and resets this slice to zero for the next run.
+void DiagnosticParticleBinningBase::reduceThreads()
+{
+    int ithread = threadIndex(), nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_num_threads();
+#endif
+    unsigned int slice = ( output_size + nthreads - 1 ) / nthreads;
+    unsigned int imin = min( ithread * slice, output_size );
+    unsigned int imax = min( imin + slice, output_size );
+    
+    double *sum = data_sum.data();
+    for( unsigned int jthread=0 ; jthread<thread_data_.size() ; jthread++ ) {
+        if( thread_data_[jthread].size() != output_size ) {
+            continue;
+        }
+        double *data = thread_data_[jthread].data();
+        #pragma omp simd
+        for( unsigned int i=imin ; i<imax ; i++ ) {
+            sum[i] += data[i];
+            data[i] = 0.;
+        }
+    }
+    #pragma omp barrier
+    
+} // END reduceThreads
+
 bool DiagnosticParticleBinningBase::writeNow( int timestep ) {
     return timestep - timeSelection->previousTime() == time_average-1;
 }
@@ -262,15 +335,28 @@ bool DiagnosticParticleBinningBase::writeNow( int timestep ) {
 // if needed now, store result to hdf file
 void DiagnosticParticleBinningBase::write( int timestep, SmileiMPI *smpi )
 {
-    if( !smpi->isMaster() || !writeNow( timestep ) ) {
+    // With a non-blocking reduction, the data is written by finishReduction
+    if( !smpi->isMaster() || !writeNow( timestep ) || nonBlockingReduction() ) {
         return;
     }
     
+    writeData( timestep, data_sum );
+    
+    if( ! time_accumulate ) {
+        // Clear the array
+        clear();
+        data_sum.resize( 0 );
+    }
+} // END write
+
+
+void DiagnosticParticleBinningBase::writeData( int timestep, vector<double> &data )
+{
     // if time_average, then we need to divide by the number of timesteps
     if( !time_accumulate && time_average > 1 ) {
         double coeff = 1./( ( double )time_average );
         for( unsigned int i=0; i<output_size; i++ ) {
-            data_sum[i] *= coeff;
+            data[i] *= coeff;
         }
     }
     
@@ -282,19 +368,38 @@ void DiagnosticParticleBinningBase::write( int timestep, SmileiMPI *smpi )
     // write the array if it does not exist already
     if( ! file_->has( mystream.str() ) ) {
         H5Space d( dims );
-        file_->array( mystream.str(), data_sum[0], &d, &d );
+        file_->array( mystream.str(), data[0], &d, &d );
     }
     
     if( flush_timeSelection->theTimeIsNow( timestep ) ) {
         file_->flush();
     }
+} // END writeData
+
+
+// The output array is swapped with the second buffer, which is reduced in place while the simulation goes on.
+// data_sum gets the previous buffer, zeroed by prepare() at the beginning of the next output period.
+void DiagnosticParticleBinningBase::startReduction( SmileiMPI *smpi, int timestep )
+{
+    finishReduction( smpi );
     
-    if( ! time_accumulate ) {
-        // Clear the array
-        clear();
-        data_sum.resize( 0 );
+    data_reduced_.swap( data_sum );
+    reduction_timestep_ = timestep;
+    MPI_Ireduce( smpi->isMaster()?MPI_IN_PLACE:&data_reduced_[0], &data_reduced_[0], output_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD, &reduction_request_ );
+} // END startReduction
+
+
+void DiagnosticParticleBinningBase::finishReduction( SmileiMPI *smpi )
+{
+    if( reduction_request_ == MPI_REQUEST_NULL ) {
+        return;
     }
-} // END write
+    
+    MPI_Wait( &reduction_request_, MPI_STATUS_IGNORE );
+    if( smpi->isMaster() ) {
+        writeData( reduction_timestep_, data_reduced_ );
+    }
+} // END finishReduction
 
 
 //! Clear the array
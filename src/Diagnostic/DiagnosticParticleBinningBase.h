@@ -31,19 +31,34 @@ public :
     
     bool prepare( int timestep ) override;
     
-    virtual void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
+    void prepareAllPatches( VectorPatch &vecPatches, int timestep ) override;
+    
+    virtual void run( SmileiMPI *smpi, Patch *patch, int timestep, SimWindow *simWindow ) override;
+    
+    void reduceThreads() override;
     
     virtual bool writeNow( int timestep );
     
     void write( int timestep, SmileiMPI *smpi ) override;
     
+    //! True if the MPI reduction of the output array overlaps the next timestep
+    bool nonBlockingReduction()
+    {
+        return overlap_reduction_ && ! time_accumulate;
+    }
+    
+    //! Start the MPI reduction of the output array to the master, from a second buffer, without waiting for it
+    void startReduction( SmileiMPI *smpi, int timestep );
+    
+    void finishReduction( SmileiMPI *smpi ) override;
+    
     //! Clear the array
     virtual void clear();
     
     //! Get memory footprint of current diagnostic
     int getMemFootPrint() override
     {
-        int size = output_size*sizeof( double );
+        int size = output_size*sizeof( double ) * ( 1 + thread_data_.size() );
         // + data_array + index_array +  axis_array
         // + nparts_max * (sizeof(double)+sizeof(int)+sizeof(double))
         return size;
@@ -63,9 +78,28 @@ protected:
     //! list of the species that will be accounted for
     std::vector<unsigned int> species;
     
+    //! True if the python functions are called once for all the patches of this MPI
+    bool concatenate_patches_;
+    
     //! vector for saving the output array for time-averaging
     std::vector<double> data_sum;
     
+    //! Histogram private to the calling thread, summed into data_sum by reduceThreads()
+    std::vector<double> &threadData();
+    
+    //! Histograms private to each thread (allocated on first use, zero after each reduction)
+    std::vector<std::vector<double> > thread_data_;
+    
+    //! Index of the calling thread
+    static int threadIndex()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+    
     //! Histogram object
     Histogram *histogram;
     
@@ -74,6 +108,15 @@ protected:
     int total_axes;
     std::vector<hsize_t> dims;
     
+    //! Write an output array of the given timestep (master only)
+    void writeData( int timestep, std::vector<double> &data );
+    
+    //! Non-blocking reduction: option, array being reduced, its request and its timestep
+    bool overlap_reduction_;
+    std::vector<double> data_reduced_;
+    MPI_Request reduction_request_;
+    int reduction_timestep_;
+    
 //    //! Minimum and maximum spatial coordinates that are useful for this diag
 //    std::vector<double> spatial_min, spatial_max;
 };
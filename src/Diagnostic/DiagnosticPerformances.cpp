@@ -2,12 +2,15 @@
 #include <iomanip>
 
 #include "DiagnosticPerformances.h"
+#include "HardwareCounters.h"
 
 
 using namespace std;
 
-const unsigned int n_quantities_double = 15;
+const unsigned int n_quantities_double = 17;
 const unsigned int n_quantities_uint   = 4;
+const unsigned int n_timers_hardware   = 13;
+const unsigned int n_quantities_hardware = n_timers_hardware * HardwareCounters::n_events;
 
 // Constructor
 DiagnosticPerformances::DiagnosticPerformances( Params &params, SmileiMPI *smpi )
@@ -16,7 +19,9 @@ DiagnosticPerformances::DiagnosticPerformances( Params &params, SmileiMPI *smpi
   filespace_double( {n_quantities_double, mpi_size_}, {0, mpi_rank_}, {n_quantities_double, 1} ),
   filespace_uint  ( {n_quantities_uint  , mpi_size_}, {0, mpi_rank_}, {n_quantities_uint  , 1} ),
   memspace_double( { n_quantities_double, 1 }, {}, {} ),
-  memspace_uint  ( { n_quantities_uint  , 1 }, {}, {} )
+  memspace_uint  ( { n_quantities_uint  , 1 }, {}, {} ),
+  filespace_hardware( {n_quantities_hardware, mpi_size_}, {0, mpi_rank_}, {n_quantities_hardware, 1} ),
+  memspace_hardware ( { n_quantities_hardware, 1 }, {}, {} )
 {
     timestep = params.timestep;
     cell_load = params.cell_load;
@@ -42,6 +47,22 @@ DiagnosticPerformances::DiagnosticPerformances( Params &params, SmileiMPI *smpi
     // Get patch information flag
     PyTools::extract( "patch_information", patch_information, "DiagPerformances"  );
     
+    // Get hardware counters flag
+    PyTools::extract( "hardware_counters", hardware_counters, "DiagPerformances"  );
+    if( hardware_counters ) {
+        uint64_t vector_event = HardwareCounters::defaultVectorEvent();
+        unsigned int event;
+        if( PyTools::extractOrNone( "vector_instructions_event", event, "DiagPerformances" ) ) {
+            vector_event = event;
+        }
+        // Unavailable counters are written as zeros, so that all processes write the same datasets
+        int available = HardwareCounters::enable( vector_event ), all_available;
+        MPI_Allreduce( &available, &all_available, 1, MPI_INT, MPI_MIN, smpi->getGlobalComm() );
+        if( ! all_available ) {
+            WARNING( errorPrefix << ": hardware counters are not available on all processes (see /proc/sys/kernel/perf_event_paranoid)" );
+        }
+    }
+    
     // Output info on diagnostics
     if( smpi->isMaster() ) {
         MESSAGE( 1, "Created performances diagnostic" );
@@ -103,8 +124,23 @@ void DiagnosticPerformances::openFile( Params &params, SmileiMPI *smpi )
     quantities_double[12] = "timer_grids"     ;
     quantities_double[13] = "timer_total"     ;
     quantities_double[14] = "memory_total"    ;
+    quantities_double[15] = "memory_remote"   ;
+    quantities_double[16] = "timer_numaCopy"  ;
     file_->attr( "quantities_double", quantities_double );
     
+    if( hardware_counters ) {
+        vector<string> timer_names = { "global", "particles", "maxwell", "densities", "collisions", "movWindow",
+                                       "loadBal", "syncPart", "syncField", "syncDens", "diags", "grids", "numaCopy"
+                                     };
+        vector<string> quantities_hardware;
+        for( unsigned int itimer=0; itimer<n_timers_hardware; itimer++ ) {
+            for( unsigned int ievent=0; ievent<HardwareCounters::n_events; ievent++ ) {
+                quantities_hardware.push_back( "hw_" + timer_names[itimer] + "_" + HardwareCounters::name( ievent ) );
+            }
+        }
+        file_->attr( "quantities_hardware", quantities_hardware );
+    }
+    
     file_->flush();
 }
 
@@ -206,19 +242,43 @@ void DiagnosticPerformances::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
         double timer_diags = MPI_Wtime() - timers.diags.last_start_ + timers.diags.time_acc_;
         quantities_double[11] = timer_diags;
         quantities_double[12] = timers.grids     .getTime();
+        quantities_double[16] = timers.numaCopy  .getTime();
         // All timers are summed in timer_total
         double timer_total =
             quantities_double[ 2] + quantities_double[3] + quantities_double[ 4]
             + quantities_double[ 5] + quantities_double[6] + quantities_double[ 7]
             + quantities_double[ 8] + quantities_double[9] + quantities_double[10]
-            + quantities_double[11] + quantities_double[12];
+            + quantities_double[11] + quantities_double[12] + quantities_double[16];
         quantities_double[13] = timer_total;
         
         quantities_double[14] = Tools::getMemFootPrint();
         
+        // Memory of the patches located on another NUMA node than the thread which computed them
+        double remote_memory = 0.;
+        for( unsigned int ipatch=0; ipatch < number_of_patches; ipatch++ ) {
+            if( vecPatches( ipatch )->memory_node_ != vecPatches( ipatch )->thread_node_ ) {
+                remote_memory += vecPatches( ipatch )->getMemFootPrint();
+            }
+        }
+        quantities_double[15] = remote_memory / 1024./1024./1024.;
+        
         // Write doubles to file
         iteration_group.array( "quantities_double", quantities_double[0], &filespace_double, &memspace_double );
         
+        // Hardware counters of each timer, summed over the threads
+        if( hardware_counters ) {
+            vector<Timer *> hardware_timers = { &timers.global, &timers.particles, &timers.maxwell, &timers.densities,
+                                                &timers.collisions, &timers.movWindow, &timers.loadBal, &timers.syncPart,
+                                                &timers.syncField, &timers.syncDens, &timers.diags, &timers.grids,
+                                                &timers.numaCopy
+                                              };
+            vector<double> quantities_hardware;
+            for( unsigned int itimer=0; itimer<n_timers_hardware; itimer++ ) {
+                quantities_hardware.insert( quantities_hardware.end(), hardware_timers[itimer]->counters_acc_.begin(), hardware_timers[itimer]->counters_acc_.end() );
+            }
+            iteration_group.array( "quantities_hardware", quantities_hardware[0], &filespace_hardware, &memspace_hardware );
+        }
+        
         // Patch information
         if( patch_information ) {
         
@@ -316,6 +376,9 @@ uint64_t DiagnosticPerformances::getDiskFootPrint( int istart, int istop, Patch
     
     // Add size of each dump
     footprint += ndumps * ( uint64_t )( mpi_size_ ) * ( uint64_t )( n_quantities_double * sizeof( double ) + n_quantities_uint * sizeof( unsigned int ) );
+    if( hardware_counters ) {
+        footprint += ndumps * ( 600 + ( uint64_t )( mpi_size_ ) * n_quantities_hardware * sizeof( double ) );
+    }
     
     return footprint;
 }
@@ -52,6 +52,7 @@ private :
     //! HDF5 shapes of datasets
     H5Space filespace_double, filespace_uint;
     H5Space memspace_double, memspace_uint;
+    H5Space filespace_hardware, memspace_hardware;
     
     //! Total number of patches
     unsigned int tot_number_of_patches;
@@ -65,6 +66,9 @@ private :
     //! Whether to output patch information
     bool patch_information;
     
+    //! Whether to output the hardware counters of each timer
+    bool hardware_counters;
+    
     //! Number of cells per patch
     unsigned int ncells_per_patch;
     
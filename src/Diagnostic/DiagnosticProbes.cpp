@@ -712,8 +712,9 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
             if( geometry == "AMcylindrical" ) {
                 if( species_field_index[ispec].size() > 0 ) {
                     int istart( 0 ), iend( npart );
-                    vector<double> dummy( npart );
-                    vector<double *> loc( 4, &dummy[0] );
+                    ScratchArena::Scope scope( smpi->dynamics_scratch[ithread] );
+                    double *dummy = smpi->dynamics_scratch[ithread].allocate<double>( npart );
+                    vector<double *> loc( 4, dummy );
                     for( unsigned int j=0; j<species_field_index[ispec].size(); j++ ) {
                         unsigned int ifield = species_field_index[ispec][j];
                         unsigned int iloc = species_field_location[ispec][j];
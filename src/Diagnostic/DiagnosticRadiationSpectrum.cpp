@@ -113,11 +113,11 @@ void DiagnosticRadiationSpectrum::openFile( Params& params, SmileiMPI* smpi )
 }
 
 // run one particle binning diagnostic
-void DiagnosticRadiationSpectrum::run( Patch* patch, int timestep, SimWindow* simWindow )
+void DiagnosticRadiationSpectrum::run( SmileiMPI *smpi, Patch* patch, int timestep, SimWindow* simWindow )
 {
 
-    vector<int> int_buffer;
-    vector<double> double_buffer;
+    ScratchArena &scratch = smpi->scratch();
+    vector<double> &data = threadData();
     
 //    // Update spatial_min and spatial_max if needed
 //    if( simWindow ) {
@@ -140,15 +140,16 @@ void DiagnosticRadiationSpectrum::run( Patch* patch, int timestep, SimWindow* si
         
         Species *s = patch->vecSpecies[species[ispec]];
         unsigned int npart = s->particles->size();
-        int_buffer   .resize( npart );
-        double_buffer.resize( npart );
+        ScratchArena::Scope scope( scratch );
+        int *int_buffer = scratch.allocate<int>( npart );
+        double *double_buffer = scratch.allocate<double>( npart );
         
-        fill(int_buffer.begin(), int_buffer.end(), 0);
+        fill( int_buffer, int_buffer+npart, 0 );
         
-        histogram->digitize( s, double_buffer, int_buffer, simWindow );
+        histogram->digitize( s, double_buffer, int_buffer, npart, simWindow );
         
-        // Sum the data into the data_sum
-        // ------------------------------
+        // Sum the data into the private histogram of this thread
+        // -------------------------------------------------------
         int ind;
         
         double gamma_inv, gamma, chi, xi, zeta, nu, cst;
@@ -189,8 +190,7 @@ void DiagnosticRadiationSpectrum::run( Patch* patch, int timestep, SimWindow* si
                 nu   = two_third_ov_chi * zeta;
                 cst  = xi * zeta;
                 increment = increment0 * delta_energies[i] * xi * RadiationTools::computeBesselPartsRadiatedPower(nu,cst);
-                #pragma omp atomic
-                data_sum[ind+i] += increment;
+                data[ind+i] += increment;
             }
             
         }
@@ -325,7 +325,7 @@ bool DiagnosticScalar::prepare( int timestep )
 } // END prepare
 
 
-void DiagnosticScalar::run( Patch *patch, int timestep, SimWindow *simWindow )
+void DiagnosticScalar::run( SmileiMPI *smpi, Patch *patch, int timestep, SimWindow *simWindow )
 {
 
     // Must keep track of Poynting flux even without diag
@@ -119,7 +119,7 @@ public :
     
     bool prepare( int timestep ) override;
     
-    void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
+    void run( SmileiMPI *smpi, Patch *patch, int timestep, SimWindow *simWindow ) override;
     
     void write( int timestep, SmileiMPI *smpi ) override;
     
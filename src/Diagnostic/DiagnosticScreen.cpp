@@ -154,12 +154,10 @@ bool DiagnosticScreen::prepare( int timestep )
 
 
 // run one screen diagnostic
-void DiagnosticScreen::run( Patch *patch, int timestep, SimWindow *simWindow )
+void DiagnosticScreen::run( SmileiMPI *smpi, Patch *patch, int timestep, SimWindow *simWindow )
 {
 
-    vector<int> int_buffer;
-    vector<double> double_buffer;
-    vector<bool> opposite;
+    ScratchArena &scratch = smpi->scratch();
     unsigned int npart, ndim = screen_point.size(), ipart, idim, nuseful;
     double side, side_old, dtg;
     
@@ -189,9 +187,10 @@ void DiagnosticScreen::run( Patch *patch, int timestep, SimWindow *simWindow )
         Species *s = patch->vecSpecies[species[ispec]];
         npart = s->particles->size();
         nuseful = 0;
-        int_buffer   .resize( npart );
-        double_buffer.resize( npart );
-        opposite     .resize( npart, false );
+        ScratchArena::Scope scope( scratch );
+        int *int_buffer = scratch.allocate<int>( npart );
+        double *double_buffer = scratch.allocate<double>( npart );
+        bool *opposite = scratch.allocate<bool>( npart );
         
         // Fill the int_buffer with -1 (not crossing screen) and 0 (crossing screen)
         if( screen_type == 0 ) { // plane
@@ -203,12 +202,10 @@ void DiagnosticScreen::run( Patch *patch, int timestep, SimWindow *simWindow )
                     side += ( s->particles->Position[idim][ipart] - screen_point[idim] ) * screen_unitvector[idim];
                     side_old += ( s->particles->Position[idim][ipart] - dtg*( s->particles->Momentum[idim][ipart] ) - screen_point[idim] ) * screen_unitvector[idim];
                 }
+                opposite[ipart] = side < 0.;
                 if( side*side_old < 0. ) {
                     int_buffer[ipart] = 0;
                     nuseful++;
-                    if( side < 0. ) {
-                        opposite[ipart] = true;
-                    }
                 } else {
                     int_buffer[ipart] = -1;
                 }
@@ -224,12 +221,10 @@ void DiagnosticScreen::run( Patch *patch, int timestep, SimWindow *simWindow )
                 }
                 side     = screen_vectornorm-sqrt( side );
                 side_old = screen_vectornorm-sqrt( side_old );
+                opposite[ipart] = side > 0.;
                 if( side*side_old < 0. ) {
                     int_buffer[ipart] = 0;
                     nuseful++;
-                    if( side > 0. ) {
-                        opposite[ipart] = true;
-                    }
                 } else {
                     int_buffer[ipart] = -1;
                 }
@@ -240,8 +235,8 @@ void DiagnosticScreen::run( Patch *patch, int timestep, SimWindow *simWindow )
             continue;
         }
         
-        histogram->digitize( s, double_buffer, int_buffer, simWindow );
-        histogram->valuate( s, double_buffer, int_buffer );
+        histogram->digitize( s, double_buffer, int_buffer, npart, simWindow );
+        histogram->valuate( s, double_buffer, int_buffer, npart );
         
         if( direction_type == 1 ) { // canceling
             for( ipart=0; ipart<npart; ipart++ )
@@ -260,7 +255,7 @@ void DiagnosticScreen::run( Patch *patch, int timestep, SimWindow *simWindow )
                 }
         }
         
-        histogram->distribute( double_buffer, int_buffer, data_sum );
+        histogram->distribute( double_buffer, int_buffer, npart, threadData() );
         
     }
     
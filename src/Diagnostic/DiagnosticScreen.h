@@ -17,7 +17,7 @@ public :
     
     bool prepare( int timestep ) override;
     
-    void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
+    void run( SmileiMPI *smpi, Patch *patch, int timestep, SimWindow *simWindow ) override;
     
     bool writeNow( int timestep ) override;
     
@@ -47,6 +47,10 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
     // Get parameter "filter" which gives a python function to select particles
     filter = PyTools::extract_py( "filter", "DiagTrackParticles", iDiagTrackParticles );
     has_filter = ( filter != Py_None );
+    
+    // Get parameter "concatenate_patches" which calls the filter once for all patches
+    concatenate_patches_ = false;
+    PyTools::extract( "concatenate_patches", concatenate_patches_, "DiagTrackParticles", iDiagTrackParticles );
     if( has_filter ) {
 #ifdef SMILEI_USE_NUMPY
         PyTools::setIteration( 0 );
@@ -235,25 +239,50 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
             PyTools::setIteration( itime );
             
             patch_selection.resize( vecPatches.size() );
-            PyArrayObject *ret;
+            PyArrayObject *ret, *ret_all = NULL;
             ParticleData particleData( 0 );
+            
+            // Run the filter function once for the particles of all patches
+            if( concatenate_patches_ ) {
+                vector<Particles *> containers( vecPatches.size() );
+                for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                    containers[ipatch] = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+                }
+                particleData.set( containers );
+                if( particleData.size() > 0 ) {
+                    PyObject *r = PyObject_CallFunctionObjArgs( filter, particleData.get(), NULL );
+                    PyTools::checkPyError();
+                    ret_all = r ? ( PyArrayObject * )PyArray_FROM_OTF( r, NPY_BOOL, NPY_ARRAY_IN_ARRAY ) : NULL;
+                    Py_XDECREF( r );
+                    if( ret_all == NULL || ( unsigned int ) PyArray_SIZE( ret_all ) != particleData.size() ) {
+                        ERROR( "A DiagTrackParticles filter has not provided a correct result" );
+                    }
+                }
+            }
+            
+            unsigned int offset = 0;
             for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
                 patch_selection[ipatch].resize( 0 );
                 Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
                 unsigned int npart = p->size();
                 if( npart > 0 ) {
-                    // Expose particle data as numpy arrays
-                    particleData.resize( npart );
-                    particleData.set( p );
-                    // run the filter function
-                    ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( filter, particleData.get(), NULL );
-                    PyTools::checkPyError();
-                    particleData.clear();
-                    if( ret == NULL ) {
-                        ERROR( "A DiagTrackParticles filter has not provided a correct result" );
+                    bool *arr;
+                    if( ret_all ) {
+                        arr = ( bool * ) PyArray_GETPTR1( ret_all, offset );
+                    } else {
+                        // Expose particle data as numpy arrays
+                        particleData.resize( npart );
+                        particleData.set( p );
+                        // run the filter function
+                        ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( filter, particleData.get(), NULL );
+                        PyTools::checkPyError();
+                        particleData.clear();
+                        if( ret == NULL ) {
+                            ERROR( "A DiagTrackParticles filter has not provided a correct result" );
+                        }
+                        arr = ( bool * ) PyArray_GETPTR1( ret, 0 );
                     }
                     // Loop the return value and store the particle IDs
-                    bool *arr = ( bool * ) PyArray_GETPTR1( ret, 0 );
                     for( unsigned int i=0; i<npart; i++ ) {
                         if( arr[i] ) {
                             patch_selection[ipatch].push_back( i );
@@ -263,11 +292,15 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
                             }
                         }
                     }
-                    Py_DECREF( ret );
+                    if( ! ret_all ) {
+                        Py_DECREF( ret );
+                    }
                 }
+                offset += npart;
                 patch_start[ipatch] = nParticles_local;
                 nParticles_local += patch_selection[ipatch].size();
             }
+            Py_XDECREF( ret_all );
 #endif
             
         } else {
@@ -554,7 +587,7 @@ template<typename T>
 void DiagnosticTrack::fill_buffer( VectorPatch &vecPatches, unsigned int iprop, vector<T> &buffer )
 {
     unsigned int patch_nParticles, i, j, nPatches=vecPatches.size();
-    vector<T> *property = NULL;
+    ParticleProperty<T> *property = NULL;
     
     if( has_filter ) {
         #pragma omp for schedule(runtime)
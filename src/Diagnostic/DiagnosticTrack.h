@@ -76,6 +76,9 @@ private :
     //! Tells whether this diag includes a particle filter
     PyObject *filter;
     
+    //! True if the filter is called once for the particles of all the patches of this MPI
+    bool concatenate_patches_;
+    
     //! Selection of the filtered particles in each patch
     std::vector<std::vector<unsigned int> > patch_selection;
     
@@ -7,75 +7,59 @@
 using namespace std;
 
 // Loop on the different axes requested and compute the output index of each particle
+// The loops are branch-free so that they vectorize: discarded particles (negative index) are
+// processed like the others, but their index is kept negative.
 void Histogram::digitize( Species *s,
-                          std::vector<double> &double_buffer,
-                          std::vector<int>    &int_buffer,
+                          double *values,
+                          int *index,
+                          unsigned int npart,
                           SimWindow *simWindow )
 {
-    unsigned int ipart, npart=s->particles->size();
-    int ind;
+    unsigned int ipart;
     
     for( unsigned int iaxis=0 ; iaxis < axes.size() ; iaxis++ ) {
     
         // first loop on particles to store the indexing (axis) quantity
-        axes[iaxis]->digitize( s, double_buffer, int_buffer, npart, simWindow );
-        // Now, double_buffer has the location of each particle along the axis
+        axes[iaxis]->digitize( s, values, index, npart, simWindow );
+        // Now, values has the location of each particle along the axis
         
         // if log scale, loop again and convert to log
         if( axes[iaxis]->logscale ) {
+            #pragma omp simd
             for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                double_buffer[ipart] = log10( abs( double_buffer[ipart] ) );
+                values[ipart] = log10( abs( values[ipart] ) );
             }
         }
         
         // The indexes are "reshaped" in one dimension.
         // For instance, in 3d, the index has the form  i = i3 + n3*( i2 + n2*i1 )
         // Here we do the multiplication by n3 or n2 (etc.)
-        if( iaxis>0 ) {
-            for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                int_buffer[ipart] *= axes[iaxis]->nbins;
-            }
-        }
+        const int nbins = axes[iaxis]->nbins;
+        const int stride = iaxis>0 ? nbins : 1;
+        const double actual_min = axes[iaxis]->actual_min;
+        const double coeff = axes[iaxis]->coeff;
         
         // loop again on the particles and calculate the index
         // This is separated in two cases: edge_inclusive and edge_exclusive
         if( !axes[iaxis]->edge_inclusive ) { // if the particles out of the "box" must be excluded
         
+            #pragma omp simd
             for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                // skip already discarded particles
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                // calculate index
-                ind = floor( ( double_buffer[ipart]-axes[iaxis]->actual_min ) * axes[iaxis]->coeff );
-                // index valid only if in the "box"
-                if( ind >= 0  &&  ind < axes[iaxis]->nbins ) {
-                    int_buffer[ipart] += ind;
-                } else {
-                    int_buffer[ipart] = -1;    // discard particle
-                }
+                double d = floor( ( values[ipart]-actual_min ) * coeff );
+                // index valid only if in the "box" and not already discarded
+                bool valid = index[ipart] >= 0 && d >= 0. && d < nbins;
+                index[ipart] = valid ? index[ipart]*stride + ( int ) d : -1;
             }
             
         } else { // if the particles out of the "box" must be included
         
+            #pragma omp simd
             for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                // skip already discarded particles
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                // calculate index
-                ind = floor( ( double_buffer[ipart]-axes[iaxis]->actual_min ) * axes[iaxis]->coeff );
+                double d = floor( ( values[ipart]-actual_min ) * coeff );
                 // move out-of-range indexes back into range
-                if( ind < 0 ) {
-                    ind = 0;
-                }
-                if( ind >= axes[iaxis]->nbins ) {
-                    ind = axes[iaxis]->nbins-1;
-                }
-                int_buffer[ipart] += ind;
+                d = d < 0. ? 0. : d;
+                d = d < nbins-1 ? d : nbins-1;
+                index[ipart] = index[ipart] >= 0 ? index[ipart]*stride + ( int ) d : -1;
             }
             
         }
@@ -83,13 +67,15 @@ void Histogram::digitize( Species *s,
     } // loop axes
 }
 
+// Sum the contribution of each particle in output_array, which must be private to the calling thread
 void Histogram::distribute(
-    std::vector<double> &double_buffer,
-    std::vector<int>    &int_buffer,
+    double *double_buffer,
+    int *int_buffer,
+    unsigned int npart,
     std::vector<double> &output_array )
 {
 
-    unsigned int ipart, npart=double_buffer.size();
+    unsigned int ipart;
     int ind;
     
     // Sum the data into the data_sum according to the indexes
@@ -99,7 +85,6 @@ void Histogram::distribute(
         if( ind<0 ) {
             continue;    // skip discarded particles
         }
-        #pragma omp atomic
         output_array[ind] += double_buffer[ipart];
     }
     
@@ -107,6 +92,64 @@ void Histogram::distribute(
 
 
 
+#ifdef SMILEI_USE_NUMPY
+void Histogram::evaluate( vector<Particles *> &containers )
+{
+    ParticleData particleData( 0 );
+    for( unsigned int iaxis=0 ; iaxis < axes.size() ; iaxis++ ) {
+        axes[iaxis]->evaluate( particleData, containers );
+    }
+    evaluateValues( particleData, containers );
+}
+
+void ParticleFunctionValues::evaluate( PyObject *function, ParticleData &particleData, vector<Particles *> &containers )
+{
+    clear();
+    unsigned int offset = 0;
+    for( unsigned int i=0; i<containers.size(); i++ ) {
+        unsigned int npart = containers[i]->size();
+        offsets_[containers[i]] = make_pair( offset, npart );
+        offset += npart;
+    }
+    if( offset == 0 ) {
+        return;
+    }
+    if( particleData.empty() ) {
+        particleData.set( containers );
+    }
+    PyObject *ret = PyObject_CallFunctionObjArgs( function, particleData.get(), NULL );
+    PyTools::checkPyError();
+    // The result may be a view of the particle data: copy it
+    PyArrayObject *result = ret ? ( PyArrayObject * )PyArray_FROM_OTF( ret, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY ) : NULL;
+    Py_XDECREF( ret );
+    if( result == NULL || ( unsigned int ) PyArray_SIZE( result ) != offset ) {
+        ERROR( "A python function of the particles has not provided a correct result" );
+    }
+    double *data = ( double * ) PyArray_DATA( result );
+    values_.assign( data, data + offset );
+    Py_DECREF( result );
+    evaluated_ = true;
+}
+
+double *ParticleFunctionValues::find( Particles *p, unsigned int npart )
+{
+    if( ! evaluated_ ) {
+        return NULL;
+    }
+    auto it = offsets_.find( p );
+    if( it == offsets_.end() || it->second.second != npart ) {
+        return NULL;
+    }
+    return &values_[it->second.first];
+}
+
+void ParticleFunctionValues::clear()
+{
+    evaluated_ = false;
+    offsets_.clear();
+}
+#endif
+
 void HistogramAxis::init( string type_, double min_, double max_, int nbins_, bool logscale_, bool edge_inclusive_, vector<double> coefficients_ )
 {
     type           = type_          ;
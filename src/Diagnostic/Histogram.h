@@ -7,6 +7,7 @@
 #include "Patch.h"
 #include "SimWindow.h"
 #include <algorithm>
+#include <unordered_map>
 
 // Class for each axis of the particle diags
 class HistogramAxis
@@ -18,7 +19,14 @@ public:
     void init( std::string, double, double, int, bool, bool, std::vector<double> );
     
     //! Function that goes through the particles and find where they should go in the axis
-    virtual void digitize( Species *, std::vector<double> &, std::vector<int> &, unsigned int, SimWindow * ) {};
+    //! (the value of discarded particles, with a negative index, is ignored)
+    virtual void digitize( Species *, double *, int *, unsigned int, SimWindow * ) {};
+    
+#ifdef SMILEI_USE_NUMPY
+    //! Calls the python function of the axis, if any, once for the particles of several containers.
+    //! The particle data is set only if needed.
+    virtual void evaluate( ParticleData &, std::vector<Particles *> & ) {};
+#endif
     
     //! Print some info about the axis
     std::string info( std::string title = "" ) {
@@ -71,13 +79,21 @@ public:
     };
     
     //! Compute the index of each particle in the final histogram
-    void digitize( Species *, std::vector<double> &, std::vector<int> &, SimWindow * );
+    void digitize( Species *, double *, int *, unsigned int, SimWindow * );
     //! Calculate the quantity of each particle to be summed in the histogram
-    virtual void valuate( Species *, std::vector<double> &, std::vector<int> & ) {
+    virtual void valuate( Species *, double *, int *, unsigned int ) {
         ERROR( "`deposited_quantity` should not be empty" );
     };
     //! Add the contribution of each particle in the histogram
-    void distribute( std::vector<double> &, std::vector<int> &, std::vector<double> & );
+    void distribute( double *, int *, unsigned int, std::vector<double> & );
+    
+#ifdef SMILEI_USE_NUMPY
+    //! Calls the python functions of the axes and of the deposited quantity once for the particles
+    //! of all the given containers, so that digitize and valuate do not call them for each container
+    void evaluate( std::vector<Particles *> &containers );
+    //! Calls the python function of the deposited quantity, if any (see evaluate)
+    virtual void evaluateValues( ParticleData &, std::vector<Particles *> & ) {};
+#endif
 
     std::string deposited_quantity;
 
@@ -89,12 +105,10 @@ public:
 class HistogramAxis_x : public HistogramAxis
 {
     ~HistogramAxis_x() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
+        #pragma omp simd
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-            if( index[ipart]<0 ) {
-                continue;
-            }
             array[ipart] = s->particles->Position[0][ipart];
         }
     };
@@ -102,13 +116,11 @@ class HistogramAxis_x : public HistogramAxis
 class HistogramAxis_moving_x : public HistogramAxis
 {
     ~HistogramAxis_moving_x() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         double x_moved = simWindow->getXmoved();
+        #pragma omp simd
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-            if( index[ipart]<0 ) {
-                continue;
-            }
             array[ipart] = s->particles->Position[0][ipart]-x_moved;
         }
     };
@@ -116,12 +128,10 @@ class HistogramAxis_moving_x : public HistogramAxis
 class HistogramAxis_y : public HistogramAxis
 {
     ~HistogramAxis_y() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
+        #pragma omp simd
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-            if( index[ipart]<0 ) {
-                continue;
-            }
             array[ipart] = s->particles->Position[1][ipart];
         }
     };
@@ -129,12 +139,10 @@ class HistogramAxis_y : public HistogramAxis
 class HistogramAxis_z : public HistogramAxis
 {
     ~HistogramAxis_z() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
+        #pragma omp simd
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-            if( index[ipart]<0 ) {
-                continue;
-            }
             array[ipart] = s->particles->Position[2][ipart];
         }
     };
@@ -142,7 +150,7 @@ class HistogramAxis_z : public HistogramAxis
 class HistogramAxis_vector : public HistogramAxis
 {
     ~HistogramAxis_vector() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         unsigned int idim, ndim = coefficients.size()/2;
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -159,7 +167,7 @@ class HistogramAxis_vector : public HistogramAxis
 class HistogramAxis_theta2D : public HistogramAxis
 {
     ~HistogramAxis_theta2D() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         double X, Y;
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -175,7 +183,7 @@ class HistogramAxis_theta2D : public HistogramAxis
 class HistogramAxis_theta3D : public HistogramAxis
 {
     ~HistogramAxis_theta3D() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
@@ -197,7 +205,7 @@ class HistogramAxis_theta3D : public HistogramAxis
 class HistogramAxis_phi : public HistogramAxis
 {
     ~HistogramAxis_phi() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         unsigned int idim;
         double a, b;
@@ -218,23 +226,19 @@ class HistogramAxis_phi : public HistogramAxis
 class HistogramAxis_px : public HistogramAxis
 {
     ~HistogramAxis_px() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
+            #pragma omp simd
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( index[ipart]<0 ) {
-                    continue;
-                }
                 array[ipart] = s->mass_ * s->particles->Momentum[0][ipart];
             }
         }
         // Photons
         else if( s->mass_ == 0 ) {
+            #pragma omp simd
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( index[ipart]<0 ) {
-                    continue;
-                }
                 array[ipart] = s->particles->Momentum[0][ipart];
             }
         }
@@ -243,23 +247,19 @@ class HistogramAxis_px : public HistogramAxis
 class HistogramAxis_py : public HistogramAxis
 {
     ~HistogramAxis_py() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
+            #pragma omp simd
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( index[ipart]<0 ) {
-                    continue;
-                }
                 array[ipart] = s->mass_ * s->particles->Momentum[1][ipart];
             }
         }
         // Photons
         else if( s->mass_ == 0 ) {
+            #pragma omp simd
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( index[ipart]<0 ) {
-                    continue;
-                }
                 array[ipart] = s->particles->Momentum[1][ipart];
             }
         }
@@ -268,23 +268,19 @@ class HistogramAxis_py : public HistogramAxis
 class HistogramAxis_pz : public HistogramAxis
 {
     ~HistogramAxis_pz() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
+            #pragma omp simd
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( index[ipart]<0 ) {
-                    continue;
-                }
                 array[ipart] = s->mass_ * s->particles->Momentum[2][ipart];
             }
         }
         // Photons
         else if( s->mass_ == 0 ) {
+            #pragma omp simd
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( index[ipart]<0 ) {
-                    continue;
-                }
                 array[ipart] = s->particles->Momentum[2][ipart];
             }
         }
@@ -293,7 +289,7 @@ class HistogramAxis_pz : public HistogramAxis
 class HistogramAxis_p : public HistogramAxis
 {
     ~HistogramAxis_p() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -322,7 +318,7 @@ class HistogramAxis_p : public HistogramAxis
 class HistogramAxis_gamma : public HistogramAxis
 {
     ~HistogramAxis_gamma() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -351,7 +347,7 @@ class HistogramAxis_gamma : public HistogramAxis
 class HistogramAxis_ekin : public HistogramAxis
 {
     ~HistogramAxis_ekin() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -380,7 +376,7 @@ class HistogramAxis_ekin : public HistogramAxis
 class HistogramAxis_vx : public HistogramAxis
 {
     ~HistogramAxis_vx() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -411,7 +407,7 @@ class HistogramAxis_vx : public HistogramAxis
 class HistogramAxis_vy : public HistogramAxis
 {
     ~HistogramAxis_vy() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -442,7 +438,7 @@ class HistogramAxis_vy : public HistogramAxis
 class HistogramAxis_vz : public HistogramAxis
 {
     ~HistogramAxis_vz() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -473,7 +469,7 @@ class HistogramAxis_vz : public HistogramAxis
 class HistogramAxis_v : public HistogramAxis
 {
     ~HistogramAxis_v() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
@@ -488,7 +484,7 @@ class HistogramAxis_v : public HistogramAxis
 class HistogramAxis_vperp2 : public HistogramAxis
 {
     ~HistogramAxis_vperp2() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -521,7 +517,7 @@ class HistogramAxis_vperp2 : public HistogramAxis
 class HistogramAxis_charge : public HistogramAxis
 {
     ~HistogramAxis_charge() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
@@ -534,7 +530,7 @@ class HistogramAxis_charge : public HistogramAxis
 class HistogramAxis_chi : public HistogramAxis
 {
     ~HistogramAxis_chi() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
@@ -545,6 +541,28 @@ class HistogramAxis_chi : public HistogramAxis
     };
 };
 #ifdef SMILEI_USE_NUMPY
+//! Values of a python function of the particles, computed at once for the particles of several containers
+class ParticleFunctionValues
+{
+public:
+    ParticleFunctionValues() : evaluated_( false ) {};
+    
+    //! Calls the function on the particles of all the containers (the particle data is set if needed)
+    void evaluate( PyObject *function, ParticleData &particleData, std::vector<Particles *> &containers );
+    
+    //! Values for the npart particles of one container, or NULL if they have not been evaluated
+    double *find( Particles *p, unsigned int npart );
+    
+    //! Forget the values
+    void clear();
+    
+private:
+    bool evaluated_;
+    std::vector<double> values_;
+    //! Offset and number of particles of each container in values_
+    std::unordered_map<Particles *, std::pair<unsigned int, unsigned int> > offsets_;
+};
+
 class HistogramAxis_user_function : public HistogramAxis
 {
 public:
@@ -558,9 +576,23 @@ public:
     {
         Py_DECREF( function );
     };
+    void evaluate( ParticleData &particleData, std::vector<Particles *> &containers ) override
+    {
+        values.evaluate( function, particleData, containers );
+    };
 private:
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, double *array, int *index, unsigned int npart, SimWindow *simWindow )
     {
+        if( npart == 0 ) {
+            return;
+        }
+        // Values already computed for all patches
+        if( double *arr = values.find( s->particles, npart ) ) {
+            for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+                array[ipart] = arr[ipart];
+            }
+            return;
+        }
         #pragma omp critical
         {
             // Expose particle data as numpy arrays
@@ -584,6 +616,7 @@ private:
 
     PyObject *function;
     ParticleData particleData;
+    ParticleFunctionValues values;
 };
 #endif
 
@@ -591,9 +624,8 @@ private:
 class Histogram_number : public Histogram
 {
     ~Histogram_number() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
@@ -605,9 +637,8 @@ class Histogram_number : public Histogram
 class Histogram_charge : public Histogram
 {
     ~Histogram_charge() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
@@ -619,9 +650,8 @@ class Histogram_charge : public Histogram
 class Histogram_jx : public Histogram
 {
     ~Histogram_jx() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -653,9 +683,8 @@ class Histogram_jx : public Histogram
 class Histogram_jy : public Histogram
 {
     ~Histogram_jy() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -687,9 +716,8 @@ class Histogram_jy : public Histogram
 class Histogram_jz : public Histogram
 {
     ~Histogram_jz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -721,9 +749,8 @@ class Histogram_jz : public Histogram
 class Histogram_ekin : public Histogram
 {
     ~Histogram_ekin() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -766,9 +793,8 @@ public:
             }
     };
 private:
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
@@ -781,9 +807,8 @@ private:
 class Histogram_p : public Histogram
 {
     ~Histogram_p() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -813,9 +838,8 @@ class Histogram_p : public Histogram
 class Histogram_px : public Histogram
 {
     ~Histogram_px() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -839,9 +863,8 @@ class Histogram_px : public Histogram
 class Histogram_py : public Histogram
 {
     ~Histogram_py() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -865,9 +888,8 @@ class Histogram_py : public Histogram
 class Histogram_pz : public Histogram
 {
     ~Histogram_pz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -891,9 +913,8 @@ class Histogram_pz : public Histogram
 class Histogram_pressure_xx : public Histogram
 {
     ~Histogram_pressure_xx() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -925,9 +946,8 @@ class Histogram_pressure_xx : public Histogram
 class Histogram_pressure_yy : public Histogram
 {
     ~Histogram_pressure_yy() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -959,9 +979,8 @@ class Histogram_pressure_yy : public Histogram
 class Histogram_pressure_zz : public Histogram
 {
     ~Histogram_pressure_zz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -993,9 +1012,8 @@ class Histogram_pressure_zz : public Histogram
 class Histogram_pressure_xy : public Histogram
 {
     ~Histogram_pressure_xy() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -1029,9 +1047,8 @@ class Histogram_pressure_xy : public Histogram
 class Histogram_pressure_xz : public Histogram
 {
     ~Histogram_pressure_xz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -1065,9 +1082,8 @@ class Histogram_pressure_xz : public Histogram
 class Histogram_pressure_yz : public Histogram
 {
     ~Histogram_pressure_yz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -1101,9 +1117,8 @@ class Histogram_pressure_yz : public Histogram
 class Histogram_ekin_vx : public Histogram
 {
     ~Histogram_ekin_vx() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -1147,9 +1162,22 @@ public:
         Py_DECREF( function );
     };
 private:
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void evaluateValues( ParticleData &particleData, std::vector<Particles *> &containers ) override
     {
-        unsigned int npart = array.size();
+        values.evaluate( function, particleData, containers );
+    };
+    void valuate( Species *s, double *array, int *index, unsigned int npart )
+    {
+        if( npart == 0 ) {
+            return;
+        }
+        // Values already computed for all patches
+        if( double *arr = values.find( s->particles, npart ) ) {
+            for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+                array[ipart] = arr[ipart];
+            }
+            return;
+        }
         #pragma omp critical
         {
             // Expose particle data as numpy arrays
@@ -1172,6 +1200,7 @@ private:
 
     PyObject *function;
     ParticleData particleData;
+    ParticleFunctionValues values;
 };
 #endif
 
@@ -1,12 +1,16 @@
 #include "ElectroMagn.h"
 
 #include <limits>
+#include <algorithm>
 #include <iostream>
 
 #include "Params.h"
 #include "Species.h"
 #include "Projector.h"
 #include "Field.h"
+#include "Field1D.h"
+#include "Field2D.h"
+#include "Field3D.h"
 #include "ElectroMagnBC.h"
 #include "ElectroMagnBC_Factory.h"
 #include "SimWindow.h"
@@ -209,6 +213,56 @@ void ElectroMagn::initElectroMagnQuantities()
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Define limits of non duplicated elements, which depend on the patch location
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::initNonDuplicatedLimits( Params &params, Patch *patch )
+{
+    // (by construction 1 (prim) or 2 (dual) elements shared between per MPI process)
+    // istart
+    for( unsigned int i=0 ; i<3 ; i++ )
+        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
+            istart[i][isDual] = 0;
+        }
+    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
+        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
+            istart[i][isDual] = oversize[i];
+            if( patch->Pcoordinates[i]!=0 ) {
+                istart[i][isDual]+=1;
+            }
+        }
+    }
+    
+    // bufsize = nelements
+    for( unsigned int i=0 ; i<3 ; i++ )
+        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
+            bufsize[i][isDual] = 1;
+        }
+        
+    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
+        for( int isDual=0 ; isDual<2 ; isDual++ ) {
+            bufsize[i][isDual] = n_space[i] + 1;
+        }
+        
+        for( int isDual=0 ; isDual<2 ; isDual++ ) {
+            bufsize[i][isDual] += isDual;
+            if( params.number_of_patches[i]!=1 ) {
+            
+                if( ( !isDual ) && ( patch->Pcoordinates[i]!=0 ) ) {
+                    bufsize[i][isDual]--;
+                } else if( isDual ) {
+                    bufsize[i][isDual]--;
+                    if( ( patch->Pcoordinates[i]!=0 ) && ( patch->Pcoordinates[i]!=( unsigned int )params.number_of_patches[i]-1 ) ) {
+                        bufsize[i][isDual]--;
+                    }
+                }
+                
+            } // if ( params.number_of_patches[i]!=1 )
+        } // for (int isDual=0 ; isDual
+    } // for (unsigned int i=0 ; i<nDim_field
+}
+
+
 void ElectroMagn::finishInitialization( int nspecies, Patch *patch )
 {
 
@@ -250,6 +304,97 @@ void ElectroMagn::finishInitialization( int nspecies, Patch *patch )
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Reset the fields of a patch which left the moving window so that it can be reused as an arriving patch:
+//   the arrays keep their memory and are zeroed, the location-dependent operators are created again
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::recycle( Params &params, Patch *patch )
+{
+    isXmin = patch->isXmin();
+    isXmax = patch->isXmax();
+    initNonDuplicatedLimits( params, patch );
+    
+    // allFields is not used here as it may still point to unused species fields which were deleted
+    Field *fields[13] = { Ex_, Ey_, Ez_, Bx_, By_, Bz_, Bx_m, By_m, Bz_m, Jx_, Jy_, Jz_, rho_ };
+    for( unsigned int ifield=0; ifield<13; ifield++ ) {
+        if( fields[ifield] ) {
+            fields[ifield]->put_to( 0. );
+        }
+    }
+    for( unsigned int ispec=0; ispec<n_species; ispec++ ) {
+        Field *species_fields[4] = { Jx_s[ispec], Jy_s[ispec], Jz_s[ispec], rho_s[ispec] };
+        for( unsigned int ifield=0; ifield<4; ifield++ ) {
+            if( species_fields[ifield] ) {
+                species_fields[ifield]->put_to( 0. );
+            }
+        }
+    }
+    for( unsigned int idiag=0; idiag<allFields_avg.size(); idiag++ ) {
+        for( unsigned int ifield=0; ifield<allFields_avg[idiag].size(); ifield++ ) {
+            allFields_avg[idiag][ifield]->put_to( 0. );
+        }
+    }
+    std::vector<Field *> *filters[6] = { &Exfilter, &Eyfilter, &Ezfilter, &Bxfilter, &Byfilter, &Bzfilter };
+    for( unsigned int i=0; i<6; i++ ) {
+        for( unsigned int ifield=0; ifield<filters[i]->size(); ifield++ ) {
+            ( *filters[i] )[ifield]->put_to( 0. );
+        }
+    }
+    
+    for( int iDim=0; iDim<2; iDim++ ) {
+        poynting     [iDim].assign( nDim_field, 0. );
+        poynting_inst[iDim].assign( nDim_field, 0. );
+    }
+    nrj_mw_lost = 0.;
+    nrj_new_fields = 0.;
+    
+    for( unsigned int ibc=0 ; ibc<emBoundCond.size() ; ibc++ ) {
+        if( emBoundCond[ibc] ) {
+            delete emBoundCond[ibc];
+        }
+    }
+    emBoundCond = ElectroMagnBC_Factory::create( params, patch );
+    
+    // Antenna profiles are computed for the initial patches only
+    for( unsigned int iantenna=0; iantenna<antennas.size(); iantenna++ ) {
+        delete antennas[iantenna].field;
+        antennas[iantenna].field = NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy the data of the fields kept during the simulation to memory first touched by the calling thread
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::firstTouch()
+{
+    Field *fields[17] = { Ex_, Ey_, Ez_, Bx_, By_, Bz_, Bx_m, By_m, Bz_m, Jx_, Jy_, Jz_, rho_,
+                          Env_A_abs_, Env_Chi_, Env_E_abs_, Env_Ex_abs_ };
+    for( unsigned int ifield=0; ifield<17; ifield++ ) {
+        if( fields[ifield] ) {
+            fields[ifield]->firstTouch();
+        }
+    }
+    for( unsigned int ispec=0; ispec<n_species; ispec++ ) {
+        Field *species_fields[5] = { Jx_s[ispec], Jy_s[ispec], Jz_s[ispec], rho_s[ispec], Env_Chi_s[ispec] };
+        for( unsigned int ifield=0; ifield<5; ifield++ ) {
+            if( species_fields[ifield] ) {
+                species_fields[ifield]->firstTouch();
+            }
+        }
+    }
+    for( unsigned int idiag=0; idiag<allFields_avg.size(); idiag++ ) {
+        for( unsigned int ifield=0; ifield<allFields_avg[idiag].size(); ifield++ ) {
+            allFields_avg[idiag][ifield]->firstTouch();
+        }
+    }
+    std::vector<Field *> *filters[6] = { &Exfilter, &Eyfilter, &Ezfilter, &Bxfilter, &Byfilter, &Bzfilter };
+    for( unsigned int i=0; i<6; i++ ) {
+        for( unsigned int ifield=0; ifield<filters[i]->size(); ifield++ ) {
+            ( *filters[i] )[ifield]->firstTouch();
+        }
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Destructor for the virtual class ElectroMagn
 // ---------------------------------------------------------------------------------------------------------------------
@@ -498,6 +643,89 @@ void ElectroMagn::restartRhoJs()
     rho_->put_to( 0. );
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// The currents and densities of species requested by the diagnostics are allocated at the timesteps where the
+// diagnostics need them, kept while the following timesteps need them too, and freed at the first one which does not
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::allocateRhoJs()
+{
+    for( unsigned int ispec=0 ; ispec < n_species ; ispec++ ) {
+        Field *species_fields[4] = { Jx_s[ispec], Jy_s[ispec], Jz_s[ispec], rho_s[ispec] };
+        for( unsigned int ifield=0; ifield<4; ifield++ ) {
+            if( species_fields[ifield] ) {
+                allocateSpeciesField( species_fields[ifield] );
+            }
+        }
+    }
+}
+
+void ElectroMagn::deallocateRhoJs()
+{
+    for( unsigned int ispec=0 ; ispec < n_species ; ispec++ ) {
+        Field *species_fields[4] = { Jx_s[ispec], Jy_s[ispec], Jz_s[ispec], rho_s[ispec] };
+        for( unsigned int ifield=0; ifield<4; ifield++ ) {
+            if( species_fields[ifield] ) {
+                species_fields[ifield]->deallocateData();
+            }
+        }
+    }
+}
+
+void ElectroMagn::allocateSpeciesField( Field *field )
+{
+    if( field->data_ != NULL ) {
+        return;
+    }
+    if( ( field->name.substr( 0, 2 )=="Jx" ) && ( !is_pxr ) ) {
+        field->allocateDims( 0, false );
+    } else if( ( field->name.substr( 0, 2 )=="Jy" ) && ( !is_pxr ) ) {
+        field->allocateDims( 1, false );
+    } else if( ( field->name.substr( 0, 2 )=="Jz" ) && ( !is_pxr ) ) {
+        field->allocateDims( 2, false );
+    } else if( ( field->name.substr( 0, 2 )=="Rh" ) || ( is_pxr ) ) {
+        field->allocateDims();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Compute the total density and currents from species density and currents, in all cartesian geometries
+// The species fields have the same dimensions as the total fields. Each total field is read and written once: the
+// species are added block by block, so that the block of the total field stays in cache.
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::computeTotalRhoJ()
+{
+    const unsigned int block_size = 512;
+    
+    Field *total_fields[4] = { Jx_, Jy_, Jz_, rho_ };
+    vector<Field *> *species_fields[4] = { &Jx_s, &Jy_s, &Jz_s, &rho_s };
+    vector<double *> species_data( n_species );
+    for( unsigned int ifield=0; ifield<4; ifield++ ) {
+        unsigned int nspecies_data = 0;
+        for( unsigned int ispec=0; ispec<n_species; ispec++ ) {
+            Field *field = ( *species_fields[ifield] )[ispec];
+            if( field && field->data_ ) {
+                species_data[nspecies_data++] = field->data_;
+            }
+        }
+        if( nspecies_data == 0 ) {
+            continue;
+        }
+        
+        double *__restrict__ total = total_fields[ifield]->data_;
+        unsigned int size = total_fields[ifield]->globalDims_;
+        for( unsigned int start=0; start<size; start+=block_size ) {
+            unsigned int stop = min( start+block_size, size );
+            for( unsigned int ispec=0; ispec<nspecies_data; ispec++ ) {
+                const double *__restrict__ species = species_data[ispec];
+                #pragma omp simd
+                for( unsigned int i=start; i<stop; i++ ) {
+                    total[i] += species[i];
+                }
+            }
+        }
+    }
+}
+
 void ElectroMagn::restartEnvChis()
 {
     for( unsigned int ispec=0 ; ispec < n_species ; ispec++ ) {
@@ -605,3 +833,169 @@ void ElectroMagn::applyAntenna( unsigned int iAntenna, double intensity )
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Preconditioned conjugate gradient of the Poisson problems (see VectorPatch::solvePoissonPCG)
+//   the fields are handled as 3D arrays, of size 1 along the missing dimensions
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::initPoissonPCG()
+{
+    Field **vectors[3] = { &u_, &w_, &s_ };
+    for( unsigned int i=0; i<3; i++ ) {
+        if( dimPrim.size() == 1 ) {
+            *vectors[i] = new Field1D( dimPrim );
+        } else if( dimPrim.size() == 2 ) {
+            *vectors[i] = new Field2D( dimPrim );
+        } else {
+            *vectors[i] = new Field3D( dimPrim );
+        }
+    }
+}
+
+void ElectroMagn::deletePoissonPCG()
+{
+    delete u_;
+    delete w_;
+    delete s_;
+    u_ = NULL;
+    w_ = NULL;
+    s_ = NULL;
+}
+
+void ElectroMagn::preconditionPoisson( double gamma_mean )
+{
+    // Sizes, real nodes and coefficients of the operator along x, y, z
+    int n[3] = { 1, 1, 1 }, lo[3] = { 0, 0, 0 }, hi[3] = { 0, 0, 0 };
+    double c[3] = { 0., 0., 0. };
+    for( unsigned int d=0; d<dimPrim.size(); d++ ) {
+        n[d]  = dimPrim[d];
+        lo[d] = index_min_p_[d];
+        hi[d] = index_max_p_[d];
+        c[d]  = 1./( cell_length[d]*cell_length[d] );
+    }
+    c[0] /= gamma_mean*gamma_mean;
+    double one_ov_diag = 1./( 2.*( c[0]+c[1]+c[2] ) );
+    const int sx = n[1]*n[2], sy = n[2];
+    
+    // The primal node shared with the next patch is not exchanged: like the first real node, which is the one
+    // shared with the previous patch, it is preconditioned pointwise (Jacobi) so that both patches agree on it.
+    // The Gauss-Seidel sweep covers the other real nodes, with u = 0 on these interfaces.
+    int top[3], in_lo[3];
+    for( unsigned int d=0; d<3; d++ ) {
+        top[d]   = hi[d] < n[d]-1 ? hi[d]+1 : hi[d];
+        in_lo[d] = lo[d] > 0 ? lo[d]+1 : lo[d];
+    }
+    
+    double *u = u_->data_;
+    double *r = r_->data_;
+    for( unsigned int i=0; i<u_->globalDims_; i++ ) {
+        u[i] = 0.;
+    }
+    
+    // Each node solves A u = r for itself, given its neighbours: c.(sum of neighbours) - diag u = r
+    auto relax = [&]( int i, int j, int k ) {
+        int idx = i*sx + j*sy + k;
+        double neighbours = 0.;
+        if( i > in_lo[0] ) {
+            neighbours += c[0]*u[idx-sx];
+        }
+        if( i < hi[0] ) {
+            neighbours += c[0]*u[idx+sx];
+        }
+        if( j > in_lo[1] ) {
+            neighbours += c[1]*u[idx-sy];
+        }
+        if( j < hi[1] ) {
+            neighbours += c[1]*u[idx+sy];
+        }
+        if( k > in_lo[2] ) {
+            neighbours += c[2]*u[idx-1];
+        }
+        if( k < hi[2] ) {
+            neighbours += c[2]*u[idx+1];
+        }
+        u[idx] = ( neighbours - r[idx] ) * one_ov_diag;
+    };
+    // Forward then backward sweep: the preconditioner stays symmetric
+    for( int i=in_lo[0]; i<=hi[0]; i++ ) {
+        for( int j=in_lo[1]; j<=hi[1]; j++ ) {
+            for( int k=in_lo[2]; k<=hi[2]; k++ ) {
+                relax( i, j, k );
+            }
+        }
+    }
+    for( int i=hi[0]; i>=in_lo[0]; i-- ) {
+        for( int j=hi[1]; j>=in_lo[1]; j-- ) {
+            for( int k=hi[2]; k>=in_lo[2]; k-- ) {
+                relax( i, j, k );
+            }
+        }
+    }
+    for( int i=lo[0]; i<=top[0]; i++ ) {
+        for( int j=lo[1]; j<=top[1]; j++ ) {
+            for( int k=lo[2]; k<=top[2]; k++ ) {
+                if( i < in_lo[0] || i > hi[0] || j < in_lo[1] || j > hi[1] || k < in_lo[2] || k > hi[2] ) {
+                    u[i*sx+j*sy+k] = -r[i*sx+j*sy+k] * one_ov_diag;
+                }
+            }
+        }
+    }
+}
+
+void ElectroMagn::compute_Au( Patch *patch, bool relativistic, double gamma_mean )
+{
+    swap( p_, u_ );
+    swap( Ap_, w_ );
+    if( relativistic ) {
+        compute_Ap_relativistic_Poisson( patch, gamma_mean );
+    } else {
+        compute_Ap( patch );
+    }
+    swap( p_, u_ );
+    swap( Ap_, w_ );
+}
+
+void ElectroMagn::compute_PCG_dots( double *dots )
+{
+    int n[3] = { 1, 1, 1 }, lo[3] = { 0, 0, 0 }, hi[3] = { 0, 0, 0 };
+    for( unsigned int d=0; d<dimPrim.size(); d++ ) {
+        n[d]  = dimPrim[d];
+        lo[d] = index_min_p_[d];
+        hi[d] = index_max_p_[d];
+    }
+    double *u = u_->data_;
+    double *w = w_->data_;
+    double *r = r_->data_;
+    double r_dot_u = 0., w_dot_u = 0., r_dot_r = 0.;
+    for( int i=lo[0]; i<=hi[0]; i++ ) {
+        for( int j=lo[1]; j<=hi[1]; j++ ) {
+            int idx = ( i*n[1] + j )*n[2];
+            #pragma omp simd reduction(+:r_dot_u,w_dot_u,r_dot_r)
+            for( int k=lo[2]; k<=hi[2]; k++ ) {
+                r_dot_u += r[idx+k]*u[idx+k];
+                w_dot_u += w[idx+k]*u[idx+k];
+                r_dot_r += r[idx+k]*r[idx+k];
+            }
+        }
+    }
+    dots[0] = r_dot_u;
+    dots[1] = w_dot_u;
+    dots[2] = r_dot_r;
+}
+
+void ElectroMagn::update_PCG( double alpha, double beta )
+{
+    double *__restrict__ phi = phi_->data_;
+    double *__restrict__ r = r_->data_;
+    double *__restrict__ p = p_->data_;
+    double *__restrict__ s = s_->data_;
+    const double *__restrict__ u = u_->data_;
+    const double *__restrict__ w = w_->data_;
+    unsigned int size = phi_->globalDims_;
+    #pragma omp simd
+    for( unsigned int i=0; i<size; i++ ) {
+        p[i] = u[i] + beta*p[i];
+        s[i] = w[i] + beta*s[i];
+        phi[i] += alpha*p[i];
+        r[i] -= alpha*s[i];
+    }
+}
@@ -77,8 +77,15 @@ public:
     ElectroMagn( Params &params, DomainDecomposition *domain_decomposition, std::vector<Species *> &vecSpecies, Patch *patch );
     ElectroMagn( ElectroMagn *emFields, Params &params, Patch *patch );
     void initElectroMagnQuantities();
+    //! Define limits of non duplicated elements (istart, bufsize)
+    void initNonDuplicatedLimits( Params &params, Patch *patch );
     //! Extra initialization. Used in ElectroMagnFactory
     virtual void finishInitialization( int nspecies, Patch *patch );
+    //! Zero the fields in place and rebuild the boundary conditions, for a patch reused elsewhere by the moving window
+    virtual void recycle( Params &params, Patch *patch );
+    //! Copy the fields to memory first touched by the calling thread, for a patch computed by a thread of another
+    //! NUMA node
+    virtual void firstTouch();
     
     //! Destructor for Electromagn
     virtual ~ElectroMagn();
@@ -260,6 +267,13 @@ public:
     //! Method used to initialize the total charge currents and densities of species
     virtual void restartRhoJs();
     
+    //! Allocate the currents and densities of species requested by the diagnostics, if not allocated
+    void allocateRhoJs();
+    //! Free the currents and densities of species, at the timesteps where the diagnostics do not need them
+    void deallocateRhoJs();
+    //! Allocate a current or density created without allocating, with the staggering given by its name
+    void allocateSpeciesField( Field *field );
+    
     //! Method used to initialize the total susceptibility
     virtual void restartEnvChi();
     //! Method used to initialize the total susceptibility of species
@@ -267,7 +281,7 @@ public:
     
     
     //! Method used to sum all species densities and currents to compute the total charge density and currents
-    virtual void computeTotalRhoJ() = 0;
+    virtual void computeTotalRhoJ();
     
     //! Method used to sum all species susceptibility to compute the total susceptibility
     virtual void computeTotalEnvChi() = 0;
@@ -281,6 +295,21 @@ public:
     virtual void update_pand_r( double r_dot_r, double p_dot_Ap ) = 0;
     virtual void update_p( double rnew_dot_rnew, double r_dot_r ) = 0;
     virtual void initE( Patch *patch ) = 0;
+    
+    //! Preconditioned conjugate gradient (Main.poisson_solver = "pcg"), in all cartesian geometries
+    //! Allocate and delete u = M^-1 r, w = A u and s = A p
+    void initPoissonPCG();
+    void deletePoissonPCG();
+    //! u = M^-1 r: one symmetric Gauss-Seidel sweep of the (relativistic) Poisson operator inside the patch, and
+    //! Jacobi on the nodes shared with the neighbour patches (block-Jacobi preconditioner, one block per patch)
+    void preconditionPoisson( double gamma_mean );
+    //! w = A u, with compute_Ap or compute_Ap_relativistic_Poisson
+    void compute_Au( Patch *patch, bool relativistic, double gamma_mean );
+    //! Scalar products (r,u), (w,u) and (r,r) over the real nodes, stored in dots[0:3]
+    void compute_PCG_dots( double *dots );
+    //! p = u + beta p, s = w + beta s, phi += alpha p, r -= alpha s
+    void update_PCG( double alpha, double beta );
+    
     virtual void initE_relativistic_Poisson( Patch *patch, double gamma_mean ) = 0;
     virtual void initB_relativistic_Poisson( Patch *patch, double gamma_mean ) = 0;
     virtual void center_fields_from_relativistic_Poisson( Patch *patch ) = 0; // centers in Yee cells the fields
@@ -311,6 +340,9 @@ public:
     Field *r_;
     Field *p_;
     Field *Ap_;
+    Field *u_;
+    Field *w_;
+    Field *s_;
 
     cField *phi_AM_;
     cField *r_AM_;
@@ -439,6 +471,7 @@ public:
         nrj_mw_lost += nrj;
     }
     
+    //! Memory of the fields allocated for the whole simulation
     inline int getMemFootPrint()
     {
     
@@ -448,6 +481,30 @@ public:
             emSize += 4;    //Env_Chi, Env_A_abs, Env_E_abs, Env_Ex_abs;
         }
         
+        for( unsigned int ispec=0 ; ispec<Env_Chi_s.size() ; ispec++ ) {
+            if( Env_Chi_s [ispec] ) {
+                emSize++;
+            }
+        }
+        
+        for( unsigned int idiag = 0 ; idiag < allFields_avg.size() ; idiag++ ) {
+            emSize += allFields_avg[idiag].size() ;
+        }
+        
+        
+        for( size_t i=0 ; i<nDim_field ; i++ ) {
+            emSize *= dimPrim[i];
+        }
+        
+        emSize *= sizeof( double );
+        return emSize;
+    }
+    
+    //! Memory of the currents and densities of species requested by the diagnostics, which are allocated only at
+    //! the timesteps where the diagnostics need them
+    inline int getSpeciesMemFootPrint()
+    {
+        int emSize = 0;
         for( unsigned int ispec=0 ; ispec<Jx_s.size() ; ispec++ ) {
             if( Jx_s [ispec] ) {
                 emSize++;
@@ -461,16 +518,8 @@ public:
             if( rho_s [ispec] ) {
                 emSize++;
             }
-            if( Env_Chi_s [ispec] ) {
-                emSize++;
-            }
         }
         
-        for( unsigned int idiag = 0 ; idiag < allFields_avg.size() ; idiag++ ) {
-            emSize += allFields_avg[idiag].size() ;
-        }
-        
-        
         for( size_t i=0 ; i<nDim_field ; i++ ) {
             emSize *= dimPrim[i];
         }
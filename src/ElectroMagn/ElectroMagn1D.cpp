@@ -157,49 +157,7 @@ void ElectroMagn1D::initElectroMagn1DQuantities( Params &params, Patch *patch )
     
     
     // Define limits of non duplicated elements
-    // (by construction 1 (prim) or 2 (dual) elements shared between per MPI process)
-    // istart
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = 0;
-        }
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = oversize[i];
-            if( patch->Pcoordinates[i]!=0 ) {
-                istart[i][isDual]+=1;
-            }
-        }
-    }
-    
-    // bufsize = nelements
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = 1;
-        }
-        
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = n_space[i] + 1;
-        }
-        
-        
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] += isDual;
-            if( params.number_of_patches[i]!=1 ) {
-            
-                if( ( !isDual ) && ( patch->Pcoordinates[i]!=0 ) ) {
-                    bufsize[i][isDual]--;
-                } else if( isDual ) {
-                    bufsize[i][isDual]--;
-                    if( ( patch->Pcoordinates[i]!=0 ) && ( patch->Pcoordinates[i]!=( unsigned int )params.number_of_patches[i]-1 ) ) {
-                        bufsize[i][isDual]--;
-                    }
-                }
-                
-            } // if ( params.number_of_patches[i]!=1 )
-        } // for (int isDual=0 ; isDual
-    } // for (unsigned int i=0 ; i<nDim_field
+    initNonDuplicatedLimits( params, patch );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -724,44 +682,6 @@ Field *ElectroMagn1D::createField( string fieldname, Params& params )
 }
 
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Compute the total density and currents from species density and currents
-// ---------------------------------------------------------------------------------------------------------------------
-void ElectroMagn1D::computeTotalRhoJ()
-{
-    Field1D *Jx1D    = static_cast<Field1D *>( Jx_ );
-    Field1D *Jy1D    = static_cast<Field1D *>( Jy_ );
-    Field1D *Jz1D    = static_cast<Field1D *>( Jz_ );
-    Field1D *rho1D   = static_cast<Field1D *>( rho_ );
-    
-    for( unsigned int ispec=0; ispec<n_species; ispec++ ) {
-        if( Jx_s[ispec] ) {
-            Field1D *Jx1D_s  = static_cast<Field1D *>( Jx_s[ispec] );
-            for( unsigned int ix=0 ; ix<=dimPrim[0] ; ix++ ) {
-                ( *Jx1D )( ix )  += ( *Jx1D_s )( ix );
-            }
-        }
-        if( Jy_s[ispec] ) {
-            Field1D *Jy1D_s  = static_cast<Field1D *>( Jy_s[ispec] );
-            for( unsigned int ix=0 ; ix<dimPrim[0] ; ix++ ) {
-                ( *Jy1D )( ix )  += ( *Jy1D_s )( ix );
-            }
-        }
-        if( Jz_s[ispec] ) {
-            Field1D *Jz1D_s  = static_cast<Field1D *>( Jz_s[ispec] );
-            for( unsigned int ix=0 ; ix<dimPrim[0] ; ix++ ) {
-                ( *Jz1D )( ix )  += ( *Jz1D_s )( ix );
-            }
-        }
-        if( rho_s[ispec] ) {
-            Field1D *rho1D_s  = static_cast<Field1D *>( rho_s[ispec] );
-            for( unsigned int ix=0 ; ix<dimPrim[0] ; ix++ ) {
-                ( *rho1D )( ix )  += ( *rho1D_s )( ix );
-            }
-        }
-    }//END loop on species ispec
-}
-
 // ---------------------------------------------------------------------------------------------------------------------
 // Compute the total susceptibility from species susceptibility
 // ---------------------------------------------------------------------------------------------------------------------
@@ -829,11 +749,19 @@ void ElectroMagn1D::applyExternalField( Field *my_field,  Profile *profile, Patc
     int N = ( int )field1D->dims()[0];
     
     // USING UNSIGNED INT CREATES PB WITH PERIODIC BCs
+    vector<double> x( N ), values( N );
     for( int i=0 ; i<N ; i++ ) {
-        ( *field1D )( i ) += profile->valueAt( pos );
+        x[i] = pos[0];
         pos[0] += dx;
     }
     
+    vector<double *> xp( 1, &x[0] );
+    profile->valuesAt( xp, N, &values[0] );
+    
+    for( int i=0 ; i<N ; i++ ) {
+        ( *field1D )( i ) += values[i];
+    }
+    
 }
 
 void ElectroMagn1D::applyPrescribedField( Field *my_field,  Profile *profile, Patch *patch, double time )
@@ -112,8 +112,6 @@ public:
     //! Creates a new field with the right characteristics, depending on the name
     Field *createField( std::string fieldname, Params& params );
     
-    //! Method used to compute the total charge density and currents by summing over all species
-    void computeTotalRhoJ();
     
     //! Method used to compute the total susceptibility by summing over all species
     void computeTotalEnvChi();
@@ -96,6 +96,16 @@ ElectroMagn2D::ElectroMagn2D( ElectroMagn2D *emFields, Params &params, Patch *pa
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Reset ElectroMagn2D for a patch reused elsewhere by the moving window
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn2D::recycle( Params &params, Patch *patch )
+{
+    isYmin = patch->isYmin();
+    isYmax = patch->isYmax();
+    ElectroMagn::recycle( params, patch );
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Initialize quantities used in ElectroMagn2D
 // ---------------------------------------------------------------------------------------------------------------------
@@ -199,48 +209,7 @@ void ElectroMagn2D::initElectroMagn2DQuantities( Params &params, Patch *patch )
     
     
     // Define limits of non duplicated elements
-    // (by construction 1 (prim) or 2 (dual) elements shared between per MPI process)
-    // istart
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = 0;
-        }
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = oversize[i];
-            if( patch->Pcoordinates[i]!=0 ) {
-                istart[i][isDual]+=1;
-            }
-        }
-    }
-    
-    // bufsize = nelements
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = 1;
-        }
-        
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = n_space[i] + 1;
-        }
-        
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] += isDual;
-            if( params.number_of_patches[i]!=1 ) {
-            
-                if( ( !isDual ) && ( patch->Pcoordinates[i]!=0 ) ) {
-                    bufsize[i][isDual]--;
-                } else if( isDual ) {
-                    bufsize[i][isDual]--;
-                    if( ( patch->Pcoordinates[i]!=0 ) && ( patch->Pcoordinates[i]!=( unsigned int )params.number_of_patches[i]-1 ) ) {
-                        bufsize[i][isDual]--;
-                    }
-                }
-                
-            } // if ( params.number_of_patches[i]!=1 )
-        } // for (int isDual=0 ; isDual
-    } // for (unsigned int i=0 ; i<nDim_field
+    initNonDuplicatedLimits( params, patch );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1256,54 +1225,6 @@ Field * ElectroMagn2D::createField( string fieldname, Params& params )
     return NULL;
 }
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Compute the total density and currents from species density and currents
-// ---------------------------------------------------------------------------------------------------------------------
-void ElectroMagn2D::computeTotalRhoJ()
-{
-    // static cast of the total currents and densities
-    Field2D *Jx2D    = static_cast<Field2D *>( Jx_ );
-    Field2D *Jy2D    = static_cast<Field2D *>( Jy_ );
-    Field2D *Jz2D    = static_cast<Field2D *>( Jz_ );
-    Field2D *rho2D   = static_cast<Field2D *>( rho_ );
-    
-    
-    
-    // -----------------------------------
-    // Species currents and charge density
-    // -----------------------------------
-    for( unsigned int ispec=0; ispec<n_species; ispec++ ) {
-        if( Jx_s[ispec] ) {
-            Field2D *Jx2D_s  = static_cast<Field2D *>( Jx_s[ispec] );
-            for( unsigned int i=0 ; i<Jx2D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<Jx2D->dims_[1] ; j++ ) {
-                    ( *Jx2D )( i, j ) += ( *Jx2D_s )( i, j );
-                }
-        }
-        if( Jy_s[ispec] ) {
-            Field2D *Jy2D_s  = static_cast<Field2D *>( Jy_s[ispec] );
-            for( unsigned int i=0 ; i<Jy2D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<Jy2D->dims_[1] ; j++ ) {
-                    ( *Jy2D )( i, j ) += ( *Jy2D_s )( i, j );
-                }
-        }
-        if( Jz_s[ispec] ) {
-            Field2D *Jz2D_s  = static_cast<Field2D *>( Jz_s[ispec] );
-            for( unsigned int i=0 ; i<Jz2D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<Jz2D->dims_[1] ; j++ ) {
-                    ( *Jz2D )( i, j ) += ( *Jz2D_s )( i, j );
-                }
-        }
-        if( rho_s[ispec] ) {
-            Field2D *rho2D_s  = static_cast<Field2D *>( rho_s[ispec] );
-            for( unsigned int i=0 ; i<rho2D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<rho2D->dims_[1] ; j++ ) {
-                    ( *rho2D )( i, j ) += ( *rho2D_s )( i, j );
-                }
-        }
-    }//END loop on species ispec
-//END computeTotalRhoJ
-}
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Compute the total susceptibility from species susceptibility
@@ -1461,15 +1382,29 @@ void ElectroMagn2D::applyExternalField( Field *my_field,  Profile *profile, Patc
     int N1 = ( int )field2D->dims()[1];
     
     // UNSIGNED INT LEADS TO PB IN PERIODIC BCs
+    // Coordinates of all the points of the field, for a single evaluation of the profile
+    unsigned int size = N0*N1;
+    vector<double> x( size ), y( size ), values( size );
     for( int i=0 ; i<N0 ; i++ ) {
         pos[1] = pos1;
         for( int j=0 ; j<N1 ; j++ ) {
-            ( *field2D )( i, j ) += profile->valueAt( pos );
+            x[i*N1+j] = pos[0];
+            y[i*N1+j] = pos[1];
             pos[1] += dy;
         }
         pos[0] += dx;
     }
     
+    vector<double *> xy( 2 );
+    xy[0] = &x[0];
+    xy[1] = &y[0];
+    profile->valuesAt( xy, size, &values[0] );
+    
+    double *field = field2D->data();
+    for( unsigned int i=0 ; i<size ; i++ ) {
+        field[i] += values[i];
+    }
+    
 }
 
 void ElectroMagn2D::applyPrescribedField( Field *my_field,  Profile *profile, Patch *patch, double time )
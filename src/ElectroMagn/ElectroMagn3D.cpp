@@ -102,6 +102,18 @@ ElectroMagn3D::ElectroMagn3D( ElectroMagn3D *emFields, Params &params, Patch *pa
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Reset ElectroMagn3D for a patch reused elsewhere by the moving window
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn3D::recycle( Params &params, Patch *patch )
+{
+    isYmin = patch->isYmin();
+    isYmax = patch->isYmax();
+    isZmin = patch->isZmin();
+    isZmax = patch->isZmax();
+    ElectroMagn::recycle( params, patch );
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Initialize quantities used in ElectroMagn3D
 // ---------------------------------------------------------------------------------------------------------------------
@@ -203,48 +215,7 @@ void ElectroMagn3D::initElectroMagn3DQuantities( Params &params, Patch *patch )
     
     
     // Define limits of non duplicated elements
-    // (by construction 1 (prim) or 2 (dual) elements shared between per MPI process)
-    // istart
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = 0;
-        }
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = oversize[i];
-            if( patch->Pcoordinates[i]!=0 ) {
-                istart[i][isDual]+=1;
-            }
-        }
-    }
-    
-    // bufsize = nelements
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = 1;
-        }
-        
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = n_space[i] + 1;
-        }
-        
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] += isDual;
-            if( params.number_of_patches[i]!=1 ) {
-            
-                if( ( !isDual ) && ( patch->Pcoordinates[i]!=0 ) ) {
-                    bufsize[i][isDual]--;
-                } else if( isDual ) {
-                    bufsize[i][isDual]--;
-                    if( ( patch->Pcoordinates[i]!=0 ) && ( patch->Pcoordinates[i]!=params.number_of_patches[i]-1 ) ) {
-                        bufsize[i][isDual]--;
-                    }
-                }
-                
-            } // if ( params.number_of_patches[i]!=1 )
-        } // for (int isDual=0 ; isDual
-    } // for (unsigned int i=0 ; i<nDim_field
+    initNonDuplicatedLimits( params, patch );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1529,58 +1500,6 @@ void ElectroMagn3D::center_fields_from_relativistic_Poisson( Patch *patch )
     
 }
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Compute the total density and currents from species density and currents
-// ---------------------------------------------------------------------------------------------------------------------
-void ElectroMagn3D::computeTotalRhoJ()
-{
-    // static cast of the total currents and densities
-    Field3D *Jx3D    = static_cast<Field3D *>( Jx_ );
-    Field3D *Jy3D    = static_cast<Field3D *>( Jy_ );
-    Field3D *Jz3D    = static_cast<Field3D *>( Jz_ );
-    Field3D *rho3D   = static_cast<Field3D *>( rho_ );
-    
-    
-    // -----------------------------------
-    // Species currents and charge density
-    // -----------------------------------
-    for( unsigned int ispec=0; ispec<n_species; ispec++ ) {
-        if( Jx_s[ispec] ) {
-            Field3D *Jx3D_s  = static_cast<Field3D *>( Jx_s[ispec] );
-            for( unsigned int i=0 ; i<Jx3D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<Jx3D->dims_[1] ; j++ )
-                    for( unsigned int k=0 ; k<Jx3D->dims_[2] ; k++ ) {
-                        ( *Jx3D )( i, j, k ) += ( *Jx3D_s )( i, j, k );
-                    }
-        }
-        if( Jy_s[ispec] ) {
-            Field3D *Jy3D_s  = static_cast<Field3D *>( Jy_s[ispec] );
-            for( unsigned int i=0 ; i<Jy3D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<Jy3D->dims_[1] ; j++ )
-                    for( unsigned int k=0 ; k<Jy3D->dims_[2] ; k++ ) {
-                        ( *Jy3D )( i, j, k ) += ( *Jy3D_s )( i, j, k );
-                    }
-        }
-        if( Jz_s[ispec] ) {
-            Field3D *Jz3D_s  = static_cast<Field3D *>( Jz_s[ispec] );
-            for( unsigned int i=0 ; i<Jz3D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<Jz3D->dims_[1] ; j++ )
-                    for( unsigned int k=0 ; k<Jz3D->dims_[2] ; k++ ) {
-                        ( *Jz3D )( i, j, k ) += ( *Jz3D_s )( i, j, k );
-                    }
-        }
-        if( rho_s[ispec] ) {
-            Field3D *rho3D_s  = static_cast<Field3D *>( rho_s[ispec] );
-            for( unsigned int i=0 ; i<rho3D->dims_[0] ; i++ )
-                for( unsigned int j=0 ; j<rho3D->dims_[1] ; j++ )
-                    for( unsigned int k=0 ; k<rho3D->dims_[2] ; k++ ) {
-                        ( *rho3D )( i, j, k ) += ( *rho3D_s )( i, j, k );
-                    }
-        }
-        
-    }//END loop on species ispec
-//END computeTotalRhoJ
-}
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Compute the total susceptibility from species susceptibility
@@ -15,6 +15,9 @@ public:
     ElectroMagn3D( Params &params, DomainDecomposition *domain_decomposition, std::vector<Species *> &vecSpecies, Patch *patch );
     ElectroMagn3D( ElectroMagn3D *emFields, Params &params, Patch *patch );
     
+    //! Zero the fields in place, for a patch reused elsewhere by the moving window
+    void recycle( Params &params, Patch *patch ) override;
+    
     //! Destructor for ElectroMagn3D
     ~ElectroMagn3D();
     
@@ -105,8 +108,6 @@ public:
     //! Creates a new field with the right characteristics, depending on the name
     Field *createField( std::string fieldname, Params& params );
     
-    //! Method used to compute the total charge density and currents by summing over all species
-    void computeTotalRhoJ();
     void addToGlobalRho( int ispec, unsigned int clrw );
     
     //! Method used to compute the total susceptibility by summing over all species
@@ -179,16 +180,16 @@ public:
     void initAntennas( Patch* patch, Params& params );
     
     //! from smpi is ymax
-    const bool isYmin;
+    bool isYmin;
     
     //! from smpi is ymin
-    const bool isYmax;
+    bool isYmax;
     
     //! from smpi is zmax
-    const bool isZmax;
+    bool isZmax;
     
     //! from smpi is zmin
-    const bool isZmin;
+    bool isZmin;
     
 private:
 
@@ -250,48 +250,7 @@ void ElectroMagnAM::initElectroMagnAMQuantities( Params &params, Patch *patch )
     
     
     // Define limits of non duplicated elements
-    // (by construction 1 (prim) or 2 (dual) elements shared between per MPI process)
-    // istart
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = 0;
-        }
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            istart[i][isDual] = oversize[i];
-            if( patch->Pcoordinates[i]!=0 ) {
-                istart[i][isDual]+=1;
-            }
-        }
-    }
-    
-    // bufsize = nelements
-    for( unsigned int i=0 ; i<3 ; i++ )
-        for( unsigned int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = 1;
-        }
-        
-    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] = n_space[i] + 1;
-        }
-        
-        for( int isDual=0 ; isDual<2 ; isDual++ ) {
-            bufsize[i][isDual] += isDual;
-            if( params.number_of_patches[i]!=1 ) {
-            
-                if( ( !isDual ) && ( patch->Pcoordinates[i]!=0 ) ) {
-                    bufsize[i][isDual]--;
-                } else if( isDual ) {
-                    bufsize[i][isDual]--;
-                    if( ( patch->Pcoordinates[i]!=0 ) && ( patch->Pcoordinates[i]!=params.number_of_patches[i]-1 ) ) {
-                        bufsize[i][isDual]--;
-                    }
-                }
-                
-            } // if ( params.number_of_patches[i]!=1 )
-        } // for (int isDual=0 ; isDual
-    } // for (unsigned int i=0 ; i<nDim_field
+    initNonDuplicatedLimits( params, patch );
 }
 
 
@@ -377,6 +336,28 @@ ElectroMagnAM::~ElectroMagnAM()
 }//END ElectroMagnAM
 
 
+void ElectroMagnAM::firstTouch()
+{
+    for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
+        cField2D *fields[13] = { El_[imode], Er_[imode], Et_[imode], Bl_[imode], Br_[imode], Bt_[imode],
+                                 Bl_m[imode], Br_m[imode], Bt_m[imode], Jl_[imode], Jr_[imode], Jt_[imode], rho_AM_[imode] };
+        for( unsigned int ifield=0; ifield<13; ifield++ ) {
+            if( fields[ifield] ) {
+                fields[ifield]->firstTouch();
+            }
+        }
+    }
+    for( unsigned int ispec=0 ; ispec < n_species*nmodes ; ispec++ ) {
+        cField2D *species_fields[4] = { Jl_s[ispec], Jr_s[ispec], Jt_s[ispec], rho_AM_s[ispec] };
+        for( unsigned int ifield=0; ifield<4; ifield++ ) {
+            if( species_fields[ifield] ) {
+                species_fields[ifield]->firstTouch();
+            }
+        }
+    }
+    ElectroMagn::firstTouch();
+}
+
 void ElectroMagnAM::restartRhoJ()
 {
     for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
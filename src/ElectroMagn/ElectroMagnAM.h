@@ -41,6 +41,7 @@ public:
     std::vector<cField2D *> rho_AM_s;
     void restartRhoJ() override;
     void restartRhoJs() override;
+    void firstTouch() override;
     
     // fields for Poisson solver
     cField2D *El_Poisson_;
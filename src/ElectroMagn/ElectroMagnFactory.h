@@ -204,16 +204,6 @@ public:
     
     static ElectroMagn *clone( ElectroMagn *EMfields, Params &params, std::vector<Species *> &vecSpecies,  Patch *patch, unsigned int n_moved )
     {
-        // Workaround for a Laser bug
-        // count laser for later
-        int nlaser_tot( 0 );
-        for( int iBC=0; iBC<2; iBC++ ) { // xmax and xmin
-            if( ! EMfields->emBoundCond[iBC] ) {
-                continue;
-            }
-            nlaser_tot += EMfields->emBoundCond[iBC]->vecLaser.size();
-        }
-        
         ElectroMagn *newEMfields = NULL;
         if( params.geometry == "1Dcartesian" ) {
             newEMfields = new ElectroMagn1D( static_cast<ElectroMagn1D *>( EMfields ), params, patch );
@@ -246,29 +236,7 @@ public:
         // -----------------
         // Clone Lasers properties
         // -----------------
-        if( nlaser_tot>0 ) {
-            int nlaser;
-            for( int iBC=0; iBC<2; iBC++ ) { // xmax and xmin
-                if( ! newEMfields->emBoundCond[iBC] ) {
-                    continue;
-                }
-                
-                newEMfields->emBoundCond[iBC]->vecLaser.resize( 0 );
-                nlaser = EMfields->emBoundCond[iBC]->vecLaser.size();
-                // Create lasers one by one
-                for( int ilaser = 0; ilaser < nlaser; ilaser++ ) {
-                    // Create laser
-                    Laser *laser = new Laser( EMfields->emBoundCond[iBC]->vecLaser[ilaser], params );
-                    // If patch is on border, then fill the fields arrays
-                    if( ( iBC==0 && patch->isXmin() )
-                            || ( iBC==1 && patch->isXmax() ) ) {
-                        laser->createFields( params, patch );
-                    }
-                    // Append the laser to the vector
-                    newEMfields->emBoundCond[iBC]->vecLaser.push_back( laser );
-                }
-            }
-        }
+        cloneLasers( EMfields, newEMfields, params, patch );
         
         // -----------------
         // Clone ExternalFields properties
@@ -317,6 +285,51 @@ public:
         return newEMfields;
     }
     
+    // Reuse the fields of a patch which left the moving window for the arriving patch
+    static void recycle( ElectroMagn *EMfields, ElectroMagn *model, Params &params, Patch *patch )
+    {
+        EMfields->recycle( params, patch );
+        cloneLasers( model, EMfields, params, patch );
+    }
+    
+    // Copy the lasers of EMfields into the (new) boundary conditions of newEMfields
+    static void cloneLasers( ElectroMagn *EMfields, ElectroMagn *newEMfields, Params &params, Patch *patch )
+    {
+        // Workaround for a Laser bug
+        // count laser for later
+        int nlaser_tot( 0 );
+        for( int iBC=0; iBC<2; iBC++ ) { // xmax and xmin
+            if( ! EMfields->emBoundCond[iBC] ) {
+                continue;
+            }
+            nlaser_tot += EMfields->emBoundCond[iBC]->vecLaser.size();
+        }
+        
+        if( nlaser_tot>0 ) {
+            int nlaser;
+            for( int iBC=0; iBC<2; iBC++ ) { // xmax and xmin
+                if( ! newEMfields->emBoundCond[iBC] ) {
+                    continue;
+                }
+                
+                newEMfields->emBoundCond[iBC]->vecLaser.resize( 0 );
+                nlaser = EMfields->emBoundCond[iBC]->vecLaser.size();
+                // Create lasers one by one
+                for( int ilaser = 0; ilaser < nlaser; ilaser++ ) {
+                    // Create laser
+                    Laser *laser = new Laser( EMfields->emBoundCond[iBC]->vecLaser[ilaser], params );
+                    // If patch is on border, then fill the fields arrays
+                    if( ( iBC==0 && patch->isXmin() )
+                            || ( iBC==1 && patch->isXmax() ) ) {
+                        laser->createFields( params, patch );
+                    }
+                    // Append the laser to the vector
+                    newEMfields->emBoundCond[iBC]->vecLaser.push_back( laser );
+                }
+            }
+        }
+    }
+    
 };
 
 #endif
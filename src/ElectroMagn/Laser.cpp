@@ -264,6 +264,7 @@ LaserProfileSeparable::LaserProfileSeparable(
 {
     space_envelope = NULL;
     phase = NULL;
+    uniform_phase_ = false;
 }
 // Separable laser profile cloning constructor
 LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
@@ -277,6 +278,7 @@ LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
 {
     space_envelope = NULL;
     phase = NULL;
+    uniform_phase_ = false;
 }
 // Separable laser profile destructor
 LaserProfileSeparable::~LaserProfileSeparable()
@@ -374,13 +376,15 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
         dim[0] = primal_ ? ny_p : ny_d;
 
         // Assign profile
-        vector<double> pos( 1 );
-        pos[0] = patch->getDomainLocalMin( 1 ) - ( ( primal_?0.:0.5 ) + oversize[1] )*dy;
+        vector<double> y( dim[0] );
+        double pos = patch->getDomainLocalMin( 1 ) - ( ( primal_?0.:0.5 ) + oversize[1] )*dy;
         for( unsigned int j=0 ; j<dim[0] ; j++ ) {
-            ( *space_envelope )( j, 0 ) = spaceProfile_->valueAt( pos );
-            ( *phase )( j, 0 ) = phaseProfile_->valueAt( pos );
-            pos[0] += dy;
+            y[j] = pos;
+            pos += dy;
         }
+        vector<double *> yp( 1, &y[0] );
+        spaceProfile_->valuesAt( yp, dim[0], space_envelope->data() );
+        phaseProfile_->valuesAt( yp, dim[0], phase->data() );
 
     } else if( params.geometry=="AMcylindrical" ) {
     
@@ -391,12 +395,13 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
         dim[0] = nr_p + nr_d; // Need to account for both primal and dual positions
 
         // Assign profile
-        vector<double> pos( 1 );
+        vector<double> r( dim[0] );
         for( unsigned int j=0 ; j<dim[0] ; j++ ) {
-            pos[0] = patch->getDomainLocalMin( 1 ) + ( j*0.5 - 0.5 - oversize[1] )*dr ; // Increment half cells
-            ( *space_envelope )( j, 0 ) = spaceProfile_->valueAt( pos );
-            ( *phase )( j, 0 ) = phaseProfile_->valueAt( pos );
+            r[j] = patch->getDomainLocalMin( 1 ) + ( j*0.5 - 0.5 - oversize[1] )*dr ; // Increment half cells
         }
+        vector<double *> rp( 1, &r[0] );
+        spaceProfile_->valuesAt( rp, dim[0], space_envelope->data() );
+        phaseProfile_->valuesAt( rp, dim[0], phase->data() );
 
     } else if( params.geometry=="3Dcartesian" ) {
         unsigned int ny_p = n_space[1]+1+2*oversize[1];
@@ -409,23 +414,38 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
         dim[0] = primal_ ? ny_p : ny_d;
         dim[1] = primal_ ? nz_d : nz_p;
 
-        // Assign profile
+        // Assign profile, evaluated at once on all the points of the boundary
+        unsigned int size = dim[0]*dim[1];
+        vector<double> y( size ), z( size );
         vector<double> pos( 2 );
         pos[0] = patch->getDomainLocalMin( 1 ) - ( ( primal_?0.:0.5 ) + oversize[1] )*dy;
         for( unsigned int j=0 ; j<dim[0] ; j++ ) {
             pos[1] = patch->getDomainLocalMin( 2 ) - ( ( primal_?0.5:0. ) + oversize[2] )*dz;
             for( unsigned int k=0 ; k<dim[1] ; k++ ) {
-                ( *space_envelope )( j, k ) = spaceProfile_->valueAt( pos );
-                ( *phase )( j, k ) = phaseProfile_->valueAt( pos );
+                y[j*dim[1]+k] = pos[0];
+                z[j*dim[1]+k] = pos[1];
                 pos[1] += dz;
             }
             pos[0] += dy;
         }
+        vector<double *> yz( 2 );
+        yz[0] = &y[0];
+        yz[1] = &z[0];
+        spaceProfile_->valuesAt( yz, size, space_envelope->data() );
+        phaseProfile_->valuesAt( yz, size, phase->data() );
+    }
+
+    // When the phase is uniform, the time envelope is the same on all the points
+    uniform_phase_ = true;
+    for( unsigned int i=1 ; i<phase->globalDims_ ; i++ ) {
+        if( phase->data()[i] != phase->data()[0] ) {
+            uniform_phase_ = false;
+        }
     }
 }
 
 // Amplitude of a separable laser profile
-double LaserProfileSeparable::getAmplitude( std::vector<double> pos, double t, int j, int k )
+double LaserProfileSeparable::getAmplitude( const std::vector<double> &pos, double t, int j, int k )
 {
     double amp;
     #pragma omp critical
@@ -530,8 +550,38 @@ void LaserProfileFile::initFields( Params &params, Patch *patch )
     }
 }
 
+// Amplitudes of a separable laser profile on all the boundary points: the space envelope and the phase
+// are tabulated, so that only the chirp and time profiles are evaluated
+void LaserProfileSeparable::addAmplitudes( double t, double *amplitudes )
+{
+    unsigned int size = space_envelope->globalDims_;
+    double *envelope = space_envelope->data();
+    double *phi = phase->data();
+    if( uniform_phase_ ) {
+        double omega, time_envelope;
+        #pragma omp critical
+        {
+            omega = omega_ * chirpProfile_->valueAt( t );
+            time_envelope = timeProfile_->valueAt( t-( phi[0]+delay_phase_ )/omega );
+        }
+        double oscillation = sin( omega*t - phi[0] );
+        #pragma omp simd
+        for( unsigned int i=0 ; i<size ; i++ ) {
+            amplitudes[i] += time_envelope * envelope[i] * oscillation;
+        }
+    } else {
+        #pragma omp critical
+        {
+            double omega = omega_ * chirpProfile_->valueAt( t );
+            for( unsigned int i=0 ; i<size ; i++ ) {
+                amplitudes[i] += timeProfile_->valueAt( t-( phi[i]+delay_phase_ )/omega ) * envelope[i] * sin( omega*t - phi[i] );
+            }
+        }
+    }
+}
+
 // Amplitude of a laser profile from a file (see LaserOffset)
-double LaserProfileFile::getAmplitude( std::vector<double> pos, double t, int j, int k )
+double LaserProfileFile::getAmplitude( const std::vector<double> &pos, double t, int j, int k )
 {
     double amp = 0;
     unsigned int n = omega.size();
@@ -24,15 +24,23 @@ class LaserProfile
 public:
     LaserProfile() {};
     virtual ~LaserProfile() {};
-    virtual double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    virtual double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     };
-    virtual std::complex<double> getAmplitudecomplex( std::vector<double> pos, double t, int j, int k )
+    virtual std::complex<double> getAmplitudecomplex( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     };
 
+    //! Number of boundary points where the amplitude is tabulated (0 if not tabulated)
+    virtual unsigned int tabulatedSize()
+    {
+        return 0;
+    };
+    //! Add the amplitude at time t to all the tabulated boundary points
+    virtual void addAmplitudes( double t, double *amplitudes ) {};
+
     virtual std::string getInfo()
     {
         return "?";
@@ -59,17 +67,34 @@ public:
     void clean();
     
     //! Gets the amplitude from both time and space profiles (By)
-    inline double getAmplitude0( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude0( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[0]->getAmplitude( pos, t, j, k );
     }
     //! Gets the amplitude from both time and space profiles (Bz)
-    inline double getAmplitude1( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude1( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[1]->getAmplitude( pos, t, j, k );
     }
 
-    inline std::complex<double> getAmplitudecomplexN( std::vector<double> pos, double t, int j, int k, int imode )
+    //! Whether the amplitudes of both profiles are tabulated on size0 and size1 boundary points.
+    //! In that case, addAmplitudes0 and addAmplitudes1 replace the point-by-point getAmplitude0 and getAmplitude1.
+    inline bool isTabulated( unsigned int size0, unsigned int size1 )
+    {
+        return profiles[0]->tabulatedSize() == size0 && profiles[1]->tabulatedSize() == size1;
+    }
+    //! Adds the amplitudes (By) at time t to all the boundary points, in the layout of the tabulated envelope
+    inline void addAmplitudes0( double t, double *amplitudes )
+    {
+        profiles[0]->addAmplitudes( t, amplitudes );
+    }
+    //! Adds the amplitudes (Bz) at time t to all the boundary points, in the layout of the tabulated envelope
+    inline void addAmplitudes1( double t, double *amplitudes )
+    {
+        profiles[1]->addAmplitudes( t, amplitudes );
+    }
+
+    inline std::complex<double> getAmplitudecomplexN( const std::vector<double> &pos, double t, int j, int k, int imode )
     {
         return profiles[imode]->getAmplitudecomplex( pos, t, j, k );
     }
@@ -118,10 +143,17 @@ public:
     ~LaserProfileSeparable();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    double getAmplitude( const std::vector<double> &pos, double t, int j, int k );
+    unsigned int tabulatedSize()
+    {
+        return space_envelope ? space_envelope->globalDims_ : 0;
+    };
+    void addAmplitudes( double t, double *amplitudes );
 protected:
     Field *space_envelope, *phase;
 private:
+    //! Whether the phase is the same on all the boundary points of the patch
+    bool uniform_phase_;
     bool primal_;
     double omega_;
     Profile *timeProfile_, *chirpProfile_, *spaceProfile_, *phaseProfile_;
@@ -138,7 +170,7 @@ public:
     LaserProfileNonSeparable( LaserProfileNonSeparable *lp )
         : spaceAndTimeProfile_( new Profile( lp->spaceAndTimeProfile_ ) ) {};
     ~LaserProfileNonSeparable();
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         double amp;
         #pragma omp critical
@@ -146,7 +178,7 @@ public:
         return amp;
     }
 
-    inline std::complex<double> getAmplitudecomplex( std::vector<double> pos, double t, int j, int k )
+    inline std::complex<double> getAmplitudecomplex( const std::vector<double> &pos, double t, int j, int k )
     {
         std::complex<double> amp;
         #pragma omp critical
@@ -171,7 +203,7 @@ public:
     ~LaserProfileFile();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    double getAmplitude( const std::vector<double> &pos, double t, int j, int k );
 protected:
     Field3D *magnitude, *phase;
     std::vector<double> omega;
@@ -188,7 +220,7 @@ public:
     LaserProfileNULL() {};
     ~LaserProfileNULL() {};
     
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     }
@@ -214,20 +214,25 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         Field2D *Bz2D = static_cast<Field2D *>( EMfields->Bz_ );
         
         // for By^(d,p)
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        vector<double> byW( ny_p, 0. );
         vector<double> yp( 1 );
-        for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
-        
-            double byW = 0.;
-            yp[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                byW += vecLaser[ilaser]->getAmplitude0( yp, time_dual, j, 0 );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p, ny_d ) ) {
+                vecLaser[ilaser]->addAmplitudes0( time_dual, &byW[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
+                yp[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
+                byW[j] += vecLaser[ilaser]->getAmplitude0( yp, time_dual, j, 0 );
             }
+        }
+        
+        for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
             
             ( *By2D )( 0, j ) = Alpha_SM_W   * ( *Ez2D )( 0, j )
                                            +              Beta_SM_W    *( ( *By2D )( 1, j )-By_val[j] )
-                                           +              Gamma_SM_W   * byW
+                                           +              Gamma_SM_W   * byW[j]
                                            +              Delta_SM_W   *( ( *Bx2D )( 0, j+1 )-Bx_val[j+1] )
                                            +              Epsilon_SM_W *( ( *Bx2D )( 0, j )-Bx_val[j] )
                                            +              By_val[j];
@@ -236,23 +241,28 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         
         
         // for Bz^(d,d)
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        vector<double> bzW( ny_d, 0. );
         vector<double> yd( 1 );
-        for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
-        
-            double bzW = 0.;
-            yd[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                bzW += vecLaser[ilaser]->getAmplitude1( yd, time_dual, j, 0 );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p, ny_d ) ) {
+                vecLaser[ilaser]->addAmplitudes1( time_dual, &bzW[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
+                yd[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
+                bzW[j] += vecLaser[ilaser]->getAmplitude1( yd, time_dual, j, 0 );
             }
+        }
+        
+        for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
             
             /*(*Bz2D)(0,j) = -Alpha_SM_W * (*Ey2D)(0,j)
              +               Beta_SM_W  * (*Bz2D)(1,j)
              +               Gamma_SM_W * bzW;*/
             ( *Bz2D )( 0, j ) = -Alpha_SM_W * ( *Ey2D )( 0, j )
                                            +               Beta_SM_W  *( ( *Bz2D )( 1, j )- Bz_val[j] )
-                                           +               Gamma_SM_W * bzW
+                                           +               Gamma_SM_W * bzW[j]
                                            +               Bz_val[j];
                                            
         }//j  ---end compute Bz
@@ -268,16 +278,21 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         Field2D *Bz2D = static_cast<Field2D *>( EMfields->Bz_ );
         
         // for By^(d,p)
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        vector<double> byE( ny_p, 0. );
         vector<double> yp( 1 );
-        for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
-        
-            double byE = 0.;
-            yp[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                byE += vecLaser[ilaser]->getAmplitude0( yp, time_dual, j, 0 );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p, ny_d ) ) {
+                vecLaser[ilaser]->addAmplitudes0( time_dual, &byE[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
+                yp[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
+                byE[j] += vecLaser[ilaser]->getAmplitude0( yp, time_dual, j, 0 );
             }
+        }
+        
+        for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
             
             /*(*By2D)(nx_d-1,j) = Alpha_SM_E   * (*Ez2D)(nx_p-1,j)
              +                   Beta_SM_E    * (*By2D)(nx_d-2,j)
@@ -286,7 +301,7 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
              +                   Epsilon_SM_E * (*Bx2D)(nx_p-1,j);*/
             ( *By2D )( nx_d-1, j ) = Alpha_SM_E   * ( *Ez2D )( nx_p-1, j )
                                                 +                   Beta_SM_E    *( ( *By2D )( nx_d-2, j ) -By_val[j] )
-                                                +                   Gamma_SM_E   * byE
+                                                +                   Gamma_SM_E   * byE[j]
                                                 +                   Delta_SM_E   *( ( *Bx2D )( nx_p-1, j+1 ) -Bx_val[j+1] ) // Check x-index
                                                 +                   Epsilon_SM_E *( ( *Bx2D )( nx_p-1, j ) -Bx_val[j] )
                                                 +                   By_val[j];
@@ -295,23 +310,28 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         
         
         // for Bz^(d,d)
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        vector<double> bzE( ny_d, 0. );
         vector<double> yd( 1 );
-        for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
-        
-            double bzE = 0.;
-            yd[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                bzE += vecLaser[ilaser]->getAmplitude1( yd, time_dual, j, 0 );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p, ny_d ) ) {
+                vecLaser[ilaser]->addAmplitudes1( time_dual, &bzE[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
+                yd[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
+                bzE[j] += vecLaser[ilaser]->getAmplitude1( yd, time_dual, j, 0 );
             }
+        }
+        
+        for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
             
             /*(*Bz2D)(nx_d-1,j) = -Alpha_SM_E * (*Ey2D)(nx_p-1,j)
              +                    Beta_SM_E  * (*Bz2D)(nx_d-2,j)
              +                    Gamma_SM_E * bzE;*/
             ( *Bz2D )( nx_d-1, j ) = -Alpha_SM_E * ( *Ey2D )( nx_p-1, j )
                                                 +                    Beta_SM_E  *( ( *Bz2D )( nx_d-2, j ) -Bz_val[j] )
-                                                +                    Gamma_SM_E * bzE
+                                                +                    Gamma_SM_E * bzE[j]
                                                 +                    Bz_val[j];
                                                 
         }//j  ---end compute Bz
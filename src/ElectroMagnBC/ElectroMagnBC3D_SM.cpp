@@ -331,12 +331,16 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     if( min_max==0 && patch->isXmin() ) {
     
         // for By^(d,p,d)
-        for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
-            pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k -0.5 - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p*nz_d, ny_d*nz_p ) ) {
+                vecLaser[ilaser]->addAmplitudes0( time_dual, &byW[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
+                pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
+                for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
+                    pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k -0.5 - ( int )EMfields->oversize[2] )*dz;
                     byW[ j*nz_d+k ] += vecLaser[ilaser]->getAmplitude0( pos, time_dual, j, k );
                 }
             }
@@ -354,12 +358,16 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         }//j  ---end compute By
         
         // for Bz^(d,d,p)
-        for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
-            pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p*nz_d, ny_d*nz_p ) ) {
+                vecLaser[ilaser]->addAmplitudes1( time_dual, &bzW[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
+                pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
+                for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
+                    pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - ( int )EMfields->oversize[2] )*dz;
                     bzW[ j*nz_p+k ] += vecLaser[ilaser]->getAmplitude1( pos, time_dual, j, k );
                 }
             }
@@ -378,12 +386,16 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     } else if( min_max==1 && patch->isXmax() ) {
     
         // for By^(d,p,d)
-        for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
-            pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - 0.5 - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p*nz_d, ny_d*nz_p ) ) {
+                vecLaser[ilaser]->addAmplitudes0( time_dual, &byE[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
+                pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
+                for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
+                    pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - 0.5 - ( int )EMfields->oversize[2] )*dz;
                     byE[ j*nz_d+k ] += vecLaser[ilaser]->getAmplitude0( pos, time_dual, j, k );
                 }
             }
@@ -401,12 +413,16 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         }//j  ---end compute By
         
         // for Bz^(d,d,p)
-        for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax(); j++ ) {
-            pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+        // Lasers: the tabulated profiles are added on all the points at once, the others point by point
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->isTabulated( ny_p*nz_d, ny_d*nz_p ) ) {
+                vecLaser[ilaser]->addAmplitudes1( time_dual, &bzE[0] );
+                continue;
+            }
+            for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax(); j++ ) {
+                pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
+                for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
+                    pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - ( int )EMfields->oversize[2] )*dz;
                     bzE[ j*nz_p+k ] += vecLaser[ilaser]->getAmplitude1( pos, time_dual, j, k );
                 }
             }
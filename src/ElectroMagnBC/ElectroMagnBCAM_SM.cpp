@@ -171,6 +171,20 @@ void ElectroMagnBCAM_SM::disableExternalFields()
 void ElectroMagnBCAM_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *patch )
 {
 
+    // Separable lasers contribute to the mode 1 only. The amplitudes of those with tabulated profiles are
+    // computed at once on all the radial points (primal points at odd indices, dual points at even indices)
+    vector<double> amplitude0( nr_p+nr_d, 0. ), amplitude1( nr_p+nr_d, 0. );
+    vector<bool> tabulated( vecLaser.size(), false );
+    if( Nmode > 1 && ( ( min_max == 0 && patch->isXmin() ) || ( min_max == 1 && patch->isXmax() ) ) ) {
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            if( vecLaser[ilaser]->spacetime.size() <= 2 && vecLaser[ilaser]->isTabulated( nr_p+nr_d, nr_p+nr_d ) ) {
+                tabulated[ilaser] = true;
+                vecLaser[ilaser]->addAmplitudes0( time_dual, &amplitude0[0] );
+                vecLaser[ilaser]->addAmplitudes1( time_dual, &amplitude1[0] );
+            }
+        }
+    }
+
     // Loop on imode
     for( unsigned int imode=0 ; imode<Nmode ; imode++ ) {
         // Static cast of the fields
@@ -194,12 +208,15 @@ void ElectroMagnBCAM_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
                     if (vecLaser[ilaser]->spacetime.size() > 2){
                         byW +=          vecLaser[ilaser]->getAmplitudecomplexN(yp, time_dual, 0, 0, 2*imode);
                     } else {                        
-                        if( imode==1 ) {
+                        if( imode==1 && !tabulated[ilaser] ) {
                             byW +=          vecLaser[ilaser]->getAmplitude0( yp, time_dual, 1+2*j, 0 )
                                             + Icpx * vecLaser[ilaser]->getAmplitude1( yp, time_dual, 1+2*j, 0 );
                         }
                     }
                 }
+                if( imode==1 ) {
+                    byW += amplitude0[1+2*j] + Icpx * amplitude1[1+2*j];
+                }
                 
                 //x= Xmin
                 unsigned int i=0;
@@ -221,12 +238,15 @@ void ElectroMagnBCAM_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
                     if (vecLaser[ilaser]->spacetime.size() > 2){
                         bzW +=          vecLaser[ilaser]->getAmplitudecomplexN(yd, time_dual, 0, 0, 2*imode+1);
                     } else {                        
-                        if( imode==1 ) {
+                        if( imode==1 && !tabulated[ilaser] ) {
                             bzW +=          vecLaser[ilaser]->getAmplitude1( yd, time_dual, 2*j, 0 )
                                            - Icpx * vecLaser[ilaser]->getAmplitude0( yd, time_dual, 2*j, 0 );
                         }
                     }
                 }
+                if( imode==1 ) {
+                    bzW += amplitude1[2*j] - Icpx * amplitude0[2*j];
+                }
                 //x=Xmin
                 unsigned int i=0;
                 ( *Bt )( i, j ) = -Alpha_SM_Xmin * ( *Er )( i, j )
@@ -252,9 +272,12 @@ void ElectroMagnBCAM_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
                 if( imode==1 ) {
                     yp[0] = patch->getDomainLocalMin( 1 ) + ( (double)j - (double)EMfields->oversize[1] )*dr;
                     for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                        byE +=          vecLaser[ilaser]->getAmplitude0( yp, time_dual, 1+2*j, 0 )
-                                        + Icpx * vecLaser[ilaser]->getAmplitude1( yp, time_dual, 1+2*j, 0 );
+                        if( !tabulated[ilaser] ) {
+                            byE +=          vecLaser[ilaser]->getAmplitude0( yp, time_dual, 1+2*j, 0 )
+                                            + Icpx * vecLaser[ilaser]->getAmplitude1( yp, time_dual, 1+2*j, 0 );
+                        }
                     }
+                    byE += amplitude0[1+2*j] + Icpx * amplitude1[1+2*j];
                 }
                 unsigned int i= nl_p;
                 ( *Br )( i, j ) = - Alpha_SM_Xmax   * ( *Et )( i-1, j )
@@ -273,9 +296,12 @@ void ElectroMagnBCAM_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
                     yd[0] = patch->getDomainLocalMin( 1 ) + ( (double)j - 0.5  - (double)EMfields->oversize[1] )*dr;
                     // Lasers
                     for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                        bzE +=         vecLaser[ilaser]->getAmplitude1( yd, time_dual, 2*j, 0 )
-                                       -Icpx * vecLaser[ilaser]->getAmplitude0( yd, time_dual, 2*j, 0 );
+                        if( !tabulated[ilaser] ) {
+                            bzE +=         vecLaser[ilaser]->getAmplitude1( yd, time_dual, 2*j, 0 )
+                                           -Icpx * vecLaser[ilaser]->getAmplitude0( yd, time_dual, 2*j, 0 );
+                        }
                     }
+                    bzE += amplitude1[2*j] - Icpx * amplitude0[2*j];
                 }
                 unsigned int i= nl_p;
                 ( *Bt )( i, j ) = Alpha_SM_Xmax * ( *Er )( i-1, j )
@@ -0,0 +1,134 @@
+
+#include "MAMF_Solver3D_Yee.h"
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+
+#include <algorithm>
+
+// Cache budget for one tile (two x planes of all the field rows touched by the update)
+#define MAMF_TILE_BYTES 262144
+
+MAMF_Solver3D_Yee::MAMF_Solver3D_Yee( Params &params )
+    : Solver3D( params )
+{
+    // 9 rows read (E, B, J) and 6 rows written (E, B) per y index, on the current and previous x planes
+    unsigned int row_bytes = 2 * 15 * nz_d * sizeof( double );
+    ny_tile = std::max( 1u, std::min( ny_d, ( unsigned int )( MAMF_TILE_BYTES / row_bytes ) ) );
+}
+
+MAMF_Solver3D_Yee::~MAMF_Solver3D_Yee()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Advance E (Maxwell-Ampere) then B (Maxwell-Faraday) in a single pass.
+// The E update at (i,j) reads B at (i,j), (i+1,j) and (i,j+1), the B update at (i,j) reads E at (i,j), (i-1,j)
+// and (i,j-1). Sweeping y tiles, then x, then y rows in the tile, and updating the E row before the B row,
+// therefore gives exactly the same result as the two separate sweeps of MA_Solver3D_norm and MF_Solver3D_Yee.
+// ---------------------------------------------------------------------------------------------------------------------
+void MAMF_Solver3D_Yee::operator()( ElectroMagn *fields )
+{
+    double *const Ex3D = &( fields->Ex_->data_[0] );
+    double *const Ey3D = &( fields->Ey_->data_[0] );
+    double *const Ez3D = &( fields->Ez_->data_[0] );
+    double *const Bx3D = &( fields->Bx_->data_[0] );
+    double *const By3D = &( fields->By_->data_[0] );
+    double *const Bz3D = &( fields->Bz_->data_[0] );
+    const double *const Jx3D = &( fields->Jx_->data_[0] );
+    const double *const Jy3D = &( fields->Jy_->data_[0] );
+    const double *const Jz3D = &( fields->Jz_->data_[0] );
+
+    // Strides of each component (x, y)
+    const unsigned int sEx = ny_p*nz_p, sEy = ny_d*nz_p, sEz = ny_p*nz_d;
+    const unsigned int sBx = ny_d*nz_d, sBy = ny_p*nz_d, sBz = ny_d*nz_p;
+
+    for( unsigned int j0=0 ; j0<ny_d ; j0+=ny_tile ) {
+        const unsigned int j1 = std::min( j0+ny_tile, ny_d );
+        for( unsigned int i=0 ; i<nx_d ; i++ ) {
+            for( unsigned int j=j0 ; j<j1 ; j++ ) {
+
+                // Electric field Ex^(d,p,p)
+                if( j<ny_p ) {
+                    double *__restrict__ Ex = Ex3D + i*sEx + j*nz_p;
+                    const double *__restrict__ Jx = Jx3D + i*sEx + j*nz_p;
+                    const double *__restrict__ Bz0 = Bz3D + i*sBz + j*nz_p;
+                    const double *__restrict__ Bz1 = Bz0 + nz_p;
+                    const double *__restrict__ By0 = By3D + i*sBy + j*nz_d;
+                    #pragma omp simd
+                    for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                        Ex[k] += -dt*Jx[k] + dt_ov_dy * ( Bz1[k] - Bz0[k] ) - dt_ov_dz * ( By0[k+1] - By0[k] );
+                    }
+                }
+
+                if( i<nx_p ) {
+                    // Electric field Ey^(p,d,p)
+                    double *__restrict__ Ey = Ey3D + i*sEy + j*nz_p;
+                    const double *__restrict__ Jy = Jy3D + i*sEy + j*nz_p;
+                    const double *__restrict__ Bz0 = Bz3D + i*sBz + j*nz_p;
+                    const double *__restrict__ Bz1 = Bz0 + sBz;
+                    const double *__restrict__ Bx0 = Bx3D + i*sBx + j*nz_d;
+                    #pragma omp simd
+                    for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                        Ey[k] += -dt*Jy[k] - dt_ov_dx * ( Bz1[k] - Bz0[k] ) + dt_ov_dz * ( Bx0[k+1] - Bx0[k] );
+                    }
+
+                    // Electric field Ez^(p,p,d)
+                    if( j<ny_p ) {
+                        double *__restrict__ Ez = Ez3D + i*sEz + j*nz_d;
+                        const double *__restrict__ Jz = Jz3D + i*sEz + j*nz_d;
+                        const double *__restrict__ By0 = By3D + i*sBy + j*nz_d;
+                        const double *__restrict__ By1 = By0 + sBy;
+                        const double *__restrict__ Bx1 = Bx0 + nz_d;
+                        #pragma omp simd
+                        for( unsigned int k=0 ; k<nz_d ; k++ ) {
+                            Ez[k] += -dt*Jz[k] + dt_ov_dx * ( By1[k] - By0[k] ) - dt_ov_dy * ( Bx1[k] - Bx0[k] );
+                        }
+                    }
+                }
+
+                const bool j_inner = ( j>=1 ) && ( j<ny_d-1 );
+                const bool i_inner = ( i>=1 ) && ( i<nx_d-1 );
+
+                // Magnetic field Bx^(p,d,d)
+                if( i<nx_p && j_inner ) {
+                    double *__restrict__ Bx = Bx3D + i*sBx + j*nz_d;
+                    const double *__restrict__ Ez1 = Ez3D + i*sEz + j*nz_d;
+                    const double *__restrict__ Ez0 = Ez1 - nz_d;
+                    const double *__restrict__ Ey0 = Ey3D + i*sEy + j*nz_p;
+                    #pragma omp simd
+                    for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                        Bx[k] += -dt_ov_dy * ( Ez1[k] - Ez0[k] ) + dt_ov_dz * ( Ey0[k] - Ey0[k-1] );
+                    }
+                }
+
+                // Magnetic field By^(d,p,d)
+                if( i_inner && j<ny_p ) {
+                    double *__restrict__ By = By3D + i*sBy + j*nz_d;
+                    const double *__restrict__ Ex0 = Ex3D + i*sEx + j*nz_p;
+                    const double *__restrict__ Ez1 = Ez3D + i*sEz + j*nz_d;
+                    const double *__restrict__ Ez0 = Ez1 - sEz;
+                    #pragma omp simd
+                    for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                        By[k] += -dt_ov_dz * ( Ex0[k] - Ex0[k-1] ) + dt_ov_dx * ( Ez1[k] - Ez0[k] );
+                    }
+                }
+
+                // Magnetic field Bz^(d,d,p)
+                if( i_inner && j_inner ) {
+                    double *__restrict__ Bz = Bz3D + i*sBz + j*nz_p;
+                    const double *__restrict__ Ey1 = Ey3D + i*sEy + j*nz_p;
+                    const double *__restrict__ Ey0 = Ey1 - sEy;
+                    const double *__restrict__ Ex1 = Ex3D + i*sEx + j*nz_p;
+                    const double *__restrict__ Ex0 = Ex1 - nz_p;
+                    #pragma omp simd
+                    for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                        Bz[k] += -dt_ov_dx * ( Ey1[k] - Ey0[k] ) + dt_ov_dy * ( Ex1[k] - Ex0[k] );
+                    }
+                }
+            }
+        }
+    }
+
+}
+
@@ -0,0 +1,31 @@
+#ifndef MAMF_SOLVER3D_YEE_H
+#define MAMF_SOLVER3D_YEE_H
+
+#include "Solver3D.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MAMF_Solver3D_Yee
+//! Fused Maxwell-Ampere / Maxwell-Faraday Yee solver: E and B are advanced in a single sweep over tiles of y rows,
+//! so that each field row is loaded once from memory for both updates. The innermost z loop is vectorized.
+//! Used in place of MA_Solver3D_norm + MF_Solver3D_Yee when Main.maxwell_kernel = "fused".
+//  --------------------------------------------------------------------------------------------------------------------
+class MAMF_Solver3D_Yee : public Solver3D
+{
+
+public:
+    MAMF_Solver3D_Yee( Params &params );
+    virtual ~MAMF_Solver3D_Yee();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn *fields );
+
+    //! Number of y rows processed together (chosen so that a tile of two x planes fits in L2 cache)
+    unsigned int ny_tile;
+
+protected:
+
+};//END class
+
+#endif
+
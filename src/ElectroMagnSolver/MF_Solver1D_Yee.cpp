@@ -14,6 +14,11 @@ MF_Solver1D_Yee::~MF_Solver1D_Yee()
 }
 
 void MF_Solver1D_Yee::operator()( ElectroMagn *fields )
+{
+    solveBox( fields, 0, nx_d );
+}
+
+void MF_Solver1D_Yee::solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax )
 {
     Field1D *Ey1D   = static_cast<Field1D *>( fields->Ey_ );
     Field1D *Ez1D   = static_cast<Field1D *>( fields->Ez_ );
@@ -26,7 +31,7 @@ void MF_Solver1D_Yee::operator()( ElectroMagn *fields )
     // NB: bx is given in 1d and defined when initializing the fields (here put to 0)
     // Transverse fields  by & bz are defined on the dual grid
     //for (unsigned int ix=1 ; ix<nx_p ; ix++) {
-    for( unsigned int ix=1 ; ix<nx_d-1 ; ix++ ) {
+    for( unsigned int ix=std::max( imin, 1u ) ; ix<std::min( imax, nx_d-1 ) ; ix++ ) {
         ( *By1D )( ix )= ( *By1D )( ix ) + dt_ov_dx * ( ( *Ez1D )( ix ) - ( *Ez1D )( ix-1 ) ) ;
         ( *Bz1D )( ix )= ( *Bz1D )( ix ) - dt_ov_dx * ( ( *Ey1D )( ix ) - ( *Ey1D )( ix-1 ) ) ;
     }
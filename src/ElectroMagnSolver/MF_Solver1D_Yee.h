@@ -19,6 +19,7 @@ public:
     virtual void operator()( ElectroMagn *fields );
     
 protected:
+    void solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax ) override;
 
 };//END class
 
@@ -18,6 +18,11 @@ MF_Solver2D_Yee::~MF_Solver2D_Yee()
 }
 
 void MF_Solver2D_Yee::operator()( ElectroMagn *fields )
+{
+    solveBox( fields, 0, nx_d, 0, ny_d );
+}
+
+void MF_Solver2D_Yee::solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax, unsigned int jmin, unsigned int jmax )
 {
     // Static-cast of the fields
     Field2D *Ex2D;
@@ -34,39 +39,33 @@ void MF_Solver2D_Yee::operator()( ElectroMagn *fields )
     Field2D *By2D = static_cast<Field2D *>( fields->By_ );
     Field2D *Bz2D = static_cast<Field2D *>( fields->Bz_ );
     
+    // Bounds of the box for the components primal (p) or dual (d) along each direction
+    const unsigned int ip_max = std::min( imax, nx_p );
+    const unsigned int id_min = std::max( imin, 1u ), id_max = std::min( imax, nx_d-1 );
+    const unsigned int jp_max = std::min( jmax, ny_p );
+    const unsigned int jd_min = std::max( jmin, 1u ), jd_max = std::min( jmax, ny_d-1 );
+    
     // Magnetic field Bx^(p,d)
-    //cout << "nx_p,nx_d-1" << nx_p << " " << nx_d-1 ;
-    //{
-    {
-        #pragma omp simd
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            ( *Bx2D )( 0, j ) -= dt_ov_dy * ( ( *Ez2D )( 0, j ) - ( *Ez2D )( 0, j-1 ) );
-        }
-    }
-    //    for (unsigned int i=0 ; i<nx_p;  i++) {
-    for( unsigned int i=1 ; i<nx_d-1;  i++ ) {
+    for( unsigned int i=imin ; i<ip_max;  i++ ) {
         #pragma omp simd
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+        for( unsigned int j=jd_min ; j<jd_max ; j++ ) {
             ( *Bx2D )( i, j ) -= dt_ov_dy * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i, j-1 ) );
         }
-        //    }
-        
+    }
+    
+    for( unsigned int i=id_min ; i<id_max;  i++ ) {
         // Magnetic field By^(d,p)
-        //    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+        for( unsigned int j=jmin ; j<jp_max ; j++ ) {
             ( *By2D )( i, j ) += dt_ov_dx * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i-1, j ) );
         }
-        //}
         
         // Magnetic field Bz^(d,d)
-        //for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+        for( unsigned int j=jd_min ; j<jd_max ; j++ ) {
             ( *Bz2D )( i, j ) += dt_ov_dy * ( ( *Ex2D )( i, j ) - ( *Ex2D )( i, j-1 ) )
                                  -               dt_ov_dx * ( ( *Ey2D )( i, j ) - ( *Ey2D )( i-1, j ) );
         }
     }
-    //}// end parallel
 }
 
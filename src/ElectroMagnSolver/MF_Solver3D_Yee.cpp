@@ -14,6 +14,12 @@ MF_Solver3D_Yee::~MF_Solver3D_Yee()
 }
 
 void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
+{
+    solveBox( fields, 0, nx_d, 0, ny_d, 0, nz_d );
+}
+
+void MF_Solver3D_Yee::solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax, unsigned int jmin, unsigned int jmax,
+                                unsigned int kmin, unsigned int kmax )
 {
     // Static-cast of the fields
     double *Ex3D = &(fields->Ex_->data_[0]);
@@ -23,10 +29,18 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     double *By3D = &(fields->By_->data_[0]);
     double *Bz3D = &(fields->Bz_->data_[0]);
     
+    // Bounds of the box for the components primal (p) or dual (d) along each direction
+    const unsigned int ip_max = std::min( imax, nx_p );
+    const unsigned int id_min = std::max( imin, 1u ), id_max = std::min( imax, nx_d-1 );
+    const unsigned int jp_max = std::min( jmax, ny_p );
+    const unsigned int jd_min = std::max( jmin, 1u ), jd_max = std::min( jmax, ny_d-1 );
+    const unsigned int kp_max = std::min( kmax, nz_p );
+    const unsigned int kd_min = std::max( kmin, 1u ), kd_max = std::min( kmax, nz_d-1 );
+    
     // Magnetic field Bx^(p,d,d)
-    for( unsigned int i=0 ; i<nx_p;  i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+    for( unsigned int i=imin ; i<ip_max;  i++ ) {
+        for( unsigned int j=jd_min ; j<jd_max ; j++ ) {
+            for( unsigned int k=kd_min ; k<kd_max ; k++ ) {
                 Bx3D[ i*(ny_d*nz_d) + j*(nz_d) + k ] += -dt_ov_dy * ( Ez3D[ i*(ny_p*nz_d) + j*(nz_d) + k ] - Ez3D[ i*(ny_p*nz_d) + (j-1)*(nz_d) + k   ] )
                                                      +   dt_ov_dz * ( Ey3D[ i*(ny_d*nz_p) + j*(nz_p) + k ] - Ey3D[ i*(ny_d*nz_p) +  j   *(nz_p) + k-1 ] );
             }
@@ -34,9 +48,9 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     }
     
     // Magnetic field By^(d,p,d)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+    for( unsigned int i=id_min ; i<id_max ; i++ ) {
+        for( unsigned int j=jmin ; j<jp_max ; j++ ) {
+            for( unsigned int k=kd_min ; k<kd_max ; k++ ) {
                 By3D[ i*(ny_p*nz_d) + j*(nz_d) + k ] += -dt_ov_dz * ( Ex3D[ i*(ny_p*nz_p) + j*(nz_p) + k ] - Ex3D[  i   *(ny_p*nz_p) + j*(nz_p) + k-1 ] )
                                                      +   dt_ov_dx * ( Ez3D[ i*(ny_p*nz_d) + j*(nz_d) + k ] - Ez3D[ (i-1)*(ny_p*nz_d) + j*(nz_d) + k   ] );
             }
@@ -44,9 +58,9 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     }
     
     // Magnetic field Bz^(d,d,p)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=0 ; k<nz_p ; k++ ) {
+    for( unsigned int i=id_min ; i<id_max ; i++ ) {
+        for( unsigned int j=jd_min ; j<jd_max ; j++ ) {
+            for( unsigned int k=kmin ; k<kp_max ; k++ ) {
                 Bz3D[ i*(ny_d*nz_p) + j*(nz_p) + k ] += -dt_ov_dx * ( Ey3D[ i*(ny_d*nz_p) + j*(nz_p) + k ] - Ey3D[ (i-1)*(ny_d*nz_p) +  j   *(nz_p) + k ] )
                                                      +   dt_ov_dy * ( Ex3D[ i*(ny_p*nz_p) + j*(nz_p) + k ] - Ex3D[  i   *(ny_p*nz_p) + (j-1)*(nz_p) + k ] );
             }
@@ -19,6 +19,8 @@ public:
     virtual void operator()( ElectroMagn *fields );
     
 protected:
+    void solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax, unsigned int jmin, unsigned int jmax,
+                   unsigned int kmin, unsigned int kmax ) override;
 
 };//END class
 
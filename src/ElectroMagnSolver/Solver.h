@@ -23,6 +23,12 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn *fields ) = 0;
     
+    //! Updates only the layers at the borders of the patch: the ghost cells and the cells sent to the neighbours
+    //! (overlap of the exchange of B with the update of the interior, Main.overlap_field_exchange)
+    virtual void updateBorders( ElectroMagn *fields ) {};
+    //! Updates only the cells which are not in these layers
+    virtual void updateInterior( ElectroMagn *fields ) {};
+    
 protected:
 
 };//END class
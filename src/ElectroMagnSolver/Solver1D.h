@@ -1,6 +1,8 @@
 #ifndef SOLVER1D_H
 #define SOLVER1D_H
 
+#include <algorithm>
+
 #include "Solver.h"
 
 //  --------------------------------------------------------------------------------------------------------------------
@@ -18,6 +20,8 @@ public:
             n_space = params.n_space_region;
         nx_p = n_space[0] +1+2*params.oversize[0];
         nx_d = n_space[0] +2+2*params.oversize[0];
+        // Ghost cells and cells sent to the neighbours, on the dual grid
+        border_x = std::min( 2*params.oversize[0]+2, nx_d/2 );
         
         dt = params.timestep;
         dt_ov_dx = params.timestep / params.cell_length[0];
@@ -27,9 +31,23 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn *fields ) = 0;
     
+    void updateBorders( ElectroMagn *fields ) override
+    {
+        solveBox( fields, 0, border_x );
+        solveBox( fields, nx_d-border_x, nx_d );
+    };
+    void updateInterior( ElectroMagn *fields ) override
+    {
+        solveBox( fields, border_x, nx_d-border_x );
+    };
+    
 protected:
+    //! Updates the cells of indices [imin, imax[ on the dual grid (solvers which can update the borders first)
+    virtual void solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax ) {};
+    
     unsigned int nx_p;
     unsigned int nx_d;
+    unsigned int border_x;
     double dt;
     double dt_ov_dx;
     
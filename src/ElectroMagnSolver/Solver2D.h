@@ -1,6 +1,8 @@
 #ifndef SOLVER2D_H
 #define SOLVER2D_H
 
+#include <algorithm>
+
 #include "Solver.h"
 
 //  --------------------------------------------------------------------------------------------------------------------
@@ -25,6 +27,9 @@ public:
         nx_d = n_space[0] +2+2*oversize[0];
         ny_p = n_space[1] +1+2*oversize[1];
         ny_d = n_space[1] +2+2*oversize[1];
+        // Ghost cells and cells sent to the neighbours, on the dual grid
+        border_x = std::min( 2*oversize[0]+2, nx_d/2 );
+        border_y = std::min( 2*oversize[1]+2, ny_d/2 );
 
         dt = params.timestep;
         dt_ov_dx = params.timestep / params.cell_length[0];
@@ -35,11 +40,28 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn *fields ) = 0;
     
+    void updateBorders( ElectroMagn *fields ) override
+    {
+        solveBox( fields, 0, border_x, 0, ny_d );
+        solveBox( fields, nx_d-border_x, nx_d, 0, ny_d );
+        solveBox( fields, border_x, nx_d-border_x, 0, border_y );
+        solveBox( fields, border_x, nx_d-border_x, ny_d-border_y, ny_d );
+    };
+    void updateInterior( ElectroMagn *fields ) override
+    {
+        solveBox( fields, border_x, nx_d-border_x, border_y, ny_d-border_y );
+    };
+    
 protected:
+    //! Updates the cells of indices [imin, imax[ x [jmin, jmax[ on the dual grid (solvers which can update the borders first)
+    virtual void solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax, unsigned int jmin, unsigned int jmax ) {};
+    
     unsigned int nx_p;
     unsigned int nx_d;
     unsigned int ny_p;
     unsigned int ny_d;
+    unsigned int border_x;
+    unsigned int border_y;
     double dt;
     double dt_ov_dy;
     double dt_ov_dx;
@@ -1,6 +1,8 @@
 #ifndef SOLVER3D_H
 #define SOLVER3D_H
 
+#include <algorithm>
+
 #include "Solver.h"
 
 //  --------------------------------------------------------------------------------------------------------------------
@@ -27,6 +29,10 @@ public:
 	ny_d = n_space[1] +2+2*oversize[1]-(params.is_pxr);
 	nz_p = n_space[2] +1+2*oversize[2];
 	nz_d = n_space[2] +2+2*oversize[2]-(params.is_pxr);
+        // Ghost cells and cells sent to the neighbours, on the dual grid
+        border_x = std::min( 2*oversize[0]+2, nx_d/2 );
+        border_y = std::min( 2*oversize[1]+2, ny_d/2 );
+        border_z = std::min( 2*oversize[2]+2, nz_d/2 );
         
         dt = params.timestep;
         dt_ov_dx = params.timestep / params.cell_length[0];
@@ -39,13 +45,35 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn *fields ) = 0;
     
+    void updateBorders( ElectroMagn *fields ) override
+    {
+        solveBox( fields, 0, border_x, 0, ny_d, 0, nz_d );
+        solveBox( fields, nx_d-border_x, nx_d, 0, ny_d, 0, nz_d );
+        solveBox( fields, border_x, nx_d-border_x, 0, border_y, 0, nz_d );
+        solveBox( fields, border_x, nx_d-border_x, ny_d-border_y, ny_d, 0, nz_d );
+        solveBox( fields, border_x, nx_d-border_x, border_y, ny_d-border_y, 0, border_z );
+        solveBox( fields, border_x, nx_d-border_x, border_y, ny_d-border_y, nz_d-border_z, nz_d );
+    };
+    void updateInterior( ElectroMagn *fields ) override
+    {
+        solveBox( fields, border_x, nx_d-border_x, border_y, ny_d-border_y, border_z, nz_d-border_z );
+    };
+    
 protected:
+    //! Updates the cells of indices [imin, imax[ x [jmin, jmax[ x [kmin, kmax[ on the dual grid
+    //! (solvers which can update the borders first)
+    virtual void solveBox( ElectroMagn *fields, unsigned int imin, unsigned int imax, unsigned int jmin, unsigned int jmax,
+                           unsigned int kmin, unsigned int kmax ) {};
+    
     unsigned int nx_p;
     unsigned int nx_d;
     unsigned int ny_p;
     unsigned int ny_d;
     unsigned int nz_p;
     unsigned int nz_d;
+    unsigned int border_x;
+    unsigned int border_y;
+    unsigned int border_z;
     double dt;
     double dt_ov_dx;
     double dt_ov_dy;
@@ -5,6 +5,7 @@
 #include "MA_Solver2D_norm.h"
 #include "MA_Solver2D_Friedman.h"
 #include "MA_Solver3D_norm.h"
+#include "MAMF_Solver3D_Yee.h"
 #include "MA_SolverAM_norm.h"
 #include "MF_Solver1D_Yee.h"
 #include "MF_Solver2D_Yee.h"
@@ -58,7 +59,11 @@ public:
                 if( params.is_spectral ) {
                     WARNING( "PS solveur are not available without Picsar" );
                 }
-                solver = new MA_Solver3D_norm( params );
+                if( params.maxwell_kernel == "fused" ) {
+                    solver = new MAMF_Solver3D_Yee( params );
+                } else {
+                    solver = new MA_Solver3D_norm( params );
+                }
             } else if( ( params.is_pxr == true ) && ( params.is_spectral == false ) ) {
                 solver = new PXR_Solver3D_FDTD( params );
             } else if( ( params.is_pxr == true ) && ( params.is_spectral == true ) ) {
@@ -113,7 +118,12 @@ public:
         } else if( params.geometry == "3Dcartesian" ) {
             if( params.is_pxr == false ) {
                 if( params.maxwell_sol == "Yee" ) {
-                    solver = new MF_Solver3D_Yee( params );
+                    if( params.maxwell_kernel == "fused" ) {
+                        // B is advanced together with E by MAMF_Solver3D_Yee
+                        solver = new NullSolver( params );
+                    } else {
+                        solver = new MF_Solver3D_Yee( params );
+                    }
                 } else if( params.maxwell_sol == "Lehe" ) {
                     solver = new MF_Solver3D_Lehe( params );
                 } else if( params.maxwell_sol == "Bouchard" ) {
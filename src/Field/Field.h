@@ -83,6 +83,12 @@ public:
     //! Virtual method to deallocate Field
     virtual void deallocateDataAndSetTo( Field* f ) = 0;
     
+    //! Virtual method to free the data, back to a field created without allocating
+    virtual void deallocateData() = 0;
+    
+    //! Virtual method to copy the data to memory first touched by the calling thread (on its NUMA node)
+    virtual void firstTouch() = 0;
+    
     //! Virtual method to shift field in space
     virtual void shift_x( unsigned int delta ) = 0;
     
@@ -113,6 +113,33 @@ void Field1D::deallocateDataAndSetTo( Field* f )
     data_ = f->data_;
 }
 
+void Field1D::deallocateData()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    delete [] data_;
+    data_ = NULL;
+
+    // The dual dimensions are added again when allocated
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    globalDims_ = dims_[0];
+}
+
+void Field1D::firstTouch()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    double *data = new double[dims_[0]];
+    memcpy( data, data_, dims_[0]*sizeof( double ) );
+    delete [] data_;
+    data_ = data;
+}
+
 
 void Field1D::allocateDims( unsigned int dims1 )
 {
@@ -127,6 +127,38 @@ void Field2D::deallocateDataAndSetTo( Field* f )
     
 }
 
+void Field2D::deallocateData()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    delete [] data_;
+    data_ = NULL;
+    delete [] data_2D;
+    data_2D = NULL;
+
+    // The dual dimensions are added again when allocated
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    globalDims_ = dims_[0]*dims_[1];
+}
+
+void Field2D::firstTouch()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    double *data = new double[dims_[0]*dims_[1]];
+    memcpy( data, data_, dims_[0]*dims_[1]*sizeof( double ) );
+    delete [] data_;
+    data_ = data;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        data_2D[i] = data_ + i*dims_[1];
+    }
+}
+
 void Field2D::allocateDims( unsigned int dims1, unsigned int dims2 )
 {
     vector<unsigned int> dims( 2 );
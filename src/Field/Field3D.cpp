@@ -3,6 +3,8 @@
 #include <iostream>
 #include <vector>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
 
 #include "Params.h"
 #include "SmileiMPI.h"
@@ -11,6 +13,15 @@
 
 using namespace std;
 
+// Field data are aligned on 64 bytes so that the vectorized solvers work on aligned rows
+static double *allocateAlignedData( unsigned int size )
+{
+    void *ptr = NULL;
+    if( posix_memalign( &ptr, 64, max( size, 1u )*sizeof( double ) ) != 0 ) {
+        ERROR( "Field3D: cannot allocate " << size << " elements" );
+    }
+    return static_cast<double *>( ptr );
+}
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -82,7 +93,7 @@ Field3D::~Field3D()
         }
     }
     if( data_!=NULL ) {
-        delete [] data_;
+        free( data_ );
         for( unsigned int i=0; i<dims_[0]; i++ ) {
             delete [] this->data_3D[i];
         }
@@ -100,12 +111,12 @@ void Field3D::allocateDims()
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        free( data_ );
     }
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = allocateAlignedData( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!!}
     data_3D= new double **[dims_[0]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
@@ -124,7 +135,7 @@ void Field3D::allocateDims()
 
 void Field3D::deallocateDataAndSetTo( Field* f )
 {
-    delete [] data_;
+    free( data_ );
     data_ = NULL;
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         delete [] data_3D[i];
@@ -137,6 +148,43 @@ void Field3D::deallocateDataAndSetTo( Field* f )
     
 }
 
+void Field3D::deallocateData()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    free( data_ );
+    data_ = NULL;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        delete [] data_3D[i];
+    }
+    delete [] data_3D;
+    data_3D = NULL;
+
+    // The dual dimensions are added again when allocated
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    globalDims_ = dims_[0]*dims_[1]*dims_[2];
+}
+
+void Field3D::firstTouch()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    double *data = allocateAlignedData( dims_[0]*dims_[1]*dims_[2] );
+    memcpy( data, data_, dims_[0]*dims_[1]*dims_[2]*sizeof( double ) );
+    free( data_ );
+    data_ = data;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        for( unsigned int j=0; j<dims_[1]; j++ ) {
+            data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
+        }
+    }
+}
+
 
 void Field3D::allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 )
 {
@@ -157,7 +205,7 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        free( data_ );
     }
     
     // isPrimal define if mainDim is Primal or Dual
@@ -174,7 +222,7 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = allocateAlignedData( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!!}
     data_3D= new double **[dims_[0]*dims_[1]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
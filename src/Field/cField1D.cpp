@@ -114,6 +114,33 @@ void cField1D::deallocateDataAndSetTo( Field* f )
 
 }
 
+void cField1D::deallocateData()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    delete [] cdata_;
+    cdata_ = NULL;
+
+    // The dual dimensions are added again when allocated
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    globalDims_ = dims_[0];
+}
+
+void cField1D::firstTouch()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    complex<double> *cdata = new complex<double>[dims_[0]];
+    memcpy( cdata, cdata_, dims_[0]*sizeof( complex<double> ) );
+    delete [] cdata_;
+    cdata_ = cdata;
+}
+
 
 void cField1D::allocateDims( unsigned int dims1 )
 {
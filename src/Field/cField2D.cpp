@@ -128,6 +128,38 @@ void cField2D::deallocateDataAndSetTo( Field* f )
     
 }
 
+void cField2D::deallocateData()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    delete [] cdata_;
+    cdata_ = NULL;
+    delete [] data_2D;
+    data_2D = NULL;
+
+    // The dual dimensions are added again when allocated
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    globalDims_ = dims_[0]*dims_[1];
+}
+
+void cField2D::firstTouch()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    complex<double> *cdata = new complex<double>[dims_[0]*dims_[1]];
+    memcpy( cdata, cdata_, dims_[0]*dims_[1]*sizeof( complex<double> ) );
+    delete [] cdata_;
+    cdata_ = cdata;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        data_2D[i] = cdata_ + i*dims_[1];
+    }
+}
+
 void cField2D::allocateDims( unsigned int dims1, unsigned int dims2 )
 {
     vector<unsigned int> dims( 2 );
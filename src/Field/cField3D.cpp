@@ -129,6 +129,43 @@ void cField3D::deallocateDataAndSetTo( Field* f )
 
 }
 
+void cField3D::deallocateData()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    delete [] cdata_;
+    cdata_ = NULL;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        delete [] data_3D[i];
+    }
+    delete [] data_3D;
+    data_3D = NULL;
+
+    // The dual dimensions are added again when allocated
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    globalDims_ = dims_[0]*dims_[1]*dims_[2];
+}
+
+void cField3D::firstTouch()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    complex<double> *cdata = new complex<double>[dims_[0]*dims_[1]*dims_[2]];
+    memcpy( cdata, cdata_, dims_[0]*dims_[1]*dims_[2]*sizeof( complex<double> ) );
+    delete [] cdata_;
+    cdata_ = cdata;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        for( unsigned int j=0; j<dims_[1]; j++ ) {
+            data_3D[i][j] = cdata_ + i*dims_[1]*dims_[2] + j*dims_[2];
+        }
+    }
+}
+
 void cField3D::allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 )
 {
     vector<unsigned int> dims( 3 );
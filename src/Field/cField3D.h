@@ -37,6 +37,8 @@ public:
     //! Method used to allocate a cField3D
     void allocateDims() override;
     void deallocateDataAndSetTo( Field* f ) override;
+    void deallocateData() override;
+    void firstTouch() override;
     //! a cField3D can also be initialized win two unsigned int
     void allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 );
     //! allocate dimensions for field3D isPrimal define if mainDim is Primal or Dual
@@ -13,7 +13,8 @@ using namespace std;
 // ---------------------------------------------------------------------------------------------------------------------
 // Creator for Interpolator3D2OrderV
 // ---------------------------------------------------------------------------------------------------------------------
-Interpolator3D2OrderV::Interpolator3D2OrderV( Params &params, Patch *patch ) : Interpolator3D( params, patch )
+template<int vecSize>
+Interpolator3D2OrderV<vecSize>::Interpolator3D2OrderV( Params &params, Patch *patch ) : Interpolator3D( params, patch )
 {
 
     dx_inv_ = 1.0/params.cell_length[0];
@@ -28,11 +29,13 @@ Interpolator3D2OrderV::Interpolator3D2OrderV( Params &params, Patch *patch ) : I
 // ---------------------------------------------------------------------------------------------------------------------
 // 2nd OrderV Interpolation of the fields at a the particle position (3 nodes are used)
 // ---------------------------------------------------------------------------------------------------------------------
-void Interpolator3D2OrderV::fields( ElectroMagn *EMfields, Particles &particles, int ipart, double *ELoc, double *BLoc )
+template<int vecSize>
+void Interpolator3D2OrderV<vecSize>::fields( ElectroMagn *EMfields, Particles &particles, int ipart, double *ELoc, double *BLoc )
 {
 }
 
-void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+template<int vecSize>
+void Interpolator3D2OrderV<vecSize>::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
 {
     if( istart[0] == iend[0] ) {
         return;    //Don't treat empty cells.
@@ -59,25 +62,24 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
     
     double *Epart[3], *Bpart[3];
     
-    double coeff[3][2][3][32];
-    int dual[3][32]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0, delta_primal < 0) or if it is +1 (dual=1, delta_primal>=0).
+    double coeff[3][2][3][blockSize];
+    int dual[3][blockSize]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0, delta_primal < 0) or if it is +1 (dual=1, delta_primal>=0).
     
-    int vecSize = 32;
     
     int cell_nparts( ( int )iend[0]-( int )istart[0] );
-    int nbVec = ( iend[0]-istart[0]+( cell_nparts-1 )-( ( iend[0]-istart[0]-1 )&( cell_nparts-1 ) ) ) / vecSize;
+    int nbVec = ( iend[0]-istart[0]+( cell_nparts-1 )-( ( iend[0]-istart[0]-1 )&( cell_nparts-1 ) ) ) / blockSize;
     
-    if( nbVec*vecSize != cell_nparts ) {
+    if( nbVec*blockSize != cell_nparts ) {
         nbVec++;
     }
     
     for( int iivect=0 ; iivect<nbVec; iivect++ ) {
-        int ivect = vecSize*iivect;
+        int ivect = blockSize*iivect;
         
         int np_computed( 0 );
-        if( cell_nparts > vecSize ) {
-            np_computed = vecSize;
-            cell_nparts -= vecSize;
+        if( cell_nparts > blockSize ) {
+            np_computed = blockSize;
+            cell_nparts -= blockSize;
         } else {
             np_computed = cell_nparts;
         }
@@ -134,7 +136,7 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxd+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) *
+                        interp_res += *( coeffxd+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) *
                                       ( ( 1-dual[0][ipart] )*( *Ex3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+kloc ) + dual[0][ipart]*( *Ex3D )( idxO[0]+1+iloc, idxO[1]+jloc, idxO[2]+kloc ) );
                     }
                 }
@@ -146,7 +148,7 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyd+jloc*32 ) * *( coeffzp+kloc*32 ) *
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyd+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) *
                                       ( ( 1-dual[1][ipart] )*( *Ey3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+kloc ) + dual[1][ipart]*( *Ey3D )( idxO[0]+iloc, idxO[1]+1+jloc, idxO[2]+kloc ) );
                     }
                 }
@@ -159,7 +161,7 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzd+kloc*32 ) *
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzd+kloc*blockSize ) *
                                       ( ( 1-dual[2][ipart] )*( *Ez3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+kloc ) + dual[2][ipart]*( *Ez3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+1+kloc ) );
                     }
                 }
@@ -172,7 +174,7 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyd+jloc*32 ) * *( coeffzd+kloc*32 ) *
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyd+jloc*blockSize ) * *( coeffzd+kloc*blockSize ) *
                                       ( ( 1-dual[2][ipart] ) * ( ( 1-dual[1][ipart] )*( *Bx3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+kloc ) + dual[1][ipart]*( *Bx3D )( idxO[0]+iloc, idxO[1]+1+jloc, idxO[2]+kloc ) )
                                         +    dual[2][ipart]  * ( ( 1-dual[1][ipart] )*( *Bx3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+1+kloc ) + dual[1][ipart]*( *Bx3D )( idxO[0]+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) ) );
                     }
@@ -185,7 +187,7 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxd+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzd+kloc*32 ) *
+                        interp_res += *( coeffxd+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzd+kloc*blockSize ) *
                                       ( ( 1-dual[2][ipart] ) * ( ( 1-dual[0][ipart] )*( *By3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+kloc ) + dual[0][ipart]*( *By3D )( idxO[0]+1+iloc, idxO[1]+jloc, idxO[2]+kloc ) )
                                         +    dual[2][ipart]  * ( ( 1-dual[0][ipart] )*( *By3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+1+kloc ) + dual[0][ipart]*( *By3D )( idxO[0]+1+iloc, idxO[1]+jloc, idxO[2]+1+kloc ) ) );
                     }
@@ -198,7 +200,7 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxd+iloc*32 ) * *( coeffyd+jloc*32 ) * *( coeffzp+kloc*32 ) *
+                        interp_res += *( coeffxd+iloc*blockSize ) * *( coeffyd+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) *
                                       ( ( 1-dual[1][ipart] ) * ( ( 1-dual[0][ipart] )*( *Bz3D )( idxO[0]+iloc, idxO[1]+jloc, idxO[2]+kloc ) + dual[0][ipart]*( *Bz3D )( idxO[0]+1+iloc, idxO[1]+jloc, idxO[2]+kloc ) )
                                         +    dual[1][ipart]  * ( ( 1-dual[0][ipart] )*( *Bz3D )( idxO[0]+iloc, idxO[1]+1+jloc, idxO[2]+kloc ) + dual[0][ipart]*( *Bz3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+kloc ) ) );
                     }
@@ -210,7 +212,8 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
 } // END Interpolator3D2OrderV
 
 
-void Interpolator3D2OrderV::fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc )
+template<int vecSize>
+void Interpolator3D2OrderV<vecSize>::fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc )
 {
     // iend not used for now
     // probes are interpolated one by one for now
@@ -409,7 +412,8 @@ void Interpolator3D2OrderV::fieldsAndCurrents( ElectroMagn *EMfields, Particles
 
 
 
-void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+template<int vecSize>
+void Interpolator3D2OrderV<vecSize>::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
 {
     if( istart[0] == iend[0] ) {
         return;    //Don't treat empty cells.
@@ -457,25 +461,24 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
     
     
     
-    double coeff[3][2][3][32];
-    int dual[3][32]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
+    double coeff[3][2][3][blockSize];
+    int dual[3][blockSize]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
     
-    int vecSize = 32;
     
     int cell_nparts( ( int )iend[0]-( int )istart[0] );
-    int nbVec = ( iend[0]-istart[0]+( cell_nparts-1 )-( ( iend[0]-istart[0]-1 )&( cell_nparts-1 ) ) ) / vecSize;
+    int nbVec = ( iend[0]-istart[0]+( cell_nparts-1 )-( ( iend[0]-istart[0]-1 )&( cell_nparts-1 ) ) ) / blockSize;
     
-    if( nbVec*vecSize != cell_nparts ) {
+    if( nbVec*blockSize != cell_nparts ) {
         nbVec++;
     }
     
     for( int iivect=0 ; iivect<nbVec; iivect++ ) {
-        int ivect = vecSize*iivect;
+        int ivect = blockSize*iivect;
         
         int np_computed( 0 );
-        if( cell_nparts > vecSize ) {
-            np_computed = vecSize;
-            cell_nparts -= vecSize;
+        if( cell_nparts > blockSize ) {
+            np_computed = blockSize;
+            cell_nparts -= blockSize;
         } else {
             np_computed = cell_nparts;
         }
@@ -522,7 +525,7 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxd+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) *
+                        interp_res += *( coeffxd+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) *
                                       ( ( 1-dual[0][ipart] )*( *Ex3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) + dual[0][ipart]*( *Ex3D )( idxO[0]+2+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) );
                     }
                 }
@@ -535,7 +538,7 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyd+jloc*32 ) * *( coeffzp+kloc*32 ) *
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyd+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) *
                                       ( ( 1-dual[1][ipart] )*( *Ey3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) + dual[1][ipart]*( *Ey3D )( idxO[0]+1+iloc, idxO[1]+2+jloc, idxO[2]+1+kloc ) );
                     }
                 }
@@ -548,8 +551,8 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        //interp_res += *(coeffxp+iloc*32) * *(coeffyd+jloc*32) * *(coeffzp+kloc*32) *
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzd+kloc*32 ) *
+                        //interp_res += *(coeffxp+iloc*blockSize) * *(coeffyd+jloc*blockSize) * *(coeffzp+kloc*blockSize) *
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzd+kloc*blockSize ) *
                                       ( ( 1-dual[2][ipart] )*( *Ez3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) + dual[2][ipart]*( *Ez3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+2+kloc ) );
                     }
                 }
@@ -562,8 +565,8 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        //interp_res += *(coeffxp+iloc*32) * *(coeffyd+jloc*32) * *(coeffzp+kloc*32) *
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyd+jloc*32 ) * *( coeffzd+kloc*32 ) *
+                        //interp_res += *(coeffxp+iloc*blockSize) * *(coeffyd+jloc*blockSize) * *(coeffzp+kloc*blockSize) *
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyd+jloc*blockSize ) * *( coeffzd+kloc*blockSize ) *
                                       ( ( 1-dual[2][ipart] ) * ( ( 1-dual[1][ipart] )*( *Bx3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) + dual[1][ipart]*( *Bx3D )( idxO[0]+1+iloc, idxO[1]+2+jloc, idxO[2]+1+kloc ) )
                                         +    dual[2][ipart]  * ( ( 1-dual[1][ipart] )*( *Bx3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+2+kloc ) + dual[1][ipart]*( *Bx3D )( idxO[0]+1+iloc, idxO[1]+2+jloc, idxO[2]+2+kloc ) ) );
                     }
@@ -576,8 +579,8 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        //interp_res += *(coeffxp+iloc*32) * *(coeffyd+jloc*32) * *(coeffzp+kloc*32) *
-                        interp_res += *( coeffxd+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzd+kloc*32 ) *
+                        //interp_res += *(coeffxp+iloc*blockSize) * *(coeffyd+jloc*blockSize) * *(coeffzp+kloc*blockSize) *
+                        interp_res += *( coeffxd+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzd+kloc*blockSize ) *
                                       ( ( 1-dual[2][ipart] ) * ( ( 1-dual[0][ipart] )*( *By3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) + dual[0][ipart]*( *By3D )( idxO[0]+2+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) )
                                         +    dual[2][ipart]  * ( ( 1-dual[0][ipart] )*( *By3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+2+kloc ) + dual[0][ipart]*( *By3D )( idxO[0]+2+iloc, idxO[1]+1+jloc, idxO[2]+2+kloc ) ) );
                     }
@@ -590,7 +593,7 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxd+iloc*32 ) * *( coeffyd+jloc*32 ) * *( coeffzp+kloc*32 ) *
+                        interp_res += *( coeffxd+iloc*blockSize ) * *( coeffyd+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) *
                                       ( ( 1-dual[1][ipart] ) * ( ( 1-dual[0][ipart] )*( *Bz3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) + dual[0][ipart]*( *Bz3D )( idxO[0]+2+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc ) )
                                         +    dual[1][ipart]  * ( ( 1-dual[0][ipart] )*( *Bz3D )( idxO[0]+1+iloc, idxO[1]+2+jloc, idxO[2]+1+kloc ) + dual[0][ipart]*( *Bz3D )( idxO[0]+2+iloc, idxO[1]+2+jloc, idxO[2]+1+kloc ) ) );
                     }
@@ -603,7 +606,7 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *Phi3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *Phi3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -614,7 +617,7 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *GradPhix3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *GradPhix3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -625,7 +628,7 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *GradPhiy3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *GradPhiy3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -636,7 +639,7 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *GradPhiz3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *GradPhiz3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -650,7 +653,8 @@ void Interpolator3D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
 }
 
 
-void Interpolator3D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+template<int vecSize>
+void Interpolator3D2OrderV<vecSize>::timeCenteredEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
 {
     if( istart[0] == iend[0] ) {
         return;    //Don't treat empty cells.
@@ -689,23 +693,22 @@ void Interpolator3D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particl
     Field3D *GradPhi_mz3D = static_cast<Field3D *>( EMfields->envelope->GradPhiz_m );
     
     
-    double coeff[3][2][3][32];
-    int vecSize = 32;
+    double coeff[3][2][3][blockSize];
     
     int cell_nparts( ( int )iend[0]-( int )istart[0] );
-    int nbVec = ( iend[0]-istart[0]+( cell_nparts-1 )-( ( iend[0]-istart[0]-1 )&( cell_nparts-1 ) ) ) / vecSize;
+    int nbVec = ( iend[0]-istart[0]+( cell_nparts-1 )-( ( iend[0]-istart[0]-1 )&( cell_nparts-1 ) ) ) / blockSize;
     
-    if( nbVec*vecSize != cell_nparts ) {
+    if( nbVec*blockSize != cell_nparts ) {
         nbVec++;
     }
     
     for( int iivect=0 ; iivect<nbVec; iivect++ ) {
-        int ivect = vecSize*iivect;
+        int ivect = blockSize*iivect;
         
         int np_computed( 0 );
-        if( cell_nparts > vecSize ) {
-            np_computed = vecSize;
-            cell_nparts -= vecSize;
+        if( cell_nparts > blockSize ) {
+            np_computed = blockSize;
+            cell_nparts -= blockSize;
         } else {
             np_computed = cell_nparts;
         }
@@ -746,7 +749,7 @@ void Interpolator3D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particl
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *Phi_m3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *Phi_m3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -757,7 +760,7 @@ void Interpolator3D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particl
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *GradPhi_mx3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *GradPhi_mx3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -768,7 +771,7 @@ void Interpolator3D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particl
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *GradPhi_my3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *GradPhi_my3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -779,7 +782,7 @@ void Interpolator3D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particl
             for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                     for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                        interp_res += *( coeffxp+iloc*32 ) * *( coeffyp+jloc*32 ) * *( coeffzp+kloc*32 ) * ( *GradPhi_mz3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
+                        interp_res += *( coeffxp+iloc*blockSize ) * *( coeffyp+jloc*blockSize ) * *( coeffzp+kloc*blockSize ) * ( *GradPhi_mz3D )( idxO[0]+1+iloc, idxO[1]+1+jloc, idxO[2]+1+kloc );
                     }
                 }
             }
@@ -793,7 +796,8 @@ void Interpolator3D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particl
 }
 
 // probes like diagnostic !
-void Interpolator3D2OrderV::envelopeAndSusceptibility( ElectroMagn *EMfields, Particles &particles, int ipart, double *Env_A_abs_Loc, double *Env_Chi_Loc, double *Env_E_abs_Loc, double *Env_Ex_abs_Loc )
+template<int vecSize>
+void Interpolator3D2OrderV<vecSize>::envelopeAndSusceptibility( ElectroMagn *EMfields, Particles &particles, int ipart, double *Env_A_abs_Loc, double *Env_Chi_Loc, double *Env_E_abs_Loc, double *Env_Ex_abs_Loc )
 {
     // probes are interpolated one by one for now
     
@@ -881,7 +885,13 @@ void Interpolator3D2OrderV::envelopeAndSusceptibility( ElectroMagn *EMfields, Pa
 
 
 // Interpolator on another field than the basic ones
-void Interpolator3D2OrderV::oneField( Field **field, Particles &particles, int *istart, int *iend, double *FieldLoc, double *l1, double *l2, double *l3 )
+template<int vecSize>
+void Interpolator3D2OrderV<vecSize>::oneField( Field **field, Particles &particles, int *istart, int *iend, double *FieldLoc, double *l1, double *l2, double *l3 )
 {
     ERROR( "Single field 3D2O interpolator not available in vectorized mode" );
 }
+
+// Instantiations for the supported vector widths
+template class Interpolator3D2OrderV<4>;
+template class Interpolator3D2OrderV<8>;
+template class Interpolator3D2OrderV<16>;
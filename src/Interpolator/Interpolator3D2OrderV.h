@@ -7,8 +7,10 @@
 
 
 //  --------------------------------------------------------------------------------------------------------------------
-//! Class for 2nd order interpolator for 1d3v simulations
+//! Class for vectorized 2nd order interpolator for 3d3v simulations
+//! Particles are processed by blocks of 4 SIMD vectors of vecSize (4, 8 or 16, see Params::vectorization_width)
 //  --------------------------------------------------------------------------------------------------------------------
+template<int vecSize>
 class Interpolator3D2OrderV : public Interpolator3D
 {
 
@@ -51,8 +53,8 @@ public:
         for( int iloc=-1 ; iloc<2 ; iloc++ ) {
             for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                 for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                    interp_res += *( coeffx+iloc*32 ) * *( coeffy+jloc*32 ) * *( coeffz+kloc*32 ) *
-                                  ( ( 1-*( dual+( idual )*32 ) )*( *f )( idx[0]+iloc, idx[1]+jloc, idx[2]+kloc ) + *( dual+( idual )*32 )*( *f )( idx2[0]+iloc, idx2[1]+jloc, idx2[2]+kloc ) );
+                    interp_res += *( coeffx+iloc*blockSize ) * *( coeffy+jloc*blockSize ) * *( coeffz+kloc*blockSize ) *
+                                  ( ( 1-*( dual+( idual )*blockSize ) )*( *f )( idx[0]+iloc, idx[1]+jloc, idx[2]+kloc ) + *( dual+( idual )*blockSize )*( *f )( idx2[0]+iloc, idx2[1]+jloc, idx2[2]+kloc ) );
                 }
             }
         }
@@ -75,9 +77,9 @@ public:
         for( int iloc=-1 ; iloc<2 ; iloc++ ) {
             for( int jloc=-1 ; jloc<2 ; jloc++ ) {
                 for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                    interp_res += *( coeffx+iloc*32 ) * *( coeffy+jloc*32 ) * *( coeffz+kloc*32 ) *
-                                  ( ( 1-*( dual+( idual1 )*32 ) ) * ( ( 1-*( dual+( idual0 )*32 ) )*( *f )( idx [0]+iloc, idx [1]+jloc, idx [2]+kloc ) + *( dual+( idual0 )*32 )*( *f )( idx2[0]+iloc, idx2[1]+jloc, idx2[2]+kloc ) )
-                                    + ( *( dual+( idual1 )*32 ) ) * ( ( 1-*( dual+( idual0 )*32 ) )*( *f )( idx3[0]+iloc, idx3[1]+jloc, idx3[2]+kloc ) + *( dual+( idual0 )*32 )*( *f )( idx4[0]+iloc, idx4[1]+jloc, idx4[2]+kloc ) ) );
+                    interp_res += *( coeffx+iloc*blockSize ) * *( coeffy+jloc*blockSize ) * *( coeffz+kloc*blockSize ) *
+                                  ( ( 1-*( dual+( idual1 )*blockSize ) ) * ( ( 1-*( dual+( idual0 )*blockSize ) )*( *f )( idx [0]+iloc, idx [1]+jloc, idx [2]+kloc ) + *( dual+( idual0 )*blockSize )*( *f )( idx2[0]+iloc, idx2[1]+jloc, idx2[2]+kloc ) )
+                                    + ( *( dual+( idual1 )*blockSize ) ) * ( ( 1-*( dual+( idual0 )*blockSize ) )*( *f )( idx3[0]+iloc, idx3[1]+jloc, idx3[2]+kloc ) + *( dual+( idual0 )*blockSize )*( *f )( idx4[0]+iloc, idx4[1]+jloc, idx4[2]+kloc ) ) );
                 }
             }
         }
@@ -85,7 +87,8 @@ public:
     }
     
 private:
-
+    //! Number of particles interpolated together
+    static const int blockSize = 4*vecSize;
 
 };//END class
 
@@ -25,3 +25,32 @@ Ionization::Ionization( Params &params, Species *species )
 Ionization::~Ionization()
 {
 }
+
+unsigned int Ionization::createNewElectrons( Particles *particles )
+{
+    unsigned int first = new_electrons.createParticlesFromParents( *particles, ionized_particles_, 1 );
+    unsigned int n = ionized_particles_.size();
+    if( n > 0 ) {
+        const int *__restrict__ index = ionized_particles_.data();
+        const unsigned int *__restrict__ events = ionization_events_.data();
+        for( unsigned int i=0; i<3; i++ ) {
+            const double *__restrict__ ion_momentum = &( particles->momentum( i, 0 ) );
+            double *__restrict__ momentum = &( new_electrons.momentum( i, first ) );
+            #pragma omp simd
+            for( unsigned int j=0; j<n; j++ ) {
+                momentum[j] = ion_momentum[index[j]]*ionized_species_invmass;
+            }
+        }
+        const double *__restrict__ ion_weight = &( particles->weight( 0 ) );
+        double *__restrict__ weight = &( new_electrons.weight( first ) );
+        short *__restrict__ charge = &( new_electrons.charge( first ) );
+        #pragma omp simd
+        for( unsigned int j=0; j<n; j++ ) {
+            weight[j] = double( events[j] )*ion_weight[index[j]];
+            charge[j] = -1;
+        }
+    }
+    ionized_particles_.clear();
+    ionization_events_.clear();
+    return first;
+}
@@ -41,6 +41,15 @@ protected:
     unsigned int nDim_particle;
     double ionized_species_invmass;
     
+    //! Ionized particles of the current call and their number of ionization events, recorded during the
+    //! Monte-Carlo loop before the bulk creation of the new electrons
+    std::vector<int> ionized_particles_;
+    std::vector<unsigned int> ionization_events_;
+    
+    //! Create at once one electron per recorded ionized particle, with the position and the momentum
+    //! (per unit mass) of the ion and the weight of the ionized electrons. Returns the index of the first one.
+    unsigned int createNewElectrons( Particles *particles );
+    
 private:
 
 
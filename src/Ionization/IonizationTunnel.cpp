@@ -154,21 +154,12 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
             Proj->ionizationCurrents( patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, *particles, ipart, Jion );
         }
         
-        // Creation of the new electrons
+        // Record the new electrons, created after the loop
         // (variable weights are used)
         // -----------------------------
         if( k_times !=0 ) {
-            new_electrons.createParticle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
-            for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
-                new_electrons.position( i, idNew )=particles->position( i, ipart );
-            }
-            for( unsigned int i=0; i<3; i++ ) {
-                new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
-            }
-            new_electrons.weight( idNew )=double( k_times )*particles->weight( ipart );
-            new_electrons.charge( idNew )=-1;
+            ionized_particles_.push_back( ipart );
+            ionization_events_.push_back( k_times );
             
             // Increase the charge of the particle
             particles->charge( ipart ) += k_times;
@@ -176,4 +167,6 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
         
         
     } // Loop on particles
+    
+    createNewElectrons( particles );
 }
@@ -186,23 +186,15 @@ void IonizationTunnelEnvelopeAveraged::envelopeIonization( Particles *particles,
     
         // ---- Ionization ion current cannot be computed with the envelope ionization model
       
-        // ---- Creation of the new electrons
+        // ---- Record the new electrons, created after the loop
         
         if( k_times !=0 ) {
-            new_electrons.createParticle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
+            ionized_particles_.push_back( ipart );
+            ionization_events_.push_back( k_times );
 
-            // The new electron is in the same position of the atom where it originated from
-            for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
-                new_electrons.position( i, idNew )=particles->position( i, ipart );
-            }
-            for( unsigned int i=0; i<3; i++ ) {
-                new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
-            }
-
-           
-            // ----  Initialise the momentum, weight and charge of the new electron
+            // The new electron is in the same position of the atom where it originated from, with its momentum
+            // ----  Momentum added to that of the atom
+            double kick[3] = { 0., 0., 0. };
 
             if (ellipticity==0.){ // linear polarization
 
@@ -216,12 +208,12 @@ void IonizationTunnelEnvelopeAveraged::envelopeIonization( Particles *particles,
 
                 // add the transverse momentum p_perp to obtain a gaussian distribution 
                 // in the momentum in the polarization direction p_perp, following Schroeder's result
-                new_electrons.momentum( 1, idNew ) += p_perp*cos_phi;
-                new_electrons.momentum( 2, idNew ) += p_perp*sin_phi;
+                kick[1] = p_perp*cos_phi;
+                kick[2] = p_perp*sin_phi;
 
                 // initialize px to take into account the average drift <px>=A^2/4 and the px=|p_perp|^2/2 relation
                 // Note: the agreement in the phase space between envelope and standard laser simulation will be seen only after the passage of the ionizing laser
-                new_electrons.momentum( 0, idNew ) += Aabs*Aabs/4. + p_perp*p_perp/2.;
+                kick[0] = Aabs*Aabs/4. + p_perp*p_perp/2.;
 
             } else if (ellipticity==1.){ // circular polarization
 
@@ -231,18 +223,17 @@ void IonizationTunnelEnvelopeAveraged::envelopeIonization( Particles *particles,
                 Aabs    = sqrt(2. * (*(Phi_env+ipart-ipart_ref))  );                 
 
                 p_perp = Aabs;   // in circular polarization it corresponds to a0/sqrt(2)
-                new_electrons.momentum( 1, idNew ) += p_perp*cos(rand_times_2pi)/sqrt(2);
-                new_electrons.momentum( 2, idNew ) += p_perp*sin(rand_times_2pi)/sqrt(2); 
+                kick[1] = p_perp*cos(rand_times_2pi)/sqrt(2);
+                kick[2] = p_perp*sin(rand_times_2pi)/sqrt(2); 
      
                 // initialize px to take into account the average drift <px>=A^2/4 and the px=|p_perp|^2/2 result
                 // Note: the agreement in the phase space between envelope and standard laser simulation will be seen only after the passage of the ionizing laser
-                new_electrons.momentum( 0, idNew ) += Aabs*Aabs/2.; 
+                kick[0] = Aabs*Aabs/2.; 
             
             }
-
-            // weight and charge of the new electron
-            new_electrons.weight( idNew )=double( k_times )*particles->weight( ipart );
-            new_electrons.charge( idNew )=-1;
+            for( unsigned int i=0; i<3; i++ ) {
+                momentum_kick_[i].push_back( kick[i] );
+            }
     
             // Increase the charge of the ion particle
             particles->charge( ipart ) += k_times;
@@ -251,5 +242,18 @@ void IonizationTunnelEnvelopeAveraged::envelopeIonization( Particles *particles,
     
     } // Loop on particles
 
+    // ---- Creation of the new electrons: weight and charge, then momentum of the atom plus the kick
+    unsigned int first = createNewElectrons( particles );
+    unsigned int n = momentum_kick_[0].size();
+    for( unsigned int i=0; i<3 && n>0; i++ ) {
+        double *__restrict__ momentum = &( new_electrons.momentum( i, first ) );
+        const double *__restrict__ kick = momentum_kick_[i].data();
+        #pragma omp simd
+        for( unsigned int j=0; j<n; j++ ) {
+            momentum[j] += kick[j];
+        }
+        momentum_kick_[i].clear();
+    }
+
 }
 
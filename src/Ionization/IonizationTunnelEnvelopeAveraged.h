@@ -33,6 +33,9 @@ private:
     
     double one_third;
     std::vector<double> alpha_tunnel, beta_tunnel, gamma_tunnel,Ip_times2_to_minus3ov4;
+    
+    //! Momentum added to that of the atom, for each new electron of the current call
+    std::vector<double> momentum_kick_[3];
 };
 
 
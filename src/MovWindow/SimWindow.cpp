@@ -24,6 +24,7 @@
 #include "ElectroMagnBC_Factory.h"
 #include "DoubleGrids.h"
 #include "SyncVectorPatch.h"
+#include "Timer.h"
 
 using namespace std;
 
@@ -47,6 +48,10 @@ SimWindow::SimWindow( Params &params )
     patch_to_be_created.resize( max_threads );
     patch_particle_created.resize( max_threads );
     
+    number_of_shifts_ = 0;
+    number_of_recycled_patches_ = 0;
+    number_of_cloned_patches_ = 0;
+    
     if( PyTools::nComponents( "MovingWindow" ) ) {
         active = true;
         
@@ -64,6 +69,14 @@ SimWindow::SimWindow( Params &params )
     x_moved = 0.;      //The window has not moved at t=0. Warning: not true anymore for restarts.
     n_moved = 0 ;      //The window has not moved at t=0. Warning: not true anymore for restarts.
     
+    // The fields of the patches leaving the window are zeroed in place and reused, except for the field
+    // structures which depend on the patch location beyond the boundary conditions
+    recycle_patches_ = params.geometry != "AMcylindrical"
+                       && ! params.is_spectral
+                       && ! params.Laser_Envelope_model
+                       && ! params.uncoupled_grids
+                       && PyTools::nComponents( "PrescribedField" ) == 0;
+    
     
     if( active ) {
         //if( velocity_x != 0. && params.EM_BCs[0][0] == "periodic" ) {
@@ -86,6 +99,9 @@ SimWindow::SimWindow( Params &params )
 
 SimWindow::~SimWindow()
 {
+    for( unsigned int i=0; i<recycled_patches_.size(); i++ ) {
+        delete recycled_patches_[i];
+    }
 }
 
 bool SimWindow::isMoving( double time_dual )
@@ -136,6 +152,7 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
 
             vecPatches_old.resize( nPatches );
             n_moved += params.n_space[0];
+            number_of_shifts_++;
         }
         //Cut off laser before exchanging any patches to avoid deadlock and store pointers in vecpatches_old.
 #ifndef _NO_MPI_TM
@@ -210,11 +227,21 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
         
         //Creation of new Patches
         for( unsigned int j = 0; j < patch_to_be_created[my_thread].size();  j++ ) {
-            //create patch without particle.
+            //create patch without particle, reusing a patch which left the window at the previous shift if possible.
 #ifndef _NO_MPI_TM
             #pragma omp critical
 #endif
-            mypatch = PatchesFactory::clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, h0 + patch_to_be_created[my_thread][j], n_moved, false );
+            {
+                if( ! recycled_patches_.empty() ) {
+                    mypatch = recycled_patches_.back();
+                    recycled_patches_.pop_back();
+                    mypatch->recycle( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, h0 + patch_to_be_created[my_thread][j], n_moved );
+                    number_of_recycled_patches_++;
+                } else {
+                    mypatch = PatchesFactory::clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, h0 + patch_to_be_created[my_thread][j], n_moved, false );
+                    number_of_cloned_patches_++;
+                }
+            }
             
             // Do not receive Xmin condition
             if( mypatch->isXmin() && mypatch->EMfields->emBoundCond[0] ) {
@@ -261,6 +288,17 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
             }
         }
         
+        // Patches left in the pool are not needed anymore (the patch distribution changed)
+#ifndef _NO_MPI_TM
+        #pragma omp single nowait
+#endif
+        {
+            for( unsigned int j=0; j < recycled_patches_.size(); j++ ) {
+                delete recycled_patches_[j];
+            }
+            recycled_patches_.clear();
+        }
+        
         //Update the correct neighbor values
         for( unsigned int j=0; j < update_patches_.size(); j++ ) {
             mypatch = update_patches_[j];
@@ -567,7 +605,15 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
                 urad[ispec] += mypatch->vecSpecies[ispec]->getNrjRadiation();
             }
             
-            delete  mypatch;
+            // Keep the patch to be reused at the next shift
+            if( recycle_patches_ ) {
+#ifndef _NO_MPI_TM
+                #pragma omp critical
+#endif
+                recycled_patches_.push_back( mypatch );
+            } else {
+                delete  mypatch;
+            }
         }
         
         // SUM energy_field_lost, energy_part_lost and poynting / All threads
@@ -627,6 +673,19 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
 
 }
 
+void SimWindow::printStatistics( SmileiMPI *smpi, Timer &timer )
+{
+    double time = timer.getTime(), max_time;
+    MPI_Reduce( &time, &max_time, 1, MPI_DOUBLE, MPI_MAX, 0, smpi->SMILEI_COMM_WORLD );
+    double patches[2] = { ( double )number_of_recycled_patches_, ( double )number_of_cloned_patches_ };
+    MPI_Reduce( smpi->isMaster()?MPI_IN_PLACE:patches, patches, 2, MPI_DOUBLE, MPI_SUM, 0, smpi->SMILEI_COMM_WORLD );
+    MESSAGE( 1, "Number of shifts = " << number_of_shifts_ );
+    if( number_of_shifts_ > 0 ) {
+        MESSAGE( 1, "Average time per shift (max over processes) = " << max_time / number_of_shifts_ * 1.e3 << " ms" );
+        MESSAGE( 1, "Arriving patches recycled = " << ( long )patches[0] << ", created = " << ( long )patches[1] );
+    }
+}
+
 void SimWindow::operate(Region& region,  VectorPatch& vecPatches, SmileiMPI* smpi, Params& params, double time_dual)
 {
     region.patch_->exchangeField_movewin( region.patch_->EMfields->Ex_, params.n_space[0] );
@@ -12,6 +12,7 @@ class Interpolator;
 class Projector;
 class SmileiMPI;
 class Region;
+class Timer;
 
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class SimWindow
@@ -81,6 +82,9 @@ public:
         return additional_shifts_time;
     }
     
+    //! Print the number of shifts, their average cost and how the arriving patches were obtained
+    void printStatistics( SmileiMPI *smpi, Timer &timer );
+    
     
 private:
     //! Tells whether there is a moving window or not
@@ -113,6 +117,16 @@ private:
     //! Number of additional moving window shifts
     unsigned int number_of_additional_shifts;
     
+    //! Whether the patches leaving the window are kept to be reused as arriving patches
+    bool recycle_patches_;
+    //! Patches which left the window at the last shift, reused at the next one
+    std::vector<Patch *> recycled_patches_;
+    //! Number of shifts done by this process
+    unsigned int number_of_shifts_;
+    //! Number of arriving patches which were recycled or cloned
+    unsigned int number_of_recycled_patches_;
+    unsigned int number_of_cloned_patches_;
+    
     
 };
 
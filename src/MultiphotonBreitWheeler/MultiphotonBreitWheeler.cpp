@@ -269,6 +269,9 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
             }
         }
     }
+
+    // 3. Creation of the pairs
+    create_pairs( particles );
 }
 
 
@@ -293,7 +296,6 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     // _______________________________________________
     // Parameters
 
-    int      nparticles;           // Total number of particles in the temporary arrays
     int      k, i;
     double   u[3];                 // propagation direction
     double *chi = new double[2];   // temporary quantum parameters
@@ -315,61 +317,86 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     }
 
     // _______________________________________________
-    // Electron (k=0) and positron (k=1) generation
+    // Electron (k=0) and positron (k=1): recorded here and created
+    // at the end of the call (see create_pairs)
 
+    decayed_photons_.push_back( ipart );
+    decayed_photon_weight_.push_back( particles.weight( ipart ) );
     for( k=0 ; k < 2 ; k++ ) {
 
-        // Creation of new electrons in the temporary array new_pair[0]
-        new_pair[k].createParticles( mBW_pair_creation_sampling_[k] );
-        
-        // Final size
-        nparticles = new_pair[k].size();
-
-        // For all new electrons...
-        for( int idNew=nparticles-mBW_pair_creation_sampling_[k]; idNew<nparticles; idNew++ ) {
+        // Momentum
+        p = sqrt( pow( 1.+chi[k]*inv_chiph_gammaph, 2 )-1 );
+        for( i=0; i<3; i++ ) {
+            pair_momentum_[k][i].push_back( p*u[i] );
+        }
+        pair_chi_[k].push_back( chi[k] );
+    }
 
-            // Momentum
-            p = sqrt( pow( 1.+chi[k]*inv_chiph_gammaph, 2 )-1 );
-            for( i=0; i<3; i++ ) {
-                new_pair[k].momentum( i, idNew ) =
-                    p*u[i];
-            }
+    // Total energy converted into pairs during the current timestep
+    pair_converted_energy_ += particles.weight( ipart )*gammaph;
 
-            // gamma
-            //inv_gamma = 1./sqrt(1.+p*p);
+    // The photon with negtive weight will be deleted latter
+    particles.weight( ipart ) = -1;
 
-            // Positions
-            for( i=0; i<n_dimensions_; i++ ) {
-                new_pair[k].position( i, idNew )=particles.position( i, ipart );
-//               + new_pair[k].momentum(i,idNew)*remaining_dt*inv_gamma;
-            }
+}
 
-            // Old positions
-            if( particles.Position_old.size() > 0 ) {
-                for( i=0; i<n_dimensions_; i++ ) {
-                    new_pair[k].position_old( i, idNew )=particles.position( i, ipart ) ;
+// -----------------------------------------------------------------------------
+//! Create at once in new_pair the electrons and positrons of the photon decays
+//! recorded by pair_emission since the last call
+//! \param particles          object particles containing the photons
+// -----------------------------------------------------------------------------
+void MultiphotonBreitWheeler::create_pairs( Particles &particles )
+{
+    const unsigned int ndecays = decayed_photons_.size();
+    if( ndecays == 0 ) {
+        return;
+    }
+    const double *__restrict__ photon_weight = decayed_photon_weight_.data();
+
+    for( int k=0 ; k < 2 ; k++ ) {
+        const unsigned int sampling = mBW_pair_creation_sampling_[k];
+        const unsigned int first = new_pair[k].createParticlesFromParents( particles, decayed_photons_, sampling );
+
+        for( unsigned int j=0; j<sampling; j++ ) {
+            for( int i=0; i<3; i++ ) {
+                double *__restrict__ momentum = &( new_pair[k].momentum( i, first ) );
+                const double *__restrict__ pair_momentum = pair_momentum_[k][i].data();
+                #pragma omp simd
+                for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+                    momentum[idecay*sampling+j] = pair_momentum[idecay];
                 }
             }
-
-            new_pair[k].weight( idNew )=particles.weight( ipart )*mBW_pair_creation_inv_sampling_[k];
-            new_pair[k].charge( idNew )= k*2-1;
-
+            double *__restrict__ weight = &( new_pair[k].weight( first ) );
+            short *__restrict__ charge = &( new_pair[k].charge( first ) );
+            #pragma omp simd
+            for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+                weight[idecay*sampling+j] = photon_weight[idecay]*mBW_pair_creation_inv_sampling_[k];
+                charge[idecay*sampling+j] = k*2-1;
+            }
             if( new_pair[k].isQuantumParameter ) {
-                new_pair[k].chi( idNew ) = chi[k];
+                double *__restrict__ chi = &( new_pair[k].chi( first ) );
+                const double *__restrict__ pair_chi = pair_chi_[k].data();
+                #pragma omp simd
+                for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+                    chi[idecay*sampling+j] = pair_chi[idecay];
+                }
             }
-
             if( new_pair[k].isMonteCarlo ) {
-                new_pair[k].tau( idNew ) = -1.;
+                double *__restrict__ tau = &( new_pair[k].tau( first ) );
+                #pragma omp simd
+                for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+                    tau[idecay*sampling+j] = -1.;
+                }
             }
         }
-    }
-
-    // Total energy converted into pairs during the current timestep
-    pair_converted_energy_ += particles.weight( ipart )*gammaph;
-
-    // The photon with negtive weight will be deleted latter
-    particles.weight( ipart ) = -1;
 
+        for( int i=0; i<3; i++ ) {
+            pair_momentum_[k][i].clear();
+        }
+        pair_chi_[k].clear();
+    }
+    decayed_photons_.clear();
+    decayed_photon_weight_.clear();
 }
 
 // -----------------------------------------------------------------------------
@@ -100,6 +100,10 @@ public:
                         double remaining_dt,
                         MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables );
                         
+    //! Create the pairs of the photon decays recorded by pair_emission
+    //! \param particles   object particles containing the photons
+    void create_pairs( Particles &particles );
+    
     //! Clean photons that decayed into pairs (weight <= 0)
     //! \param particles   particle object containing the particle
     //!                    properties of the current species
@@ -159,6 +163,17 @@ private:
     //! Espilon to check when tau is near 0
     static constexpr double epsilon_tau_ = 1e-100;
     
+    // _________________________________________
+    // Photon decays of the current call, whose pairs are created at its end
+    
+    //! Index and weight of the decayed photon
+    std::vector<int> decayed_photons_;
+    std::vector<double> decayed_photon_weight_;
+    
+    //! Momentum and quantum parameter of the electron (k=0) and of the positron (k=1)
+    std::vector<double> pair_momentum_[2][3];
+    std::vector<double> pair_chi_[2];
+    
 };
 
 #endif
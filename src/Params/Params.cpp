@@ -1,7 +1,11 @@
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <ctime>
 #include <iomanip>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define SMILEI_IMPORT_ARRAY
 
@@ -205,6 +209,11 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         srand48( random_seed );
         // Init of the seed for the C++ random generator
         Rand::gen = std::mt19937( random_seed );
+    } else {
+        // Seed from the machine clock, identical on all processes so that each patch has its own random stream
+        int seed = time( NULL );
+        smpi->bcast( seed );
+        random_seed = seed;
     }
 
     // communication pattern initialized as partial B exchange
@@ -437,6 +446,13 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     PyTools::extract( "solve_relativistic_poisson", solve_relativistic_poisson, "Main"   );
     PyTools::extract( "relativistic_poisson_max_iteration", relativistic_poisson_max_iteration, "Main"   );
     PyTools::extract( "relativistic_poisson_max_error", relativistic_poisson_max_error, "Main"   );
+    PyTools::extract( "poisson_solver", poisson_solver, "Main"   );
+    if( poisson_solver != "cg" && poisson_solver != "pcg" ) {
+        ERROR( "Main.poisson_solver must be `cg` or `pcg`" );
+    }
+    if( poisson_solver == "pcg" && geometry == "AMcylindrical" ) {
+        ERROR( "Main.poisson_solver = `pcg` is not available in AMcylindrical geometry" );
+    }
 
     // PXR parameters
     PyTools::extract( "is_spectral", is_spectral, "Main"   );
@@ -455,6 +471,17 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     if( (maxwell_sol == "Lehe")||(maxwell_sol == "Bouchard") ) {
         full_B_exchange=true;
     }
+    PyTools::extract( "maxwell_kernel", maxwell_kernel, "Main"   );
+    if( maxwell_kernel != "standard" && maxwell_kernel != "fused" ) {
+        ERROR( "Main.maxwell_kernel must be `standard` or `fused`" );
+    }
+    if( maxwell_kernel == "fused" && ( geometry != "3Dcartesian" || maxwell_sol != "Yee" || is_pxr ) ) {
+        ERROR( "Main.maxwell_kernel = `fused` is only available for the Yee solver in 3Dcartesian geometry" );
+    }
+    PyTools::extract( "overlap_field_exchange", overlap_field_exchange, "Main"   );
+    PyTools::extract( "aggregate_mpi_messages", aggregate_mpi_messages, "Main"   );
+    PyTools::extract( "overlap_diag_reductions", overlap_diag_reductions, "Main"   );
+    PyTools::extract( "numa_first_touch", numa_first_touch, "Main"   );
 
     // Current filter properties
     int nCurrentFilter = PyTools::nComponents( "CurrentFilter" );
@@ -608,11 +635,16 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         PyTools::extract( "cell_load", cell_load, "LoadBalancing"   );
         PyTools::extract( "frozen_particle_load", frozen_particle_load, "LoadBalancing"   );
         PyTools::extract( "initial_balance", initial_balance, "LoadBalancing"   );
+        PyTools::extract( "cost_model", load_balancing_cost_model, "LoadBalancing"   );
+        if( load_balancing_cost_model != "particles" && load_balancing_cost_model != "measured" ) {
+            ERROR( "In block LoadBalancing, cost_model must be `particles` or `measured`" );
+        }
     } else {
         load_balancing_time_selection = new TimeSelection();
     }
 
     has_load_balancing = ( smpi->getSize()>1 )  && ( ! load_balancing_time_selection->isEmpty() );
+    measure_patch_load = has_load_balancing && ( load_balancing_cost_model == "measured" );
 
     if( has_load_balancing && patch_arrangement != "hilbertian" ) {
         ERROR( "Dynamic load balancing is only available for Hilbert decomposition" );
@@ -640,6 +672,19 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     has_adaptive_vectorization = false;
     adaptive_vecto_time_selection = nullptr;
 
+    // Vector width of the vectorized operators, by default from the instruction set targeted at compile time
+#if defined( __AVX512F__ )
+    vectorization_width = 8;
+#elif defined( __ARM_FEATURE_SVE_BITS ) && __ARM_FEATURE_SVE_BITS > 0
+    vectorization_width = std::min( std::max( __ARM_FEATURE_SVE_BITS/64, 4 ), 16 );
+#elif defined( __AVX__ ) || defined( __ARM_NEON )
+    vectorization_width = 4;
+#else
+    vectorization_width = 8;
+#endif
+    vectorization_sort_threshold = 0.3;
+    vectorization_block_size = 0;
+
     if( PyTools::nComponents( "Vectorization" )>0 ) {
         // Extraction of the vectorization mode
         PyTools::extract( "mode", vectorization_mode, "Vectorization"   );
@@ -666,6 +711,21 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
             ERROR( "In block `Vectorization`, parameter `default` must be `off` or `on`" );
         }
 
+        // Vector width (None = detected)
+        PyTools::extractOrNone( "vector_width", vectorization_width, "Vectorization" );
+        if( vectorization_width != 4 && vectorization_width != 8 && vectorization_width != 16 ) {
+            ERROR( "In block `Vectorization`, parameter `vector_width` must be 4, 8 or 16" );
+        }
+
+        // Choice of the particle sorting algorithm
+        PyTools::extract( "counting_sort_threshold", vectorization_sort_threshold, "Vectorization" );
+        if( vectorization_sort_threshold < 0. ) {
+            ERROR( "In block `Vectorization`, parameter `counting_sort_threshold` must be positive" );
+        }
+
+        // Pipelining of the particle operators by blocks of particles
+        PyTools::extract( "particle_block_size", vectorization_block_size, "Vectorization" );
+
         // get parameter "every" which describes a timestep selection
         if( ! adaptive_vecto_time_selection )
             adaptive_vecto_time_selection = new TimeSelection(
@@ -1037,6 +1097,34 @@ void Params::compute()
         full_B_exchange = true;
     }
 
+    // The overlapped exchange of B needs a solver which can update the borders of the patches first
+    if( overlap_field_exchange && ( geometry == "AMcylindrical" || maxwell_sol != "Yee" || maxwell_kernel != "standard" || is_pxr || full_B_exchange ) ) {
+        ERROR( "Main.overlap_field_exchange is only available for the Yee solver with the standard kernel, in cartesian geometries, without spectral solvers, uncoupled grids or Buneman boundary conditions" );
+    }
+
+    // The AM modes and the uncoupled grids keep their own exchanges, patch by patch
+    if( geometry == "AMcylindrical" || uncoupled_grids ) {
+        aggregate_mpi_messages = false;
+    }
+
+    // The spectral solvers share the data of some fields, which cannot be moved separately
+    if( numa_first_touch && is_spectral ) {
+        ERROR( "Main.numa_first_touch is not available with spectral solvers" );
+    }
+#ifdef _OPENMP
+    // All the loops on patches with a runtime schedule give the same patches to the same threads
+    if( numa_first_touch ) {
+        omp_set_schedule( omp_sched_static, 0 );
+        // A thread which is not bound to a core may run on another NUMA node at each timestep
+        const char *proc_bind = getenv( "OMP_PROC_BIND" );
+        const char *places    = getenv( "OMP_PLACES" );
+        bool bound_threads = proc_bind ? string( proc_bind ) != "false" && string( proc_bind ) != "FALSE" : places != NULL;
+        if( !bound_threads ) {
+            WARNING( "Main.numa_first_touch: the threads are not bound (OMP_PROC_BIND and OMP_PLACES are not set), the patches may be copied again at each timestep" );
+        }
+    }
+#endif
+
 }
 
 
@@ -1095,6 +1183,9 @@ void Params::print_init()
     TITLE( "Geometry: " << geometry );
     MESSAGE( 1, "Interpolation order : " <<  interpolation_order );
     MESSAGE( 1, "Maxwell solver : " <<  maxwell_sol );
+    if( maxwell_kernel != "standard" ) {
+        MESSAGE( 1, "Maxwell kernel : " <<  maxwell_kernel );
+    }
     MESSAGE( 1, "(Time resolution, Total simulation time) : (" << res_time << ", " << simulation_time << ")" );
     MESSAGE( 1, "(Total number of iterations,   timestep) : (" << n_time << ", " << timestep << ")" );
     MESSAGE( 1, "           timestep  = " << timestep/dtCFL << " * CFL" );
@@ -1131,6 +1222,18 @@ void Params::print_init()
     if( full_B_exchange ) {
         MESSAGE( 1, "All components of B are exchanged at synchronization" );
     }
+    if( overlap_field_exchange ) {
+        MESSAGE( 1, "The exchange of B is overlapped with the update of the interior of the patches" );
+    }
+    if( aggregate_mpi_messages ) {
+        MESSAGE( 1, "The halo messages of the patches are aggregated per neighbour process" );
+    }
+    if( overlap_diag_reductions ) {
+        MESSAGE( 1, "The reductions of the particle binning diagnostics overlap the next timestep" );
+    }
+    if( numa_first_touch ) {
+        MESSAGE( 1, "The memory of the patches is first touched by the threads which compute them (NUMA-aware mode)" );
+    }
 
     if( has_load_balancing ) {
         TITLE( "Load Balancing: " );
@@ -1142,10 +1245,14 @@ void Params::print_init()
         MESSAGE( 1, "Happens: " << load_balancing_time_selection->info() );
         MESSAGE( 1, "Cell load coefficient = " << cell_load );
         MESSAGE( 1, "Frozen particle load coefficient = " << frozen_particle_load );
+        MESSAGE( 1, "Cost model: " << load_balancing_cost_model );
     }
 
     TITLE( "Vectorization: " );
     MESSAGE( 1, "Mode: " << vectorization_mode );
+    if( vectorization_mode != "off" ) {
+        MESSAGE( 1, "Vector width: " << vectorization_width );
+    }
     if( vectorization_mode == "adaptive_mixed_sort" || vectorization_mode == "adaptive" ) {
         MESSAGE( 1, "Default mode: " << adaptive_default_mode );
         MESSAGE( 1, "Time selection: " << adaptive_vecto_time_selection->info() );
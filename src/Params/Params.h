@@ -153,6 +153,8 @@ public:
     unsigned int poisson_max_iteration;
     //! Maxium poisson error tolerated
     double poisson_max_error;
+    //! Iterative method of the Poisson solvers: "cg" (conjugate gradient) or "pcg" (preconditioned, one reduction per iteration)
+    std::string poisson_solver;
 
     //"Relativistic" Poisson solver
     //! Do we solve "relativistic poisson problem" for relativistic species
@@ -170,6 +172,21 @@ public:
     //! Maxwell Solver (default='Yee')
     std::string maxwell_sol;
 
+    //! Maxwell solver kernel: "standard" (separate E and B sweeps) or "fused" (single tiled sweep, 3D Yee only)
+    std::string maxwell_kernel;
+
+    //! Overlap the exchange of B between patches with the update of the interior of the patches (Yee solver only)
+    bool overlap_field_exchange;
+
+    //! Aggregate the halo messages of all the patches sent to the same neighbour process
+    bool aggregate_mpi_messages;
+
+    //! Reduce the particle binning diagnostics without blocking, and write them during the next timestep
+    bool overlap_diag_reductions;
+
+    //! Keep the same patches on the same threads, and move the memory of each patch to the NUMA node of its thread
+    bool numa_first_touch;
+
     //! Current spatial filter: number of binomial passes
     std::vector<unsigned int> currentFilter_passes;
     std::string currentFilter_model;
@@ -271,6 +288,10 @@ public:
     double cell_load;
     //! Load coefficient applied to a frozen particle (default = 0.1)
     double frozen_particle_load;
+    //! Model for the load of a patch: "particles" (number of particles) or "measured" (computing time)
+    std::string load_balancing_cost_model;
+    //! True if the computing time of each patch must be measured for the load balancing
+    bool measure_patch_load;
     //! Return if number of patch = number of MPI process, to tune IO //ism
     bool one_patch_per_MPI;
     //! Compute an initially balanced patch distribution right from the start
@@ -280,6 +301,12 @@ public:
     std::string vectorization_mode;
     //! Initial state of the patches in adaptive mode
     std::string adaptive_default_mode;
+    //! Number of doubles processed together by the vectorized 3D operators (4, 8 or 16)
+    unsigned int vectorization_width;
+    //! Fraction of moved particles above which the vectorized species use the counting sort instead of the cycle sort
+    double vectorization_sort_threshold;
+    //! Maximum number of particles of the blocks pipelined through the vectorized 3D operators (0: whole patch)
+    unsigned int vectorization_block_size;
 
     //! Tells whether there is a moving window
     bool hasWindow;
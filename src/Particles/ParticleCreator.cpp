@@ -282,7 +282,10 @@ int ParticleCreator::create( struct SubSpace sub_space,
             if( species_->getNbrOfParticles() != patch->vecSpecies[ispec]->getNbrOfParticles() ) {
                 ERROR( "Copying particles: species '"<<species_->name_<<"' and '"<<patch->vecSpecies[ispec]->name_<<"' should have the same number of particles");
             }
-            particles_->Position = patch->vecSpecies[ispec]->particles->Position;
+            Particles *other = patch->vecSpecies[ispec]->particles;
+            for( unsigned int idim=0 ; idim<particles_->dimension() ; idim++ ) {
+                std::copy( other->Position[idim].begin(), other->Position[idim].end(), particles_->Position[idim].begin() );
+            }
         }
         
         // In AM, normalization of weights might be required
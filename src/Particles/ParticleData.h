@@ -5,6 +5,8 @@
 #include "PyTools.h"
 
 #include <numpy/arrayobject.h>
+#include <vector>
+#include <algorithm>
 
 #include "Particles.h"
 
@@ -90,24 +92,24 @@ public:
     };
 
     // Expose a vector to numpy
-    inline PyArrayObject *vector2numpy( std::vector<double> &vec )
+    inline PyArrayObject *vector2numpy( double *data )
     {
-        return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_DOUBLE, ( double * )( &vec[start] ) );
+        return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_DOUBLE, ( double * )( data + start ) );
     };
-    inline PyArrayObject *vector2numpy( std::vector<uint64_t> &vec )
+    inline PyArrayObject *vector2numpy( uint64_t *data )
     {
-        return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_UINT64, ( uint64_t * )( &vec[start] ) );
+        return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_UINT64, ( uint64_t * )( data + start ) );
     };
-    inline PyArrayObject *vector2numpy( std::vector<short> &vec )
+    inline PyArrayObject *vector2numpy( short *data )
     {
-        return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_SHORT, ( short * )( &vec[start] ) );
+        return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_SHORT, ( short * )( data + start ) );
     };
 
-    // Add a C++ vector as an attribute, but exposed as a numpy array
-    template <typename T>
-    inline void setVectorAttr( std::vector<T> &vec, std::string name )
+    // Add a C++ vector (or a property of the particles) as an attribute, but exposed as a numpy array
+    template <typename Vector>
+    inline void setVectorAttr( Vector &vec, std::string name )
     {
-        PyArrayObject *numpy_vector = vector2numpy( vec );
+        PyArrayObject *numpy_vector = vector2numpy( vec.data() );
         PyObject_SetAttrString( particles, name.c_str(), ( PyObject * )numpy_vector );
         attrs.push_back( numpy_vector );
     };
@@ -144,6 +146,68 @@ public:
         }
     };
 
+    // Set all attributes from the particles of several containers, one after the other
+    // The particles are copied once in buffers owned by this object
+    inline void set( std::vector<Particles *> &containers )
+    {
+        unsigned int npart = 0;
+        for( unsigned int i=0; i<containers.size(); i++ ) {
+            npart += containers[i]->size();
+        }
+        resize( npart );
+        startAt( 0 );
+        if( containers.empty() ) {
+            return;
+        }
+        Particles *p0 = containers[0];
+        unsigned int nDim_particle = p0->Position.size();
+        position_.resize( nDim_particle );
+        for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+            concatenate( containers, position_[idim], [idim]( Particles *p ) -> ParticleProperty<double> & { return p->Position[idim]; } );
+        }
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            concatenate( containers, momentum_[idim], [idim]( Particles *p ) -> ParticleProperty<double> & { return p->Momentum[idim]; } );
+        }
+        concatenate( containers, weight_, []( Particles *p ) -> ParticleProperty<double> & { return p->Weight; } );
+        concatenate( containers, charge_, []( Particles *p ) -> ParticleProperty<short> & { return p->Charge; } );
+        const char *xyz[3] = { "x", "y", "z" };
+        const char *pxyz[3] = { "px", "py", "pz" };
+        for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+            setVectorAttr( position_[idim], xyz[idim] );
+        }
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            setVectorAttr( momentum_[idim], pxyz[idim] );
+        }
+        setVectorAttr( weight_, "weight" );
+        setVectorAttr( charge_, "charge" );
+        // The ids and chi exist only for some species
+        bool has_id = true, has_chi = true;
+        for( unsigned int i=0; i<containers.size(); i++ ) {
+            has_id  = has_id  && containers[i]->tracked;
+            has_chi = has_chi && containers[i]->isQuantumParameter;
+        }
+        if( has_id ) {
+            concatenate( containers, id_, []( Particles *p ) -> ParticleProperty<uint64_t> & { return p->Id; } );
+            setVectorAttr( id_, "id" );
+        }
+        if( has_chi ) {
+            concatenate( containers, chi_, []( Particles *p ) -> ParticleProperty<double> & { return p->Chi; } );
+            setVectorAttr( chi_, "chi" );
+        }
+    };
+
+    // Number of particles exposed
+    inline unsigned int size()
+    {
+        return dims[0];
+    };
+
+    // Whether no attribute has been set
+    inline bool empty()
+    {
+        return attrs.empty();
+    };
+
     inline PyObject *get()
     {
         return particles;
@@ -155,6 +219,24 @@ private:
     npy_intp dims[1];
     unsigned int start; // particles are read starting at that index
 
+    // Buffers holding the particles of several containers
+    std::vector<std::vector<double> > position_;
+    std::vector<double> momentum_[3], weight_, chi_;
+    std::vector<short> charge_;
+    std::vector<uint64_t> id_;
+
+    template <typename T, typename Getter>
+    void concatenate( std::vector<Particles *> &containers, std::vector<T> &buffer, Getter get_vector )
+    {
+        buffer.resize( dims[0] );
+        unsigned int offset = 0;
+        for( unsigned int i=0; i<containers.size(); i++ ) {
+            unsigned int npart = containers[i]->size();
+            std::copy( get_vector( containers[i] ).begin(), get_vector( containers[i] ).begin() + npart, buffer.begin() + offset );
+            offset += npart;
+        }
+    };
+
     void checkType( PyObject *obj, std::string &errorPrefix, bool *dummy )
     {
         if( !PyArray_ISBOOL( ( PyArrayObject * )obj ) ) {
@@ -0,0 +1,83 @@
+#ifndef PARTICLEPROPERTY_H
+#define PARTICLEPROPERTY_H
+
+#include <cstddef>
+
+class Particles;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class ParticleProperty
+//! View on one property of the particles (a position, a momentum, the weights...) stored in the arena of a Particles.
+//! It gives the subset of the std::vector interface used to read and write the particles; the number of particles is
+//! the one of the container, and only the container can change it or move the data.
+//! A property that is not registered in its container (the ids of untracked particles for instance) has no data and
+//! a size of zero.
+//  --------------------------------------------------------------------------------------------------------------------
+template<typename T>
+class ParticleProperty
+{
+public:
+    ParticleProperty() : data_( NULL ), size_( NULL ) {}
+
+    //! A view cannot be assigned: the data must be copied explicitly
+    ParticleProperty &operator=( const ParticleProperty & ) = delete;
+
+    inline T &operator[]( unsigned int i )
+    {
+        return data_[i];
+    }
+    inline const T &operator[]( unsigned int i ) const
+    {
+        return data_[i];
+    }
+
+    inline T *data()
+    {
+        return data_;
+    }
+    inline const T *data() const
+    {
+        return data_;
+    }
+
+    inline unsigned int size() const
+    {
+        return size_ ? *size_ : 0;
+    }
+    inline bool empty() const
+    {
+        return size() == 0;
+    }
+
+    inline T &back()
+    {
+        return data_[size()-1];
+    }
+
+    inline T *begin()
+    {
+        return data_;
+    }
+    inline T *end()
+    {
+        return data_ + size();
+    }
+    inline const T *begin() const
+    {
+        return data_;
+    }
+    inline const T *end() const
+    {
+        return data_ + size();
+    }
+
+private:
+    friend class Particles;
+
+    //! Segment of the property in the arena of the container
+    T *data_;
+    //! Number of particles of the container, NULL if the property is not registered
+    const unsigned int *size_;
+};
+
+#endif
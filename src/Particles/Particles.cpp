@@ -1,6 +1,8 @@
 #include "Particles.h"
 
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
 #include <iostream>
 
 #include "Params.h"
@@ -11,13 +13,41 @@
 
 using namespace std;
 
+namespace
+{
+//! The capacity grows by multiples of this number of particles, so that the segments of all the properties
+//! (2 or 8 bytes per particle) fill whole cache lines
+const unsigned int capacity_granularity = 32;
+
+//! Number of bytes of the segment of a property, for a given capacity
+inline size_t segmentBytes( unsigned int capacity, size_t element_size )
+{
+    return ( capacity*element_size + Particles::alignment - 1 ) / Particles::alignment * Particles::alignment;
+}
+
+//! Copy one element of a property: the usual sizes are constants, so that the copy is a single load and store
+inline void copyElement( char *dest, const char *src, size_t element_size )
+{
+    if( element_size == sizeof( double ) ) {
+        memcpy( dest, src, sizeof( double ) );
+    } else if( element_size == sizeof( short ) ) {
+        memcpy( dest, src, sizeof( short ) );
+    } else {
+        memcpy( dest, src, element_size );
+    }
+}
+}
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Constructor for Particle
 // ---------------------------------------------------------------------------------------------------------------------
 Particles::Particles():
-    tracked( false )
+    tracked( false ),
+    arena_( NULL ),
+    arena_bytes_( 0 ),
+    size_( 0 ),
+    capacity_( 0 )
 {
     Position.resize( 0 );
     Position_old.resize( 0 );
@@ -31,10 +61,43 @@ Particles::Particles():
     uint64_prop.resize( 0 );
 }
 
+Particles::Particles( const Particles &part ) :
+    Particles()
+{
+    *this = part;
+}
+
+Particles &Particles::operator=( const Particles &part )
+{
+    if( this == &part ) {
+        return *this;
+    }
+
+    releaseArena();
+    is_test = part.is_test;
+    tracked = part.tracked;
+    isQuantumParameter = part.isQuantumParameter;
+    isMonteCarlo = part.isMonteCarlo;
+
+    // The views of part point to its own arena: they are rebuilt from the flags
+    if( !part.double_prop.empty() ) {
+        registerProperties( part.dimension(), part.Position_old.size() > 0 );
+        setCapacity( part.capacity_, true );
+        size_ = part.size_;
+        for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+            memcpy( segment( iprop ), part.segment( iprop ), size_*element_size_[iprop] );
+        }
+    }
+
+    cell_keys = part.cell_keys;
+    first_index = part.first_index;
+    last_index = part.last_index;
+    return *this;
+}
+
 Particles::~Particles()
 {
-    clear();
-    shrinkToFit();
+    releaseArena();
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -42,60 +105,12 @@ Particles::~Particles()
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::initialize( unsigned int nParticles, unsigned int nDim, bool keep_position_old )
 {
-    //if (nParticles > Weight.capacity()) {
-    //    WARNING("You should increase c_part_max in specie namelist");
-    //}
-    if( Weight.size()==0 ) {
-        float c_part_max =1.2;
-        //float c_part_max = part.c_part_max;
-        //float c_part_max = params.species_param[0].c_part_max;
-        reserve( round( c_part_max * nParticles ), nDim );
-    }
-
-    resize( nParticles, nDim, keep_position_old );
-    cell_keys.resize( nParticles );
-
     if( double_prop.empty() ) {  // do this just once
-
-        Position.resize( nDim );
-        for( unsigned int i=0 ; i< nDim ; i++ ) {
-            double_prop.push_back( &( Position[i] ) );
-        }
-
-        for( unsigned int i=0 ; i< 3 ; i++ ) {
-            double_prop.push_back( &( Momentum[i] ) );
-        }
-
-        double_prop.push_back( &Weight );
-
-        if( keep_position_old ) {
-            Position_old.resize( nDim );
-            for( unsigned int i=0 ; i< nDim ; i++ ) {
-                double_prop.push_back( &( Position_old[i] ) );
-            }
-        }
-
-        short_prop.push_back( &Charge );
-        if( tracked ) {
-            uint64_prop.push_back( &Id );
-        }
-
-        // Quantum parameter (for QED effects):
-        // - if radiation reaction (continuous or discontinuous)
-        // - if multiphoton-Breit-Wheeler if photons
-        if( isQuantumParameter ) {
-            double_prop.push_back( &Chi );
-        }
-
-        // Optical Depth for Monte-Carlo processes:
-        // - if the discontinuous (Monte-Carlo) radiation reaction
-        // are activated, tau is the incremental optical depth to emission
-        if( isMonteCarlo ) {
-            double_prop.push_back( &Tau );
-        }
-
+        registerProperties( nDim, keep_position_old );
     }
 
+    resize( nParticles );
+    cell_keys.resize( nParticles );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -114,107 +129,230 @@ void Particles::initialize( unsigned int nParticles, Particles &part )
     initialize( nParticles, part.Position.size(), part.Position_old.size() > 0 );
 }
 
-
-
 // ---------------------------------------------------------------------------------------------------------------------
-// Set capacity of Particles vectors
+// Register the properties and lay out the arena
 // ---------------------------------------------------------------------------------------------------------------------
-void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
+void Particles::registerProperties( unsigned int nDim, bool keep_position_old )
 {
-    return;
+    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        double_prop[iprop]->data_ = NULL;
+        double_prop[iprop]->size_ = NULL;
+    }
+    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        short_prop[iprop]->data_ = NULL;
+        short_prop[iprop]->size_ = NULL;
+    }
+    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        uint64_prop[iprop]->data_ = NULL;
+        uint64_prop[iprop]->size_ = NULL;
+    }
+    double_prop.clear();
+    short_prop.clear();
+    uint64_prop.clear();
 
+    Position.clear();
     Position.resize( nDim );
-    Position_old.resize( nDim );
     for( unsigned int i=0 ; i< nDim ; i++ ) {
-        Position[i].reserve( n_part_max );
-        Position_old[i].reserve( n_part_max );
+        double_prop.push_back( &( Position[i] ) );
     }
+
+    Momentum.clear();
     Momentum.resize( 3 );
     for( unsigned int i=0 ; i< 3 ; i++ ) {
-        Momentum[i].reserve( n_part_max );
+        double_prop.push_back( &( Momentum[i] ) );
     }
-    Weight.reserve( n_part_max );
-    Charge.reserve( n_part_max );
 
+    double_prop.push_back( &Weight );
+
+    Position_old.clear();
+    if( keep_position_old ) {
+        Position_old.resize( nDim );
+        for( unsigned int i=0 ; i< nDim ; i++ ) {
+            double_prop.push_back( &( Position_old[i] ) );
+        }
+    }
+
+    short_prop.push_back( &Charge );
     if( tracked ) {
-        Id.reserve( n_part_max );
+        uint64_prop.push_back( &Id );
     }
 
+    // Quantum parameter (for QED effects):
+    // - if radiation reaction (continuous or discontinuous)
+    // - if multiphoton-Breit-Wheeler if photons
     if( isQuantumParameter ) {
-        Chi.reserve( n_part_max );
+        double_prop.push_back( &Chi );
     }
 
+    // Optical Depth for Monte-Carlo processes:
+    // - if the discontinuous (Monte-Carlo) radiation reaction
+    // are activated, tau is the incremental optical depth to emission
     if( isMonteCarlo ) {
-        Tau.reserve( n_part_max );
+        double_prop.push_back( &Tau );
     }
 
+    element_size_.assign( double_prop.size(), sizeof( double ) );
+    element_size_.insert( element_size_.end(), short_prop.size(), sizeof( short ) );
+    element_size_.insert( element_size_.end(), uint64_prop.size(), sizeof( uint64_t ) );
+    layOut( capacity_, offset_ );
+    bindViews();
 }
 
-void Particles::initializeReserve( unsigned int npart_max, Particles &part )
+// ---------------------------------------------------------------------------------------------------------------------
+// Offsets of the segments of the properties, each segment being rounded to the alignment
+// ---------------------------------------------------------------------------------------------------------------------
+size_t Particles::layOut( unsigned int capacity, vector<size_t> &offset ) const
 {
-    initialize( 0, part );
-    reserve( npart_max, part.dimension() );
+    offset.resize( element_size_.size() );
+    size_t bytes = 0;
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        offset[iprop] = bytes;
+        bytes += segmentBytes( capacity, element_size_[iprop] );
+    }
+    return bytes;
 }
 
-
-
 // ---------------------------------------------------------------------------------------------------------------------
-//Resize Particle vectors
+// Change the capacity, the particles being kept
 // ---------------------------------------------------------------------------------------------------------------------
-void Particles::resize( unsigned int nParticles, unsigned int nDim, bool keep_position_old )
+void Particles::setCapacity( unsigned int capacity, bool reallocate )
 {
-    Position.resize( nDim );
-    for( unsigned int i=0 ; i<nDim ; i++ ) {
-        Position[i].resize( nParticles, 0. );
-    }
-    
-    if( keep_position_old ) {
-        Position_old.resize( nDim );
-        for( unsigned int i=0 ; i<nDim ; i++ ) {
-            Position_old[i].resize( nParticles, 0. );
+    vector<size_t> offset;
+    size_t bytes = layOut( capacity, offset );
+    unsigned int nprop = element_size_.size();
+
+    if( !reallocate && bytes <= arena_bytes_ ) {
+        // The segments move towards the end of the arena if the capacity grows, towards its start otherwise:
+        // they are moved in the order that never overwrites a segment not moved yet
+        if( size_ > 0 ) {
+            for( unsigned int i=0 ; i<nprop ; i++ ) {
+                unsigned int iprop = capacity > capacity_ ? nprop-1-i : i;
+                memmove( arena_ + offset[iprop], segment( iprop ), size_*element_size_[iprop] );
+            }
         }
+    } else {
+        char *arena = NULL;
+        if( bytes > 0 ) {
+            void *ptr = NULL;
+            if( posix_memalign( &ptr, alignment, bytes ) != 0 ) {
+                ERROR( "Cannot allocate " << bytes << " bytes for " << capacity << " particles" );
+            }
+            arena = static_cast<char *>( ptr );
+            if( size_ > 0 ) {
+                for( unsigned int iprop=0 ; iprop<nprop ; iprop++ ) {
+                    memcpy( arena + offset[iprop], segment( iprop ), size_*element_size_[iprop] );
+                }
+            }
+        }
+        free( arena_ );
+        arena_ = arena;
+        arena_bytes_ = bytes;
     }
 
-    Momentum.resize( 3 );
-    for( unsigned int i=0 ; i< 3 ; i++ ) {
-        Momentum[i].resize( nParticles, 0. );
-    }
-
-    Weight.resize( nParticles, 0. );
-    Charge.resize( nParticles, 0 );
+    capacity_ = capacity;
+    offset_.swap( offset );
+    bindViews();
+}
 
-    if( tracked ) {
-        Id.resize( nParticles, 0 );
+// ---------------------------------------------------------------------------------------------------------------------
+// Growth policy: the capacity grows by half, at least up to nParticles
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::grow( unsigned int nParticles )
+{
+    if( nParticles <= capacity_ ) {
+        return;
     }
+    unsigned int capacity = max( nParticles, capacity_ + capacity_/2 );
+    capacity = ( capacity + capacity_granularity - 1 ) / capacity_granularity * capacity_granularity;
+    setCapacity( capacity, false );
+}
 
-    if( isQuantumParameter ) {
-        Chi.resize( nParticles, 0. );
+// ---------------------------------------------------------------------------------------------------------------------
+// Open a gap of nParticles particles at position pos, the following particles being shifted
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::insertGap( unsigned int pos, unsigned int nParticles )
+{
+    unsigned int nmove = size_ - pos;
+    grow( size_ + nParticles );
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        memmove( segment( iprop ) + ( pos+nParticles )*s, segment( iprop ) + pos*s, nmove*s );
     }
+    size_ += nParticles;
+}
 
-    if( isMonteCarlo ) {
-        Tau.resize( nParticles, 0. );
+void Particles::bindViews()
+{
+    unsigned int iprop = 0;
+    for( unsigned int i=0 ; i<double_prop.size() ; i++, iprop++ ) {
+        double_prop[i]->data_ = arena_ ? reinterpret_cast<double *>( segment( iprop ) ) : NULL;
+        double_prop[i]->size_ = &size_;
     }
+    for( unsigned int i=0 ; i<short_prop.size() ; i++, iprop++ ) {
+        short_prop[i]->data_ = arena_ ? reinterpret_cast<short *>( segment( iprop ) ) : NULL;
+        short_prop[i]->size_ = &size_;
+    }
+    for( unsigned int i=0 ; i<uint64_prop.size() ; i++, iprop++ ) {
+        uint64_prop[i]->data_ = arena_ ? reinterpret_cast<uint64_t *>( segment( iprop ) ) : NULL;
+        uint64_prop[i]->size_ = &size_;
+    }
+}
 
+void Particles::releaseArena()
+{
+    free( arena_ );
+    arena_ = NULL;
+    arena_bytes_ = 0;
+    size_ = 0;
+    capacity_ = 0;
+    layOut( 0, offset_ );
+    bindViews();
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Resize Particle vectors with nParticles
+// Set capacity of Particles vectors
+// Nothing is reserved in advance: the capacity follows the growth policy of the arena
 // ---------------------------------------------------------------------------------------------------------------------
-void Particles::resize( unsigned int nParticles)
+void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
 {
+}
 
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).resize( nParticles, 0. );
-    }
+void Particles::initializeReserve( unsigned int npart_max, Particles &part )
+{
+    initialize( 0, part );
+    reserve( npart_max, part.dimension() );
+}
 
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).resize( nParticles, 0 );
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//Resize Particle vectors
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::resize( unsigned int nParticles, unsigned int nDim, bool keep_position_old )
+{
+    if( double_prop.empty() ) {
+        registerProperties( nDim, keep_position_old );
     }
+    resize( nParticles );
+}
 
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).resize( nParticles, 0 );
+// ---------------------------------------------------------------------------------------------------------------------
+// Resize Particle vectors with nParticles, the new particles being null
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::resize( unsigned int nParticles)
+{
+    if( element_size_.empty() ) {
+        return;
     }
 
+    if( nParticles > size_ ) {
+        grow( nParticles );
+        for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+            size_t s = element_size_[iprop];
+            memset( segment( iprop ) + size_*s, 0, ( nParticles-size_ )*s );
+        }
+    }
+    size_ = nParticles;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -222,18 +360,28 @@ void Particles::resize( unsigned int nParticles)
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::shrinkToFit()
 {
+    setCapacity( size_, true );
+}
 
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        std::vector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
-    }
 
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        std::vector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
-    }
+// Copy a vector to memory first touched by the calling thread, keeping its capacity
+template<typename T>
+static void firstTouchVector( std::vector<T> &v )
+{
+    std::vector<T> copy;
+    copy.reserve( v.capacity() );
+    copy.assign( v.begin(), v.end() );
+    v.swap( copy );
+}
 
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        std::vector<uint64_t>( *uint64_prop[iprop] ).swap( *uint64_prop[iprop] );
-    }
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy the properties to memory first touched by the calling thread (on its NUMA node)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::firstTouch()
+{
+    setCapacity( capacity_, true );
+
+    firstTouchVector( cell_keys );
 }
 
 
@@ -242,51 +390,115 @@ void Particles::shrinkToFit()
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::clear()
 {
+    size_ = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Exchange the data of all properties with another Particles
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::swapData( Particles &part )
+{
+    std::swap( arena_, part.arena_ );
+    std::swap( arena_bytes_, part.arena_bytes_ );
+    std::swap( size_, part.size_ );
+    std::swap( capacity_, part.capacity_ );
+    offset_.swap( part.offset_ );
+    bindViews();
+    part.bindViews();
+
+    cell_keys.swap( part.cell_keys );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Out-of-place copy of the particles to the positions dest in dest_parts, property by property
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::scatterParticles( const std::vector<int> &dest, Particles &dest_parts )
+{
+    const int *__restrict__ d = dest.data();
+    unsigned int n = dest.size();
+
     for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        double_prop[iprop]->clear();
+        const double *__restrict__ src = double_prop[iprop]->data();
+        double *__restrict__ dst = dest_parts.double_prop[iprop]->data();
+        for( unsigned int ip=0 ; ip<n ; ip++ ) {
+            if( d[ip] >= 0 ) {
+                dst[d[ip]] = src[ip];
+            }
+        }
     }
 
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        short_prop[iprop]->clear();
+        const short *__restrict__ src = short_prop[iprop]->data();
+        short *__restrict__ dst = dest_parts.short_prop[iprop]->data();
+        for( unsigned int ip=0 ; ip<n ; ip++ ) {
+            if( d[ip] >= 0 ) {
+                dst[d[ip]] = src[ip];
+            }
+        }
     }
 
     for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        uint64_prop[iprop]->clear();
+        const uint64_t *__restrict__ src = uint64_prop[iprop]->data();
+        uint64_t *__restrict__ dst = dest_parts.uint64_prop[iprop]->data();
+        for( unsigned int ip=0 ; ip<n ; ip++ ) {
+            if( d[ip] >= 0 ) {
+                dst[d[ip]] = src[ip];
+            }
+        }
     }
 }
 
-
-void Particles::copyParticle( unsigned int ipart )
+// ---------------------------------------------------------------------------------------------------------------------
+// Pack and unpack the particles in a contiguous buffer, for the MPI messages.
+// The packed layout is the layout of the arena for a capacity equal to the number of particles.
+// ---------------------------------------------------------------------------------------------------------------------
+size_t Particles::packedSize( unsigned int nParticles ) const
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
+    size_t bytes = 0;
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        bytes += segmentBytes( nParticles, element_size_[iprop] );
     }
+    return bytes;
+}
 
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
+void Particles::pack( char *buffer ) const
+{
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        memcpy( buffer, segment( iprop ), size_*element_size_[iprop] );
+        buffer += segmentBytes( size_, element_size_[iprop] );
     }
+}
 
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        uint64_prop[iprop]->push_back( ( *uint64_prop[iprop] )[ipart] );
+void Particles::unpack( const char *buffer )
+{
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        memcpy( segment( iprop ), buffer, size_*element_size_[iprop] );
+        buffer += segmentBytes( size_, element_size_[iprop] );
     }
 }
 
+void Particles::compact()
+{
+    setCapacity( size_, false );
+}
+
+void Particles::copyParticle( unsigned int ipart )
+{
+    copyParticle( ipart, *this );
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Copy particle iPart at the end of dest_parts
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::copyParticle( unsigned int ipart, Particles &dest_parts )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        dest_parts.double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->push_back( ( *uint64_prop[iprop] )[ipart] );
+    unsigned int idest = dest_parts.size_;
+    dest_parts.grow( idest+1 );
+    dest_parts.size_++;
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        copyElement( dest_parts.segment( iprop ) + idest*s, segment( iprop ) + ipart*s, s );
     }
 }
 
@@ -295,18 +507,15 @@ void Particles::copyParticle( unsigned int ipart, Particles &dest_parts )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::copyParticle( unsigned int ipart, Particles &dest_parts, int dest_id )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, ( *double_prop[iprop] )[ipart] );
+    dest_parts.insertGap( dest_id, 1 );
+    // Within the same particles, the gap shifts the particle to copy
+    if( &dest_parts == this && ipart >= ( unsigned int )dest_id ) {
+        ipart++;
     }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, ( *short_prop[iprop] )[ipart] );
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        copyElement( dest_parts.segment( iprop ) + dest_id*s, segment( iprop ) + ipart*s, s );
     }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->insert( dest_parts.uint64_prop[iprop]->begin() + dest_id, ( *uint64_prop[iprop] )[ipart] );
-    }
-
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -314,22 +523,17 @@ void Particles::copyParticle( unsigned int ipart, Particles &dest_parts, int des
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::copyParticles( unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, double_prop[iprop]->begin()+iPart, double_prop[iprop]->begin()+iPart+nPart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, short_prop[iprop]->begin()+iPart, short_prop[iprop]->begin()+iPart+nPart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->insert( dest_parts.uint64_prop[iprop]->begin() + dest_id, uint64_prop[iprop]->begin()+iPart, uint64_prop[iprop]->begin()+iPart+nPart );
+    dest_parts.insertGap( dest_id, nPart );
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        memcpy( dest_parts.segment( iprop ) + dest_id*s, segment( iprop ) + iPart*s, nPart*s );
     }
 }
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Copy particle iPart at the end of dest_parts -- safe
+// (only the properties that both particles have are copied, the others being null)
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::copyParticleSafe( unsigned int ipart, Particles &dest_parts )
 {
@@ -341,17 +545,20 @@ void Particles::copyParticleSafe( unsigned int ipart, Particles &dest_parts )
     if( dest_parts.uint64_prop.size() < nuint ) {
         nuint = dest_parts.uint64_prop.size();
     }
-    
+
+    unsigned int idest = dest_parts.size();
+    dest_parts.createParticle();
+
     for( unsigned int iprop=0 ; iprop<ndouble ; iprop++ ) {
-        dest_parts.double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
+        ( *dest_parts.double_prop[iprop] )[idest] = ( *double_prop[iprop] )[ipart];
     }
-    
+
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
+        ( *dest_parts.short_prop[iprop] )[idest] = ( *short_prop[iprop] )[ipart];
     }
-    
+
     for( unsigned int iprop=0 ; iprop<nuint ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->push_back( ( *uint64_prop[iprop] )[ipart] );
+        ( *dest_parts.uint64_prop[iprop] )[idest] = ( *uint64_prop[iprop] )[ipart];
     }
 }
 
@@ -361,18 +568,7 @@ void Particles::copyParticleSafe( unsigned int ipart, Particles &dest_parts )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::eraseParticle( unsigned int ipart )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).erase( ( *uint64_prop[iprop] ).begin()+ipart );
-    }
-
+    eraseParticle( ipart, 1 );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -380,36 +576,21 @@ void Particles::eraseParticle( unsigned int ipart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::eraseParticleTrail( unsigned int ipart )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart, ( *double_prop[iprop] ).end() );
+    if( ipart < size_ ) {
+        size_ = ipart;
     }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart, ( *short_prop[iprop] ).end() );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).erase( ( *uint64_prop[iprop] ).begin()+ipart, ( *uint64_prop[iprop] ).end() );
-    }
-
 }
 // ---------------------------------------------------------------------------------------------------------------------
 // Suppress npart particles from ipart
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::eraseParticle( unsigned int ipart, unsigned int npart )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart, ( *double_prop[iprop] ).begin()+ipart+npart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart, ( *short_prop[iprop] ).begin()+ipart+npart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).erase( ( *uint64_prop[iprop] ).begin()+ipart, ( *uint64_prop[iprop] ).begin()+ipart+npart );
+    unsigned int nmove = size_ - ipart - npart;
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        memmove( segment( iprop ) + ipart*s, segment( iprop ) + ( ipart+npart )*s, nmove*s );
     }
-
+    size_ -= npart;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -480,16 +661,13 @@ ostream &operator << ( ostream &out, const Particles &particles )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::swapParticle( unsigned int part1, unsigned int part2 )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        std::swap( ( *double_prop[iprop] )[part1], ( *double_prop[iprop] )[part2] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        std::swap( ( *short_prop[iprop] )[part1], ( *short_prop[iprop] )[part2] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        std::swap( ( *uint64_prop[iprop] )[part1], ( *uint64_prop[iprop] )[part2] );
+    char temp[sizeof( uint64_t )];
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        char *p = segment( iprop );
+        copyElement( temp, p + part1*s, s );
+        copyElement( p + part1*s, p + part2*s, s );
+        copyElement( p + part2*s, temp, s );
     }
 }
 
@@ -497,83 +675,63 @@ void Particles::swapParticle( unsigned int part1, unsigned int part2 )
 void Particles::swapParticle3( unsigned int part1, unsigned int part2, unsigned int part3 )
 {
     // 1 ==> 2 ==> 3 ==> 1
-    double temp;
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        temp = ( *double_prop[iprop] )[part1];
-        ( *double_prop[iprop] )[part1] = ( *double_prop[iprop] )[part3];
-        ( *double_prop[iprop] )[part3] = ( *double_prop[iprop] )[part2];
-        ( *double_prop[iprop] )[part2] = temp;
-    }
-
-    short stemp;
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        stemp = ( *short_prop[iprop] )[part1];
-        ( *short_prop[iprop] )[part1] = ( *short_prop[iprop] )[part3];
-        ( *short_prop[iprop] )[part3] = ( *short_prop[iprop] )[part2];
-        ( *short_prop[iprop] )[part2] = stemp;
-    }
-
-    unsigned int uitemp;
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        uitemp = ( *short_prop[iprop] )[part1];
-        ( *uint64_prop[iprop] )[part1] = ( *uint64_prop[iprop] )[part3];
-        ( *uint64_prop[iprop] )[part3] = ( *uint64_prop[iprop] )[part2];
-        ( *uint64_prop[iprop] )[part2] = uitemp;
+    char temp[sizeof( uint64_t )];
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        char *p = segment( iprop );
+        copyElement( temp, p + part1*s, s );
+        copyElement( p + part1*s, p + part3*s, s );
+        copyElement( p + part3*s, p + part2*s, s );
+        copyElement( p + part2*s, temp, s );
     }
-
 }
 
 
 void Particles::swapParticle4( unsigned int part1, unsigned int part2, unsigned int part3, unsigned int part4 )
 {
-    double temp;
     // 1 ==> 2 ==> 3 ==> 4 ==> 1
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        temp = ( *double_prop[iprop] )[part1];
-        ( *double_prop[iprop] )[part1] = ( *double_prop[iprop] )[part4];
-        ( *double_prop[iprop] )[part4] = ( *double_prop[iprop] )[part3];
-        ( *double_prop[iprop] )[part3] = ( *double_prop[iprop] )[part2];
-        ( *double_prop[iprop] )[part2] = temp;
-    }
-
-    short stemp;
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        stemp = ( *short_prop[iprop] )[part1];
-        ( *short_prop[iprop] )[part1] = ( *short_prop[iprop] )[part4];
-        ( *short_prop[iprop] )[part4] = ( *short_prop[iprop] )[part3];
-        ( *short_prop[iprop] )[part3] = ( *short_prop[iprop] )[part2];
-        ( *short_prop[iprop] )[part2] = stemp;
+    char temp[sizeof( uint64_t )];
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        char *p = segment( iprop );
+        copyElement( temp, p + part1*s, s );
+        copyElement( p + part1*s, p + part4*s, s );
+        copyElement( p + part4*s, p + part3*s, s );
+        copyElement( p + part3*s, p + part2*s, s );
+        copyElement( p + part2*s, temp, s );
     }
+}
 
-    unsigned int uitemp;
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        uitemp = ( *short_prop[iprop] )[part1];
-        ( *uint64_prop[iprop] )[part1] = ( *uint64_prop[iprop] )[part4];
-        ( *uint64_prop[iprop] )[part4] = ( *uint64_prop[iprop] )[part3];
-        ( *uint64_prop[iprop] )[part3] = ( *uint64_prop[iprop] )[part2];
-        ( *uint64_prop[iprop] )[part2] = uitemp;
-    }
 
+void Particles::swapParticles( const std::vector<unsigned int> &parts )
+{
+    swapParticles( parts.data(), parts.size() );
 }
 
 
-void Particles::swapParticles( std::vector<unsigned int> parts )
+void Particles::swapParticles( const unsigned int *parts, unsigned int nparts )
 {
-    // parts[0] ==> parts[1] ==> parts[2] ==> parts[parts.size()-1] ==> parts[0]
+    // parts[0] ==> parts[1] ==> parts[2] ==> parts[nparts-1] ==> parts[0]
 
-    copyParticle( parts.back() );
-    translateParticles( parts );
+    copyParticle( parts[nparts-1] );
+    translateParticles( parts, nparts );
     overwriteParticle( size()-1, parts[0] );
     eraseParticle( size()-1 );
 
 }
 
 
-void Particles::translateParticles( std::vector<unsigned int> parts )
+void Particles::translateParticles( const std::vector<unsigned int> &parts )
+{
+    translateParticles( parts.data(), parts.size() );
+}
+
+
+void Particles::translateParticles( const unsigned int *parts, unsigned int nparts )
 {
-    // parts[0] ==> parts[1] ==> parts[2] ==> parts[parts.size()-1]
+    // parts[0] ==> parts[1] ==> parts[2] ==> parts[nparts-1]
 
-    for( int icycle = parts.size()-2; icycle >=0; icycle-- ) {
+    for( int icycle = ( int )nparts-2; icycle >=0; icycle-- ) {
         overwriteParticle( parts[icycle], parts[icycle+1] );
     }
 
@@ -585,16 +743,9 @@ void Particles::translateParticles( std::vector<unsigned int> parts )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::overwriteParticle( unsigned int src_particle, unsigned int dest_particle )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] )[dest_particle] = ( *double_prop[iprop] )[src_particle];
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] )[dest_particle] = ( *short_prop[iprop] )[src_particle];
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] )[dest_particle] = ( *uint64_prop[iprop] )[src_particle];
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        copyElement( segment( iprop ) + dest_particle*s, segment( iprop ) + src_particle*s, s );
     }
 }
 
@@ -604,20 +755,9 @@ void Particles::overwriteParticle( unsigned int src_particle, unsigned int dest_
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::overwriteParticle( unsigned int part1, unsigned int part2, unsigned int N )
 {
-    unsigned int sizepart = N*sizeof( Position[0][0] );
-    unsigned int sizecharge = N*sizeof( Charge[0] );
-    unsigned int sizeid = N*sizeof( Id[0] );
-
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        memcpy( & ( *double_prop[iprop] )[part2],  &( *double_prop[iprop] )[part1], sizepart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        memcpy( & ( *short_prop[iprop] )[part2],  &( *short_prop[iprop] )[part1], sizecharge );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        memcpy( & ( *uint64_prop[iprop] )[part2],  &( *uint64_prop[iprop] )[part1], sizeid );
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        memcpy( segment( iprop ) + part2*s, segment( iprop ) + part1*s, N*s );
     }
 }
 
@@ -626,16 +766,9 @@ void Particles::overwriteParticle( unsigned int part1, unsigned int part2, unsig
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::overwriteParticle( unsigned int part1, Particles &dest_parts, unsigned int part2 )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *dest_parts.double_prop[iprop] )[part2] = ( *double_prop[iprop] )[part1];
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *dest_parts.short_prop[iprop] )[part2] = ( *short_prop[iprop] )[part1];
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *dest_parts.uint64_prop[iprop] )[part2] = ( *uint64_prop[iprop] )[part1];
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        copyElement( dest_parts.segment( iprop ) + part2*s, segment( iprop ) + part1*s, s );
     }
 }
 
@@ -644,22 +777,10 @@ void Particles::overwriteParticle( unsigned int part1, Particles &dest_parts, un
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::overwriteParticle( unsigned int part1, Particles &dest_parts, unsigned int part2, unsigned int N )
 {
-    unsigned int sizepart = N*sizeof( Position[0][0] );
-    unsigned int sizecharge = N*sizeof( Charge[0] );
-    unsigned int sizeid = N*sizeof( Id[0] );
-
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        memcpy( & ( *dest_parts.double_prop[iprop] )[part2],  &( *double_prop[iprop] )[part1], sizepart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        memcpy( & ( *dest_parts.short_prop[iprop] )[part2],  &( *short_prop[iprop] )[part1], sizecharge );
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        memcpy( dest_parts.segment( iprop ) + part2*s, segment( iprop ) + part1*s, N*s );
     }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        memcpy( & ( *dest_parts.uint64_prop[iprop] )[part2],  &( *uint64_prop[iprop] )[part1], sizeid );
-    }
-
 }
 
 
@@ -668,30 +789,11 @@ void Particles::overwriteParticle( unsigned int part1, Particles &dest_parts, un
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::swapParticle( unsigned int part1, unsigned int part2, unsigned int N )
 {
-    double *buffer[N];
-
-    unsigned int sizepart = N*sizeof( Position[0][0] );
-    unsigned int sizecharge = N*sizeof( Charge[0] );
-    unsigned int sizeid = N*sizeof( Id[0] );
-
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        memcpy( buffer, &( ( *double_prop[iprop] )[part1] ), sizepart );
-        memcpy( &( ( *double_prop[iprop] )[part1] ), &( ( *double_prop[iprop] )[part2] ), sizepart );
-        memcpy( &( ( *double_prop[iprop] )[part2] ), buffer, sizepart );
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        char *p = segment( iprop );
+        swap_ranges( p + part1*s, p + ( part1+N )*s, p + part2*s );
     }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        memcpy( buffer, &( ( *short_prop[iprop] )[part1] ), sizecharge );
-        memcpy( &( ( *short_prop[iprop] )[part1] ), &( ( *short_prop[iprop] )[part2] ), sizecharge );
-        memcpy( &( ( *short_prop[iprop] )[part2] ), buffer, sizecharge );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        memcpy( buffer, &( ( *uint64_prop[iprop] )[part1] ), sizeid );
-        memcpy( &( ( *uint64_prop[iprop] )[part1] ), &( ( *uint64_prop[iprop] )[part2] ), sizeid );
-        memcpy( &( ( *uint64_prop[iprop] )[part2] ), buffer, sizeid );
-    }
-
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -707,18 +809,7 @@ void Particles::pushToEnd( unsigned int iPart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::createParticle()
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).push_back( 0. );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).push_back( 0 );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).push_back( 0 );
-    }
-//MESSAGE("create1");
+    resize( size_+1 );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -726,20 +817,7 @@ void Particles::createParticle()
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::createParticles( int nAdditionalParticles )
 {
-    int nParticles = size();
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0. );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0 );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0 );
-    }
-
-//MESSAGE("create2");
+    resize( size_+nAdditionalParticles );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -747,26 +825,21 @@ void Particles::createParticles( int nAdditionalParticles )
 //! This function is optimized.
 //! The mask determines which particles to keep (>= 0) and which to delete (< 0)
 //! Particle order is kept in case the vector is sorted
+//! Each kept particle is moved once, all its properties at once, to the first free slot.
 //! Warning: This method do not update count, first_index and last_index in Species
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::eraseParticlesWithMask( int istart, int iend, vector <int> & mask ) {
 
     unsigned int idest = (unsigned int) istart;
-    unsigned int isrc = (unsigned int) istart;
-    while (isrc < (unsigned int) iend) {
-        if (mask[idest] < 0) {
-            if (mask[isrc] >= 0) {
-                overwriteParticle( isrc, idest);
+    for( unsigned int isrc = (unsigned int) istart ; isrc < (unsigned int) iend ; isrc++ ) {
+        if( mask[isrc] >= 0 ) {
+            if( isrc != idest ) {
+                overwriteParticle( isrc, idest );
                 cell_keys[idest] = cell_keys[isrc];
                 mask[idest] = 1;
                 mask[isrc] = -1;
-                idest++;
-            } else {
-                isrc++;
             }
-        } else {
             idest++;
-            isrc = idest;
         }
     }
 
@@ -783,19 +856,13 @@ void Particles::eraseParticlesWithMask( int istart, int iend, vector <int> & mas
 void Particles::eraseParticlesWithMask( int istart, int iend) {
 
     unsigned int idest = (unsigned int) istart;
-    unsigned int isrc = (unsigned int) istart;
-    while (isrc < (unsigned int) iend) {
-        if (cell_keys[idest] < 0) {
-            if (cell_keys[isrc] >= 0) {
-                overwriteParticle( isrc, idest);
+    for( unsigned int isrc = (unsigned int) istart ; isrc < (unsigned int) iend ; isrc++ ) {
+        if( cell_keys[isrc] >= 0 ) {
+            if( isrc != idest ) {
+                overwriteParticle( isrc, idest );
                 cell_keys[idest] = cell_keys[isrc];
-                idest++;
-            } else {
-                isrc++;
             }
-        } else {
             idest++;
-            isrc = idest;
         }
     }
 
@@ -845,17 +912,44 @@ void Particles::eraseParticlesWithMask( int istart, int iend) {
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::createParticles( int nAdditionalParticles, int pstart )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).insert( ( *double_prop[iprop] ).begin()+pstart, nAdditionalParticles, 0. );
-    }
-    
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).insert( ( *short_prop[iprop] ).begin()+pstart, nAdditionalParticles, 0 );
+    insertGap( pstart, nAdditionalParticles );
+    for( unsigned int iprop=0 ; iprop<element_size_.size() ; iprop++ ) {
+        size_t s = element_size_[iprop];
+        memset( segment( iprop ) + pstart*s, 0, nAdditionalParticles*s );
     }
-    
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).insert( ( *uint64_prop[iprop] ).begin()+pstart, nAdditionalParticles, 0 );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Create n_per_parent new particles per parent at the end of vectors, at the position of their parent
+// ---------------------------------------------------------------------------------------------------------------------
+unsigned int Particles::createParticlesFromParents( Particles &parents, const vector<int> &parent_index, unsigned int n_per_parent )
+{
+    unsigned int first = size();
+    unsigned int nparents = parent_index.size();
+    if( nparents == 0 ) {
+        return first;
+    }
+    createParticles( nparents*n_per_parent );
+
+    const int *__restrict__ index = parent_index.data();
+    for( unsigned int idim=0 ; idim<Position.size() ; idim++ ) {
+        const double *__restrict__ parent_position = parents.Position[idim].data();
+        double *__restrict__ new_position = Position[idim].data() + first;
+        double *__restrict__ new_position_old = Position_old.size() > 0 ? Position_old[idim].data() + first : NULL;
+        for( unsigned int j=0 ; j<n_per_parent ; j++ ) {
+            #pragma omp simd
+            for( unsigned int i=0 ; i<nparents ; i++ ) {
+                new_position[i*n_per_parent+j] = parent_position[index[i]];
+            }
+            if( new_position_old ) {
+                #pragma omp simd
+                for( unsigned int i=0 ; i<nparents ; i++ ) {
+                    new_position_old[i*n_per_parent+j] = parent_position[index[i]];
+                }
+            }
+        }
     }
+    return first;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -863,18 +957,7 @@ void Particles::createParticles( int nAdditionalParticles, int pstart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::moveParticles( int iPart, int new_pos )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).insert( ( *double_prop[iprop] ).begin()+new_pos,( *double_prop[iprop] )[iPart]  );
-    }
-    
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).insert( ( *short_prop[iprop] ).begin()+new_pos, ( *short_prop[iprop] )[iPart] );
-    }
-    
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).insert( ( *uint64_prop[iprop] ).begin()+new_pos,( *uint64_prop[iprop] )[iPart]  );
-    }
-  
+    copyParticle( iPart, *this, new_pos );
     eraseParticle( iPart+1 );
 }
 
@@ -9,6 +9,7 @@
 
 #include "Tools.h"
 #include "TimeSelection.h"
+#include "ParticleProperty.h"
 
 class Particle;
 
@@ -19,14 +20,23 @@ class Patch;
 
 //----------------------------------------------------------------------------------------------------------------------
 //! Particle class: holds the basic properties of a particle
+//! All the properties are stored in a single arena, one 64-byte aligned segment per property (structure of arrays).
+//! Position, Momentum, Weight... are views on these segments. When the number of particles exceeds the capacity,
+//! the capacity grows by half (at least up to the new number of particles) and the segments are laid out again.
 //----------------------------------------------------------------------------------------------------------------------
 class Particles
 {
 public:
+    //! Alignment of the arena and of the segment of each property (one cache line)
+    static const std::size_t alignment = 64;
 
     //! Constructor for Particle
     Particles();
 
+    //! Copy of the properties and of the particles
+    Particles( const Particles &part );
+    Particles &operator=( const Particles &part );
+
     //! Destructor for Particle
     ~Particles();
 
@@ -51,19 +61,45 @@ public:
     //! Remove extra capacity of Particles vectors
     void shrinkToFit();
 
+    //! Copy the properties to memory first touched by the calling thread
+    void firstTouch();
+
     //! Reset Particles vectors
     void clear();
 
+    //! Exchange the content of all the properties and cell_keys with another Particles of same structure
+    //! (the vectors themselves stay in place, so that the pointers of double_prop & co. remain valid)
+    void swapData( Particles &part );
+
+    //! Copy each particle ip of [0:dest.size()[ at position dest[ip] of dest_parts (skipped if dest[ip] < 0)
+    void scatterParticles( const std::vector<int> &dest, Particles &dest_parts );
+
+    //! Number of bytes of nParticles particles in the packed layout: the layout of the arena for a capacity of
+    //! nParticles, each property being followed by the padding up to the next multiple of 64 bytes
+    std::size_t packedSize( unsigned int nParticles ) const;
+    //! Copy all the particles in a buffer, in the packed layout
+    void pack( char *buffer ) const;
+    //! Copy the particles from a buffer written by pack(), the size being already set
+    void unpack( const char *buffer );
+    //! Set the capacity to the number of particles without reallocating, so that the arena holds the particles in
+    //! the packed layout and can be sent or received directly (packedSize( size() ) bytes from packedData())
+    void compact();
+    //! Start of the arena
+    inline char *packedData()
+    {
+        return arena_;
+    }
+
     //! Get number of particules
     inline unsigned int size() const
     {
-        return Weight.size();
+        return size_;
     }
 
     //! Get number of particules
     inline unsigned int capacity() const
     {
-        return Weight.capacity();
+        return capacity_;
     }
 
     //! Get dimension of particules
@@ -100,8 +136,10 @@ public:
 
     //! Exchange particles part1 & part2 memory location
     void swapParticle( unsigned int part1, unsigned int part2 );
-    void swapParticles( std::vector<unsigned int> parts );
-    void translateParticles( std::vector<unsigned int> parts );
+    void swapParticles( const std::vector<unsigned int> &parts );
+    void swapParticles( const unsigned int *parts, unsigned int nparts );
+    void translateParticles( const std::vector<unsigned int> &parts );
+    void translateParticles( const unsigned int *parts, unsigned int nparts );
     void swapParticle3( unsigned int part1, unsigned int part2, unsigned int part3 );
     void swapParticle4( unsigned int part1, unsigned int part2, unsigned int part3, unsigned int part4 );
 
@@ -132,6 +170,12 @@ public:
     //! Create nParticles new particles at position pstart in the particles data structure
     void createParticles( int nAdditionalParticles, int pstart );
 
+    //! Bulk creation of n_per_parent particles for each particle parent_index[i] of parents, all the
+    //! property vectors being resized once. The new particles take the position of their parent
+    //! (particle first+i*n_per_parent+j comes from parent_index[i]), the other properties being
+    //! written afterwards by the caller. Returns first, the index of the first new particle.
+    unsigned int createParticlesFromParents( Particles &parents, const std::vector<int> &parent_index, unsigned int n_per_parent );
+
     //! Move ipart at new_pos in the particles data structure
     void moveParticles( int iPart, int new_pos );
 
@@ -181,7 +225,7 @@ public:
     //! Method used to get the list of Particle position
     inline std::vector<double>  position( unsigned int idim ) const
     {
-        return Position[idim];
+        return std::vector<double>( Position[idim].begin(), Position[idim].end() );
     }
 
     //! Method used to get the Particle momentum
@@ -197,7 +241,7 @@ public:
     //! Method used to get the Particle momentum
     inline std::vector<double>  momentum( unsigned int idim ) const
     {
-        return Momentum[idim];
+        return std::vector<double>( Momentum[idim].begin(), Momentum[idim].end() );
     }
 
     //! Method used to get the Particle weight
@@ -213,7 +257,7 @@ public:
     //! Method used to get the Particle weight
     inline std::vector<double>  weight() const
     {
-        return Weight;
+        return std::vector<double>( Weight.begin(), Weight.end() );
     }
 
     //! Method used to get the Particle charge
@@ -229,7 +273,7 @@ public:
     //! Method used to get the list of Particle charges
     inline std::vector<short>  charge() const
     {
-        return Charge;
+        return std::vector<short>( Charge.begin(), Charge.end() );
     }
 
 
@@ -254,33 +298,33 @@ public:
     //! Partiles properties, respect type order : all double, all short, all unsigned int
 
     //! array containing the particle position
-    std::vector< std::vector<double> > Position;
+    std::vector< ParticleProperty<double> > Position;
 
     //! array containing the particle former (old) positions
-    std::vector< std::vector<double> >Position_old;
+    std::vector< ParticleProperty<double> >Position_old;
 
     //! array containing the particle moments
-    std::vector< std::vector<double> >  Momentum;
+    std::vector< ParticleProperty<double> >  Momentum;
 
     //! containing the particle weight: equivalent to a charge density
-    std::vector<double> Weight;
+    ParticleProperty<double> Weight;
 
     //! containing the particle quantum parameter
-    std::vector<double> Chi;
+    ParticleProperty<double> Chi;
 
     //! charge state of the particle (multiples of e>0)
-    std::vector<short> Charge;
+    ParticleProperty<short> Charge;
 
     //! Id of the particle
-    std::vector<uint64_t> Id;
+    ParticleProperty<uint64_t> Id;
 
     // Discontinuous radiation losses
 
     //! Incremental optical depth for
     //! the Monte-Carlo process
-    std::vector<double> Tau;
+    ParticleProperty<double> Tau;
 
-    //! cell_keys of the particle
+    //! cell_keys of the particle (work array of the species, outside of the arena: it is resized on its own)
     std::vector<int> cell_keys;
 
     // TEST PARTICLE PARAMETERS
@@ -311,7 +355,7 @@ public:
     //! Method used to get the Particle Ids
     inline std::vector<uint64_t> id() const
     {
-        return Id;
+        return std::vector<uint64_t>( Id.begin(), Id.end() );
     }
     void sortById();
 
@@ -337,7 +381,7 @@ public:
     //! Method used to get the Particle chi factor
     inline std::vector<double>  chi() const
     {
-        return Chi;
+        return std::vector<double>( Chi.begin(), Chi.end() );
     }
 
     //! Method used to get the Particle optical depth
@@ -354,14 +398,14 @@ public:
     //! Method used to get the Particle optical depth
     inline std::vector<double>  tau() const
     {
-        return Tau;
+        return std::vector<double>( Tau.begin(), Tau.end() );
     }
     
     void savePositions();
     
-    std::vector< std::vector<double  >*> double_prop;
-    std::vector< std::vector<short   >*> short_prop;
-    std::vector< std::vector<uint64_t>*> uint64_prop;
+    std::vector< ParticleProperty<double  >*> double_prop;
+    std::vector< ParticleProperty<short   >*> short_prop;
+    std::vector< ParticleProperty<uint64_t>*> uint64_prop;
 
 #ifdef __DEBUG
     bool testMove( int iPartStart, int iPartEnd, Params &params );
@@ -385,15 +429,15 @@ public:
     Particle operator()( unsigned int iPart );
 
     //! Methods to obtain any property, given its index in the arrays double_prop, uint64_prop, or short_prop
-    void getProperty( unsigned int iprop, std::vector<uint64_t> *&prop )
+    void getProperty( unsigned int iprop, ParticleProperty<uint64_t> *&prop )
     {
         prop = uint64_prop[iprop];
     }
-    void getProperty( unsigned int iprop, std::vector<short> *&prop )
+    void getProperty( unsigned int iprop, ParticleProperty<short> *&prop )
     {
         prop = short_prop[iprop];
     }
-    void getProperty( unsigned int iprop, std::vector<double> *&prop )
+    void getProperty( unsigned int iprop, ParticleProperty<double> *&prop )
     {
         prop = double_prop[iprop];
     }
@@ -432,6 +476,42 @@ public:
 
 private:
 
+    //! Register the properties in double_prop, short_prop and uint64_prop, according to the flags
+    void registerProperties( unsigned int nDim, bool keep_position_old );
+
+    //! Offsets of the segments for a given capacity; returns the size of the arena
+    std::size_t layOut( unsigned int capacity, std::vector<std::size_t> &offset ) const;
+
+    //! Change the capacity, keeping the particles. The segments are moved in place when the arena is large
+    //! enough, unless reallocate is set.
+    void setCapacity( unsigned int capacity, bool reallocate );
+
+    //! Make room for nParticles particles, following the growth policy
+    void grow( unsigned int nParticles );
+
+    //! Open a gap of nParticles uninitialized particles at position pos
+    void insertGap( unsigned int pos, unsigned int nParticles );
+
+    //! Point the views to their segment
+    void bindViews();
+
+    //! Free the arena
+    void releaseArena();
+
+    //! Segment of property iprop (in the order double_prop, short_prop, uint64_prop)
+    inline char *segment( unsigned int iprop ) const
+    {
+        return arena_ + offset_[iprop];
+    }
+
+    //! Arena holding all the properties
+    char *arena_;
+    //! Number of bytes allocated for the arena
+    std::size_t arena_bytes_;
+    //! Number of particles, and number of particles that each segment can hold
+    unsigned int size_, capacity_;
+    //! Number of bytes of one element of each property, and offset of its segment in the arena
+    std::vector<std::size_t> element_size_, offset_;
 };
 
 
@@ -45,7 +45,7 @@ Patch::Patch( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decom
     hindex = ipatch;
     nDim_fields_ = params.nDim_field;
 
-    initStep1( params );
+    initStep1( params, n_moved );
 
 #ifdef  __DETAILED_TIMERS
     // Initialize timers
@@ -78,7 +78,7 @@ Patch::Patch( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition
     hindex = ipatch;
     nDim_fields_ = patch->nDim_fields_;
 
-    initStep1( params );
+    initStep1( params, n_moved );
 
 #ifdef  __DETAILED_TIMERS
     // Initialize timers
@@ -87,8 +87,13 @@ Patch::Patch( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition
 
 }
 
-void Patch::initStep1( Params &params )
+void Patch::initStep1( Params &params, unsigned int n_moved )
 {
+    measured_load_.resize( 3, 0. );
+    measured_iterations_ = 0;
+    memory_node_ = Tools::getNumaNode();
+    thread_node_ = memory_node_;
+    
     // for nDim_fields = 1 : bug if Pcoordinates.size = 1 !!
     //Pcoordinates.resize(nDim_fields_);
     Pcoordinates.resize( 2 );
@@ -112,8 +117,8 @@ void Patch::initStep1( Params &params )
         oversize[iDim] = params.oversize[iDim];
     }
     
-    // Initialize the random number generator
-    rand_ = new Random( params.random_seed );
+    // Initialize the random number generator: one stream per patch and per window shift
+    rand_ = new Random( params.random_seed, hindex, n_moved );
     
     // Obtain the cell_volume
     cell_volume = params.cell_volume;
@@ -129,7 +134,7 @@ void Patch::initStep3( Params &params, SmileiMPI *smpi, unsigned int n_moved )
     min_local.resize( params.nDim_field, 0. );
     max_local.resize( params.nDim_field, 0. );
     center   .resize( params.nDim_field, 0. );
-    cell_starting_global_index.resize( params.nDim_field, 0 );
+    cell_starting_global_index.assign( params.nDim_field, 0 );
     radius = 0.;
     for( unsigned int i = 0 ; i<params.nDim_field ; i++ ) {
         min_local[i] = ( Pcoordinates[i] )*( params.n_space[i]*params.cell_length[i] );
@@ -204,6 +209,77 @@ void Patch::finishCloning( Patch *patch, Params &params, SmileiMPI *smpi, unsign
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Recycle a patch which left the moving window as the new patch ipatch, as a clone of patch without particles:
+//   - the lightweight operators are cloned again from patch at the new location
+//   - the fields are zeroed in place
+//   - the particles are removed but their arrays keep their capacity
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::recycle( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved )
+{
+    hindex = ipatch;
+    measured_load_.assign( 3, 0. );
+    measured_iterations_ = 0;
+#ifdef  __DETAILED_TIMERS
+    patch_timers.assign( 15, 0. );
+#endif
+    delete rand_;
+    rand_ = new Random( params.random_seed, hindex, n_moved );
+    
+    initStep2( params, domain_decomposition );
+    initStep3( params, smpi, n_moved );
+    
+    // clone the species again, then give them the memory of the old particles
+    std::vector<Species *> old_species = vecSpecies;
+    SpeciesFactory::cloneVector( patch->vecSpecies, params, this, false );
+    for( unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++ ) {
+        vecSpecies[ispec]->particles->swapData( *old_species[ispec]->particles );
+        vecSpecies[ispec]->particles->initialize( 0, params.nDim_particle, params.keep_position_old );
+        delete old_species[ispec];
+    }
+    
+    // zero the electromagnetic fields in place
+    ElectroMagnFactory::recycle( EMfields, patch->EMfields, params, this );
+    
+    for( unsigned int i=0; i<vecCollisions.size(); i++ ) {
+        delete vecCollisions[i];
+    }
+    vecCollisions = CollisionsFactory::clone( patch->vecCollisions );
+    
+    delete partWalls;
+    partWalls = new PartWalls( patch->partWalls, this );
+    
+    for( unsigned int i=0; i<probes.size(); i++ ) {
+        delete probes[i];
+    }
+    probes = DiagnosticFactory::cloneProbes( patch->probes );
+    
+    delete probesInterp;
+    probesInterp = InterpolatorFactory::create( params, this, false );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy the fields and particles to memory first touched by the calling thread, so that they are located on the NUMA
+// node of the thread which computes this patch
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::firstTouch()
+{
+    EMfields->firstTouch();
+    for( unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++ ) {
+        vecSpecies[ispec]->particles->firstTouch();
+    }
+    memory_node_ = Tools::getNumaNode();
+}
+
+long int Patch::getMemFootPrint()
+{
+    long int mem = EMfields->getMemFootPrint() + EMfields->getSpeciesMemFootPrint();
+    for( unsigned int ispec=0 ; ispec<vecSpecies.size(); ispec++ ) {
+        mem += vecSpecies[ispec]->getMemFootPrint();
+    }
+    return mem;
+}
+
 void Patch::finalizeMPIenvironment( Params &params )
 {
     int nb_comms( 9 ); // E, B, B_m : min number of comms
@@ -885,16 +961,19 @@ void Patch::exchNbrOfParticles( SmileiMPI *smpi, int ispec, Params &params, int
 
             if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
                 //If neighbour is MPI ==> I send him the number of particles I'll send later.
-                int local_hindex = hindex - vecPatch->refHindex_;
-                int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                MPI_Isend( &( vecSpecies[ispec]->MPI_buffer_.part_index_send_sz[iDim][iNeighbor] ), 1, MPI_INT, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ) );
+                //(with aggregated messages, sent for all patches by SyncVectorPatch::startParticleCountMessages)
+                if( !vecPatch->aggregate_messages_ ) {
+                    int local_hindex = hindex - vecPatch->refHindex_;
+                    int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
+                    MPI_Isend( &( vecSpecies[ispec]->MPI_buffer_.part_index_send_sz[iDim][iNeighbor] ), 1, MPI_INT, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ) );
+                }
             } else {
                 //Else, I directly set the receive size to the correct value.
                 ( *vecPatch )( neighbor_[iDim][iNeighbor]- h0 )->vecSpecies[ispec]->MPI_buffer_.part_index_recv_sz[iDim][( iNeighbor+1 )%2] = vecSpecies[ispec]->MPI_buffer_.part_index_send_sz[iDim][iNeighbor];
             }
         } // END of Send
 
-        if( neighbor_[iDim][( iNeighbor+1 )%2]!=MPI_PROC_NULL ) {
+        if( neighbor_[iDim][( iNeighbor+1 )%2]!=MPI_PROC_NULL && !vecPatch->aggregate_messages_ ) {
             if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
                 //If other neighbour is MPI ==> I receive the number of particles I'll receive later.
                 int local_hindex = neighbor_[iDim][( iNeighbor+1 )%2] - smpi->patch_refHindexes[ MPI_neighbor_[iDim][( iNeighbor+1 )%2] ];
@@ -917,14 +996,16 @@ void Patch::endNbrOfParticles( SmileiMPI *smpi, int ispec, Params &params, int i
     for( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
         MPI_Status sstat    [2];
         MPI_Status rstat    [2];
-        if( neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL ) {
+        if( neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL && !vecPatch->aggregate_messages_ ) {
             if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
                 MPI_Wait( &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ), &( sstat[iNeighbor] ) );
             }
         }
         if( neighbor_[iDim][( iNeighbor+1 )%2]!=MPI_PROC_NULL ) {
             if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) )  {
-                MPI_Wait( &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ), &( rstat[( iNeighbor+1 )%2] ) );
+                if( !vecPatch->aggregate_messages_ ) {
+                    MPI_Wait( &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ), &( rstat[( iNeighbor+1 )%2] ) );
+                }
                 if( vecSpecies[ispec]->MPI_buffer_.part_index_recv_sz[iDim][( iNeighbor+1 )%2]!=0 ) {
                     //If I receive particles over MPI, I initialize my receive buffer with the appropriate size.
                     vecSpecies[ispec]->MPI_buffer_.partRecv[iDim][( iNeighbor+1 )%2].initialize( vecSpecies[ispec]->MPI_buffer_.part_index_recv_sz[iDim][( iNeighbor+1 )%2], cuParticles );
@@ -997,8 +1078,10 @@ void Patch::exchParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim,
                 // Then send particles
                 int local_hindex = hindex - vecPatch->refHindex_;
                 int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                vecSpecies[ispec]->typePartSend[( iDim*2 )+iNeighbor] = smpi->createMPIparticles( &( vecSpecies[ispec]->MPI_buffer_.partSend[iDim][iNeighbor] ) );
-                MPI_Isend( &( ( vecSpecies[ispec]->MPI_buffer_.partSend[iDim][iNeighbor] ).position( 0, 0 ) ), 1, vecSpecies[ispec]->typePartSend[( iDim*2 )+iNeighbor], MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ) );
+                // The arena of the send buffer, laid out for its number of particles, is sent as a whole
+                Particles &partSend = vecSpecies[ispec]->MPI_buffer_.partSend[iDim][iNeighbor];
+                partSend.compact();
+                MPI_Isend( partSend.packedData(), partSend.packedSize( n_part_send ), MPI_BYTE, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ) );
             }
         } // END of Send
 
@@ -1006,10 +1089,11 @@ void Patch::exchParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim,
         if( ( neighbor_[iDim][( iNeighbor+1 )%2]!=MPI_PROC_NULL ) && ( n_part_recv!=0 ) ) {
             if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
                 // If MPI comm, receive particles in the recv buffer previously initialized.
-                vecSpecies[ispec]->typePartRecv[( iDim*2 )+iNeighbor] = smpi->createMPIparticles( &( vecSpecies[ispec]->MPI_buffer_.partRecv[iDim][( iNeighbor+1 )%2] ) );
+                Particles &partRecv = vecSpecies[ispec]->MPI_buffer_.partRecv[iDim][( iNeighbor+1 )%2];
+                partRecv.compact();
                 int local_hindex = neighbor_[iDim][( iNeighbor+1 )%2] - smpi->patch_refHindexes[ MPI_neighbor_[iDim][( iNeighbor+1 )%2] ];
                 int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                MPI_Irecv( &( ( vecSpecies[ispec]->MPI_buffer_.partRecv[iDim][( iNeighbor+1 )%2] ).position( 0, 0 ) ), 1, vecSpecies[ispec]->typePartRecv[( iDim*2 )+iNeighbor], MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ) );
+                MPI_Irecv( partRecv.packedData(), partRecv.packedSize( n_part_recv ), MPI_BYTE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ) );
             }
 
         } // END of Recv
@@ -1044,13 +1128,11 @@ void Patch::finalizeExchParticles( SmileiMPI *smpi, int ispec, Params &params, i
         if( ( neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL ) && ( n_part_send!=0 ) ) {
             if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
                 MPI_Wait( &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ), &( sstat[iNeighbor] ) );
-                MPI_Type_free( &( vecSpecies[ispec]->typePartSend[( iDim*2 )+iNeighbor] ) );
             }
         }
         if( ( neighbor_[iDim][( iNeighbor+1 )%2]!=MPI_PROC_NULL ) && ( n_part_recv!=0 ) ) {
             if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
                 MPI_Wait( &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ), &( rstat[( iNeighbor+1 )%2] ) );
-                MPI_Type_free( &( vecSpecies[ispec]->typePartRecv[( iDim*2 )+iNeighbor] ) );
             }
         }
     }
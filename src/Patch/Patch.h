@@ -38,7 +38,7 @@ public:
     Patch( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved, bool with_particles );
     
     //! First initialization step for patches
-    void initStep1( Params &params );
+    void initStep1( Params &params, unsigned int n_moved );
     //! Second initialization step for patches
     virtual void initStep2( Params &params, DomainDecomposition *domain_decomposition ) = 0;
     //! Third initialization step for patches
@@ -47,6 +47,10 @@ public:
     void finishCreation( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition );
     //! Last cloning step
     void finishCloning( Patch *patch, Params &params, SmileiMPI *smpi, unsigned int n_moved, bool with_particles );
+    //! Reset a patch which left the moving window so that it becomes the arriving patch ipatch
+    void recycle( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved );
+    //! Copy the fields and particles to memory first touched by the calling thread, on its NUMA node
+    void firstTouch();
     
     //! Finalize MPI environment : especially requests array for non blocking communications
     void finalizeMPIenvironment( Params &params );
@@ -96,6 +100,20 @@ public:
     std::vector<double> patch_timers;
 #endif
     
+    //! Time spent in the particle operators of this patch since the last load balancing
+    //! (only when the load balancing uses measured loads)
+    //!   0 - dynamics, 1 - collisions, 2 - merging
+    std::vector<double> measured_load_;
+    //! Number of iterations accumulated in measured_load_
+    unsigned int measured_iterations_;
+    
+    //! NUMA node of the memory of the fields and particles (node of the thread which allocated or copied them last)
+    int memory_node_;
+    //! NUMA node of the thread which computed the particles of this patch at the last timestep
+    int thread_node_;
+    //! Memory of the fields and particles of this patch
+    long int getMemFootPrint();
+    
     // Random number generator.
     Random * rand_;
     
@@ -2,6 +2,8 @@
 #include "SyncVectorPatch.h"
 
 #include <vector>
+#include <sstream>
+#include <cstring>
 
 #include "VectorPatch.h"
 #include "Params.h"
@@ -39,6 +41,9 @@ void SyncVectorPatch::exchangeParticles( VectorPatch &vecPatches, int ispec, Par
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
         vecPatches( ipatch )->exchNbrOfParticles( smpi, ispec, params, 0, &vecPatches );
     }
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::startParticleCountMessages( vecPatches, ispec, 0 );
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -61,6 +66,9 @@ void SyncVectorPatch::finalizeAndSortParticles( VectorPatch &vecPatches, int isp
         for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
             vecPatches( ipatch )->exchNbrOfParticles( smpi, ispec, params, iDim, &vecPatches );
         }
+        if( vecPatches.aggregate_messages_ ) {
+            SyncVectorPatch::startParticleCountMessages( vecPatches, ispec, iDim );
+        }
 
         SyncVectorPatch::finalizeExchangeParticles( vecPatches, ispec, iDim, params, smpi, timers, itime );
     }
@@ -106,6 +114,10 @@ void SyncVectorPatch::finalizeAndSortParticles( VectorPatch &vecPatches, int isp
 
 void SyncVectorPatch::finalizeExchangeParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
 {
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::finishParticleCountMessages( vecPatches, ispec, iDim );
+    }
+
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(runtime)
 #else
@@ -120,22 +132,27 @@ void SyncVectorPatch::finalizeExchangeParticles( VectorPatch &vecPatches, int is
         vecPatches( ipatch )->prepareParticles( smpi, ispec, params, iDim, &vecPatches );
     }
 
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::startParticleMessages( vecPatches, ispec, iDim );
+        SyncVectorPatch::finishParticleMessages( vecPatches, ispec, iDim );
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(runtime)
+        #pragma omp for schedule(runtime)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
-        vecPatches( ipatch )->exchParticles( smpi, ispec, params, iDim, &vecPatches );
-    }
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            vecPatches( ipatch )->exchParticles( smpi, ispec, params, iDim, &vecPatches );
+        }
 
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(runtime)
+        #pragma omp for schedule(runtime)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
-        vecPatches( ipatch )->finalizeExchParticles( smpi, ispec, params, iDim, &vecPatches );
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            vecPatches( ipatch )->finalizeExchParticles( smpi, ispec, params, iDim, &vecPatches );
+        }
     }
 
     #pragma omp for schedule(runtime)
@@ -270,9 +287,14 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
                 vecPatches.densitiesMPIx[ifield+2*nPatchMPIx]->extract_fields_sum( 0, iNeighbor, oversize[0] );
             }
         }
-        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi ); // Jx
-        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi ); // Jy
-        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi ); // Jz
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi ); // Jx
+            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi ); // Jy
+            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi ); // Jz
+        }
+    }
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::startFaceMessages( "densities", vecPatches.densitiesMPIx, &vecPatches.MPIxIdx, vecPatches, 0 );
     }
     // iDim = 0, local
     int nFieldLocalx = vecPatches.densitiesLocalx.size()/3;
@@ -312,6 +334,9 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
     }
 
     // iDim = 0, finalize (waitall)
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::finishFaceMessages( "densities", vecPatches.densitiesMPIx, &vecPatches.MPIxIdx, vecPatches, 0 );
+    }
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(static)
 #else
@@ -319,9 +344,11 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 #endif
     for( unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield             ], 0 ); // Jx
-        vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+nPatchMPIx  ], 0 ); // Jy
-        vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield             ], 0 ); // Jx
+            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+nPatchMPIx  ], 0 ); // Jy
+            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
+        }
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 0, ( iNeighbor+1 )%2 ) ) {
                 vecPatches.densitiesMPIx[ifield             ]->inject_fields_sum( 0, iNeighbor, oversize[0] );
@@ -357,9 +384,14 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
                     vecPatches.densitiesMPIy[ifield+2*nPatchMPIy]->extract_fields_sum( 1, iNeighbor, oversize[1] );
                 }
             }
-            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi ); // Jx
-            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi ); // Jy
-            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi ); // Jz
+            if( !vecPatches.aggregate_messages_ ) {
+                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi ); // Jx
+                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi ); // Jy
+                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi ); // Jz
+            }
+        }
+        if( vecPatches.aggregate_messages_ ) {
+            SyncVectorPatch::startFaceMessages( "densities", vecPatches.densitiesMPIy, &vecPatches.MPIyIdx, vecPatches, 1 );
         }
 
         // iDim = 1,
@@ -404,6 +436,9 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
         }
 
         // iDim = 1, finalize (waitall)
+        if( vecPatches.aggregate_messages_ ) {
+            SyncVectorPatch::finishFaceMessages( "densities", vecPatches.densitiesMPIy, &vecPatches.MPIyIdx, vecPatches, 1 );
+        }
 #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
 #else
@@ -411,9 +446,11 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 #endif
         for( unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield=ifield+1 ) {
             unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield             ], 1 ); // Jx
-            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1 ); // Jy
-            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
+            if( !vecPatches.aggregate_messages_ ) {
+                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield             ], 1 ); // Jx
+                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1 ); // Jy
+                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
+            }
             for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                 if ( vecPatches( ipatch )->is_a_MPI_neighbor( 1, ( iNeighbor+1 )%2 ) ) {
                     vecPatches.densitiesMPIy[ifield             ]->inject_fields_sum( 1, iNeighbor, oversize[1] );
@@ -448,9 +485,14 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
                         vecPatches.densitiesMPIz[ifield+2*nPatchMPIz]->extract_fields_sum( 2, iNeighbor, oversize[2] );
                     }
                 }
-                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi ); // Jx
-                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi ); // Jy
-                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi ); // Jz
+                if( !vecPatches.aggregate_messages_ ) {
+                    vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi ); // Jx
+                    vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi ); // Jy
+                    vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi ); // Jz
+                }
+            }
+            if( vecPatches.aggregate_messages_ ) {
+                SyncVectorPatch::startFaceMessages( "densities", vecPatches.densitiesMPIz, &vecPatches.MPIzIdx, vecPatches, 2 );
             }
 
             // iDim = 2 local
@@ -496,6 +538,9 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
             }
 
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
+            if( vecPatches.aggregate_messages_ ) {
+                SyncVectorPatch::finishFaceMessages( "densities", vecPatches.densitiesMPIz, &vecPatches.MPIzIdx, vecPatches, 2 );
+            }
 #ifndef _NO_MPI_TM
             #pragma omp for schedule(static)
 #else
@@ -503,9 +548,11 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 #endif
             for( unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield=ifield+1 ) {
                 unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield             ], 2 ); // Jx
-                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2 ); // Jy
-                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
+                if( !vecPatches.aggregate_messages_ ) {
+                    vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield             ], 2 ); // Jx
+                    vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2 ); // Jy
+                    vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
+                }
                 for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                     if ( vecPatches( ipatch )->is_a_MPI_neighbor( 2, ( iNeighbor+1 )%2 ) ) {
                         vecPatches.densitiesMPIz[ifield             ]->inject_fields_sum( 2, iNeighbor, oversize[2] );
@@ -855,10 +902,15 @@ void SyncVectorPatch::exchangeAlongAllDirections( std::vector<Field *> fields, V
                     fields[ipatch]->extract_fields_exch( iDim, iNeighbor, oversize[iDim] );
                 }
             }
-            if ( !dynamic_cast<cField*>( fields[ipatch] ) )
-                vecPatches( ipatch )->initExchange       ( fields[ipatch], iDim, smpi );
-            else
-                vecPatches( ipatch )->initExchangeComplex( fields[ipatch], iDim, smpi );
+            if( !vecPatches.aggregate_messages_ ) {
+                if ( !dynamic_cast<cField*>( fields[ipatch] ) )
+                    vecPatches( ipatch )->initExchange       ( fields[ipatch], iDim, smpi );
+                else
+                    vecPatches( ipatch )->initExchangeComplex( fields[ipatch], iDim, smpi );
+            }
+        }
+        if( vecPatches.aggregate_messages_ ) {
+            SyncVectorPatch::startFaceMessages( "exchange " + fields[0]->name, fields, NULL, vecPatches, iDim );
         }
     } // End for iDim
 
@@ -941,13 +993,18 @@ void SyncVectorPatch::finalizeExchangeAlongAllDirections( std::vector<Field *> f
     oversize[2] = vecPatches( 0 )->EMfields->oversize[2];
 
     for( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+        if( vecPatches.aggregate_messages_ ) {
+            SyncVectorPatch::finishFaceMessages( "exchange " + fields[0]->name, fields, NULL, vecPatches, iDim );
+        }
 #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
 #else
         #pragma omp single
 #endif
         for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
-            vecPatches( ipatch )->finalizeExchange( fields[ipatch], iDim );
+            if( !vecPatches.aggregate_messages_ ) {
+                vecPatches( ipatch )->finalizeExchange( fields[ipatch], iDim );
+            }
 
             for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                 if ( vecPatches( ipatch )->is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
@@ -1312,8 +1369,13 @@ void SyncVectorPatch::exchangeAllComponentsAlongX( std::vector<Field *> &fields,
                 vecPatches.B_MPIx[ifield+nMPIx]->extract_fields_exch( 0, iNeighbor, oversize );
             }
         }
-        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
-        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
+            vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
+        }
+    }
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::startFaceMessages( "B", vecPatches.B_MPIx, &vecPatches.MPIxIdx, vecPatches, 0 );
     }
 
     unsigned int h0, n_space;
@@ -1365,6 +1427,9 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongX( std::vector<Field *>
     unsigned oversize = vecPatches( 0 )->EMfields->oversize[0];
 
     unsigned int nMPIx = vecPatches.MPIxIdx.size();
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::finishFaceMessages( "B", vecPatches.B_MPIx, &vecPatches.MPIxIdx, vecPatches, 0 );
+    }
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(static)
 #else
@@ -1372,8 +1437,10 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongX( std::vector<Field *>
 #endif
     for( unsigned int ifield=0 ; ifield<nMPIx ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B_MPIx[ifield      ], 0 ); // By
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B_MPIx[ifield+nMPIx], 0 ); // Bz
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->finalizeExchange( vecPatches.B_MPIx[ifield      ], 0 ); // By
+            vecPatches( ipatch )->finalizeExchange( vecPatches.B_MPIx[ifield+nMPIx], 0 ); // Bz
+        }
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 0, ( iNeighbor+1 )%2 ) ) {
                 vecPatches.B_MPIx[ifield      ]->inject_fields_exch( 0, iNeighbor, oversize );
@@ -1412,8 +1479,13 @@ void SyncVectorPatch::exchangeAllComponentsAlongY( std::vector<Field *> &fields,
                 vecPatches.B1_MPIy[ifield+nMPIy]->extract_fields_exch( 1, iNeighbor, oversize );
             }
         }
-        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi ); // Bx
-        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi ); // Bx
+            vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
+        }
+    }
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::startFaceMessages( "B", vecPatches.B1_MPIy, &vecPatches.MPIyIdx, vecPatches, 1 );
     }
 
     unsigned int h0, n_space;
@@ -1469,6 +1541,9 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongY( std::vector<Field *>
     unsigned oversize = vecPatches( 0 )->EMfields->oversize[1];
 
     unsigned int nMPIy = vecPatches.MPIyIdx.size();
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::finishFaceMessages( "B", vecPatches.B1_MPIy, &vecPatches.MPIyIdx, vecPatches, 1 );
+    }
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(static)
 #else
@@ -1476,8 +1551,10 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongY( std::vector<Field *>
 #endif
     for( unsigned int ifield=0 ; ifield<nMPIy ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B1_MPIy[ifield      ], 1 ); // By
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1 ); // Bz
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->finalizeExchange( vecPatches.B1_MPIy[ifield      ], 1 ); // By
+            vecPatches( ipatch )->finalizeExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1 ); // Bz
+        }
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 1, ( iNeighbor+1 )%2 ) ) {
                 vecPatches.B1_MPIy[ifield      ]->inject_fields_exch( 1, iNeighbor, oversize );
@@ -1516,8 +1593,13 @@ void SyncVectorPatch::exchangeAllComponentsAlongZ( std::vector<Field *> fields,
                 vecPatches.B2_MPIz[ifield+nMPIz]->extract_fields_exch( 2, iNeighbor, oversize );
             }
         }
-        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi ); // Bx
-        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield      ], 2, smpi ); // Bx
+            vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
+        }
+    }
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::startFaceMessages( "B", vecPatches.B2_MPIz, &vecPatches.MPIzIdx, vecPatches, 2 );
     }
 
     unsigned int h0, n_space;
@@ -1570,6 +1652,9 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongZ( std::vector<Field *>
     unsigned oversize = vecPatches( 0 )->EMfields->oversize[2];
 
     unsigned int nMPIz = vecPatches.MPIzIdx.size();
+    if( vecPatches.aggregate_messages_ ) {
+        SyncVectorPatch::finishFaceMessages( "B", vecPatches.B2_MPIz, &vecPatches.MPIzIdx, vecPatches, 2 );
+    }
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(static)
 #else
@@ -1577,8 +1662,10 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongZ( std::vector<Field *>
 #endif
     for( unsigned int ifield=0 ; ifield<nMPIz ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B2_MPIz[ifield      ], 2 ); // Bx
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2 ); // By
+        if( !vecPatches.aggregate_messages_ ) {
+            vecPatches( ipatch )->finalizeExchange( vecPatches.B2_MPIz[ifield      ], 2 ); // Bx
+            vecPatches( ipatch )->finalizeExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2 ); // By
+        }
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 2, ( iNeighbor+1 )%2 ) ) {
                 vecPatches.B2_MPIz[ifield      ]->inject_fields_exch( 2, iNeighbor, oversize );
@@ -1589,3 +1676,208 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongZ( std::vector<Field *>
 
 }
 
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------   AGGREGATED MESSAGES   ----------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Data and size of a face (sub-field) of a real or complex field
+static inline char *faceData( Field *face )
+{
+    cField *cface = dynamic_cast<cField *>( face );
+    if( cface ) {
+        return reinterpret_cast<char *>( cface->cdata_ );
+    }
+    return reinterpret_cast<char *>( face->data_ );
+}
+
+static inline size_t faceBytes( Field *face )
+{
+    if( dynamic_cast<cField *>( face ) ) {
+        return face->globalDims_*sizeof( complex<double> );
+    }
+    return face->globalDims_*sizeof( double );
+}
+
+static inline string messagesKey( const string &key, int iDim )
+{
+    ostringstream name;
+    name << key << " " << iDim;
+    return name.str();
+}
+
+// The faces are described by a single thread, then copied in the send buffer by all the threads.
+// The key of a face in a message is the hindex of the sending patch, and the component for several fields per patch.
+void SyncVectorPatch::startFaceMessages( const string &key, vector<Field *> &fields, vector<int> *patches, VectorPatch &vecPatches, int iDim )
+{
+    NeighborMessages &messages = vecPatches.neighborMessages( messagesKey( key, iDim ) );
+    unsigned int nPatches = patches ? patches->size() : vecPatches.size();
+
+    #pragma omp single
+    {
+        messages.clearFaces();
+        for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
+            Patch *patch = vecPatches( patches ? ( *patches )[ifield%nPatches] : ifield%nPatches );
+            uint64_t comp = ifield/nPatches;
+            for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                    messages.addSendFace( ifield, iNeighbor, patch->MPI_neighbor_[iDim][iNeighbor], ( comp<<32 ) + patch->hindex,
+                                          faceBytes( fields[ifield]->sendFields_[iDim*2+iNeighbor] ) );
+                    messages.addRecvFace( ifield, iNeighbor, patch->MPI_neighbor_[iDim][iNeighbor], ( comp<<32 ) + patch->neighbor_[iDim][iNeighbor],
+                                          faceBytes( fields[ifield]->recvFields_[iDim*2+iNeighbor] ) );
+                }
+            }
+        }
+        messages.setLayout( true );
+    }
+
+    #pragma omp for schedule(static)
+    for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
+        Patch *patch = vecPatches( patches ? ( *patches )[ifield%nPatches] : ifield%nPatches );
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                Field *face = fields[ifield]->sendFields_[iDim*2+iNeighbor];
+                memcpy( messages.sendFace( ifield, iNeighbor ), faceData( face ), faceBytes( face ) );
+            }
+        }
+    }
+
+    #pragma omp single
+    messages.start();
+}
+
+void SyncVectorPatch::finishFaceMessages( const string &key, vector<Field *> &fields, vector<int> *patches, VectorPatch &vecPatches, int iDim )
+{
+    NeighborMessages &messages = vecPatches.neighborMessages( messagesKey( key, iDim ) );
+    unsigned int nPatches = patches ? patches->size() : vecPatches.size();
+
+    #pragma omp single
+    messages.wait();
+
+    #pragma omp for schedule(static)
+    for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
+        Patch *patch = vecPatches( patches ? ( *patches )[ifield%nPatches] : ifield%nPatches );
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                Field *face = fields[ifield]->recvFields_[iDim*2+iNeighbor];
+                memcpy( faceData( face ), messages.recvFace( ifield, iNeighbor ), faceBytes( face ) );
+            }
+        }
+    }
+}
+
+void SyncVectorPatch::startParticleCountMessages( VectorPatch &vecPatches, int ispec, int iDim )
+{
+    ostringstream key;
+    key << "particle counts " << ispec;
+    NeighborMessages &messages = vecPatches.neighborMessages( messagesKey( key.str(), iDim ) );
+
+    #pragma omp single
+    {
+        messages.clearFaces();
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            Patch *patch = vecPatches( ipatch );
+            for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                    messages.addSendFace( ipatch, iNeighbor, patch->MPI_neighbor_[iDim][iNeighbor], patch->hindex, sizeof( unsigned int ) );
+                    messages.addRecvFace( ipatch, iNeighbor, patch->MPI_neighbor_[iDim][iNeighbor], patch->neighbor_[iDim][iNeighbor], sizeof( unsigned int ) );
+                }
+            }
+        }
+        messages.setLayout( true );
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            Patch *patch = vecPatches( ipatch );
+            for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                    memcpy( messages.sendFace( ipatch, iNeighbor ), &( vecPatches.species( ipatch, ispec )->MPI_buffer_.part_index_send_sz[iDim][iNeighbor] ), sizeof( unsigned int ) );
+                }
+            }
+        }
+        messages.start();
+    }
+}
+
+void SyncVectorPatch::finishParticleCountMessages( VectorPatch &vecPatches, int ispec, int iDim )
+{
+    ostringstream key;
+    key << "particle counts " << ispec;
+    NeighborMessages &messages = vecPatches.neighborMessages( messagesKey( key.str(), iDim ) );
+
+    #pragma omp single
+    {
+        messages.wait();
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            Patch *patch = vecPatches( ipatch );
+            for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                    memcpy( &( vecPatches.species( ipatch, ispec )->MPI_buffer_.part_index_recv_sz[iDim][iNeighbor] ), messages.recvFace( ipatch, iNeighbor ), sizeof( unsigned int ) );
+                }
+            }
+        }
+    }
+}
+
+// The size of the messages of particles changes at each exchange: they are laid out again, without persistent requests
+void SyncVectorPatch::startParticleMessages( VectorPatch &vecPatches, int ispec, int iDim )
+{
+    ostringstream key;
+    key << "particles " << ispec;
+    NeighborMessages &messages = vecPatches.neighborMessages( messagesKey( key.str(), iDim ) );
+
+    #pragma omp single
+    {
+        messages.clearFaces();
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            Patch *patch = vecPatches( ipatch );
+            SpeciesMPIbuffers &buffers = vecPatches.species( ipatch, ispec )->MPI_buffer_;
+            Particles *particles = vecPatches.species( ipatch, ispec )->particles;
+            for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                    messages.addSendFace( ipatch, iNeighbor, patch->MPI_neighbor_[iDim][iNeighbor], patch->hindex,
+                                          particles->packedSize( buffers.part_index_send[iDim][iNeighbor].size() ) );
+                    messages.addRecvFace( ipatch, iNeighbor, patch->MPI_neighbor_[iDim][iNeighbor], patch->neighbor_[iDim][iNeighbor],
+                                          particles->packedSize( buffers.part_index_recv_sz[iDim][iNeighbor] ) );
+                }
+            }
+        }
+        messages.setLayout( false );
+    }
+
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        SpeciesMPIbuffers &buffers = vecPatches.species( ipatch, ispec )->MPI_buffer_;
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) && buffers.part_index_send[iDim][iNeighbor].size() > 0 ) {
+                buffers.partSend[iDim][iNeighbor].pack( messages.sendFace( ipatch, iNeighbor ) );
+            }
+        }
+    }
+
+    #pragma omp single
+    messages.start();
+}
+
+void SyncVectorPatch::finishParticleMessages( VectorPatch &vecPatches, int ispec, int iDim )
+{
+    ostringstream key;
+    key << "particles " << ispec;
+    NeighborMessages &messages = vecPatches.neighborMessages( messagesKey( key.str(), iDim ) );
+
+    #pragma omp single
+    messages.wait();
+
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        SpeciesMPIbuffers &buffers = vecPatches.species( ipatch, ispec )->MPI_buffer_;
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) && buffers.part_index_recv_sz[iDim][iNeighbor] > 0 ) {
+                buffers.partRecv[iDim][iNeighbor].unpack( messages.recvFace( ipatch, iNeighbor ) );
+            }
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #define SYNCVECTORPATCH_H
 
 #include <vector>
+#include <string>
 
 #include "VectorPatch.h"
 
@@ -73,10 +74,15 @@ public :
                     fields[ifield]->extract_fields_sum( 0, iNeighbor, oversize[0] );
                 }
             }
-            if ( !dynamic_cast<cField*>( fields[ipatch] ) )
-                vecPatches( ipatch )->initSumField( fields[ifield], 0, smpi );
-            else
-                vecPatches( ipatch )->initSumFieldComplex( fields[ifield], 0, smpi );
+            if( !vecPatches.aggregate_messages_ ) {
+                if ( !dynamic_cast<cField*>( fields[ipatch] ) )
+                    vecPatches( ipatch )->initSumField( fields[ifield], 0, smpi );
+                else
+                    vecPatches( ipatch )->initSumFieldComplex( fields[ifield], 0, smpi );
+            }
+        }
+        if( vecPatches.aggregate_messages_ ) {
+            SyncVectorPatch::startFaceMessages( "sum " + fields[0]->name, fields, NULL, vecPatches, 0 );
         }
 
         // iDim = 0, local
@@ -111,6 +117,9 @@ public :
         }
 
         // iDim = 0, finalize (waitall)
+        if( vecPatches.aggregate_messages_ ) {
+            SyncVectorPatch::finishFaceMessages( "sum " + fields[0]->name, fields, NULL, vecPatches, 0 );
+        }
     #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
     #else
@@ -118,7 +127,9 @@ public :
     #endif
         for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
             unsigned int ipatch = ifield%nPatches;
-            vecPatches( ipatch )->finalizeSumField( fields[ifield], 0 );
+            if( !vecPatches.aggregate_messages_ ) {
+                vecPatches( ipatch )->finalizeSumField( fields[ifield], 0 );
+            }
             for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                 if ( vecPatches( ipatch )->is_a_MPI_neighbor( 0, ( iNeighbor+1 )%2 ) ) {
                     fields[ifield]->inject_fields_sum( 0, iNeighbor, oversize[0] );
@@ -146,10 +157,15 @@ public :
                         fields[ifield]->extract_fields_sum( 1, iNeighbor, oversize[1] );
                     }
                 }
-                if ( !dynamic_cast<cField*>( fields[ipatch] ) )
-                    vecPatches( ipatch )->initSumField( fields[ifield], 1, smpi );
-                else
-                    vecPatches( ipatch )->initSumFieldComplex( fields[ifield], 1, smpi );
+                if( !vecPatches.aggregate_messages_ ) {
+                    if ( !dynamic_cast<cField*>( fields[ipatch] ) )
+                        vecPatches( ipatch )->initSumField( fields[ifield], 1, smpi );
+                    else
+                        vecPatches( ipatch )->initSumFieldComplex( fields[ifield], 1, smpi );
+                }
+            }
+            if( vecPatches.aggregate_messages_ ) {
+                SyncVectorPatch::startFaceMessages( "sum " + fields[0]->name, fields, NULL, vecPatches, 1 );
             }
 
             // iDim = 1, local
@@ -188,6 +204,9 @@ public :
             }
 
             // iDim = 1, finalize (waitall)
+            if( vecPatches.aggregate_messages_ ) {
+                SyncVectorPatch::finishFaceMessages( "sum " + fields[0]->name, fields, NULL, vecPatches, 1 );
+            }
     #ifndef _NO_MPI_TM
             #pragma omp for schedule(static)
     #else
@@ -195,7 +214,9 @@ public :
     #endif
             for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
                 unsigned int ipatch = ifield%nPatches;
-                vecPatches( ipatch )->finalizeSumField( fields[ifield], 1 );
+                if( !vecPatches.aggregate_messages_ ) {
+                    vecPatches( ipatch )->finalizeSumField( fields[ifield], 1 );
+                }
                 for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                     if ( vecPatches( ipatch )->is_a_MPI_neighbor( 1, ( iNeighbor+1 )%2 ) ) {
                         fields[ifield]->inject_fields_sum( 1, iNeighbor, oversize[1] );
@@ -223,7 +244,12 @@ public :
                             fields[ifield]->extract_fields_sum( 2, iNeighbor, oversize[2] );
                         }
                     }
-                    vecPatches( ipatch )->initSumField( fields[ifield], 2, smpi );
+                    if( !vecPatches.aggregate_messages_ ) {
+                        vecPatches( ipatch )->initSumField( fields[ifield], 2, smpi );
+                    }
+                }
+                if( vecPatches.aggregate_messages_ ) {
+                    SyncVectorPatch::startFaceMessages( "sum " + fields[0]->name, fields, NULL, vecPatches, 2 );
                 }
 
                 // iDim = 2 local
@@ -262,6 +288,9 @@ public :
                 }
 
                 // iDim = 2, complete non local sync through MPIfinalize (waitall)
+                if( vecPatches.aggregate_messages_ ) {
+                    SyncVectorPatch::finishFaceMessages( "sum " + fields[0]->name, fields, NULL, vecPatches, 2 );
+                }
     #ifndef _NO_MPI_TM
                 #pragma omp for schedule(static)
     #else
@@ -269,7 +298,9 @@ public :
     #endif
                 for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
                     unsigned int ipatch = ifield%nPatches;
-                    vecPatches( ipatch )->finalizeSumField( fields[ifield], 2 );
+                    if( !vecPatches.aggregate_messages_ ) {
+                        vecPatches( ipatch )->finalizeSumField( fields[ifield], 2 );
+                    }
                     for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                         if ( vecPatches( ipatch )->is_a_MPI_neighbor( 2, ( iNeighbor+1 )%2 ) ) {
                             fields[ifield]->inject_fields_sum( 2, iNeighbor, oversize[2] );
@@ -331,6 +362,18 @@ public :
     static void exchangeAllComponentsAlongZ( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void finalizeExchangeAllComponentsAlongZ( std::vector<Field *> fields, VectorPatch &vecPatches );
 
+    //! Aggregated messages (Main.aggregate_mpi_messages) : start sending the faces along iDim of fields, fields[ifield]
+    //! belonging to the patch (*patches)[ifield%patches->size()], or ifield%vecPatches.size() if patches is NULL
+    static void startFaceMessages( const std::string &key, std::vector<Field *> &fields, std::vector<int> *patches, VectorPatch &vecPatches, int iDim );
+    //! Wait for the faces along iDim and copy them in the receive buffers of the fields
+    static void finishFaceMessages( const std::string &key, std::vector<Field *> &fields, std::vector<int> *patches, VectorPatch &vecPatches, int iDim );
+    //! Aggregated messages of the numbers of particles of the species ispec, along iDim
+    static void startParticleCountMessages( VectorPatch &vecPatches, int ispec, int iDim );
+    static void finishParticleCountMessages( VectorPatch &vecPatches, int ispec, int iDim );
+    //! Aggregated messages of the particles of the species ispec, along iDim
+    static void startParticleMessages( VectorPatch &vecPatches, int ispec, int iDim );
+    static void finishParticleMessages( VectorPatch &vecPatches, int ispec, int iDim );
+
 };
 
 #endif
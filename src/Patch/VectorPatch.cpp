@@ -31,12 +31,19 @@ using namespace std;
 VectorPatch::VectorPatch()
 {
     domain_decomposition_ = NULL ;
+    aggregate_messages_ = false;
+    neighbor_comm_ = MPI_COMM_NULL;
 }
 
 
 VectorPatch::VectorPatch( Params &params )
 {
     domain_decomposition_ = DomainDecompositionFactory::create( params );
+    aggregate_messages_ = params.aggregate_mpi_messages;
+    neighbor_comm_ = MPI_COMM_NULL;
+    if( aggregate_messages_ ) {
+        MPI_Comm_dup( MPI_COMM_WORLD, &neighbor_comm_ );
+    }
 }
 
 
@@ -45,11 +52,38 @@ VectorPatch::~VectorPatch()
     if( domain_decomposition_ != NULL ) {
         delete domain_decomposition_;
     }
+    for( map<string, NeighborMessages *>::iterator it = neighbor_messages_.begin() ; it != neighbor_messages_.end() ; it++ ) {
+        delete it->second;
+    }
+    if( neighbor_comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &neighbor_comm_ );
+    }
+}
+
+
+NeighborMessages &VectorPatch::neighborMessages( const string &key )
+{
+    NeighborMessages *messages;
+    #pragma omp critical
+    {
+        map<string, NeighborMessages *>::iterator it = neighbor_messages_.find( key );
+        if( it == neighbor_messages_.end() ) {
+            // Same tag on all the processes, from the name of the exchange (FNV-1a hash)
+            uint32_t hash = 2166136261u;
+            for( unsigned int i=0 ; i<key.size() ; i++ ) {
+                hash = ( hash ^ ( unsigned char )key[i] ) * 16777619u;
+            }
+            it = neighbor_messages_.insert( make_pair( key, new NeighborMessages( neighbor_comm_, 2*( hash%16000 ) ) ) ).first;
+        }
+        messages = it->second;
+    }
+    return *messages;
 }
 
 
 void VectorPatch::close( SmileiMPI *smpiData )
 {
+    finishGlobalDiags( smpiData );
     closeAllDiags( smpiData );
 
 
@@ -249,6 +283,28 @@ void VectorPatch::configuration( Params &params, Timers &timers, int itime )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// NUMA-aware mode: the patches are distributed to the threads in the same way by all the loops on patches (static
+// schedule), and their memory is copied by the owning thread if it was touched first on another NUMA node.
+// This concerns the patches created by the master thread (initialization, moving window) and the patches given to
+// another thread after a load balancing.
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::firstTouch( Params &params, Timers &timers )
+{
+    if( !params.numa_first_touch ) {
+        return;
+    }
+    
+    timers.numaCopy.restart();
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        if( patches_[ipatch]->memory_node_ != Tools::getNumaNode() ) {
+            patches_[ipatch]->firstTouch();
+        }
+    }
+    timers.numaCopy.update();
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Reconfigure all patches for the new time step
 // ---------------------------------------------------------------------------------------------------------------------
@@ -323,10 +379,27 @@ void VectorPatch::dynamics( Params &params,
         diag_flag = ( needsRhoJsNow( itime ) || params.is_spectral );
     }
     
+    // The reductions of the global diags started at the previous timestep complete while the other threads push
+    if( params.overlap_diag_reductions ) {
+#ifndef _NO_MPI_TM
+        #pragma omp single nowait
+#else
+        #pragma omp master
+#endif
+        finishGlobalDiags( smpi );
+    }
+    
     timers.particles.restart();
     ostringstream t;
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        double patch_timer = params.measure_patch_load ? MPI_Wtime() : 0.;
+        ( *this )( ipatch )->thread_node_ = Tools::getNumaNode();
+        if( diag_flag ) {
+            ( *this )( ipatch )->EMfields->allocateRhoJs();
+        } else {
+            ( *this )( ipatch )->EMfields->deallocateRhoJs();
+        }
         ( *this )( ipatch )->EMfields->restartRhoJ();
         //MESSAGE("restart rhoj");
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
@@ -374,6 +447,10 @@ void VectorPatch::dynamics( Params &params,
             } // end if condition on species
         } // end loop on species
         //MESSAGE("species dynamics");
+        if( params.measure_patch_load ) {
+            ( *this )( ipatch )->measured_load_[0] += MPI_Wtime() - patch_timer;
+            ( *this )( ipatch )->measured_iterations_++;
+        }
     } // end loop on patches
 
 
@@ -417,6 +494,9 @@ void VectorPatch::projectionForDiags( Params &params,
 
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        if( diag_flag ) {
+            ( *this )( ipatch )->EMfields->allocateRhoJs();
+        }
         ( *this )( ipatch )->EMfields->restartRhoJ();
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) || diag_flag ) {
@@ -497,6 +577,7 @@ void VectorPatch::mergeParticles(Params &params, SmileiMPI *smpi, double time_du
     
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        double patch_timer = params.measure_patch_load ? MPI_Wtime() : 0.;
         // Particle importation for all species
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             // Check if the particle merging is activated for this species
@@ -511,6 +592,9 @@ void VectorPatch::mergeParticles(Params &params, SmileiMPI *smpi, double time_du
                 }
             }
         }
+        if( params.measure_patch_load ) {
+            ( *this )( ipatch )->measured_load_[2] += MPI_Wtime() - patch_timer;
+        }
     }
     
     timers.particleMerging.update( params.printNow( itime ) );
@@ -1121,30 +1205,52 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
         ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
     }
 
-    #pragma omp for schedule(static)
-    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-        // Computes Bx_, By_, Bz_ at time n+1 on interior points.
-        ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
-    }
-    //Synchronize B fields between patches.
-    timers.maxwell.update( params.printNow( itime ) );
+    if( params.overlap_field_exchange ) {
+        // Computes Bx_, By_, Bz_ at time n+1 on the ghost cells and on the cells sent to the neighbours,
+        // then sends them while the interior of the patches is computed
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            ( *this )( ipatch )->EMfields->MaxwellFaradaySolver_->updateBorders( ( *this )( ipatch )->EMfields );
+        }
+        timers.maxwell.update( params.printNow( itime ) );
 
+        timers.syncField.restart();
+        SyncVectorPatch::exchangeB( params, ( *this ), smpi );
+        timers.syncField.update( params.printNow( itime ) );
 
-    timers.syncField.restart();
-    if( params.geometry != "AMcylindrical" ) {
-        if( params.is_spectral ) {
-            SyncVectorPatch::exchangeE( params, ( *this ), smpi );
+        // The exchange is completed in finalizeSyncAndBCFields
+        timers.maxwell.restart();
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            ( *this )( ipatch )->EMfields->MaxwellFaradaySolver_->updateInterior( ( *this )( ipatch )->EMfields );
         }
-        SyncVectorPatch::exchangeB( params, ( *this ), smpi );
+        timers.maxwell.update( params.printNow( itime ) );
     } else {
-        for( unsigned int imode = 0 ; imode < static_cast<ElectroMagnAM *>( patches_[0]->EMfields )->El_.size() ; imode++ ) {
-            SyncVectorPatch::exchangeE( params, ( *this ), imode, smpi );
-            //SyncVectorPatch::finalizeexchangeE( params, ( *this ), imode ); // disable async, because of tags which is the same for all modes
-            SyncVectorPatch::exchangeB( params, ( *this ), imode, smpi );
-            //SyncVectorPatch::finalizeexchangeB( params, ( *this ), imode ); // disable async, because of tags which is the same for all modes
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            // Computes Bx_, By_, Bz_ at time n+1 on interior points.
+            ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
+        }
+        //Synchronize B fields between patches.
+        timers.maxwell.update( params.printNow( itime ) );
+
+
+        timers.syncField.restart();
+        if( params.geometry != "AMcylindrical" ) {
+            if( params.is_spectral ) {
+                SyncVectorPatch::exchangeE( params, ( *this ), smpi );
+            }
+            SyncVectorPatch::exchangeB( params, ( *this ), smpi );
+        } else {
+            for( unsigned int imode = 0 ; imode < static_cast<ElectroMagnAM *>( patches_[0]->EMfields )->El_.size() ; imode++ ) {
+                SyncVectorPatch::exchangeE( params, ( *this ), imode, smpi );
+                //SyncVectorPatch::finalizeexchangeE( params, ( *this ), imode ); // disable async, because of tags which is the same for all modes
+                SyncVectorPatch::exchangeB( params, ( *this ), imode, smpi );
+                //SyncVectorPatch::finalizeexchangeB( params, ( *this ), imode ); // disable async, because of tags which is the same for all modes
+            }
         }
+        timers.syncField.update( params.printNow( itime ) );
     }
-    timers.syncField.update( params.printNow( itime ) );
     
     
     if ( (params.uncoupled_grids) && ( itime!=0 ) && ( time_dual > params.time_fields_frozen ) ) { // uncoupled_grids = true -> is_spectral = true
@@ -1302,6 +1408,13 @@ void VectorPatch::initAllDiags( Params &params, SmileiMPI *smpi )
 } // END initAllDiags
 
 
+void VectorPatch::finishGlobalDiags( SmileiMPI *smpi )
+{
+    for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+        globalDiags[idiag]->finishReduction( smpi );
+    }
+}
+
 void VectorPatch::closeAllDiags( SmileiMPI *smpi )
 {
     // MPI master closes all global diags
@@ -1333,11 +1446,15 @@ void VectorPatch::runAllDiags( Params &params, SmileiMPI *smpi, unsigned int iti
         globalDiags[idiag]->theTimeIsNow = globalDiags[idiag]->prepare( itime );
         #pragma omp barrier
         if( globalDiags[idiag]->theTimeIsNow ) {
+            #pragma omp single
+            globalDiags[idiag]->prepareAllPatches( *this, itime );
             // All patches run
             #pragma omp for schedule(runtime)
             for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
-                globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
+                globalDiags[idiag]->run( smpi, ( *this )( ipatch ), itime, simWindow );
             }
+            // Threads sum their private contributions
+            globalDiags[idiag]->reduceThreads();
             // MPI procs gather the data and compute
             #pragma omp single
             smpi->computeGlobalDiags( globalDiags[idiag], itime );
@@ -1401,6 +1518,80 @@ bool VectorPatch::isRhoNull( SmileiMPI *smpi )
 } // END isRhoNull
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Preconditioned conjugate gradient (Main.poisson_solver = "pcg") of the Poisson or relativistic Poisson problem
+//   - block-Jacobi preconditioner: symmetric Gauss-Seidel sweep inside each patch
+//   - Chronopoulos-Gear formulation: the 3 scalar products of an iteration are summed in a single MPI_Allreduce
+//   - patches shared between the OpenMP threads (serial when called from a master section)
+// phi, r and p are those set by initPoisson. Iterates while r.r > rr_max, returns the number of iterations and r.r
+// ---------------------------------------------------------------------------------------------------------------------
+unsigned int VectorPatch::solvePoissonPCG( Params &params, SmileiMPI *smpi, bool relativistic, double gamma_mean,
+                                           double rr_max, unsigned int iteration_max, double &rr )
+{
+    unsigned int npatches = this->size();
+    std::vector<Field *> u_( npatches );
+    for( unsigned int ipatch=0 ; ipatch<npatches ; ipatch++ ) {
+        ( *this )( ipatch )->EMfields->initPoissonPCG();
+        u_[ipatch] = ( *this )( ipatch )->EMfields->u_;
+    }
+    
+    std::vector<double> dots_patch( 3*npatches );
+    double alpha = 0., r_dot_u_old = 0.;
+    unsigned int iteration = 0;
+    while( true ) {
+        // u = M^-1 r
+        #pragma omp parallel for schedule(dynamic)
+        for( unsigned int ipatch=0 ; ipatch<npatches ; ipatch++ ) {
+            ( *this )( ipatch )->EMfields->preconditionPoisson( gamma_mean );
+        }
+        SyncVectorPatch::exchangeAlongAllDirectionsNoOMP<double,Field>( u_, *this, smpi );
+        SyncVectorPatch::finalizeExchangeAlongAllDirectionsNoOMP( u_, *this );
+        
+        // w = A u and scalar products (r,u), (w,u), (r,r)
+        #pragma omp parallel for schedule(dynamic)
+        for( unsigned int ipatch=0 ; ipatch<npatches ; ipatch++ ) {
+            ( *this )( ipatch )->EMfields->compute_Au( ( *this )( ipatch ), relativistic, gamma_mean );
+            ( *this )( ipatch )->EMfields->compute_PCG_dots( &dots_patch[3*ipatch] );
+        }
+        // Summed in the patch order, so that the result does not depend on the threads
+        double dots_local[3] = { 0., 0., 0. }, dots[3];
+        for( unsigned int ipatch=0 ; ipatch<npatches ; ipatch++ ) {
+            for( unsigned int i=0 ; i<3 ; i++ ) {
+                dots_local[i] += dots_patch[3*ipatch+i];
+            }
+        }
+        MPI_Allreduce( dots_local, dots, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        rr = dots[2];
+        if( rr <= rr_max || iteration >= iteration_max ) {
+            break;
+        }
+        iteration++;
+        
+        double beta = 0.;
+        if( iteration == 1 ) {
+            alpha = dots[0] / dots[1];
+        } else {
+            beta  = dots[0] / r_dot_u_old;
+            alpha = dots[0] / ( dots[1] - beta * dots[0] / alpha );
+        }
+        r_dot_u_old = dots[0];
+        if( smpi->isMaster() ) {
+            DEBUG( "PCG iteration " << iteration << " started with residual r.r = " << rr );
+        }
+        
+        #pragma omp parallel for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<npatches ; ipatch++ ) {
+            ( *this )( ipatch )->EMfields->update_PCG( alpha, beta );
+        }
+    }
+    
+    for( unsigned int ipatch=0 ; ipatch<npatches ; ipatch++ ) {
+        ( *this )( ipatch )->EMfields->deletePoissonPCG();
+    }
+    return iteration;
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Solve Poisson to initialize E
 //   - all steps are done locally, sync per patch, sync per MPI process
@@ -1450,60 +1641,65 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
     if( smpi->isMaster() ) {
         DEBUG( "Starting iterative loop for CG method" );
     }
-    while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
-        iteration++;
-        if( smpi->isMaster() ) {
-            DEBUG( "iteration " << iteration << " started with control parameter ctrl = " << ctrl*1.e14 << " x 1e-14" );
-        }
+    if( params.poisson_solver == "pcg" ) {
+        iteration = solvePoissonPCG( params, smpi, false, 1., error_max*nx_p2_global, iteration_max, rnew_dot_rnew );
+        ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
+    } else {
+        while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
+            iteration++;
+            if( smpi->isMaster() ) {
+                DEBUG( "iteration " << iteration << " started with control parameter ctrl = " << ctrl*1.e14 << " x 1e-14" );
+            }
 
-        // scalar product of the residual
-        double r_dot_r = rnew_dot_rnew;
+            // scalar product of the residual
+            double r_dot_r = rnew_dot_rnew;
 
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->compute_Ap( ( *this )( ipatch ) );
-        }
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->compute_Ap( ( *this )( ipatch ) );
+            }
 
-        // Exchange Ap_ (intra & extra MPI)
-        SyncVectorPatch::exchangeAlongAllDirections<double,Field>( Ap_, *this, smpi );
-        SyncVectorPatch::finalizeExchangeAlongAllDirections( Ap_, *this );
+            // Exchange Ap_ (intra & extra MPI)
+            SyncVectorPatch::exchangeAlongAllDirections<double,Field>( Ap_, *this, smpi );
+            SyncVectorPatch::finalizeExchangeAlongAllDirections( Ap_, *this );
 
-        // scalar product p.Ap
-        double p_dot_Ap       = 0.0;
-        double p_dot_Ap_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            p_dot_Ap_local += ( *this )( ipatch )->EMfields->compute_pAp();
-        }
-        MPI_Allreduce( &p_dot_Ap_local, &p_dot_Ap, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            // scalar product p.Ap
+            double p_dot_Ap       = 0.0;
+            double p_dot_Ap_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                p_dot_Ap_local += ( *this )( ipatch )->EMfields->compute_pAp();
+            }
+            MPI_Allreduce( &p_dot_Ap_local, &p_dot_Ap, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
 
 
-        // compute new potential and residual
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
-        }
+            // compute new potential and residual
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            }
 
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
-        }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
-        if( smpi->isMaster() ) {
-            DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
-        }
+            // compute new residual norm
+            rnew_dot_rnew       = 0.0;
+            rnew_dot_rnew_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            }
+            MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            if( smpi->isMaster() ) {
+                DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
+            }
 
-        // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
-        }
+            // compute new directio
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
 
-        // compute control parameter
-        ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
-        if( smpi->isMaster() ) {
-            DEBUG( "iteration " << iteration << " done, exiting with control parameter ctrl = " << ctrl );
-        }
+            // compute control parameter
+            ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
+            if( smpi->isMaster() ) {
+                DEBUG( "iteration " << iteration << " done, exiting with control parameter ctrl = " << ctrl );
+            }
 
-    }//End of the iterative loop
+        }//End of the iterative loop
+    }
 
 
     // --------------------------------
@@ -2065,63 +2261,69 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
     if( smpi->isMaster() ) {
         DEBUG( "Starting iterative loop for CG method" );
     }
-    while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
-        iteration++;
+    if( params.poisson_solver == "pcg" ) {
+        double rr_max = error_max*norm2_source_term;
+        iteration = solvePoissonPCG( params, smpi, true, gamma_mean, rr_max*rr_max, iteration_max, rnew_dot_rnew );
+        ctrl = sqrt( rnew_dot_rnew )/norm2_source_term;
+    } else {
+        while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
+            iteration++;
 
-        if( ( smpi->isMaster() ) && ( iteration%1000==0 ) ) {
-            MESSAGE( "iteration " << iteration << " started with control parameter ctrl = " << 1.0e22*ctrl << " x 1.e-22" );
-        }
+            if( ( smpi->isMaster() ) && ( iteration%1000==0 ) ) {
+                MESSAGE( "iteration " << iteration << " started with control parameter ctrl = " << 1.0e22*ctrl << " x 1.e-22" );
+            }
 
-        // scalar product of the residual
-        double r_dot_r = rnew_dot_rnew;
+            // scalar product of the residual
+            double r_dot_r = rnew_dot_rnew;
 
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->compute_Ap_relativistic_Poisson( ( *this )( ipatch ), gamma_mean );
-        }
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->compute_Ap_relativistic_Poisson( ( *this )( ipatch ), gamma_mean );
+            }
 
-        // Exchange Ap_ (intra & extra MPI)
-        SyncVectorPatch::exchangeAlongAllDirectionsNoOMP<double,Field>( Ap_, *this, smpi );
-        SyncVectorPatch::finalizeExchangeAlongAllDirectionsNoOMP( Ap_, *this );
+            // Exchange Ap_ (intra & extra MPI)
+            SyncVectorPatch::exchangeAlongAllDirectionsNoOMP<double,Field>( Ap_, *this, smpi );
+            SyncVectorPatch::finalizeExchangeAlongAllDirectionsNoOMP( Ap_, *this );
 
 
-        // scalar product p.Ap
-        double p_dot_Ap       = 0.0;
-        double p_dot_Ap_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            p_dot_Ap_local += ( *this )( ipatch )->EMfields->compute_pAp();
-        }
-        MPI_Allreduce( &p_dot_Ap_local, &p_dot_Ap, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            // scalar product p.Ap
+            double p_dot_Ap       = 0.0;
+            double p_dot_Ap_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                p_dot_Ap_local += ( *this )( ipatch )->EMfields->compute_pAp();
+            }
+            MPI_Allreduce( &p_dot_Ap_local, &p_dot_Ap, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
 
 
-        // compute new potential and residual
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
-        }
+            // compute new potential and residual
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            }
 
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
-        }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
-        if( smpi->isMaster() ) {
-            DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
-        }
+            // compute new residual norm
+            rnew_dot_rnew       = 0.0;
+            rnew_dot_rnew_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            }
+            MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            if( smpi->isMaster() ) {
+                DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
+            }
 
-        // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
-        }
+            // compute new directio
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
 
-        // compute control parameter
+            // compute control parameter
         
-        ctrl = sqrt( rnew_dot_rnew )/norm2_source_term;
-        if( smpi->isMaster() ) {
-            DEBUG( "iteration " << iteration << " done, exiting with control parameter ctrl = " << 1.0e22*ctrl << " x 1.e-22" );
-        }
+            ctrl = sqrt( rnew_dot_rnew )/norm2_source_term;
+            if( smpi->isMaster() ) {
+                DEBUG( "iteration " << iteration << " done, exiting with control parameter ctrl = " << 1.0e22*ctrl << " x 1.e-22" );
+            }
 
-    }//End of the iterative loop
+        }//End of the iterative loop
+    }
 
 
     // --------------------------------
@@ -3573,7 +3775,7 @@ void VectorPatch::applyAntennas( double time )
 }
 
 // For each patch, apply the collisions
-void VectorPatch::applyCollisions( Params &params, int itime, Timers &timers )
+void VectorPatch::applyCollisions( Params &params, SmileiMPI *smpi, int itime, Timers &timers )
 {
     timers.collisions.restart();
 
@@ -3588,8 +3790,12 @@ void VectorPatch::applyCollisions( Params &params, int itime, Timers &timers )
     
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        double patch_timer = params.measure_patch_load ? MPI_Wtime() : 0.;
         for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
-            patches_[ipatch]->vecCollisions[icoll]->collide( params, patches_[ipatch], itime, localDiags );
+            patches_[ipatch]->vecCollisions[icoll]->collide( params, smpi, patches_[ipatch], itime, localDiags );
+        }
+        if( params.measure_patch_load ) {
+            patches_[ipatch]->measured_load_[1] += MPI_Wtime() - patch_timer;
         }
     }
     
@@ -3607,20 +3813,7 @@ void VectorPatch::allocateField( unsigned int ifield, Params &params )
 {
     for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
         if( params.geometry != "AMcylindrical" ) {
-            Field *field = emfields( ipatch )->allFields[ifield];
-            if( field->data_ != NULL ) {
-                continue;
-            }
-            if( ( field->name.substr( 0, 2 )=="Jx" ) && (!params.is_pxr) ) {
-                field->allocateDims( 0, false );
-            } else if( ( field->name.substr( 0, 2 )=="Jy" ) && (!params.is_pxr) ) {
-                field->allocateDims( 1, false );
-            } else if( ( field->name.substr( 0, 2 )=="Jz" ) && (!params.is_pxr) ) {
-                field->allocateDims( 2, false );
-            } else if( ( field->name.substr( 0, 2 )=="Rh" ) || (params.is_pxr) ) {
-                field->allocateDims();
-            }
-            //MESSAGE("HNA4");
+            emfields( ipatch )->allocateSpeciesField( emfields( ipatch )->allFields[ifield] );
         } else {
             cField2D *field = static_cast<cField2D *>( emfields( ipatch )->allFields[ifield] );
             if( field->cdata_ != NULL ) {
@@ -3708,6 +3901,24 @@ void VectorPatch::checkMemoryConsumption( SmileiMPI *smpi )
     MPI_Reduce( smpi->isMaster()?MPI_IN_PLACE:&fieldsMem, &fieldsMem, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD );
     MESSAGE( 1, "Max Fields part = " << ( int )( ( double )fieldsMem / 1024./1024. ) << " MB" );
 
+    // Fields per species, allocated only at the timesteps where the diagnostics need them
+    long int speciesFieldsMem( 0 );
+    // Largest memory of a patch (particles, fields and fields per species)
+    double patchMem( 0. );
+    for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        speciesFieldsMem += patches_[ipatch]->EMfields->getSpeciesMemFootPrint();
+        patchMem = max( patchMem, ( double )patches_[ipatch]->getMemFootPrint() );
+    }
+    double dSpeciesFieldsMem = ( double )speciesFieldsMem / 1024./1024./1024.;
+    MPI_Reduce( smpi->isMaster()?MPI_IN_PLACE:&dSpeciesFieldsMem, &dSpeciesFieldsMem, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+    if( dSpeciesFieldsMem>0. ) {
+        MESSAGE( 1, "(Master) Fields per species part = " << ( int )( ( double )speciesFieldsMem / 1024./1024. ) << " MB (only when the diagnostics need them)" );
+        MESSAGE( 1, setprecision( 3 ) << "Global Fields per species part = " << dSpeciesFieldsMem << " GB" );
+    }
+
+    MPI_Reduce( smpi->isMaster()?MPI_IN_PLACE:&patchMem, &patchMem, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+    MESSAGE( 1, setprecision( 3 ) << "Max peak memory of a patch = " << patchMem / 1024./1024. << " MB" );
+
 
     for( unsigned int idiags=0 ; idiags<globalDiags.size() ; idiags++ ) {
         // fieldsMem contains field per species
@@ -19,6 +19,9 @@
 #include "Timers.h"
 #include "RadiationTables.h"
 #include "ParticleCreator.h"
+#include "NeighborMessages.h"
+
+#include <map>
 
 class Field;
 class Timer;
@@ -110,6 +113,9 @@ public :
     //! Reconfigure all patches for the new time step
     void reconfiguration( Params &params, Timers &timers, int itime );
     
+    //! NUMA-aware mode: move the memory of the patches to the NUMA node of the threads which compute them
+    void firstTouch( Params &params, Timers &timers );
+    
     //! Particle sorting for all patches
     void sortAllParticles( Params &params );
     
@@ -184,6 +190,8 @@ public :
     void runAllDiags( Params &params, SmileiMPI *smpi, unsigned int itime, Timers &timers, SimWindow *simWindow );
     void initAllDiags( Params &params, SmileiMPI *smpi );
     void closeAllDiags( SmileiMPI *smpi );
+    //! Complete the non-blocking reductions of the global diags, and write them
+    void finishGlobalDiags( SmileiMPI *smpi );
     
     //! Check if rho is null (MPI & patch sync)
     bool isRhoNull( SmileiMPI *smpi );
@@ -192,6 +200,9 @@ public :
     void solvePoisson( Params &params, SmileiMPI *smpi );
     void runNonRelativisticPoissonModule( Params &params, SmileiMPI* smpi,  Timers &timers );
     void solvePoissonAM( Params &params, SmileiMPI *smpi);
+    //! Preconditioned conjugate gradient for solvePoisson and solveRelativisticPoisson (Main.poisson_solver = "pcg")
+    unsigned int solvePoissonPCG( Params &params, SmileiMPI *smpi, bool relativistic, double gamma_mean,
+                                  double rr_max, unsigned int iteration_max, double &rr );
     
     //! Solve relativistic Poisson problem to initialize E and B of a relativistic bunch
     void runRelativisticModule( double time_prim, Params &params, SmileiMPI* smpi,  Timers &timers );
@@ -205,7 +216,7 @@ public :
     void applyAntennas( double time );
     
     //! For all patches, apply collisions
-    void applyCollisions( Params &params, int itime, Timers &timer );
+    void applyCollisions( Params &params, SmileiMPI *smpi, int itime, Timers &timer );
     
     //! For all patches, allocate a field if not allocated
     void allocateField( unsigned int ifield, Params &params );
@@ -356,6 +367,12 @@ public :
     
     DomainDecomposition *domain_decomposition_;
     
+    //! Aggregate the halo messages of the patches per neighbour process (Main.aggregate_mpi_messages)
+    bool aggregate_messages_;
+    
+    //! Aggregated messages of the exchange named key, created at its first use
+    NeighborMessages &neighborMessages( const std::string &key );
+    
     
     //! Methods to access readably to patch PIC operators.
     //!   - patches_ should not be access outsied of VectorPatch
@@ -398,6 +415,10 @@ private :
     double antenna_intensity;
     
     std::vector<Timer *> diag_timers;
+    
+    //! Communicator of the aggregated messages, apart from the tags of the patch by patch messages
+    MPI_Comm neighbor_comm_;
+    std::map<std::string, NeighborMessages *> neighbor_messages_;
 };
 
 
@@ -10,56 +10,56 @@ double Function_Python1D::valueAt( double time )
 {
     return PyTools::runPyFunction( py_profile, time );
 }
-double Function_Python1D::valueAt( vector<double> x_cell, double time )
+double Function_Python1D::valueAt( const vector<double> &x_cell, double time )
 {
     return PyTools::runPyFunction( py_profile, time );
 }
-double Function_Python1D::valueAt( vector<double> x_cell )
+double Function_Python1D::valueAt( const vector<double> &x_cell )
 {
     return PyTools::runPyFunction( py_profile, x_cell[0] );
 }
 
 // 2D
-double Function_Python2D::valueAt( vector<double> x_cell, double time )
+double Function_Python2D::valueAt( const vector<double> &x_cell, double time )
 {
     return PyTools::runPyFunction( py_profile, x_cell[0], time );
 }
-double Function_Python2D::valueAt( vector<double> x_cell )
+double Function_Python2D::valueAt( const vector<double> &x_cell )
 {
     return PyTools::runPyFunction( py_profile, x_cell[0], x_cell[1] );
 }
 // 2D complex
-std::complex<double> Function_Python2D::complexValueAt( vector<double> x_cell, double time )
+std::complex<double> Function_Python2D::complexValueAt( const vector<double> &x_cell, double time )
 {
     return PyTools::runPyFunction_complex( py_profile, x_cell[0], time );
 }
-std::complex<double> Function_Python2D::complexValueAt( vector<double> x_cell )
+std::complex<double> Function_Python2D::complexValueAt( const vector<double> &x_cell )
 {
     return PyTools::runPyFunction_complex( py_profile, x_cell[0], x_cell[1] );
 }
 
 // 3D
-double Function_Python3D::valueAt( vector<double> x_cell, double time )
+double Function_Python3D::valueAt( const vector<double> &x_cell, double time )
 {
     return PyTools::runPyFunction( py_profile, x_cell[0], x_cell[1], time );
 }
-double Function_Python3D::valueAt( vector<double> x_cell )
+double Function_Python3D::valueAt( const vector<double> &x_cell )
 {
     return PyTools::runPyFunction( py_profile, x_cell[0], x_cell[1], x_cell[2] );
 }
 // 3D complex
-std::complex<double> Function_Python3D::complexValueAt( vector<double> x_cell, double time )
+std::complex<double> Function_Python3D::complexValueAt( const vector<double> &x_cell, double time )
 {
     return PyTools::runPyFunction_complex( py_profile, x_cell[0], x_cell[1], time );
 }
 
 // 4D
-double Function_Python4D::valueAt( vector<double> x_cell, double time )
+double Function_Python4D::valueAt( const vector<double> &x_cell, double time )
 {
     return PyTools::runPyFunction( py_profile, x_cell[0], x_cell[1], x_cell[2], time );
 }
 // 4D complex
-std::complex<double> Function_Python4D::complexValueAt( vector<double> x_cell, double time )
+std::complex<double> Function_Python4D::complexValueAt( const vector<double> &x_cell, double time )
 {
     return PyTools::runPyFunction_complex( py_profile, x_cell[0], x_cell[1], x_cell[2], time );
 }
@@ -119,114 +119,179 @@ PyArrayObject *Function_Python4D::complexValueAt( std::vector<PyArrayObject *> x
 
 
 // Constant profiles
-double Function_Constant1D::valueAt( vector<double> x_cell )
+double Function_Constant1D::valueAt( const vector<double> &x_cell )
 {
     return ( x_cell[0]>=xvacuum ) ? value : 0.;
 }
-double Function_Constant2D::valueAt( vector<double> x_cell )
+double Function_Constant2D::valueAt( const vector<double> &x_cell )
 {
     return ( ( x_cell[0]>=xvacuum ) && ( x_cell[1]>=yvacuum ) ) ? value : 0.;
 }
-double Function_Constant3D::valueAt( vector<double> x_cell )
+double Function_Constant3D::valueAt( const vector<double> &x_cell )
 {
     return ( ( x_cell[0]>=xvacuum ) && ( x_cell[1]>=yvacuum ) && ( x_cell[2]>=zvacuum ) ) ? value : 0.;
 }
+void Function_Constant1D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = ( x[i]>=xvacuum ) ? value : 0.;
+    }
+}
+void Function_Constant2D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = ( ( x[i]>=xvacuum ) && ( y[i]>=yvacuum ) ) ? value : 0.;
+    }
+}
+void Function_Constant3D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    const double *__restrict__ z = x_cell[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = ( ( x[i]>=xvacuum ) && ( y[i]>=yvacuum ) && ( z[i]>=zvacuum ) ) ? value : 0.;
+    }
+}
 
 // Constant profiles + time
-double Function_Constant1D::valueAt( vector<double> x_cell, double time )
+double Function_Constant1D::valueAt( const vector<double> &x_cell, double time )
 {
     return ( x_cell[0]>=xvacuum ) ? value : 0.;
 }
-double Function_Constant2D::valueAt( vector<double> x_cell, double time )
+double Function_Constant2D::valueAt( const vector<double> &x_cell, double time )
 {
     return ( ( x_cell[0]>=xvacuum ) && ( x_cell[1]>=yvacuum ) ) ? value : 0.;
 }
-double Function_Constant3D::valueAt( vector<double> x_cell, double time )
+double Function_Constant3D::valueAt( const vector<double> &x_cell, double time )
 {
     return ( ( x_cell[0]>=xvacuum ) && ( x_cell[1]>=yvacuum ) && ( x_cell[2]>=zvacuum ) ) ? value : 0.;
 }
 
-// Trapezoidal profiles
+// Trapezoidal profiles (written without branches so that the loops over points can be vectorized)
 inline double trapeze( double x, double plateau, double slope1, double slope2, double invslope1, double invslope2 )
 {
-    double result = 0.;
-    if( x > 0. ) {
-        if( x < slope1 ) {
-            result = invslope1 * x;
-        } else {
-            x -= slope1 + plateau;
-            if( x < 0. ) {
-                result = 1.;
-            } else {
-                x -= slope2;
-                if( x < 0. ) {
-                    result = - x * invslope2;
-                }
-            }
-        }
-    }
-    return result;
+    double x_plateau_end = x - ( slope1 + plateau );
+    double x_slope2_end = x_plateau_end - slope2;
+    double result = ( x_slope2_end < 0. ) ? - x_slope2_end * invslope2 : 0.;
+    result = ( x_plateau_end < 0. ) ? 1. : result;
+    result = ( x < slope1 ) ? invslope1 * x : result;
+    return ( x > 0. ) ? result : 0.;
 }
-double Function_Trapezoidal1D::valueAt( vector<double> x_cell )
+double Function_Trapezoidal1D::valueAt( const vector<double> &x_cell )
 {
     return value * trapeze( x_cell[0]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 );
 }
-double Function_Trapezoidal2D::valueAt( vector<double> x_cell )
+double Function_Trapezoidal2D::valueAt( const vector<double> &x_cell )
 {
     return value
            * trapeze( x_cell[0]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 )
            * trapeze( x_cell[1]-yvacuum, yplateau, yslope1, yslope2, invyslope1, invyslope2 );
 }
-double Function_Trapezoidal3D::valueAt( vector<double> x_cell )
+double Function_Trapezoidal3D::valueAt( const vector<double> &x_cell )
 {
     return value
            * trapeze( x_cell[0]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 )
            * trapeze( x_cell[1]-yvacuum, yplateau, yslope1, yslope2, invyslope1, invyslope2 )
            * trapeze( x_cell[2]-zvacuum, zplateau, zslope1, zslope2, invzslope1, invzslope2 );
 }
-
-// Gaussian profiles
-double Function_Gaussian1D::valueAt( vector<double> x_cell )
+void Function_Trapezoidal1D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
 {
-    double x = x_cell[0], xfactor=0.;
-    if( x > xvacuum  && x < xvacuum+xlength ) {
-        xfactor = xorder ? exp( -pow( x-xcenter, xorder ) * invxsigma ) : 1.;
+    const double *__restrict__ x = x_cell[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value * trapeze( x[i]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 );
     }
-    return value * xfactor;
 }
-double Function_Gaussian2D::valueAt( vector<double> x_cell )
+void Function_Trapezoidal2D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
 {
-    double x = x_cell[0], xfactor=0.;
-    double y = x_cell[1], yfactor=0.;
-    if( x > xvacuum  && x < xvacuum+xlength ) {
-        xfactor = xorder ? exp( -pow( x-xcenter, xorder ) * invxsigma ) : 1.;
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * trapeze( x[i]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 )
+                    * trapeze( y[i]-yvacuum, yplateau, yslope1, yslope2, invyslope1, invyslope2 );
     }
-    if( y > yvacuum  && y < yvacuum+ylength ) {
-        yfactor = yorder ? exp( -pow( y-ycenter, yorder ) * invysigma ) : 1.;
+}
+void Function_Trapezoidal3D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    const double *__restrict__ z = x_cell[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * trapeze( x[i]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 )
+                    * trapeze( y[i]-yvacuum, yplateau, yslope1, yslope2, invyslope1, invyslope2 )
+                    * trapeze( z[i]-zvacuum, zplateau, zslope1, zslope2, invzslope1, invzslope2 );
     }
-    return value * xfactor * yfactor;
 }
-double Function_Gaussian3D::valueAt( vector<double> x_cell )
+
+// Gaussian profiles
+inline double gaussian( double x, double vacuum, double length, double center, int order, double invsigma )
 {
-    double x = x_cell[0], xfactor=0.;
-    double y = x_cell[1], yfactor=0.;
-    double z = x_cell[2], zfactor=0.;
-    if( x > xvacuum  && x < xvacuum+xlength ) {
-        xfactor = xorder ? exp( -pow( x-xcenter, xorder ) * invxsigma ) : 1.;
+    double factor = order ? exp( -pow( x-center, order ) * invsigma ) : 1.;
+    return ( x > vacuum  && x < vacuum+length ) ? factor : 0.;
+}
+double Function_Gaussian1D::valueAt( const vector<double> &x_cell )
+{
+    return value * gaussian( x_cell[0], xvacuum, xlength, xcenter, xorder, invxsigma );
+}
+double Function_Gaussian2D::valueAt( const vector<double> &x_cell )
+{
+    return value
+           * gaussian( x_cell[0], xvacuum, xlength, xcenter, xorder, invxsigma )
+           * gaussian( x_cell[1], yvacuum, ylength, ycenter, yorder, invysigma );
+}
+double Function_Gaussian3D::valueAt( const vector<double> &x_cell )
+{
+    return value
+           * gaussian( x_cell[0], xvacuum, xlength, xcenter, xorder, invxsigma )
+           * gaussian( x_cell[1], yvacuum, ylength, ycenter, yorder, invysigma )
+           * gaussian( x_cell[2], zvacuum, zlength, zcenter, zorder, invzsigma );
+}
+void Function_Gaussian1D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value * gaussian( x[i], xvacuum, xlength, xcenter, xorder, invxsigma );
     }
-    if( y > yvacuum  && y < yvacuum+ylength ) {
-        yfactor = yorder ? exp( -pow( y-ycenter, yorder ) * invysigma ) : 1.;
+}
+void Function_Gaussian2D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * gaussian( x[i], xvacuum, xlength, xcenter, xorder, invxsigma )
+                    * gaussian( y[i], yvacuum, ylength, ycenter, yorder, invysigma );
     }
-    if( z > zvacuum  && z < zvacuum+zlength ) {
-        zfactor = zorder ? exp( -pow( z-zcenter, zorder ) * invzsigma ) : 1.;
+}
+void Function_Gaussian3D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    const double *__restrict__ z = x_cell[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * gaussian( x[i], xvacuum, xlength, xcenter, xorder, invxsigma )
+                    * gaussian( y[i], yvacuum, ylength, ycenter, yorder, invysigma )
+                    * gaussian( z[i], zvacuum, zlength, zcenter, zorder, invzsigma );
     }
-    return value * xfactor * yfactor * zfactor;
 }
 
 // Polygonal profiles
-double Function_Polygonal1D::valueAt( vector<double> x_cell )
+inline double polygonal( double x, const vector<double> &xpoints, const vector<double> &xvalues, const vector<double> &xslopes, int npoints )
 {
-    double x = x_cell[0];
     if( x < xpoints[0] ) {
         return 0.;
     }
@@ -236,71 +301,109 @@ double Function_Polygonal1D::valueAt( vector<double> x_cell )
         }
     return 0.;
 }
-double Function_Polygonal2D::valueAt( vector<double> x_cell )
+// Loop over the segments, in reverse order so that each point finally gets
+// the first segment whose end is beyond the point, as in the scalar version
+inline void polygonal( const double *__restrict__ x, unsigned int n, double *__restrict__ values,
+                       const vector<double> &xpoints, const vector<double> &xvalues, const vector<double> &xslopes, int npoints )
 {
-    double x = x_cell[0];
-    if( x < xpoints[0] ) {
-        return 0.;
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = 0.;
     }
-    for( int i=1; i<npoints; i++ )
-        if( x < xpoints[i] ) {
-            return xvalues[i-1] + xslopes[i-1] * ( x - xpoints[i-1] );
+    for( int ipoint=npoints-1; ipoint>0; ipoint-- ) {
+        double xend = xpoints[ipoint];
+        double xstart = xpoints[ipoint-1];
+        double value = xvalues[ipoint-1];
+        double slope = xslopes[ipoint-1];
+        #pragma omp simd
+        for( unsigned int i=0; i<n; i++ ) {
+            values[i] = ( x[i] < xend ) ? value + slope * ( x[i] - xstart ) : values[i];
         }
-    return 0.;
+    }
+    double xstart = npoints>0 ? xpoints[0] : 0.;
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = ( x[i] < xstart ) ? 0. : values[i];
+    }
 }
-double Function_Polygonal3D::valueAt( vector<double> x_cell )
+double Function_Polygonal1D::valueAt( const vector<double> &x_cell )
 {
-    double x = x_cell[0];
-    if( x < xpoints[0] ) {
-        return 0.;
-    }
-    for( int i=1; i<npoints; i++ )
-        if( x < xpoints[i] ) {
-            return xvalues[i-1] + xslopes[i-1] * ( x - xpoints[i-1] );
-        }
-    return 0.;
+    return polygonal( x_cell[0], xpoints, xvalues, xslopes, npoints );
+}
+double Function_Polygonal2D::valueAt( const vector<double> &x_cell )
+{
+    return polygonal( x_cell[0], xpoints, xvalues, xslopes, npoints );
+}
+double Function_Polygonal3D::valueAt( const vector<double> &x_cell )
+{
+    return polygonal( x_cell[0], xpoints, xvalues, xslopes, npoints );
+}
+void Function_Polygonal1D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    polygonal( x_cell[0], n, values, xpoints, xvalues, xslopes, npoints );
+}
+void Function_Polygonal2D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    polygonal( x_cell[0], n, values, xpoints, xvalues, xslopes, npoints );
+}
+void Function_Polygonal3D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    polygonal( x_cell[0], n, values, xpoints, xvalues, xslopes, npoints );
 }
 
-// Cosine profiles
-double Function_Cosine1D::valueAt( vector<double> x_cell )
+// Cosine profiles (x normalized to the length of the profile)
+inline double cosine( double x, double base, double amplitude, double phi, double number2pi )
 {
-    double x = ( x_cell[0] - xvacuum ) * invxlength, xfactor = 0.;
-    if( x > 0. && x < 1. ) {
-        xfactor = base + xamplitude * cos( xphi + xnumber2pi * x );
-    }
-    return xfactor;
+    return ( x > 0. && x < 1. ) ? base + amplitude * cos( phi + number2pi * x ) : 0.;
 }
-double Function_Cosine2D::valueAt( vector<double> x_cell )
+double Function_Cosine1D::valueAt( const vector<double> &x_cell )
 {
-    double x = ( x_cell[0] - xvacuum ) * invxlength, xfactor = 0.;
-    double y = ( x_cell[1] - yvacuum ) * invylength, yfactor = 0.;
-    if( x > 0. && x < 1. ) {
-        xfactor = base + xamplitude * cos( xphi + xnumber2pi * x );
-    }
-    if( y > 0. && y < 1. ) {
-        yfactor = base + yamplitude * cos( yphi + ynumber2pi * y );
-    }
-    return xfactor * yfactor;
+    return cosine( ( x_cell[0] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi );
 }
-double Function_Cosine3D::valueAt( vector<double> x_cell )
+double Function_Cosine2D::valueAt( const vector<double> &x_cell )
 {
-    double x = ( x_cell[0] - xvacuum ) * invxlength, xfactor = 0.;
-    double y = ( x_cell[1] - yvacuum ) * invylength, yfactor = 0.;
-    double z = ( x_cell[2] - zvacuum ) * invzlength, zfactor = 0.;
-    if( x > 0. && x < 1. ) {
-        xfactor = base + xamplitude * cos( xphi + xnumber2pi * x );
+    return cosine( ( x_cell[0] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+           * cosine( ( x_cell[1] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi );
+}
+double Function_Cosine3D::valueAt( const vector<double> &x_cell )
+{
+    return cosine( ( x_cell[0] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+           * cosine( ( x_cell[1] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi )
+           * cosine( ( x_cell[2] - zvacuum ) * invzlength, base, zamplitude, zphi, znumber2pi );
+}
+void Function_Cosine1D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = cosine( ( x[i] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi );
     }
-    if( y > 0. && y < 1. ) {
-        yfactor = base + yamplitude * cos( yphi + ynumber2pi * y );
+}
+void Function_Cosine2D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = cosine( ( x[i] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+                    * cosine( ( y[i] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi );
     }
-    if( z > 0. && z < 1. ) {
-        zfactor = base + zamplitude * cos( zphi + znumber2pi * z );
+}
+void Function_Cosine3D::valuesAt( const vector<double *> &x_cell, unsigned int n, double *values )
+{
+    const double *__restrict__ x = x_cell[0];
+    const double *__restrict__ y = x_cell[1];
+    const double *__restrict__ z = x_cell[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = cosine( ( x[i] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+                    * cosine( ( y[i] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi )
+                    * cosine( ( z[i] - zvacuum ) * invzlength, base, zamplitude, zphi, znumber2pi );
     }
-    return xfactor * yfactor * zfactor;
 }
 
 // Polynomial profiles
-double Function_Polynomial1D::valueAt( vector<double> x_cell )
+double Function_Polynomial1D::valueAt( const vector<double> &x_cell )
 {
     double r = 0., xx0 = x_cell[0]-x0, xx = 1.;
     unsigned int currentOrder = 0;
@@ -313,7 +416,7 @@ double Function_Polynomial1D::valueAt( vector<double> x_cell )
     }
     return r;
 }
-double Function_Polynomial2D::valueAt( vector<double> x_cell )
+double Function_Polynomial2D::valueAt( const vector<double> &x_cell )
 {
     double r = 0., xx0 = x_cell[0]-x0, yy0 = x_cell[1]-y0;
     vector<double> xx;
@@ -336,7 +439,7 @@ double Function_Polynomial2D::valueAt( vector<double> x_cell )
     }
     return r;
 }
-double Function_Polynomial3D::valueAt( vector<double> x_cell )
+double Function_Polynomial3D::valueAt( const vector<double> &x_cell )
 {
     double r = 0., xx0 = x_cell[0]-x0, yy0 = x_cell[1]-y0, zz0 = x_cell[2]-z0;
     vector<double> xx;
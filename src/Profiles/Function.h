@@ -15,11 +15,24 @@ public:
     virtual ~Function() {};
     
     //! Gets the value of a N-D function at a point located by its coordinates in a vector
-    virtual double valueAt( std::vector<double> )
+    virtual double valueAt( const std::vector<double> & )
     {
         return 0.; // virtual => will be redefined
     };
     
+    //! Gets the values of a N-D function at n points, given by the arrays of coordinates x[0][0:n], x[1][0:n], ...
+    //! The built-in profiles redefine it with vectorized loops
+    virtual void valuesAt( const std::vector<double *> &x, unsigned int n, double *values )
+    {
+        std::vector<double> x_point( x.size() );
+        for( unsigned int i=0; i<n; i++ ) {
+            for( unsigned int ivar=0; ivar<x.size(); ivar++ ) {
+                x_point[ivar] = x[ivar][i];
+            }
+            values[i] = valueAt( x_point );
+        }
+    };
+    
     //! Gets the value of a 1-D function at a point located by a double
     virtual double valueAt( double x )
     {
@@ -30,21 +43,21 @@ public:
     };
     
     //! Gets the value of a N-D function from both a vector and a double. The double is the last argument.
-    virtual double valueAt( std::vector<double>, double )
+    virtual double valueAt( const std::vector<double> &, double )
     {
         ERROR("Profile `"<<getInfo()<<"` is not available");
         return 0.; // virtual => will be redefined
     };
     
     //! Gets the complex value of a N-D function from both a vector and a double. The double is the last argument.
-    virtual std::complex<double> complexValueAt( std::vector<double>, double )
+    virtual std::complex<double> complexValueAt( const std::vector<double> &, double )
     {
         ERROR("Profile `"<<getInfo()<<"` is not available");
         return 0.; // virtual => will be redefined
     };
     
     //! Gets the complex value of a N-D function from a vector.
-    virtual std::complex<double> complexValueAt( std::vector<double> )
+    virtual std::complex<double> complexValueAt( const std::vector<double> & )
     {
         ERROR("Profile `"<<getInfo()<<"` is not available");
         return 0.; // virtual => will be redefined
@@ -99,8 +112,8 @@ public:
     Function_Python1D( PyObject *pp ) : py_profile( pp ) {};
     Function_Python1D( Function_Python1D *f ) : py_profile( f->py_profile ) {};
     double valueAt( double ); // time
-    double valueAt( std::vector<double>, double ); // time (space discarded)
-    double valueAt( std::vector<double> ); // space
+    double valueAt( const std::vector<double> &, double ); // time (space discarded)
+    double valueAt( const std::vector<double> & ); // space
 #ifdef SMILEI_USE_NUMPY
     PyArrayObject *valueAt( std::vector<PyArrayObject *> ); // numpy
     PyArrayObject *valueAt( std::vector<PyArrayObject *>, double ); // numpy + time
@@ -115,10 +128,10 @@ class Function_Python2D : public Function
 public:
     Function_Python2D( PyObject *pp ) : py_profile( pp ) {};
     Function_Python2D( Function_Python2D *f ) : py_profile( f->py_profile ) {};
-    double valueAt( std::vector<double>, double ); // space + time
-    double valueAt( std::vector<double> ); // space
-    std::complex<double> complexValueAt( std::vector<double>, double ); // space + time
-    std::complex<double> complexValueAt( std::vector<double> ); // space
+    double valueAt( const std::vector<double> &, double ); // space + time
+    double valueAt( const std::vector<double> & ); // space
+    std::complex<double> complexValueAt( const std::vector<double> &, double ); // space + time
+    std::complex<double> complexValueAt( const std::vector<double> & ); // space
 #ifdef SMILEI_USE_NUMPY
     PyArrayObject *valueAt( std::vector<PyArrayObject *> ); // numpy
     PyArrayObject *valueAt( std::vector<PyArrayObject *>, double ); // numpy + time
@@ -143,9 +156,9 @@ class Function_Python3D : public Function
 public:
     Function_Python3D( PyObject *pp ) : py_profile( pp ) {};
     Function_Python3D( Function_Python3D *f ) : py_profile( f->py_profile ) {};
-    double valueAt( std::vector<double>, double ); // space + time
-    double valueAt( std::vector<double> ); // space
-    std::complex<double> complexValueAt( std::vector<double>, double ); // space + time
+    double valueAt( const std::vector<double> &, double ); // space + time
+    double valueAt( const std::vector<double> & ); // space
+    std::complex<double> complexValueAt( const std::vector<double> &, double ); // space + time
 #ifdef SMILEI_USE_NUMPY
     PyArrayObject *valueAt( std::vector<PyArrayObject *> ); // numpy
     PyArrayObject *valueAt( std::vector<PyArrayObject *> , double ); // numpy + time
@@ -169,8 +182,8 @@ class Function_Python4D : public Function
 public:
     Function_Python4D( PyObject *pp ) : py_profile( pp ) {};
     Function_Python4D( Function_Python4D *f ) : py_profile( f->py_profile ) {};
-    double valueAt( std::vector<double>, double ); // space + time
-    std::complex<double> complexValueAt( std::vector<double>, double ); // space + time
+    double valueAt( const std::vector<double> &, double ); // space + time
+    std::complex<double> complexValueAt( const std::vector<double> &, double ); // space + time
 #ifdef SMILEI_USE_NUMPY
     PyArrayObject *complexValueAt( std::vector<PyArrayObject *>, PyArrayObject * ); // numpy
     PyArrayObject *complexValueAt( std::vector<PyArrayObject *>, double ); // numpy + time
@@ -209,8 +222,9 @@ public:
         value   = f->value  ;
         xvacuum = f->xvacuum;
     };
-    double valueAt( std::vector<double> );
-    double valueAt( std::vector<double>, double );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
+    double valueAt( const std::vector<double> &, double );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value) + ")";
@@ -236,8 +250,9 @@ public:
         xvacuum = f->xvacuum;
         yvacuum = f->yvacuum;
     };
-    double valueAt( std::vector<double> );
-    double valueAt( std::vector<double>, double );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
+    double valueAt( const std::vector<double> &, double );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value) + ")";
@@ -265,8 +280,9 @@ public:
         yvacuum = f->yvacuum;
         zvacuum = f->zvacuum;
     };
-    double valueAt( std::vector<double> );
-    double valueAt( std::vector<double>, double );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
+    double valueAt( const std::vector<double> &, double );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value) + ")";
@@ -300,7 +316,8 @@ public:
         invxslope1 = 1./xslope1;
         invxslope2 = 1./xslope2;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -351,7 +368,8 @@ public:
         invyslope1 = 1./yslope1;
         invyslope2 = 1./yslope2;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -420,7 +438,8 @@ public:
         invzslope1 = 1./zslope1;
         invzslope2 = 1./zslope2;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -470,7 +489,8 @@ public:
         xcenter   = f->xcenter;
         xorder    = f->xorder ;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -522,7 +542,8 @@ public:
         ycenter   = f->ycenter;
         yorder    = f->yorder ;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -587,7 +608,8 @@ public:
         zcenter   = f->zcenter;
         zorder    = f->zorder ;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -625,7 +647,8 @@ public:
         xslopes = f->xslopes;
         npoints = xpoints.size();
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (xpoints: [";
@@ -669,7 +692,8 @@ public:
         xslopes = f->xslopes;
         npoints = xpoints.size();
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (xpoints: [";
@@ -713,7 +737,8 @@ public:
         xslopes = f->xslopes;
         npoints = xpoints.size();
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (xpoints: [";
@@ -764,7 +789,8 @@ public:
         xphi       = f->xphi      ;
         xnumber2pi = f->xnumber2pi     ;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = "";
@@ -818,7 +844,8 @@ public:
         yphi       = f->yphi      ;
         ynumber2pi = f->ynumber2pi;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = "";
@@ -885,7 +912,8 @@ public:
         zphi       = f->zphi      ;
         znumber2pi = f->znumber2pi;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
+    void valuesAt( const std::vector<double *> &, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = "";
@@ -923,7 +951,7 @@ public:
         x0       = f->x0    ;
         n_orders = f->n_orders;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
     std::string getInfo ()
     {
         std::string info = " (x0: " + std::to_string(x0) + ", orders: [";
@@ -974,7 +1002,7 @@ public:
         n_orders = f->n_orders;
         n_coeffs = f->n_coeffs;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
     std::string getInfo ()
     {
         std::string info = " (x0: " + std::to_string(x0) + ", y0: " + std::to_string(y0) + ", orders: [";
@@ -1027,7 +1055,7 @@ public:
         n_orders = f->n_orders;
         n_coeffs = f->n_coeffs;
     };
-    double valueAt( std::vector<double> );
+    double valueAt( const std::vector<double> & );
     std::string getInfo ()
     {
         std::string info = " (x0: " + std::to_string(x0)
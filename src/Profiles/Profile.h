@@ -24,7 +24,7 @@ public:
     ~Profile();
     
     //! Get the value of the profile at some location (spatial)
-    inline double valueAt( std::vector<double> coordinates )
+    inline double valueAt( const std::vector<double> &coordinates )
     {
         return function->valueAt( coordinates );
     };
@@ -34,16 +34,43 @@ public:
         return function->valueAt( time );
     };
     //! Get the value of the profile at some location (spatio-temporal)
-    inline double valueAt( std::vector<double> coordinates, double time )
+    inline double valueAt( const std::vector<double> &coordinates, double time )
     {
         return function->valueAt( coordinates, time );
     };
     //! Get the complex value of the profile at some location (spatio-temporal)
-    inline std::complex<double> complexValueAt( std::vector<double> coordinates, double time )
+    inline std::complex<double> complexValueAt( const std::vector<double> &coordinates, double time )
     {
         return function->complexValueAt( coordinates, time );
     };
     
+    //! Get the value of the profile at n locations given by the arrays of coordinates x[0][0:n], x[1][0:n], ... (spatial)
+    inline void valuesAt( const std::vector<double *> &x, unsigned int n, double *values )
+    {
+#ifdef SMILEI_USE_NUMPY
+        // If numpy profile, then expose coordinates as 1D numpy arrays before evaluating profile
+        if( uses_numpy ) {
+            std::vector<PyArrayObject *> x_numpy( x.size() );
+            npy_intp dims[1] = { ( npy_intp ) n };
+            for( unsigned int ivar=0; ivar<x.size(); ivar++ ) {
+                x_numpy[ivar] = ( PyArrayObject * )PyArray_SimpleNewFromData( 1, dims, NPY_DOUBLE, ( double * )( x[ivar] ) );
+            }
+            PyArrayObject *ret = function->valueAt( x_numpy );
+            for( unsigned int ivar=0; ivar<x.size(); ivar++ ) {
+                Py_DECREF( x_numpy[ivar] );
+            }
+            double *arr = ( double * ) PyArray_GETPTR1( ret, 0 );
+            for( unsigned int i=0; i<n; i++ ) {
+                values[i] = arr[i];
+            }
+            Py_DECREF( ret );
+        } else
+#endif
+        {
+            function->valuesAt( x, n, values );
+        }
+    };
+    
     //! Get the value of the profile at several locations (spatial)
     inline void valuesAt( std::vector<Field *> &coordinates, Field &ret )
     {
@@ -76,13 +103,11 @@ public:
 #endif
             // Otherwise, calculate profile for each point
         {
-            std::vector<double> x( nvar );
-            for( unsigned int i=0; i<size; i++ ) {
-                for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
-                    x[ivar]=( *coordinates[ivar] )( i );
-                }
-                ret( i ) = function->valueAt( x );
+            std::vector<double *> x( nvar );
+            for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+                x[ivar] = coordinates[ivar]->data();
             }
+            function->valuesAt( x, size, ret.data() );
         }
     };
     
@@ -118,12 +143,14 @@ public:
 #endif
             // Otherwise, calculate profile for each point
         {
-            std::vector<double> x( nvar );
+            std::vector<double *> x( nvar );
+            for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+                x[ivar] = coordinates[ivar]->data();
+            }
+            std::vector<double> values( size );
+            function->valuesAt( x, size, &values[0] );
             for( unsigned int i=0; i<size; i++ ) {
-                for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
-                    x[ivar]=( *coordinates[ivar] )( i );
-                }
-                ret( i ) += function->valueAt( x );
+                ret( i ) += values[i];
             }
         }
     };
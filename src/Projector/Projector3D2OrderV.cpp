@@ -15,7 +15,8 @@ using namespace std;
 // ---------------------------------------------------------------------------------------------------------------------
 // Constructor for Projector3D2OrderV
 // ---------------------------------------------------------------------------------------------------------------------
-Projector3D2OrderV::Projector3D2OrderV( Params &params, Patch *patch ) : Projector3D( params, patch )
+template<int vecSize>
+Projector3D2OrderV<vecSize>::Projector3D2OrderV( Params &params, Patch *patch ) : Projector3D( params, patch )
 {
     dx_inv_   = 1.0/params.cell_length[0];
     dx_ov_dt  = params.cell_length[0] / params.timestep;
@@ -51,14 +52,16 @@ Projector3D2OrderV::Projector3D2OrderV( Params &params, Patch *patch ) : Project
 // ---------------------------------------------------------------------------------------------------------------------
 // Destructor for Projector3D2OrderV
 // ---------------------------------------------------------------------------------------------------------------------
-Projector3D2OrderV::~Projector3D2OrderV()
+template<int vecSize>
+Projector3D2OrderV<vecSize>::~Projector3D2OrderV()
 {
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 //!  Project current densities & charge : diagFields timstep (not vectorized)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz, double *rho, Particles &particles, unsigned int istart, unsigned int iend, std::vector<double> *invgf, int *iold, double *deltaold, int ipart_ref )
+template<int vecSize>
+void Projector3D2OrderV<vecSize>::currentsAndDensity( double *Jx, double *Jy, double *Jz, double *rho, Particles &particles, unsigned int istart, unsigned int iend, std::vector<double> *invgf, int *iold, double *deltaold, int ipart_ref )
 {
 
     // -------------------------------------
@@ -73,17 +76,16 @@ void Projector3D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz,
     int jpom2 = jpo-2;
     int kpom2 = kpo-2;
     
-    int vecSize = 8;
     unsigned int bsize = 5*5*5*vecSize;
     
     double bJx[bsize] __attribute__( ( aligned( 64 ) ) );
     
-    double DSx[40] __attribute__( ( aligned( 64 ) ) );
-    double DSy[40] __attribute__( ( aligned( 64 ) ) );
-    double DSz[40] __attribute__( ( aligned( 64 ) ) );
-    double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
+    double DSx[5*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double DSy[5*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double DSz[5*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double charge_weight[vecSize] __attribute__( ( aligned( 64 ) ) );
     
-    // Closest multiple of 8 higher or equal than npart = iend-istart.
+    // Closest multiple of vecSize higher or equal than npart = iend-istart.
     int cell_nparts( ( int )iend-( int )istart );
     int nbVec = ( iend-istart+( cell_nparts-1 )-( ( iend-istart-1 )&( cell_nparts-1 ) ) ) / vecSize;
     if( nbVec*vecSize != cell_nparts ) {
@@ -98,7 +100,7 @@ void Projector3D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz,
     // rho^(p,p,d)
     cell_nparts = ( int )iend-( int )istart;
     #pragma omp simd
-    for( unsigned int j=0; j<1000; j++ ) {
+    for( unsigned int j=0; j<bsize; j++ ) {
         bJx[j] = 0.;
     }
     
@@ -137,8 +139,7 @@ void Projector3D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz,
             for( unsigned int k=0 ; k<5 ; k++ ) {
                 double tmpRho = 0.;
                 int ilocal = ( ( i )*25+j*5+k )*vecSize;
-#pragma unroll(8)
-                for( int ipart=0 ; ipart<8; ipart++ ) {
+                for( int ipart=0 ; ipart<vecSize; ipart++ ) {
                     tmpRho +=  bJx[ilocal+ipart];
                 }
                 rho [iloc + ( j )*( nprimz ) + k] +=  tmpRho;
@@ -153,7 +154,8 @@ void Projector3D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz,
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project charge : frozen & diagFields timstep (not vectorized)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2OrderV::basic( double *rhoj, Particles &particles, unsigned int ipart, unsigned int type )
+template<int vecSize>
+void Projector3D2OrderV<vecSize>::basic( double *rhoj, Particles &particles, unsigned int ipart, unsigned int type )
 {
     //Warning : this function is used for frozen species or initialization only and doesn't use the standard scheme.
     //rho type = 0
@@ -251,7 +253,8 @@ void Projector3D2OrderV::basic( double *rhoj, Particles &particles, unsigned int
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project global current densities : ionization (WARNING: Not Vectorized)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2OrderV::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion )
+template<int vecSize>
+void Projector3D2OrderV<vecSize>::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion )
 {
     Field3D *Jx3D  = static_cast<Field3D *>( Jx );
     Field3D *Jy3D  = static_cast<Field3D *>( Jy );
@@ -362,7 +365,8 @@ void Projector3D2OrderV::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Pa
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project current densities : main projector vectorized
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int istart, unsigned int iend, std::vector<double> *invgf, int *iold, double *deltaold, int ipart_ref )
+template<int vecSize>
+void Projector3D2OrderV<vecSize>::currents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int istart, unsigned int iend, std::vector<double> *invgf, int *iold, double *deltaold, int ipart_ref )
 {
     // -------------------------------------
     // Variable declaration & initialization
@@ -377,20 +381,19 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
     int kpom2 = kpo-2;
     int nyz = nprimy*nprimz;
     
-    int vecSize = 8;
     unsigned int bsize = 5*5*5*vecSize;
     
     double bJx[bsize] __attribute__( ( aligned( 64 ) ) );
     
-    double Sx0_buff_vect[32] __attribute__( ( aligned( 64 ) ) );
-    double Sy0_buff_vect[32] __attribute__( ( aligned( 64 ) ) );
-    double Sz0_buff_vect[32] __attribute__( ( aligned( 64 ) ) );
-    double DSx[40] __attribute__( ( aligned( 64 ) ) );
-    double DSy[40] __attribute__( ( aligned( 64 ) ) );
-    double DSz[40] __attribute__( ( aligned( 64 ) ) );
-    double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
+    double Sx0_buff_vect[4*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double Sy0_buff_vect[4*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double Sz0_buff_vect[4*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double DSx[5*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double DSy[5*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double DSz[5*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double charge_weight[vecSize] __attribute__( ( aligned( 64 ) ) );
     
-    // Closest multiple of 8 higher or equal than npart = iend-istart.
+    // Closest multiple of vecSize higher or equal than npart = iend-istart.
     int cell_nparts( ( int )iend-( int )istart );
     int nbVec = ( iend-istart+( cell_nparts-1 )-( ( iend-istart-1 )&( cell_nparts-1 ) ) ) / vecSize;
     if( nbVec*vecSize != cell_nparts ) {
@@ -399,7 +402,7 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
     
     // Jx^(d,p,p)
     #pragma omp simd
-    for( unsigned int j=0; j<1000; j++ ) {
+    for( unsigned int j=0; j<bsize; j++ ) {
         bJx[j] = 0.;
     }
     
@@ -431,8 +434,7 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
             for( unsigned int k=0 ; k<5 ; k++ ) {
                 double tmpJx = 0.;
                 int ilocal = ( ( i )*25+j*5+k )*vecSize;
-#pragma unroll(8)
-                for( int ipart=0 ; ipart<8; ipart++ ) {
+                for( int ipart=0 ; ipart<vecSize; ipart++ ) {
                     tmpJx += bJx [ilocal+ipart];
                 }
                 Jx[iglobal+j*nprimz+k]         += tmpJx;
@@ -443,7 +445,7 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
     
     // Jy^(p,d,p)
     #pragma omp simd
-    for( unsigned int j=0; j<1000; j++ ) {
+    for( unsigned int j=0; j<bsize; j++ ) {
         bJx[j] = 0.;
     }
     
@@ -473,8 +475,7 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
             for( unsigned int k=0 ; k<5 ; k++ ) {
                 double tmpJy = 0.;
                 int ilocal = ( ( i )*25+j*5+k )*vecSize;
-#pragma unroll(8)
-                for( int ipart=0 ; ipart<8; ipart++ ) {
+                for( int ipart=0 ; ipart<vecSize; ipart++ ) {
                     tmpJy += bJx [ilocal+ipart];
                 }
                 Jy[iglobal+j*nprimz+k] += tmpJy;
@@ -487,7 +488,7 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
     // Jz^(p,p,d)
     cell_nparts = ( int )iend-( int )istart;
     #pragma omp simd
-    for( unsigned int j=0; j<1000; j++ ) {
+    for( unsigned int j=0; j<bsize; j++ ) {
         bJx[j] = 0.;
     }
     
@@ -516,8 +517,7 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
             for( unsigned int k=1 ; k<5 ; k++ ) {
                 double tmpJz = 0.;
                 int ilocal = ( ( i )*25+j*5+k )*vecSize;
-#pragma unroll(8)
-                for( int ipart=0 ; ipart<8; ipart++ ) {
+                for( int ipart=0 ; ipart<vecSize; ipart++ ) {
                     tmpJz +=  bJx[ilocal+ipart];
                 }
                 Jz [iglobal + ( j )*( nprimz+1 ) + k] +=  tmpJz;
@@ -533,7 +533,8 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
 // ---------------------------------------------------------------------------------------------------------------------
 //! Wrapper for projection
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields,
+template<int vecSize>
+void Projector3D2OrderV<vecSize>::currentsAndDensityWrapper( ElectroMagn *EMfields,
         Particles &particles,
         SmileiMPI *smpi,
         int istart, int iend,
@@ -581,7 +582,8 @@ void Projector3D2OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields,
 }
 
 
-void Projector3D2OrderV::susceptibility( ElectroMagn *EMfields, Particles &particles, double species_mass, SmileiMPI *smpi, int istart, int iend,  int ithread, int scell, int ipart_ref )
+template<int vecSize>
+void Projector3D2OrderV<vecSize>::susceptibility( ElectroMagn *EMfields, Particles &particles, double species_mass, SmileiMPI *smpi, int istart, int iend,  int ithread, int scell, int ipart_ref )
 {
 
     double *Chi_envelope = &( *EMfields->Env_Chi_ )( 0 ) ;
@@ -607,16 +609,15 @@ void Projector3D2OrderV::susceptibility( ElectroMagn *EMfields, Particles &parti
     double *GradPhiy = &( ( *GradPhipart )[1*nparts] );
     double *GradPhiz = &( ( *GradPhipart )[2*nparts] );
     
-    int vecSize = 8;
     unsigned int bsize = 3*3*3*vecSize; // primal grid, particles did not yet move (3x3x3 enough)
     double bChi[bsize] __attribute__( ( aligned( 64 ) ) );
     
-    double Sx1[24] __attribute__( ( aligned( 64 ) ) );
-    double Sy1[24] __attribute__( ( aligned( 64 ) ) );
-    double Sz1[24] __attribute__( ( aligned( 64 ) ) );
-    double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
+    double Sx1[3*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double Sy1[3*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double Sz1[3*vecSize] __attribute__( ( aligned( 64 ) ) );
+    double charge_weight[vecSize] __attribute__( ( aligned( 64 ) ) );
     
-    // Closest multiple of 8 higher or equal than npart = iend-istart.
+    // Closest multiple of vecSize higher or equal than npart = iend-istart.
     int cell_nparts( ( int )iend-( int )istart );
     int nbVec = ( iend-istart+( cell_nparts-1 )-( ( iend-istart-1 )&( cell_nparts-1 ) ) ) / vecSize;
     if( nbVec*vecSize != cell_nparts ) {
@@ -745,8 +746,7 @@ void Projector3D2OrderV::susceptibility( ElectroMagn *EMfields, Particles &parti
             for( unsigned int k=0 ; k<3 ; k++ ) {
                 double tmpChi = 0.;
                 int ilocal = ( i*9+j*3+k )*vecSize;
-#pragma unroll(8)
-                for( int ipart=0 ; ipart<8; ipart++ ) {
+                for( int ipart=0 ; ipart<vecSize; ipart++ ) {
                     tmpChi +=  bChi[ilocal+ipart];
                 }
                 Chi_envelope [iglobal + j*nprimz + k] +=  tmpChi;
@@ -758,3 +758,8 @@ void Projector3D2OrderV::susceptibility( ElectroMagn *EMfields, Particles &parti
     
     
 }
+
+// Instantiations for the supported vector widths
+template class Projector3D2OrderV<4>;
+template class Projector3D2OrderV<8>;
+template class Projector3D2OrderV<16>;
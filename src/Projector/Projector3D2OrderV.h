@@ -4,6 +4,10 @@
 #include "Projector3D.h"
 
 
+//  --------------------------------------------------------------------------------------------------------------------
+//! Vectorized 2nd order projector in 3D, processing particles by blocks of vecSize (4, 8 or 16, see Params::vectorization_width)
+//  --------------------------------------------------------------------------------------------------------------------
+template<int vecSize>
 class Projector3D2OrderV : public Projector3D
 {
 public:
@@ -36,8 +40,6 @@ private:
         int jpo = iold[1];
         int kpo = iold[2];
         
-        int vecSize = 8;
-        
         double delta = delta0[istart-ipart_ref+ipart];
         double delta2 = delta*delta;
         
@@ -127,8 +129,6 @@ private:
         int jpo = iold[1];
         int kpo = iold[2];
         
-        int vecSize = 8;
-        
         // locate the particle on the primal grid at current time-step & calculate coeff. S1
         //                            X                                 //
         double pos = particles.position( 0, istart+ipart ) * dx_inv_;
@@ -189,8 +189,6 @@ private:
         //optrpt complains about the following loop but not unrolling it actually seems to give better result.
         double crx_p = charge_weight[ipart]*dxovdt;
         
-        int vecSize = 8;
-        
         double sum[5];
         sum[0] = 0.;
         for( unsigned int k=1 ; k<5 ; k++ ) {
@@ -61,7 +61,13 @@ public:
             }
 #ifdef _VECTO
             else {
-                Proj = new Projector3D2OrderV( params, patch );
+                if( params.vectorization_width == 4 ) {
+                    Proj = new Projector3D2OrderV<4>( params, patch );
+                } else if( params.vectorization_width == 16 ) {
+                    Proj = new Projector3D2OrderV<16>( params, patch );
+                } else {
+                    Proj = new Projector3D2OrderV<8>( params, patch );
+                }
             }
 #endif
         } else if( ( params.geometry == "3Dcartesian" ) && ( params.interpolation_order == ( unsigned int )4 ) ) {
@@ -9,12 +9,14 @@
 
 using namespace std;
 
-PusherBorisV::PusherBorisV( Params &params, Species *species )
+template<int vecSize>
+PusherBorisV<vecSize>::PusherBorisV( Params &params, Species *species )
     : Pusher( params, species )
 {
 }
 
-PusherBorisV::~PusherBorisV()
+template<int vecSize>
+PusherBorisV<vecSize>::~PusherBorisV()
 {
 }
 
@@ -22,7 +24,8 @@ PusherBorisV::~PusherBorisV()
     Lorentz Force -- leap-frog (Boris) scheme
 ***********************************************************************/
 
-void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_ref )
+template<int vecSize>
+void PusherBorisV<vecSize>::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_ref )
 {
     std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
     std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
@@ -56,12 +59,13 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
     //particles.cell_keys.resize(nparts);
     //cell_keys = &( particles.cell_keys[0]);
     
-    vector<double> dcharge(nparts);
+    ScratchArena::Scope scope( smpi->dynamics_scratch[ithread] );
+    double *dcharge = smpi->dynamics_scratch[ithread].allocate<double>( nparts );
     for( int ipart=istart ; ipart<iend; ipart++ ) {
         dcharge[ipart-ipart_ref] = ( double )( charge[ipart] );
     }
     
-    #pragma omp simd
+    #pragma omp simd simdlen(vecSize)
     for( int ipart=istart ; ipart<iend; ipart++ ) {
         double psm[3], um[3];
         
@@ -116,3 +120,8 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
     //}
     
 }
+
+// Instantiations for the supported vector widths
+template class PusherBorisV<4>;
+template class PusherBorisV<8>;
+template class PusherBorisV<16>;
@@ -12,7 +12,9 @@
 
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class PusherBorisV
+//! The particle loop is vectorized with vecSize lanes (4, 8 or 16, see Params::vectorization_width)
 //  --------------------------------------------------------------------------------------------------------------------
+template<int vecSize>
 class PusherBorisV : public Pusher
 {
 public:
@@ -56,7 +56,13 @@ public:
                 }
 #ifdef _VECTO
                 else {
-                    Push = new PusherBorisV( params, species );
+                    if( params.vectorization_width == 4 ) {
+                        Push = new PusherBorisV<4>( params, species );
+                    } else if( params.vectorization_width == 16 ) {
+                        Push = new PusherBorisV<16>( params, species );
+                    } else {
+                        Push = new PusherBorisV<8>( params, species );
+                    }
                 }
 #endif
             } else if( species->pusher_name_ == "ponderomotive_boris" ) {
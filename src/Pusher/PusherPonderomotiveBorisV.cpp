@@ -54,7 +54,8 @@ void PusherPonderomotiveBorisV::operator()( Particles &particles, SmileiMPI *smp
     double *GradPhiz = &( ( *GradPhipart )[2*nparts] );
     double *inv_gamma_ponderomotive = &( ( *dynamics_inv_gamma_ponderomotive )[0*nparts] );
     
-    vector<double> dcharge(nparts);
+    ScratchArena::Scope scope( smpi->dynamics_scratch[ithread] );
+    double *dcharge = smpi->dynamics_scratch[ithread].allocate<double>( nparts );
     for( int ipart=istart ; ipart<iend; ipart++ ) {
         dcharge[ipart-ipart_ref] = ( double )( charge[ipart] );
     }
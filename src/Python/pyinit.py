@@ -196,9 +196,15 @@ class Main(SmileiSingleton):
     solve_relativistic_poisson = False
     relativistic_poisson_max_iteration = 50000
     relativistic_poisson_max_error = 1.e-22
+    poisson_solver = "cg"
 
     # Default fields
     maxwell_solver = 'Yee'
+    maxwell_kernel = 'standard'
+    overlap_field_exchange = False
+    aggregate_mpi_messages = False
+    overlap_diag_reductions = False
+    numa_first_touch = False
     EM_boundary_conditions = [["periodic"]]
     EM_boundary_conditions_k = []
     save_magnectic_fields_for_SM = True
@@ -287,6 +293,7 @@ class LoadBalancing(SmileiSingleton):
     initial_balance      = True
     cell_load            = 1.0
     frozen_particle_load = 0.1
+    cost_model           = "particles"
 
 # Radiation reaction configuration (continuous and MC algorithms)
 class Vectorization(SmileiSingleton):
@@ -296,6 +303,9 @@ class Vectorization(SmileiSingleton):
     mode                = "off"
     reconfigure_every   = 20
     initial_mode        = "off"
+    vector_width        = None
+    counting_sort_threshold = 0.3
+    particle_block_size = 0
 
 
 class MovingWindow(SmileiSingleton):
@@ -318,6 +328,7 @@ class Checkpoints(SmileiSingleton):
     dump_deflate = 0
     exit_after_dump = True
     file_grouping = 0
+    dump_asynchronous = False
     restart_files = []
 
 class CurrentFilter(SmileiSingleton):
@@ -434,6 +445,7 @@ class Collisions(SmileiComponent):
     coulomb_log = 0.
     coulomb_log_factor = 1.
     debug_every = 0
+    batch_size = 0
     ionizing = False
     nuclear_reaction = None
     nuclear_reaction_multiplier = 0.
@@ -460,6 +472,7 @@ class DiagParticleBinning(SmileiComponent):
     axes = []
     every = None
     flush_every = 1
+    concatenate_patches = False
 
 class DiagRadiationSpectrum(SmileiComponent):
     """Radiation Spectrum diagnostic"""
@@ -470,6 +483,7 @@ class DiagRadiationSpectrum(SmileiComponent):
     axes = []
     every = None
     flush_every = 1
+    concatenate_patches = False
 
 class DiagScreen(SmileiComponent):
     """Screen diagnostic"""
@@ -484,6 +498,7 @@ class DiagScreen(SmileiComponent):
     time_average = 1
     every = None
     flush_every = 1
+    concatenate_patches = False
 
 class DiagScalar(SmileiComponent):
     """Scalar diagnostic"""
@@ -499,6 +514,9 @@ class DiagFields(SmileiComponent):
     time_average = 1
     subgrid = None
     flush_every = 1
+    deflate = 0
+    absolute_error = 0.
+    aggregators = 0
 
 class DiagTrackParticles(SmileiComponent):
     """Track diagnostic"""
@@ -507,6 +525,7 @@ class DiagTrackParticles(SmileiComponent):
     every = 0
     flush_every = 1
     filter = None
+    concatenate_patches = False
     attributes = ["x", "y", "z", "px", "py", "pz", "w"]
 
 class DiagPerformances(SmileiSingleton):
@@ -514,6 +533,8 @@ class DiagPerformances(SmileiSingleton):
     every = 0
     flush_every = 1
     patch_information = True
+    hardware_counters = False
+    vector_instructions_event = None
 
 # external fields
 class ExternalField(SmileiComponent):
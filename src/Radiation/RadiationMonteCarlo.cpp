@@ -257,6 +257,11 @@ void RadiationMonteCarlo::operator()(
 
     }
     
+    // ____________________________________________________
+    // Creation of the emitted macro-photons
+    
+    createPhotons( particles );
+    
     // ____________________________________________________
     // Update of the quantum parameter chi
     
@@ -368,40 +373,19 @@ double RadiationMonteCarlo::photonEmission( int ipart,
         // Second method: emission of several photons for statistics following
         // the parameter radiation_photon_sampling_
 
-        // Creation of new photons in the temporary array new_photons_
-        new_photons_.createParticles( radiation_photon_sampling_ );
-
-        // Final size
-        int npart = new_photons_.size();
+        // The photon is recorded here and the radiation_photon_sampling_ macro-photons
+        // are created in new_photons_ at the end of the call (see createPhotons)
+        emitting_particles_.push_back( ipart );
 
         // Inverse of the momentum norm
         inv_old_norm_p = 1./sqrt( momentum[0][ipart]*momentum[0][ipart]
                                   + momentum[1][ipart]*momentum[1][ipart]
                                   + momentum[2][ipart]*momentum[2][ipart] );
 
-        // For all new photons...
-        for( int idNew=npart-radiation_photon_sampling_; idNew<npart; idNew++ ) {
-            for( int i=0; i<n_dimensions_; i++ ) {
-                new_photons_.position( i, idNew )=position[i][ipart];
-            }
-
-            for( int i=0; i<3; i++ ) {
-                new_photons_.momentum( i, idNew ) =
-                    gammaph*momentum[i][ipart]*inv_old_norm_p;
-            }
-
-            new_photons_.weight( idNew )=weight[ipart]*inv_radiation_photon_sampling_;
-            new_photons_.charge( idNew )=0;
-
-            if( new_photons_.isQuantumParameter ) {
-                new_photons_.chi( idNew ) = photon_chi;
-            }
-
-            if( new_photons_.isMonteCarlo ) {
-                new_photons_.tau( idNew ) = -1.;
-            }
-
+        for( int i=0; i<3; i++ ) {
+            photon_momentum_[i].push_back( gammaph*momentum[i][ipart]*inv_old_norm_p );
         }
+        photon_chi_.push_back( photon_chi );
 
     }
     // Addition of the emitted energy in the cumulating parameter
@@ -415,3 +399,59 @@ double RadiationMonteCarlo::photonEmission( int ipart,
     
     return radiated_energy;
 }
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Create at once in new_photons_ the radiation_photon_sampling_ macro-photons of each
+//! emission recorded by photonEmission since the last call
+//! \param particles          particle object containing the emitting particles
+// ---------------------------------------------------------------------------------------------------------------------
+void RadiationMonteCarlo::createPhotons( Particles &particles )
+{
+    const unsigned int nevents = emitting_particles_.size();
+    if( nevents == 0 ) {
+        return;
+    }
+    const unsigned int sampling = radiation_photon_sampling_;
+    const unsigned int first = new_photons_.createParticlesFromParents( particles, emitting_particles_, sampling );
+
+    const int *__restrict__ index = emitting_particles_.data();
+    const double *__restrict__ weight = &( particles.weight( 0 ) );
+    for( unsigned int j=0; j<sampling; j++ ) {
+        for( int i=0; i<3; i++ ) {
+            double *__restrict__ momentum = &( new_photons_.momentum( i, first ) );
+            const double *__restrict__ photon_momentum = photon_momentum_[i].data();
+            #pragma omp simd
+            for( unsigned int ievent=0; ievent<nevents; ievent++ ) {
+                momentum[ievent*sampling+j] = photon_momentum[ievent];
+            }
+        }
+        double *__restrict__ photon_weight = &( new_photons_.weight( first ) );
+        short *__restrict__ charge = &( new_photons_.charge( first ) );
+        #pragma omp simd
+        for( unsigned int ievent=0; ievent<nevents; ievent++ ) {
+            photon_weight[ievent*sampling+j] = weight[index[ievent]]*inv_radiation_photon_sampling_;
+            charge[ievent*sampling+j] = 0;
+        }
+        if( new_photons_.isQuantumParameter ) {
+            double *__restrict__ chi = &( new_photons_.chi( first ) );
+            const double *__restrict__ photon_chi = photon_chi_.data();
+            #pragma omp simd
+            for( unsigned int ievent=0; ievent<nevents; ievent++ ) {
+                chi[ievent*sampling+j] = photon_chi[ievent];
+            }
+        }
+        if( new_photons_.isMonteCarlo ) {
+            double *__restrict__ tau = &( new_photons_.tau( first ) );
+            #pragma omp simd
+            for( unsigned int ievent=0; ievent<nevents; ievent++ ) {
+                tau[ievent*sampling+j] = -1.;
+            }
+        }
+    }
+
+    emitting_particles_.clear();
+    for( int i=0; i<3; i++ ) {
+        photon_momentum_[i].clear();
+    }
+    photon_chi_.clear();
+}
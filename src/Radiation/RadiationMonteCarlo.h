@@ -76,6 +76,12 @@ public:
                          double *weight,
                          Species *photon_species,
                          RadiationTables &RadiationTables );
+
+    // ---------------------------------------------------------------------
+    //! Create the macro-photons of the emissions recorded by photonEmission
+    //! \param particles          particle object containing the emitting particles
+    // ---------------------------------------------------------------------
+    void createPhotons( Particles &particles );
                          
 protected:
 
@@ -98,6 +104,16 @@ protected:
     
     //! Espilon to check when tau is near 0
     const double epsilon_tau_ = 1e-100;
+
+    // ________________________________________
+    // Emissions of the current call, whose macro-photons are created at its end
+
+    //! Index of the emitting particle
+    std::vector<int> emitting_particles_;
+    //! Momentum of the emitted photon
+    std::vector<double> photon_momentum_[3];
+    //! Quantum parameter of the emitted photon
+    std::vector<double> photon_chi_;
     
 private:
 
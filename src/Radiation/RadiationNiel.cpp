@@ -161,21 +161,9 @@ void RadiationNiel::operator()(
     }*/
 
     // Vectorized computation of the random number in a uniform distribution
-    // #pragma omp simd
-    for( ipart=0 ; ipart < nbparticles; ipart++ ) {
-
-        // Below particle_chi = minimum_chi_continuous_, radiation losses are negligible
-        if( particle_chi[ipart] > minimum_chi_continuous_ ) {
-
-            // Pick a random number in the normal distribution of standard
-            // deviation sqrt(dt_) (variance dt_)
-            //random_numbers[ipart] = 2.*Rand::uniform() -1.;
-            //random_numbers[ipart] = 2.*drand48() -1.;
-            random_numbers[ipart] = 2.*rand_->uniform() -1.;
-        }
-        // else {
-        //     random_numbers[ipart] = 0;
-        // }
+    // (drawn for all particles at once, only used when particle_chi > minimum_chi_continuous_)
+    if( nbparticles > 0 ) {
+        rand_->uniform2( random_numbers, nbparticles );
     }
 
     // Vectorized computation of the random number in a normal distribution
@@ -365,13 +365,19 @@ int main( int argc, char *argv[] )
                 time_dual += params.timestep;
             }
 
+            // Release the scratch memory of the previous step
+            smpi.resetScratch();
+
+            // Move the memory of the new or moved patches to the NUMA node of their thread
+            vecPatches.firstTouch( params, timers );
+
             // Patch reconfiguration
             if( params.has_adaptive_vectorization && params.adaptive_vecto_time_selection->theTimeIsNow( itime ) ) {
                 vecPatches.reconfiguration( params, timers, itime );
             }
 
             // apply collisions if requested
-            vecPatches.applyCollisions( params, itime, timers );
+            vecPatches.applyCollisions( params, &smpi, itime, timers );
 
             // Solve "Relativistic Poisson" problem (including proper centering of fields)
             // for species who stop to be frozen
@@ -609,7 +615,9 @@ int main( int argc, char *argv[] )
         itime++;
             
     }//END of the time loop
-        
+    
+    // Make sure that the latest checkpoint is written before exiting
+    checkpoint.waitDumpWriter();
     
     smpi.barrier();
 
@@ -622,6 +630,14 @@ int main( int argc, char *argv[] )
     TITLE( "Time profiling : (print time > 0.001%)" );
     timers.profile( &smpi );
 
+    TITLE( "Scratch memory of the operators" );
+    smpi.printScratchStatistics();
+
+    if( simWindow->isActive() ) {
+        TITLE( "Moving window" );
+        simWindow->printStatistics( &smpi, timers.movWindow );
+    }
+
     smpi.barrier();
 
     /*tommaso
@@ -0,0 +1,131 @@
+#include "NeighborMessages.h"
+
+#include <algorithm>
+
+using namespace std;
+
+NeighborMessages::NeighborMessages( MPI_Comm comm, int tag ) :
+    comm_( comm ),
+    tag_( tag ),
+    persistent_( false )
+{
+}
+
+NeighborMessages::~NeighborMessages()
+{
+    freeRequests();
+}
+
+void NeighborMessages::clearFaces()
+{
+    send_faces_.clear();
+    recv_faces_.clear();
+}
+
+void NeighborMessages::addSendFace( unsigned int iface, int side, int rank, uint64_t key, size_t bytes )
+{
+    Face face = { iface, side, rank, side, key, bytes };
+    send_faces_.push_back( face );
+}
+
+void NeighborMessages::addRecvFace( unsigned int iface, int side, int rank, uint64_t key, size_t bytes )
+{
+    // The sender sent this face towards the opposite side
+    Face face = { iface, side, rank, ( side+1 )%2, key, bytes };
+    recv_faces_.push_back( face );
+}
+
+void NeighborMessages::setLayout( bool persistent )
+{
+    if( persistent == persistent_ && send_faces_ == send_layout_ && recv_faces_ == recv_layout_ ) {
+        return;
+    }
+
+    freeRequests();
+    send_layout_ = send_faces_;
+    recv_layout_ = recv_faces_;
+    layOut( send_layout_, send_messages_, send_offset_, send_buffer_ );
+    layOut( recv_layout_, recv_messages_, recv_offset_, recv_buffer_ );
+
+    persistent_ = persistent;
+    if( persistent_ ) {
+        for( unsigned int imsg=0 ; imsg<send_messages_.size() ; imsg++ ) {
+            Message &msg = send_messages_[imsg];
+            requests_.push_back( MPI_REQUEST_NULL );
+            MPI_Send_init( &send_buffer_[msg.offset], msg.bytes, MPI_BYTE, msg.rank, tag_+msg.side, comm_, &requests_.back() );
+        }
+        for( unsigned int imsg=0 ; imsg<recv_messages_.size() ; imsg++ ) {
+            Message &msg = recv_messages_[imsg];
+            requests_.push_back( MPI_REQUEST_NULL );
+            MPI_Recv_init( &recv_buffer_[msg.offset], msg.bytes, MPI_BYTE, msg.rank, tag_+msg.side, comm_, &requests_.back() );
+        }
+    }
+}
+
+void NeighborMessages::start()
+{
+    if( persistent_ ) {
+        if( requests_.size() > 0 ) {
+            MPI_Startall( requests_.size(), &requests_[0] );
+        }
+        return;
+    }
+
+    // Messages of variable size: both sides know the size of each message, and skip the empty ones
+    requests_.clear();
+    for( unsigned int imsg=0 ; imsg<send_messages_.size() ; imsg++ ) {
+        Message &msg = send_messages_[imsg];
+        if( msg.bytes > 0 ) {
+            requests_.push_back( MPI_REQUEST_NULL );
+            MPI_Isend( &send_buffer_[msg.offset], msg.bytes, MPI_BYTE, msg.rank, tag_+msg.side, comm_, &requests_.back() );
+        }
+    }
+    for( unsigned int imsg=0 ; imsg<recv_messages_.size() ; imsg++ ) {
+        Message &msg = recv_messages_[imsg];
+        if( msg.bytes > 0 ) {
+            requests_.push_back( MPI_REQUEST_NULL );
+            MPI_Irecv( &recv_buffer_[msg.offset], msg.bytes, MPI_BYTE, msg.rank, tag_+msg.side, comm_, &requests_.back() );
+        }
+    }
+}
+
+void NeighborMessages::wait()
+{
+    if( requests_.size() > 0 ) {
+        MPI_Waitall( requests_.size(), &requests_[0], MPI_STATUSES_IGNORE );
+    }
+}
+
+void NeighborMessages::layOut( vector<Face> faces, vector<Message> &messages, vector<size_t> &offsets, vector<char> &buffer )
+{
+    sort( faces.begin(), faces.end() );
+
+    unsigned int nfaces = 0;
+    for( unsigned int i=0 ; i<faces.size() ; i++ ) {
+        nfaces = max( nfaces, faces[i].iface+1 );
+    }
+    offsets.assign( 2*nfaces, 0 );
+    messages.clear();
+
+    size_t size = 0;
+    for( unsigned int i=0 ; i<faces.size() ; i++ ) {
+        if( i==0 || faces[i].rank != faces[i-1].rank || faces[i].message_side != faces[i-1].message_side ) {
+            Message msg = { faces[i].rank, faces[i].message_side, size, 0 };
+            messages.push_back( msg );
+        }
+        offsets[2*faces[i].iface+faces[i].side] = size;
+        messages.back().bytes += faces[i].bytes;
+        size += faces[i].bytes;
+    }
+    buffer.resize( size );
+}
+
+void NeighborMessages::freeRequests()
+{
+    if( persistent_ ) {
+        for( unsigned int i=0 ; i<requests_.size() ; i++ ) {
+            MPI_Request_free( &requests_[i] );
+        }
+    }
+    requests_.clear();
+}
@@ -0,0 +1,108 @@
+#ifndef NEIGHBORMESSAGES_H
+#define NEIGHBORMESSAGES_H
+
+#include <mpi.h>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class NeighborMessages
+//! Messages between the patches of the MPI process and the patches of the neighbour processes, aggregated per
+//! neighbour process: along one direction, the faces sent by all the patches to the same process, towards the same
+//! side, are packed in a single message instead of one message per patch.
+//! The faces are described before each exchange. As long as they do not change, the layout of the buffers is kept,
+//! and so are the persistent requests of the messages of constant size (fields, densities, numbers of particles).
+//  --------------------------------------------------------------------------------------------------------------------
+class NeighborMessages
+{
+public:
+    //! The messages of the sides 0 and 1 have the tags tag and tag+1 in the communicator comm
+    NeighborMessages( MPI_Comm comm, int tag );
+    ~NeighborMessages();
+
+    //! Start the description of the faces of the next exchange
+    void clearFaces();
+    //! Face iface of a local patch, sent to the process rank, towards the side (0: min, 1: max) of the patch.
+    //! The faces are ordered by key in the message: the receiver must give the same key to the same face.
+    void addSendFace( unsigned int iface, int side, int rank, uint64_t key, std::size_t bytes );
+    //! Face iface of a local patch, received from the process rank, on the side (0: min, 1: max) of the patch
+    void addRecvFace( unsigned int iface, int side, int rank, uint64_t key, std::size_t bytes );
+    //! Lay out the buffers for the faces described since clearFaces(), if they changed since the previous exchange.
+    //! If persistent, the requests are created with the layout and reused by all the exchanges.
+    void setLayout( bool persistent );
+
+    //! Location of a face in the send buffer
+    inline char *sendFace( unsigned int iface, int side )
+    {
+        return send_buffer_.data() + send_offset_[2*iface+side];
+    }
+    //! Location of a face in the receive buffer
+    inline char *recvFace( unsigned int iface, int side )
+    {
+        return recv_buffer_.data() + recv_offset_[2*iface+side];
+    }
+
+    //! Start sending and receiving all the messages
+    void start();
+    //! Wait for the end of all the messages
+    void wait();
+
+private:
+    struct Face {
+        unsigned int iface;
+        //! Side of the local patch
+        int side;
+        int rank;
+        //! Side towards which the face is sent by the sender patch
+        int message_side;
+        uint64_t key;
+        std::size_t bytes;
+
+        bool operator==( const Face &f ) const
+        {
+            return iface==f.iface && side==f.side && rank==f.rank && key==f.key && bytes==f.bytes;
+        }
+        //! Order of the messages, then of the faces in a message
+        bool operator<( const Face &f ) const
+        {
+            if( rank != f.rank ) {
+                return rank < f.rank;
+            }
+            if( message_side != f.message_side ) {
+                return message_side < f.message_side;
+            }
+            return key < f.key;
+        }
+    };
+    struct Message {
+        int rank;
+        int side;
+        std::size_t offset;
+        std::size_t bytes;
+    };
+
+    //! Group the faces in messages and place them in a buffer
+    static void layOut( std::vector<Face> faces, std::vector<Message> &messages, std::vector<std::size_t> &offsets, std::vector<char> &buffer );
+
+    void freeRequests();
+
+    MPI_Comm comm_;
+    int tag_;
+
+    //! Faces described for the next exchange
+    std::vector<Face> send_faces_, recv_faces_;
+    //! Faces of the current layout, as described
+    std::vector<Face> send_layout_, recv_layout_;
+
+    std::vector<Message> send_messages_, recv_messages_;
+    //! Offset of each face (2*iface+side) in the buffers
+    std::vector<std::size_t> send_offset_, recv_offset_;
+    std::vector<char> send_buffer_, recv_buffer_;
+
+    //! Requests of the messages (sent then received)
+    std::vector<MPI_Request> requests_;
+    bool persistent_;
+};
+
+#endif
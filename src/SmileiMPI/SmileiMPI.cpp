@@ -139,6 +139,7 @@ void SmileiMPI::init( Params &params, DomainDecomposition *domain_decomposition
     int n_envlaser = PyTools::nComponents( "LaserEnvelope" );
 
 #ifdef _OPENMP
+    dynamics_scratch.resize( omp_get_max_threads() );
     dynamics_Epart.resize( omp_get_max_threads() );
     dynamics_Bpart.resize( omp_get_max_threads() );
     dynamics_invgf.resize( omp_get_max_threads() );
@@ -163,6 +164,7 @@ void SmileiMPI::init( Params &params, DomainDecomposition *domain_decomposition
         }
     }
 #else
+    dynamics_scratch.resize( 1 );
     dynamics_Epart.resize( 1 );
     dynamics_Bpart.resize( 1 );
     dynamics_invgf.resize( 1 );
@@ -418,11 +420,11 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
 
     unsigned int ncells_perpatch, j;
     int Ncur;
-    double Tload, Tload_loc, Tcur, cells_load, target, Tscan, largest_patch_loc, largest_patch;
+    double Tload, Tload_loc, Tload_new, Tcur, cells_load, target, Tscan, largest_patch_loc, largest_patch;
     bool recompute_tload = true;
     //Load of a cell = cell_load*load of a particle.
     //Load of a frozen particle = frozen_particle_load*load of a particle.
-    std::vector<double> Lp, Lp_left, Lp_right;
+    std::vector<double> Lp, Lp_left, Lp_right, Lp_particles, Lp_measured;
     ofstream fout;
 
     if( isMaster() ) {
@@ -450,19 +452,47 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
 
 
 
-    while( recompute_tload ) {
+    //Compute particle contribution to Local Loads of each Patch
+    Lp_particles.resize( patch_count[smilei_rk], 0. );
+    for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+        for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
+            Lp_particles[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen_ ) ) ;
+        }
+    }
 
-        Tload_loc = 0.;
-        Ncur = 0; // Variation of the number of patches assigned to current rank r.
+    //With measured loads, the particle contribution is replaced by the computing time per iteration
+    //averaged since the last balancing, converted in particle units so that cell_load keeps its meaning.
+    //Patches without measurement (just created) keep the particle estimate.
+    if( params.measure_patch_load ) {
+        Lp_measured.resize( patch_count[smilei_rk], -1. );
+        double sums_loc[2] = { 0., 0. }, sums[2];
         for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
-            Lp[ipatch] =  cells_load ;
+            Patch *patch = vecpatches( ipatch );
+            if( patch->measured_iterations_ > 0 ) {
+                Lp_measured[ipatch] = ( patch->measured_load_[0] + patch->measured_load_[1] + patch->measured_load_[2] ) / patch->measured_iterations_;
+                sums_loc[0] += Lp_measured[ipatch];
+                sums_loc[1] += Lp_particles[ipatch];
+            }
+            patch->measured_load_.assign( patch->measured_load_.size(), 0. );
+            patch->measured_iterations_ = 0;
+        }
+        MPI_Allreduce( sums_loc, sums, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        if( sums[0] > 0. && sums[1] > 0. ) {
+            double particles_per_second = sums[1] / sums[0];
+            for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+                if( Lp_measured[ipatch] >= 0. ) {
+                    Lp_particles[ipatch] = Lp_measured[ipatch] * particles_per_second;
+                }
+            }
         }
+    }
 
-        //Compute particle contribution to Local Loads of each Patch (Lp)
+    while( recompute_tload ) {
+
+        Tload_loc = 0.;
+        Ncur = 0; // Variation of the number of patches assigned to current rank r.
         for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
-            for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
-                Lp[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen_ ) ) ;
-            }
+            Lp[ipatch] = cells_load + Lp_particles[ipatch];
             Tload_loc += Lp[ipatch];
         }
 
@@ -508,6 +538,9 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         MPI_Wait( &request0, &status );
     }
 
+    //Load of this rank after balancing
+    Tload_new = Tload_loc;
+
     if( smilei_rk > 0 ) {
         //Tcur is now initialized as the total load currently carried by previous ranks.
         Tcur = Tscan - Tload_loc;
@@ -517,6 +550,7 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
             j = Lp_left.size()-1;
             while( abs( Tcur-target ) > abs( Tcur-Lp_left[j] - target ) && j>0 ) { //Leave at least 1 patch to my neighbour.
                 Tcur -= Lp_left[j];
+                Tload_new += Lp_left[j];
                 j--;
                 Ncur++;
             }
@@ -525,6 +559,7 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
             j = 0;
             while( ( abs( Tcur-target ) > abs( Tcur+Lp[j]-target ) ) && ( j < ( unsigned int )patch_count[smilei_rk]-1 ) ) { //Keep at least 1 patch from my original set of patches
                 Tcur += Lp[j];
+                Tload_new -= Lp[j];
                 j++;
                 Ncur --;
             }
@@ -541,6 +576,7 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
             j = 0;
             while( ( abs( Tcur-target ) > abs( Tcur+Lp_right[j] - target ) ) && ( j<( unsigned int )patch_count[smilei_rk+1] - 1 ) ) { //Leave at least 1 patch to my neighbour
                 Tcur += Lp_right[j];
+                Tload_new += Lp_right[j];
                 j++;
                 Ncur++;
             }
@@ -550,6 +586,7 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
             j = patch_count[smilei_rk]-1;
             while( abs( Tcur-target ) > abs( Tcur-Lp[j]-target ) && j > 0 ) { //Keep at least 1 patch from my original set of patches
                 Tcur -= Lp[j];
+                Tload_new -= Lp[j];
                 j--;
                 Ncur --;
             }
@@ -568,9 +605,15 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         patch_refHindexes[rk] = patch_refHindexes[rk-1] + patch_count[rk-1];
     }
 
+    //Imbalance (max load / mean load) before and after balancing
+    double loads_loc[2] = { Tload_loc, Tload_new }, loads_max[2];
+    MPI_Reduce( loads_loc, loads_max, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+
     //Write patch_load.txt
     if( smilei_rk==0 ) {
+        double Tmean = Tload * Tcapabilities / smilei_sz;
         fout << "\tt = " << time_dual << endl;
+        fout << " imbalance before = " << loads_max[0]/Tmean << ", after = " << loads_max[1]/Tmean << endl;
         for( int irk=0; irk<smilei_sz; irk++ ) {
             fout << " patch_count[" << irk << "] = " << patch_count[irk] << endl;
         }
@@ -602,58 +645,6 @@ int SmileiMPI::hrank( int h )
 } // END hrank
 
 
-// ----------------------------------------------------------------------
-// Create MPI type to exchange all particles properties of particles
-// ----------------------------------------------------------------------
-MPI_Datatype SmileiMPI::createMPIparticles( Particles *particles )
-{
-    int nbrOfProp = particles->double_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
-
-    MPI_Aint address[nbrOfProp];
-    for( unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->double_prop[iprop] ) )[0] ), &( address[iprop] ) );
-    }
-    for( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->short_prop[iprop] ) )[0] ), &( address[particles->double_prop.size()+iprop] ) );
-    }
-    for( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->uint64_prop[iprop] ) )[0] ), &( address[particles->double_prop.size()+particles->short_prop.size()+iprop] ) );
-    }
-
-    int nbr_parts[nbrOfProp];
-    // number of elements per property
-    for( int i=0 ; i<nbrOfProp ; i++ ) {
-        nbr_parts[i] = particles->size();
-    }
-
-    MPI_Aint disp[nbrOfProp];
-    // displacement between 2 properties
-    disp[0] = 0;
-    for( int i=1 ; i<nbrOfProp ; i++ ) {
-        disp[i] = address[i] - address[0];
-    }
-
-    MPI_Datatype partDataType[nbrOfProp];
-    // define MPI type of each property, default is DOUBLE
-    for( unsigned int i=0 ; i<particles->double_prop.size() ; i++ ) {
-        partDataType[i] = MPI_DOUBLE;
-    }
-    for( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ ) {
-        partDataType[ particles->double_prop.size()+iprop] = MPI_SHORT;
-    }
-    for( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ ) {
-        partDataType[ particles->double_prop.size()+particles->short_prop.size()+iprop] = MPI_UNSIGNED_LONG_LONG;
-    }
-
-    MPI_Datatype typeParticlesMPI;
-    MPI_Type_create_struct( nbrOfProp, &( nbr_parts[0] ), &( disp[0] ), &( partDataType[0] ), &typeParticlesMPI );
-    MPI_Type_commit( &typeParticlesMPI );
-
-    return typeParticlesMPI;
-
-} // END createMPIparticles
-
-
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // -----------------------------------------       PATCH SEND / RECV METHODS        ------------------------------------
@@ -705,8 +696,7 @@ void SmileiMPI::isend_species( Patch *patch, int to, int &maxtag, int tag, Param
     for( unsigned int ispec=0; ispec<nspec; ispec++ ) {
         isend( &( patch->vecSpecies[ispec]->particles->last_index ), to, tag+maxtag+2*ispec+1, patch->requests_[maxtag+2*ispec] );
         if( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
-            patch->vecSpecies[ispec]->exchangePatch = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            isend( patch->vecSpecies[ispec]->particles, to, tag+maxtag+2*ispec, patch->vecSpecies[ispec]->exchangePatch, patch->requests_[maxtag+2*ispec+1] );
+            isend( patch->vecSpecies[ispec]->particles, to, tag+maxtag+2*ispec, patch->requests_[maxtag+2*ispec+1] );
         }
     }
 
@@ -714,9 +704,9 @@ void SmileiMPI::isend_species( Patch *patch, int to, int &maxtag, int tag, Param
 
     // Send some scalars
     if( params.hasMCRadiation || params.hasLLRadiation || params.hasNielRadiation ) {
-        patch->buffer_scalars.resize( 3*nspec );
+        patch->buffer_scalars.resize( 3*nspec + Random::state_size );
     } else {
-        patch->buffer_scalars.resize( 2*nspec );
+        patch->buffer_scalars.resize( 2*nspec + Random::state_size );
     }
     unsigned int i = 0;
     // Energy lost at boundaries
@@ -736,6 +726,13 @@ void SmileiMPI::isend_species( Patch *patch, int to, int &maxtag, int tag, Param
             i++;
         }
     }
+    // Random number generator state (32-bit words, exact in doubles)
+    uint32_t random_state[Random::state_size];
+    patch->rand_->getState( random_state );
+    for( unsigned int k=0; k<Random::state_size; k++ ) {
+        patch->buffer_scalars[i] = random_state[k];
+        i++;
+    }
     MPI_Isend( &patch->buffer_scalars[0], patch->buffer_scalars.size(), MPI_DOUBLE, to, tag + maxtag, SMILEI_COMM_WORLD, &patch->requests_[maxtag] );
     maxtag ++;
 }
@@ -764,15 +761,6 @@ void SmileiMPI::waitall( Patch *patch )
         //patch->requests_[ireq] = MPI_REQUEST_NULL;
     }
 
-    for( int ispec=0 ; ispec<( int )patch->vecSpecies.size() ; ispec++ ) {
-        if( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
-            if( patch->vecSpecies[ispec]->exchangePatch != MPI_DATATYPE_NULL ) {
-                MPI_Type_free( &( patch->vecSpecies[ispec]->exchangePatch ) );
-                patch->vecSpecies[ispec]->exchangePatch = MPI_DATATYPE_NULL;
-            }
-        }
-    }
-
 }
 
 void SmileiMPI::recv( Patch *patch, int from, int tag, Params &params )
@@ -793,7 +781,6 @@ void SmileiMPI::recv( Patch *patch, int from, int tag, Params &params )
 
 void SmileiMPI::recv_species( Patch *patch, int from, int &tag, Params &params )
 {
-    MPI_Datatype recvParts;
     int nbrOfPartsRecv;
     
     // number of species
@@ -832,9 +819,7 @@ void SmileiMPI::recv_species( Patch *patch, int from, int &tag, Params &params )
         patch->vecSpecies[ispec]->particles->initialize( nbrOfPartsRecv, params.nDim_particle, params.keep_position_old );
         //Receive particles
         if( nbrOfPartsRecv > 0 ) {
-            recvParts = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            recv( patch->vecSpecies[ispec]->particles, from, tag+2*ispec, recvParts );
-            MPI_Type_free( &( recvParts ) );
+            recv( patch->vecSpecies[ispec]->particles, from, tag+2*ispec );
         }
         /*std::cerr << "Species: " << ispec
                   << " particles->last_index: " <<  patch->vecSpecies[ispec]->particles->last_index[0]
@@ -845,9 +830,9 @@ void SmileiMPI::recv_species( Patch *patch, int from, int &tag, Params &params )
     
     // Receive some scalars
     if( params.hasMCRadiation || params.hasLLRadiation || params.hasNielRadiation ) {
-        patch->buffer_scalars.resize( 3*nspec );
+        patch->buffer_scalars.resize( 3*nspec + Random::state_size );
     } else {
-        patch->buffer_scalars.resize( 2*nspec );
+        patch->buffer_scalars.resize( 2*nspec + Random::state_size );
     }
     MPI_Status status;
     MPI_Recv( &patch->buffer_scalars[0], patch->buffer_scalars.size(), MPI_DOUBLE, from, tag, SMILEI_COMM_WORLD, &status );
@@ -870,6 +855,13 @@ void SmileiMPI::recv_species( Patch *patch, int from, int &tag, Params &params )
             i++;
         }
     }
+    // Random number generator state
+    uint32_t random_state[Random::state_size];
+    for( unsigned int k=0; k<Random::state_size; k++ ) {
+        random_state[k] = patch->buffer_scalars[i];
+        i++;
+    }
+    patch->rand_->setState( random_state );
     
 }
 
@@ -886,17 +878,20 @@ void SmileiMPI::recv_fields( Patch *patch, int from, int tag, Params &params )
 } // END recv ( Patch )
 
 
-void SmileiMPI::isend( Particles *particles, int to, int tag, MPI_Datatype typePartSend, MPI_Request &request )
+// The particles are sent as their arena, laid out beforehand for their number (packed layout)
+void SmileiMPI::isend( Particles *particles, int to, int tag, MPI_Request &request )
 {
-    MPI_Isend( &( particles->position( 0, 0 ) ), 1, typePartSend, to, tag, MPI_COMM_WORLD, &request );
+    particles->compact();
+    MPI_Isend( particles->packedData(), particles->packedSize( particles->size() ), MPI_BYTE, to, tag, MPI_COMM_WORLD, &request );
 
 } // END isend( Particles )
 
 
-void SmileiMPI::recv( Particles *particles, int to, int tag, MPI_Datatype typePartRecv )
+void SmileiMPI::recv( Particles *particles, int to, int tag )
 {
     MPI_Status status;
-    MPI_Recv( &( particles->position( 0, 0 ) ), 1, typePartRecv, to, tag, MPI_COMM_WORLD, &status );
+    particles->compact();
+    MPI_Recv( particles->packedData(), particles->packedSize( particles->size() ), MPI_BYTE, to, tag, MPI_COMM_WORLD, &status );
 
 } // END recv( Particles )
 
@@ -1686,6 +1681,10 @@ void SmileiMPI::computeGlobalDiags( DiagnosticScalar *scalars, int timestep )
 void SmileiMPI::computeGlobalDiags( DiagnosticParticleBinning *diagParticles, int timestep )
 {
     if( timestep - diagParticles->timeSelection->previousTime() == diagParticles->time_average-1 ) {
+        if( diagParticles->nonBlockingReduction() ) {
+            diagParticles->startReduction( this, timestep );
+            return;
+        }
         MPI_Reduce( diagParticles->filename.size()?MPI_IN_PLACE:&diagParticles->data_sum[0], &diagParticles->data_sum[0], diagParticles->output_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
 
         if( !isMaster() ) {
@@ -1714,6 +1713,10 @@ void SmileiMPI::computeGlobalDiags( DiagnosticScreen *diagScreen, int timestep )
 void SmileiMPI::computeGlobalDiags(DiagnosticRadiationSpectrum* diagRad, int timestep)
 {
     if (timestep - diagRad->timeSelection->previousTime() == diagRad->time_average-1) {
+        if( diagRad->nonBlockingReduction() ) {
+            diagRad->startReduction( this, timestep );
+            return;
+        }
         MPI_Reduce( diagRad->filename.size()?MPI_IN_PLACE:&diagRad->data_sum[0], &diagRad->data_sum[0], diagRad->output_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
 
         if( !isMaster() ) {
@@ -1721,3 +1724,24 @@ void SmileiMPI::computeGlobalDiags(DiagnosticRadiationSpectrum* diagRad, int tim
         }
     }
 } // END computeGlobalDiags(DiagnosticRadiationSpectrum*  ...)
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Print the largest high-water mark of the threads scratch memory, over all MPI processes
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::printScratchStatistics()
+{
+    double high_water = 0., capacity = 0., allocations = 0., chunks = 0.;
+    for( unsigned int ithread=0 ; ithread<dynamics_scratch.size() ; ithread++ ) {
+        high_water  = max( high_water, ( double )dynamics_scratch[ithread].highWaterMark() );
+        capacity    = max( capacity, ( double )dynamics_scratch[ithread].capacity() );
+        allocations += dynamics_scratch[ithread].allocations();
+        chunks      += dynamics_scratch[ithread].chunkAllocations();
+    }
+    double local[2] = { high_water, capacity }, global[2];
+    MPI_Reduce( local, global, 2, MPI_DOUBLE, MPI_MAX, 0, SMILEI_COMM_WORLD );
+    double sums[2] = { allocations, chunks };
+    MPI_Reduce( isMaster()?MPI_IN_PLACE:sums, sums, 2, MPI_DOUBLE, MPI_SUM, 0, SMILEI_COMM_WORLD );
+    MESSAGE( 1, "Scratch memory high-water mark (max over threads) = " << ( int )( global[0] / 1024. ) << " kB" );
+    MESSAGE( 1, "Scratch memory reserved (max over threads) = " << ( int )( global[1] / 1024. ) << " kB" );
+    MESSAGE( 1, "Scratch arrays = " << ( long )sums[0] << ", in " << ( long )sums[1] << " memory allocations" );
+} // END printScratchStatistics
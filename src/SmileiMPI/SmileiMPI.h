@@ -5,10 +5,14 @@
 #include <vector>
 
 #include <mpi.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "Tools.h"
 #include "Particles.h"
 #include "Field.h"
+#include "ScratchArena.h"
 
 class Params;
 class Species;
@@ -60,10 +64,6 @@ public:
     // Returns the rank of the MPI process currently owning patch h.
     int hrank( int h );
 
-    // Create MPI type to exchange all particles properties of particles
-    MPI_Datatype createMPIparticles( Particles *particles );
-
-
     // PATCH SEND / RECV METHODS
     //     - during load balancing process
     //     - during moving window
@@ -77,8 +77,8 @@ public:
     void isend_species( Patch *patch, int to, int &maxtag, int tag, Params &params );
     void recv_species( Patch *patch, int from, int &tag, Params &params );
 
-    void isend( Particles *particles, int to, int hindex, MPI_Datatype datatype, MPI_Request &request );
-    void recv( Particles *partictles, int from, int hindex, MPI_Datatype datatype );
+    void isend( Particles *particles, int to, int hindex, MPI_Request &request );
+    void recv( Particles *partictles, int from, int hindex );
     void isend( std::vector<int> *vec, int to, int hindex, MPI_Request &request );
     void recv( std::vector<int> *vec, int from, int hindex );
 
@@ -194,6 +194,26 @@ public:
     std::vector<std::vector<double>> dynamics_EnvEabs_part;
     //! value of the EnvEabs used for envelope ionization
     std::vector<std::vector<double>> dynamics_EnvExabs_part;
+
+    //! Scratch memory of each thread, for the temporary arrays of the particle and diagnostic operators
+    std::vector<ScratchArena> dynamics_scratch;
+
+    //! Scratch memory of the calling thread
+    inline ScratchArena &scratch()
+    {
+#ifdef _OPENMP
+        return dynamics_scratch[omp_get_thread_num()];
+#else
+        return dynamics_scratch[0];
+#endif
+    }
+    //! Release the scratch memory of the calling thread (once per step)
+    inline void resetScratch()
+    {
+        scratch().reset();
+    }
+    //! Print the high-water marks of the scratch memory
+    void printScratchStatistics();
     
     // Resize buffers for a given number of particles
     inline void dynamics_resize( int ithread, int ndim_field, int npart, bool isAM = false )
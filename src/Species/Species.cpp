@@ -268,10 +268,6 @@ void Species::initOperators( Params &params, Patch *patch )
             MPI_buffer_.part_index_send_sz[iDim][iNeighbor] = 0;
         }
     }
-    typePartSend.resize( nDim_field*2, MPI_DATATYPE_NULL );
-    typePartRecv.resize( nDim_field*2, MPI_DATATYPE_NULL );
-    exchangePatch = MPI_DATATYPE_NULL;
-
     particles_to_move->initialize( 0, *particles );
 
 }
@@ -906,11 +902,7 @@ void Species::sortParticles( Params &params, Patch * patch )
     }
     //Make room for new particles
     if( shift[particles->last_index.size()] ) {
-        //! vecor::resize of Charge crashed ! Temporay solution : push_back / Particle
-        //particles->initialize( particles->size()+shift[particles->last_index.size()], particles->Position.size() );
-        for( int inewpart=0 ; inewpart<shift[particles->last_index.size()] ; inewpart++ ) {
-            particles->createParticle();
-        }
+        particles->createParticles( shift[particles->last_index.size()] );
     }
 
     //Shift bins, must be done sequentially
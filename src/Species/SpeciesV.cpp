@@ -153,10 +153,24 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
     int tid( 0 );
     std::vector<double> nrj_lost_per_thd( 1, 0. );
 
+    // Interpolation, push and projection pipelined over blocks of particles (3D, without per-cell processes)
+    // Only the vectorized Boris pusher works on buffers holding a single block
+    bool pipeline = params.vectorization_block_size > 0 && params.geometry == "3Dcartesian" && mass_ > 0 && pusher_name_ == "boris"
+                    && !Ionize && !Radiate && !Multiphoton_Breit_Wheeler_process && partWalls->size() == 0;
+
     // -------------------------------
     // calculate the particle dynamics
     // -------------------------------
-    if( time_dual>time_frozen_ || Ionize ) { // moving particle
+    if( time_dual>time_frozen_ && pipeline ) { // moving particle, by blocks
+
+        //Prepare for sorting
+        for( unsigned int i=0; i<count.size(); i++ ) {
+            count[i] = 0;
+        }
+
+        dynamicsBlocks( ispec, EMfields, params, diag_flag, patch, smpi, ithread );
+
+    } else if( time_dual>time_frozen_ || Ionize ) { // moving particle
     
         smpi->dynamics_resize( ithread, nDim_field, particles->last_index.back(), params.geometry=="AMcylindrical" );
 
@@ -396,6 +410,102 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
 
 }//END dynamics
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Particle dynamics by blocks of consecutive cells holding at most params.vectorization_block_size particles
+// (or a single cell). Each block is interpolated, pushed, checked against the boundaries and projected before the
+// next one, and the per-thread buffers of SmileiMPI are resized to the block: they stay in the L1/L2 caches.
+// ---------------------------------------------------------------------------------------------------------------------
+void SpeciesV::dynamicsBlocks( unsigned int ispec, ElectroMagn *EMfields, Params &params, bool diag_flag,
+                               Patch *patch, SmileiMPI *smpi, int ithread )
+{
+#ifdef  __DETAILED_TIMERS
+    double timer;
+#endif
+
+    unsigned int ncell = particles->first_index.size();
+    int block_size = params.vectorization_block_size;
+    double nrj_lost = 0.;
+
+    unsigned int cell_end;
+    for( unsigned int cell_start = 0 ; cell_start < ncell ; cell_start = cell_end ) {
+
+        // Particles of the block are [ipart_ref, iend[
+        int ipart_ref = particles->first_index[cell_start];
+        cell_end = cell_start+1;
+        while( cell_end < ncell && particles->last_index[cell_end] - ipart_ref <= block_size ) {
+            cell_end++;
+        }
+        int iend = particles->last_index[cell_end-1];
+        if( iend == ipart_ref ) {
+            continue;
+        }
+
+        smpi->dynamics_resize( ithread, nDim_field, iend - ipart_ref );
+
+#ifdef  __DETAILED_TIMERS
+        timer = MPI_Wtime();
+#endif
+
+        // Interpolate the fields at the particle position
+        for( unsigned int scell = cell_start ; scell < cell_end ; scell++ ) {
+            Interp->fieldsWrapper( EMfields, *particles, smpi, &( particles->first_index[scell] ),
+                                   &( particles->last_index[scell] ), ithread, ipart_ref );
+        }
+
+#ifdef  __DETAILED_TIMERS
+        patch->patch_timers[0] += MPI_Wtime() - timer;
+        timer = MPI_Wtime();
+#endif
+
+        // Push the particles
+        ( *Push )( *particles, smpi, ipart_ref, iend, ithread, ipart_ref );
+
+#ifdef  __DETAILED_TIMERS
+        patch->patch_timers[1] += MPI_Wtime() - timer;
+        timer = MPI_Wtime();
+#endif
+
+        for( unsigned int scell = cell_start ; scell < cell_end ; scell++ ) {
+            // Boundary Condition may be physical or due to domain decomposition
+            double ener_iPart( 0. );
+            partBoundCond->apply( *particles, smpi, particles->first_index[scell], particles->last_index[scell], this, ithread, ener_iPart );
+            nrj_lost += mass_ * ener_iPart;
+
+            for( int iPart=particles->first_index[scell] ; iPart<particles->last_index[scell]; iPart++ ) {
+                if ( particles->cell_keys[iPart] != -1 ) {
+                    //Compute cell_keys of remaining particles
+                    for( unsigned int i = 0 ; i<nDim_field; i++ ) {
+                        particles->cell_keys[iPart] *= this->length_[i];
+                        particles->cell_keys[iPart] += round( ((this)->*(distance[i]))(particles, i, iPart) * dx_inv_[i] );
+                    }
+                    //First reduction of the count sort algorithm. Lost particles are not included.
+                    count[particles->cell_keys[iPart]] ++;
+                }
+            }
+        }
+
+#ifdef  __DETAILED_TIMERS
+        patch->patch_timers[3] += MPI_Wtime() - timer;
+        timer = MPI_Wtime();
+#endif
+
+        // Project currents if not a Test species and charges as well if a diag is needed.
+        if( !particles->is_test ) {
+            for( unsigned int scell = cell_start ; scell < cell_end ; scell++ ) {
+                Proj->currentsAndDensityWrapper( EMfields, *particles, smpi, particles->first_index[scell],
+                                                 particles->last_index[scell], ithread, diag_flag, params.is_spectral,
+                                                 ispec, scell, ipart_ref );
+            }
+        }
+
+#ifdef  __DETAILED_TIMERS
+        patch->patch_timers[2] += MPI_Wtime() - timer;
+#endif
+    }
+
+    nrj_bc_lost += nrj_lost;
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // For all particles of the species
@@ -433,12 +543,8 @@ void SpeciesV::computeCharge( unsigned int ispec, ElectroMagn *EMfields )
 // ---------------------------------------------------------------------------------------------------------------------
 void SpeciesV::sortParticles( Params &params, Patch *patch )
 {
-    unsigned int npart, ncell;
-    int ip_dest, cell_target;
+    unsigned int npart, ncell, nmoved;
     unsigned int length[3];
-    vector<int> buf_cell_keys[3][2];
-    std::vector<unsigned int> cycle;
-    unsigned int ip_src;
 
     length[0]=0;
     length[1]=params.n_space[1]+1;
@@ -453,22 +559,41 @@ void SpeciesV::sortParticles( Params &params, Patch *patch )
     //Number of particles before exchange
     npart = particles->size();
 
+    //Count the particles which left their cell (or the patch) since the last sort
+    nmoved = 0;
+    if( ( unsigned int )particles->last_index.back() < npart ) {
+        nmoved = npart - particles->last_index.back();
+    }
+    for( unsigned int ic=0; ic < ncell; ic++ ) {
+        unsigned int iend = min( ( unsigned int )particles->last_index[ic], npart );
+        const int *__restrict__ keys = particles->cell_keys.data();
+        #pragma omp simd reduction(+:nmoved)
+        for( unsigned int ip=( unsigned int )particles->first_index[ic]; ip < iend; ip++ ) {
+            nmoved += ( keys[ip] != ( int )ic );
+        }
+    }
+
     //Loop over just arrived particles to compute their cell keys and contribution to count
     for( unsigned int idim=0; idim < nDim_field ; idim++ ) {
         for( unsigned int ineighbor=0 ; ineighbor < 2 ; ineighbor++ ) {
-            buf_cell_keys[idim][ineighbor].resize( MPI_buffer_.part_index_recv_sz[idim][ineighbor] );
+            unsigned int nrecv = MPI_buffer_.part_index_recv_sz[idim][ineighbor];
+            buf_cell_keys_[idim][ineighbor].resize( nrecv );
+            int *__restrict__ keys = buf_cell_keys_[idim][ineighbor].data();
             #pragma omp simd
-            for( unsigned int ip=0; ip < MPI_buffer_.part_index_recv_sz[idim][ineighbor]; ip++ ) {
+            for( unsigned int ip=0; ip < nrecv; ip++ ) {
+                int key = 0;
                 for( unsigned int ipos=0; ipos < nDim_field ; ipos++ ) {
                     double X = ((this)->*(distance[ipos]))(&MPI_buffer_.partRecv[idim][ineighbor], ipos, ip);
                     int IX = round( X * dx_inv_[ipos] );
-                    buf_cell_keys[idim][ineighbor][ip] = buf_cell_keys[idim][ineighbor][ip] * length[ipos] + IX;
+                    key = key * length[ipos] + IX;
                 }
+                keys[ip] = key;
             }
             //Can we vectorize this reduction ?
-            for( unsigned int ip=0; ip < MPI_buffer_.part_index_recv_sz[idim][ineighbor]; ip++ ) {
-                count[buf_cell_keys[idim][ineighbor][ip]] ++;
+            for( unsigned int ip=0; ip < nrecv; ip++ ) {
+                count[keys[ip]] ++;
             }
+            nmoved += nrecv;
         }
     }
 
@@ -482,12 +607,34 @@ void SpeciesV::sortParticles( Params &params, Patch *patch )
     //New total number of particles is stored as last element of particles->last_index
     particles->last_index[ncell-1] = particles->last_index[ncell-2] + count.back() ;
 
-    //Now proceed to the cycle sort
-
     if( MPI_buffer_.partRecv[0][0].size() == 0 ) {
         MPI_buffer_.partRecv[0][0].initialize( 0, *particles );    //Is this correct ?
     }
 
+    // The in-place cycle sort only moves the particles which changed cell,
+    // the out-of-place counting sort is faster when many particles moved
+    if( nmoved > params.vectorization_sort_threshold * npart ) {
+        countingSortParticles( params, npart, ncell );
+    } else {
+        cycleSortParticles( params, npart, ncell );
+    }
+
+    // Restore particles->first_index initial value
+    particles->first_index[0]=0;
+    for( unsigned int ic=1; ic < ncell; ic++ ) {
+        particles->first_index[ic] = particles->last_index[ic-1];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// In-place cycle sort of the particles, using the cell_keys and the new bins first_index, last_index
+// ---------------------------------------------------------------------------------------------------------------------
+void SpeciesV::cycleSortParticles( Params &params, unsigned int npart, unsigned int ncell )
+{
+    int ip_dest, cell_target;
+    unsigned int ip_src;
+    std::vector<unsigned int> &cycle = sort_cycle_;
+
     // Resize the particle vector
     if( ( unsigned int )particles->last_index.back() > npart ) {
         particles->resize( particles->last_index.back(), nDim_particle, params.keep_position_old );
@@ -499,7 +646,7 @@ void SpeciesV::sortParticles( Params &params, Patch *patch )
         for( unsigned int ineighbor=0 ; ineighbor < 2 ; ineighbor++ ) {
             for( unsigned int ip=0; ip < MPI_buffer_.part_index_recv_sz[idim][ineighbor]; ip++ ) {
                 cycle.resize( 1 );
-                cell_target = buf_cell_keys[idim][ineighbor][ip];
+                cell_target = buf_cell_keys_[idim][ineighbor][ip];
                 ip_dest = particles->first_index[cell_target];
                 while( particles->cell_keys[ip_dest] == cell_target ) {
                     ip_dest++;
@@ -662,10 +809,49 @@ void SpeciesV::sortParticles( Params &params, Patch *patch )
             }
         }
     } //end loop on cells
-    // Restore particles->first_index initial value
-    particles->first_index[0]=0;
-    for( unsigned int ic=1; ic < ncell; ic++ ) {
-        particles->first_index[ic] = particles->last_index[ic-1];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Out-of-place counting sort of the particles into the second buffer of particles_sorted,
+// using the cell_keys and the new bins first_index, last_index
+// ---------------------------------------------------------------------------------------------------------------------
+void SpeciesV::countingSortParticles( Params &params, unsigned int npart, unsigned int ncell )
+{
+    Particles &buffer = particles_sorted[particles == &particles_sorted[0]];
+    if( buffer.double_prop.empty() ) {
+        buffer.initialize( 0, *particles );
+    }
+    unsigned int nnew = particles->last_index.back();
+    buffer.resize( nnew );
+    buffer.cell_keys.resize( nnew );
+
+    // Destination of each particle, first_index being the insertion point in each cell
+    sort_destination_.resize( npart );
+    int *__restrict__ dest = sort_destination_.data();
+    const int *__restrict__ keys = particles->cell_keys.data();
+    int *__restrict__ insert = particles->first_index.data();
+    for( unsigned int ip=0; ip < npart; ip++ ) {
+        dest[ip] = keys[ip] < 0 ? -1 : insert[keys[ip]]++;
+    }
+    particles->scatterParticles( sort_destination_, buffer );
+
+    // Particles received from the MPI buffers fill the end of their cell
+    for( unsigned int idim=0; idim < nDim_field ; idim++ ) {
+        for( unsigned int ineighbor=0 ; ineighbor < 2 ; ineighbor++ ) {
+            for( unsigned int ip=0; ip < MPI_buffer_.part_index_recv_sz[idim][ineighbor]; ip++ ) {
+                MPI_buffer_.partRecv[idim][ineighbor].overwriteParticle( ip, buffer, insert[buf_cell_keys_[idim][ineighbor][ip]]++ );
+            }
+        }
+    }
+
+    // The sorted particles become the species particles, the old ones are kept as buffer for the next sort
+    particles->swapData( buffer );
+    for( unsigned int ic=0; ic < ncell; ic++ ) {
+        int *__restrict__ cell_keys = particles->cell_keys.data();
+        #pragma omp simd
+        for( int ip=( ic==0 ? 0 : particles->last_index[ic-1] ); ip < particles->last_index[ic]; ip++ ) {
+            cell_keys[ip] = ic;
+        }
     }
 }
 
@@ -42,6 +42,10 @@ public:
                    MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
                    std::vector<Diagnostic *> &localDiags ) override;
 
+    //! Particle dynamics pipelined over blocks of particles which fit in cache (dynamics helper)
+    void dynamicsBlocks( unsigned int ispec, ElectroMagn *EMfields, Params &params, bool diag_flag,
+                         Patch *patch, SmileiMPI *smpi, int ithread );
+
     //! Method projecting susceptibility and calculating the particles updated momentum (interpolation, momentum pusher), only particles interacting with envelope
     void ponderomotiveUpdateSusceptibilityAndMomentum( double time_dual, unsigned int ispec,
             ElectroMagn *EMfields,
@@ -68,10 +72,16 @@ public:
     //! Method calculating the Particle charge on the grid (projection)
     void computeCharge( unsigned int ispec, ElectroMagn *EMfields ) override;
 
-    //! Method used to sort particles
+    //! Method used to sort particles: cycle sort or counting sort depending on the fraction of particles which moved
     void sortParticles( Params &params , Patch * patch) override;
     //void countSortParticles(Params& param);
 
+    //! In-place sort exchanging the particles along cycles of cells (sortParticles helper)
+    void cycleSortParticles( Params &params, unsigned int npart, unsigned int ncell );
+
+    //! Out-of-place counting sort into the second particles buffer (sortParticles helper)
+    void countingSortParticles( Params &params, unsigned int npart, unsigned int ncell );
+
     //! Compute cell_keys for all particles of the current species
     void computeParticleCellKeys( Params &params ) override;
 
@@ -101,6 +111,13 @@ private:
     //! Size of the pack in number of particles
     unsigned int packsize_;
 
+    //! Cell keys of the particles received from each neighbor
+    std::vector<int> buf_cell_keys_[3][2];
+    //! Destination of each particle in the counting sort
+    std::vector<int> sort_destination_;
+    //! Cycle of particle exchanges in the cycle sort, kept between steps to avoid reallocations
+    std::vector<unsigned int> sort_cycle_;
+
 };
 
 #endif
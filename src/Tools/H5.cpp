@@ -1,7 +1,7 @@
 #include "H5.h"
 
 //! Open HDF5 file + location
-H5::H5( std::string file, unsigned access, bool parallel, bool _raise )
+H5::H5( std::string file, unsigned access, bool parallel, bool _raise, bool in_memory )
 {
     
     // Analyse file string : separate file name and tree inside hdf5 file
@@ -34,6 +34,9 @@ H5::H5( std::string file, unsigned access, bool parallel, bool _raise )
     hid_t fapl = H5Pcreate( H5P_FILE_ACCESS );
     if( parallel ) {
         H5Pset_fapl_mpio( fapl, MPI_COMM_WORLD, MPI_INFO_NULL );
+    } else if( in_memory ) {
+        // Core driver without backing store: nothing is written to disk
+        H5Pset_fapl_core( fapl, 64*1024*1024, 0 );
     }
     if( access == H5F_ACC_RDWR ) {
         fid_ = H5Fcreate( filepath.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl );
@@ -108,6 +111,7 @@ H5Space::H5Space( hsize_t size ) {
         H5Sselect_none( sid );
     }
     chunk_.resize(0);
+    compress( 0, false, 0 );
 }
 
 //! 1D
@@ -126,6 +130,7 @@ H5Space::H5Space( hsize_t size, hsize_t offset, hsize_t npoints, hsize_t chunk )
     } else {
         chunk_.resize( 0 );
     }
+    compress( 0, false, 0 );
 }
 
 //! ND
@@ -149,4 +154,20 @@ H5Space::H5Space( std::vector<hsize_t> size, std::vector<hsize_t> offset, std::v
         }
     }
     chunk_ = chunk;
+    compress( 0, false, 0 );
+}
+
+//! Select the union of several blocks
+void H5Space::selectBlocks( std::vector<std::vector<hsize_t> > offsets, std::vector<std::vector<hsize_t> > npoints ) {
+    H5Sselect_none( sid );
+    std::vector<hsize_t> count( dims_.size(), 1 );
+    bool selected = false;
+    for( unsigned int iblock=0; iblock<offsets.size(); iblock++ ) {
+        unsigned int i;
+        for( i=0; i<npoints[iblock].size() && npoints[iblock][i]>0; i++ ) {}
+        if( global_ > 0 && i == npoints[iblock].size() ) {
+            H5Sselect_hyperslab( sid, selected ? H5S_SELECT_OR : H5S_SELECT_SET, &offsets[iblock][0], NULL, &count[0], &npoints[iblock][0] );
+            selected = true;
+        }
+    }
 }
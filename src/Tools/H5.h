@@ -52,6 +52,18 @@ public:
     //! ND
     H5Space( std::vector<hsize_t> size, std::vector<hsize_t> offset = {}, std::vector<hsize_t> npoints = {}, std::vector<hsize_t> chunk = {} );
     
+    //! Select the union of several blocks (none if there is no block)
+    void selectBlocks( std::vector<std::vector<hsize_t> > offsets, std::vector<std::vector<hsize_t> > npoints );
+    
+    //! Compress the chunked dataset created with this space: deflate level (0: none), and lossy quantization
+    //! keeping decimal_digits digits after the decimal point (scale-offset filter) if lossy
+    void compress( int deflate, bool lossy, int decimal_digits )
+    {
+        deflate_ = deflate;
+        lossy_ = lossy;
+        decimal_digits_ = decimal_digits;
+    }
+    
     ~H5Space() {
         H5Sclose( sid );
     }
@@ -60,6 +72,9 @@ public:
     std::vector<hsize_t> dims_;
     std::vector<hsize_t> chunk_;
     hsize_t global_;
+    int deflate_;
+    bool lossy_;
+    int decimal_digits_;
     
 };
 
@@ -67,7 +82,7 @@ class H5
 {
 public:
     //! Open HDF5 file + location
-    H5( std::string file, unsigned access, bool parallel, bool _raise );
+    H5( std::string file, unsigned access, bool parallel, bool _raise, bool in_memory = false );
     
     ~H5();
     
@@ -79,6 +94,17 @@ public:
         H5Fflush( id_, H5F_SCOPE_GLOBAL );
     }
     
+    //! Copy the image of the whole file in a buffer (useful for files opened in memory)
+    bool image( std::vector<char> &buffer ) {
+        H5Fflush( fid_, H5F_SCOPE_GLOBAL );
+        ssize_t size = H5Fget_file_image( fid_, NULL, 0 );
+        if( size < 0 ) {
+            return false;
+        }
+        buffer.resize( size );
+        return H5Fget_file_image( fid_, &buffer[0], size ) == size;
+    }
+    
     //! Check if group exists
     bool has( std::string group_name )
     {
@@ -124,8 +150,9 @@ class H5Write : public H5
 {
 public:
     //! Open HDF5 file + location
-    H5Write( std::string file, bool parallel = false, bool _raise = true )
-     : H5( file, H5F_ACC_RDWR, parallel, _raise ) {};
+    //! If in_memory, the file is only built in memory (see H5::image)
+    H5Write( std::string file, bool parallel = false, bool _raise = true, bool in_memory = false )
+     : H5( file, H5F_ACC_RDWR, parallel, _raise, in_memory ) {};
     
     //! Create group given H5Write location
     H5Write( H5Write *loc, std::string group_name )
@@ -138,6 +165,13 @@ public:
         H5D_layout_t layout = H5Pget_layout( dcr_ );
         if( ! filespace->chunk_.empty() ) {
             H5Pset_chunk( dcr_, filespace->chunk_.size(), &filespace->chunk_[0] );
+            // The quantization must precede the deflate filter
+            if( filespace->lossy_ ) {
+                H5Pset_scaleoffset( dcr_, H5Z_SO_FLOAT_DSCALE, filespace->decimal_digits_ );
+            }
+            if( filespace->deflate_ > 0 ) {
+                H5Pset_deflate( dcr_, std::min( 9, filespace->deflate_ ) );
+            }
         }
         if( H5Lexists( loc->id_, name.c_str(), H5P_DEFAULT ) == 0 ) {
             id_  = H5Dcreate( loc->id_, name.c_str(), type, filespace->sid, H5P_DEFAULT, dcr_, H5P_DEFAULT );
@@ -146,6 +180,9 @@ public:
             id_ = H5Dopen( loc->id_, name.c_str(), pid );
             H5Pclose( pid );
         }
+        if( H5Pget_nfilters( dcr_ ) > 0 ) {
+            H5Premove_filter( dcr_, H5Z_FILTER_ALL );
+        }
         H5Pset_layout( dcr_, layout );
     }
     
@@ -0,0 +1,143 @@
+#include "HardwareCounters.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+bool HardwareCounters::enabled_ = false;
+uint64_t HardwareCounters::vector_event_ = 0;
+
+namespace
+{
+//! Counters opened by one thread, as a group led by the first opened event
+struct ThreadCounters {
+    ThreadCounters() : opened( false ), leader( -1 ), n_opened( 0 ) {}
+    ~ThreadCounters()
+    {
+#ifdef __linux__
+        for( unsigned int i=0; opened && i<HardwareCounters::n_events; i++ ) {
+            if( fd[i] >= 0 ) {
+                close( fd[i] );
+            }
+        }
+#endif
+    }
+    bool opened;
+    int leader;
+    int fd[HardwareCounters::n_events];
+    //! Position of each event in the group read (-1 if not opened)
+    int position[HardwareCounters::n_events];
+    unsigned int n_opened;
+};
+
+thread_local ThreadCounters thread_counters;
+
+#ifdef __linux__
+int openEvent( uint32_t type, uint64_t config, int group_fd )
+{
+    struct perf_event_attr attr;
+    memset( &attr, 0, sizeof( attr ) );
+    attr.size = sizeof( attr );
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    // Only user space, allowed with the default perf_event_paranoid level
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall( __NR_perf_event_open, &attr, 0, -1, group_fd, 0 );
+}
+#endif
+
+void openThreadCounters( ThreadCounters &c, uint64_t vector_event )
+{
+    c.opened = true;
+    for( unsigned int i=0; i<HardwareCounters::n_events; i++ ) {
+        c.fd[i] = -1;
+        c.position[i] = -1;
+    }
+#ifdef __linux__
+    const uint32_t types[HardwareCounters::n_events] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_RAW
+    };
+    const uint64_t configs[HardwareCounters::n_events] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, vector_event
+    };
+    for( unsigned int i=0; i<HardwareCounters::n_events; i++ ) {
+        if( types[i] == PERF_TYPE_RAW && configs[i] == 0 ) {
+            continue;
+        }
+        c.fd[i] = openEvent( types[i], configs[i], c.leader );
+        if( c.fd[i] >= 0 ) {
+            if( c.leader < 0 ) {
+                c.leader = c.fd[i];
+            }
+            c.position[i] = c.n_opened++;
+        }
+    }
+#endif
+}
+}
+
+string HardwareCounters::name( unsigned int ievent )
+{
+    const char *names[n_events] = { "cycles", "instructions", "cache_misses", "vector_instructions" };
+    return names[ievent];
+}
+
+bool HardwareCounters::enable( uint64_t vector_event )
+{
+    vector_event_ = vector_event;
+    // Try on the calling thread
+    if( ! thread_counters.opened ) {
+        openThreadCounters( thread_counters, vector_event_ );
+    }
+    enabled_ = thread_counters.leader >= 0;
+    return enabled_;
+}
+
+void HardwareCounters::read( uint64_t *values )
+{
+    for( unsigned int i=0; i<n_events; i++ ) {
+        values[i] = 0;
+    }
+    if( ! enabled_ ) {
+        return;
+    }
+    ThreadCounters &c = thread_counters;
+    if( ! c.opened ) {
+        openThreadCounters( c, vector_event_ );
+    }
+#ifdef __linux__
+    if( c.leader < 0 ) {
+        return;
+    }
+    // Group read format: number of events followed by their values
+    uint64_t buffer[1+n_events];
+    ssize_t size = ::read( c.leader, buffer, sizeof( buffer ) );
+    if( size < ( ssize_t )( ( 1+c.n_opened )*sizeof( uint64_t ) ) ) {
+        return;
+    }
+    for( unsigned int i=0; i<n_events; i++ ) {
+        if( c.position[i] >= 0 ) {
+            values[i] = buffer[1+c.position[i]];
+        }
+    }
+#endif
+}
+
+uint64_t HardwareCounters::defaultVectorEvent()
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+    // Intel FP_ARITH_INST_RETIRED (event 0xC7) with all the packed (128, 256 and 512-bit) umasks
+    if( __builtin_cpu_is( "intel" ) ) {
+        return 0xfcc7;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,42 @@
+#ifndef HARDWARECOUNTERS_H
+#define HARDWARECOUNTERS_H
+
+#include <string>
+#include <inttypes.h>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class HardwareCounters
+//! Hardware performance counters of each thread, read through the Linux perf_event_open system call.
+//! Once enabled, the counters of a thread are opened the first time this thread reads them.
+//  --------------------------------------------------------------------------------------------------------------------
+class HardwareCounters
+{
+public:
+    //! Counted events: cycles, instructions, cache misses and vector instructions
+    static const unsigned int n_events = 4;
+
+    //! Name of each event
+    static std::string name( unsigned int ievent );
+
+    //! Activate the counters. vector_event is the raw PMU code counting vector instructions (0 if unknown).
+    //! Returns false if the counters cannot be opened on this system.
+    static bool enable( uint64_t vector_event );
+
+    //! Whether the counters are active
+    static bool enabled()
+    {
+        return enabled_;
+    }
+
+    //! Values of the counters of the calling thread (zero for the events not supported)
+    static void read( uint64_t *values );
+
+    //! Default raw code of the vector instruction event for the current processor (0 if unknown)
+    static uint64_t defaultVectorEvent();
+
+private:
+    static bool enabled_;
+    static uint64_t vector_event_;
+};
+
+#endif
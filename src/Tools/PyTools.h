@@ -459,7 +459,10 @@ public:
         }
         PyObject *inspect=PyImport_ImportModule( "inspect" );
         checkPyError();
-        PyObject *tuple = PyObject_CallMethod( inspect, const_cast<char *>( "getargspec" ), const_cast<char *>( "(O)" ), obj );
+        // getargspec does not exist anymore in python 3.11
+        const char *argspec = PyObject_HasAttrString( inspect, "getfullargspec" ) ? "getfullargspec" : "getargspec";
+        PyObject *tuple = PyObject_CallMethod( inspect, const_cast<char *>( argspec ), const_cast<char *>( "(O)" ), obj );
+        checkPyError();
         PyObject *arglist = PyTuple_GetItem( tuple, 0 ); // list of function arguments
         PyObject *vararg = PyTuple_GetItem( tuple, 1 ); // name of *args
         int nargs = PyObject_Size( arglist );
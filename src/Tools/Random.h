@@ -5,86 +5,196 @@
 #include <inttypes.h>
 #include <cmath>
 
+//! Counter-based random number generator Philox-4x32-10 (Salmon et al., SC'11)
+//!
+//! The n-th block of 4 random integers is a pure function of the key, of the substream and of n.
+//! Each patch owns its own key (random seed, patch index) and substream (shift of the moving window at
+//! the patch creation), so that the random numbers of a patch depend neither on the number of threads
+//! nor on the process that owns the patch. The batch methods fill arrays with independent iterations
+//! over the blocks, which the compiler can vectorize.
 class Random
 {
 public:
-    Random( unsigned int seed ) {
-        // Initialize the state of the random number generator
-        xorshift32_state = seed;
-        // Ensure that the random seed is different for each patch
-        xorshift32_state += std::rand();
-        // zero is not acceptable for xorshift
-        if( xorshift32_state==0 ) {
-            xorshift32_state = 1073741824;
-        }
+    Random( unsigned int seed, unsigned int stream, unsigned int substream = 0 )
+    {
+        key_[0] = seed;
+        key_[1] = stream;
+        substream_ = substream;
+        counter_ = 0;
+        cached_block_ = UINT64_MAX;
     };
-    
+
     ~Random() {};
-    
+
     //! random integer
     inline uint32_t integer() {
-        return xorshift32();
+        return next();
     }
-    //! Uniform rand from xorshift32 generator, between 0 (excluded) and 1 (included)
+    //! Uniform rand between 0 (excluded) and 1 (included)
     inline double uniform() {
-        return xorshift32() * xorshift32_invmax;
+        return ( next() + 1. ) * invmax;
     }
-    //! Uniform rand from xorshift32 generator, between 0 (excluded) and 1-10^-11
+    //! Uniform rand between 0 (excluded) and 1-10^-11
     inline double uniform1() {
-        return xorshift32() * xorshift32_invmax1;
+        return ( next() + 1. ) * invmax1;
     }
-    //! Uniform rand from xorshift32 generator, between -1. (excluded) and 1. (included)
+    //! Uniform rand between -1. (excluded) and 1. (included)
     inline double uniform2() {
-        return xorshift32() * xorshift32_invmax2 - 1.;
+        return ( next() + 1. ) * invmax2 - 1.;
     }
-    //! Uniform rand from xorshift32 generator, between 0. (excluded) and 2 pi (included)
+    //! Uniform rand between 0. (excluded) and 2 pi (included)
     inline double uniform_2pi() {
-        return xorshift32() * xorshift32_invmax_2pi;
+        return ( next() + 1. ) * invmax_2pi;
     }
-    //! Normal rand from xorshift32 generator (std deviation = 1.)
+    //! Normal rand (std deviation = 1.), Box-Muller transform of two uniform rands
     inline double normal() {
-        static double spare;
-        static bool has_spare = false;
-        if( has_spare ) {
-            has_spare = false;
-            return spare;
-        } else {
-            double u, v, s;
-            do {
-                u = uniform2();
-                v = uniform2();
-                s = u*u + v*v;
-            } while( s >= 1. );
-            s = std::sqrt( -2. * std::log(s) / s );
-            spare = v * s;
-            has_spare = true;
-            return u * s;
+        double r = std::sqrt( -2. * std::log( uniform() ) );
+        return r * std::cos( uniform_2pi() );
+    }
+
+    //! Fill r[0:n] with uniform rands between 0 (excluded) and 1 (included)
+    inline void uniform( double *r, unsigned int n ) {
+        fill( r, n, invmax, 0. );
+    }
+    //! Fill r[0:n] with uniform rands between -1. (excluded) and 1. (included)
+    inline void uniform2( double *r, unsigned int n ) {
+        fill( r, n, invmax2, -1. );
+    }
+    //! Fill r[0:n] with uniform rands between 0. (excluded) and 2 pi (included)
+    inline void uniform_2pi( double *r, unsigned int n ) {
+        fill( r, n, invmax_2pi, 0. );
+    }
+    //! Fill r[0:n] with normal rands (std deviation = 1.): each block gives two Box-Muller pairs
+    inline void normal( double *r, unsigned int n ) {
+        uint64_t block0 = firstBatchBlock();
+        unsigned int nblocks = n/4;
+        #pragma omp simd
+        for( unsigned int b=0 ; b<nblocks ; b++ ) {
+            uint32_t x[4];
+            philox( block0+b, x );
+            for( unsigned int k=0 ; k<4 ; k+=2 ) {
+                double radius = std::sqrt( -2. * std::log( ( x[k] + 1. ) * invmax ) );
+                double angle = ( x[k+1] + 1. ) * invmax_2pi;
+                r[4*b+k  ] = radius * std::cos( angle );
+                r[4*b+k+1] = radius * std::sin( angle );
+            }
+        }
+        if( n%4 > 0 ) {
+            uint32_t x[4];
+            philox( block0+nblocks, x );
+            for( unsigned int k=0 ; k<n%4 ; k++ ) {
+                double radius = std::sqrt( -2. * std::log( ( x[k/2*2] + 1. ) * invmax ) );
+                double angle = ( x[k/2*2+1] + 1. ) * invmax_2pi;
+                r[4*nblocks+k] = radius * ( k%2==0 ? std::cos( angle ) : std::sin( angle ) );
+            }
         }
+        counter_ = 4 * ( block0 + ( n+3 )/4 );
     }
 
-    //! State of the random number generator
-    uint32_t xorshift32_state;
+    //! Number of 32-bit words of the state (key, substream, counter)
+    static const unsigned int state_size = 5;
+
+    //! Copy the state into s[0:state_size] (for checkpoints and patch exchanges)
+    void getState( uint32_t *s ) const
+    {
+        s[0] = key_[0];
+        s[1] = key_[1];
+        s[2] = substream_;
+        s[3] = ( uint32_t ) counter_;
+        s[4] = ( uint32_t )( counter_ >> 32 );
+    }
+    //! Restore the state from s[0:state_size]
+    void setState( const uint32_t *s )
+    {
+        key_[0] = s[0];
+        key_[1] = s[1];
+        substream_ = s[2];
+        counter_ = ( ( uint64_t ) s[4] << 32 ) | s[3];
+        cached_block_ = UINT64_MAX;
+    }
 
 private:
-    
-    //! Random number generator
-    inline uint32_t xorshift32()
+
+    //! Philox-4x32 block of 4 random integers number `block` of the current key and substream
+    inline void philox( uint64_t block, uint32_t *x ) const
     {
-        /* Algorithm "xor" from p. 4 of Marsaglia, "Xorshift RNGs" */
-        xorshift32_state ^= xorshift32_state << 13;
-        xorshift32_state ^= xorshift32_state >> 17;
-        xorshift32_state ^= xorshift32_state << 5;
-        return xorshift32_state;
+        uint32_t c0 = ( uint32_t ) block, c1 = ( uint32_t )( block >> 32 ), c2 = substream_, c3 = 0;
+        uint32_t k0 = key_[0], k1 = key_[1];
+        for( unsigned int round=0 ; round<10 ; round++ ) {
+            uint64_t p0 = ( uint64_t ) 0xD2511F53 * c0;
+            uint64_t p1 = ( uint64_t ) 0xCD9E8D57 * c2;
+            c0 = ( uint32_t )( p1 >> 32 ) ^ c1 ^ k0;
+            c1 = ( uint32_t ) p1;
+            c2 = ( uint32_t )( p0 >> 32 ) ^ c3 ^ k1;
+            c3 = ( uint32_t ) p0;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        x[0] = c0;
+        x[1] = c1;
+        x[2] = c2;
+        x[3] = c3;
+    }
+
+    //! Next random integer, taken from the cached block
+    inline uint32_t next()
+    {
+        uint64_t block = counter_ >> 2;
+        if( block != cached_block_ ) {
+            philox( block, cache_ );
+            cached_block_ = block;
+        }
+        return cache_[counter_++ & 3];
+    }
+
+    //! Batches start at a block boundary: the rest of a partially used block is skipped
+    inline uint64_t firstBatchBlock() const
+    {
+        return ( counter_ + 3 ) >> 2;
     }
+
+    //! Fill r[0:n] with (x+1)*scale+shift for consecutive random integers x
+    inline void fill( double *r, unsigned int n, double scale, double shift )
+    {
+        uint64_t block0 = firstBatchBlock();
+        unsigned int nblocks = n/4;
+        #pragma omp simd
+        for( unsigned int b=0 ; b<nblocks ; b++ ) {
+            uint32_t x[4];
+            philox( block0+b, x );
+            for( unsigned int k=0 ; k<4 ; k++ ) {
+                r[4*b+k] = ( x[k] + 1. ) * scale + shift;
+            }
+        }
+        if( n%4 > 0 ) {
+            uint32_t x[4];
+            philox( block0+nblocks, x );
+            for( unsigned int k=0 ; k<n%4 ; k++ ) {
+                r[4*nblocks+k] = ( x[k] + 1. ) * scale + shift;
+            }
+        }
+        counter_ = 4 * ( block0 + ( n+3 )/4 );
+    }
+
+    //! Key of the stream (random seed, patch index)
+    uint32_t key_[2];
+    //! Substream number (third word of the counter)
+    uint32_t substream_;
+    //! Number of random integers drawn in this stream
+    uint64_t counter_;
+    //! Last block computed by the scalar methods
+    uint64_t cached_block_;
+    uint32_t cache_[4];
+
     //! Inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax = 1./4294967296.;
+    static constexpr double invmax = 1./4294967296.;
     //! Almost inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax1 = (1.-1e-11)/4294967296.;
+    static constexpr double invmax1 = (1.-1e-11)/4294967296.;
     //! Twice inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax2 = 2./4294967296.;
-     //! two pi * inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax_2pi = 2.*M_PI/4294967296.;
-    
+    static constexpr double invmax2 = 2./4294967296.;
+    //! two pi * inverse of the maximum value of the random number generator
+    static constexpr double invmax_2pi = 2.*M_PI/4294967296.;
+
 };
 
 
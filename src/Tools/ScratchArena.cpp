@@ -0,0 +1,141 @@
+#include "ScratchArena.h"
+
+#include <cstdlib>
+#include <algorithm>
+
+#include "Tools.h"
+
+using namespace std;
+
+namespace
+{
+//! Size of the first chunk
+const size_t default_chunk_size = 1<<16;
+
+size_t roundToAlignment( size_t bytes )
+{
+    return ( bytes + ScratchArena::alignment - 1 ) / ScratchArena::alignment * ScratchArena::alignment;
+}
+}
+
+ScratchArena::ScratchArena() :
+    current_( 0 ),
+    in_use_( 0 ),
+    high_water_( 0 ),
+    n_allocations_( 0 ),
+    n_chunk_allocations_( 0 )
+{
+}
+
+ScratchArena::ScratchArena( ScratchArena &&other ) noexcept :
+    chunks_( std::move( other.chunks_ ) ),
+    current_( other.current_ ),
+    in_use_( other.in_use_ ),
+    high_water_( other.high_water_ ),
+    n_allocations_( other.n_allocations_ ),
+    n_chunk_allocations_( other.n_chunk_allocations_ )
+{
+    other.chunks_.clear();
+    other.current_ = 0;
+    other.in_use_ = 0;
+}
+
+ScratchArena::~ScratchArena()
+{
+    freeChunks();
+}
+
+ScratchArena::Mark ScratchArena::mark() const
+{
+    Mark m;
+    m.chunk = current_;
+    m.offset = chunks_.empty() ? 0 : chunks_[current_].used;
+    return m;
+}
+
+void ScratchArena::release( Mark m )
+{
+    if( chunks_.empty() ) {
+        return;
+    }
+    // The chunks after the current one are always empty
+    for( size_t c = m.chunk+1 ; c <= current_ ; c++ ) {
+        in_use_ -= chunks_[c].used;
+        chunks_[c].used = 0;
+    }
+    in_use_ -= chunks_[m.chunk].used - m.offset;
+    chunks_[m.chunk].used = m.offset;
+    current_ = m.chunk;
+}
+
+void ScratchArena::reset()
+{
+    Mark bottom = { 0, 0 };
+    release( bottom );
+    if( chunks_.size() > 1 ) {
+        freeChunks();
+        addChunk( roundToAlignment( high_water_ ) );
+    }
+}
+
+size_t ScratchArena::capacity() const
+{
+    size_t size = 0;
+    for( size_t c = 0 ; c < chunks_.size() ; c++ ) {
+        size += chunks_[c].size;
+    }
+    return size;
+}
+
+void *ScratchArena::allocateBytes( size_t bytes )
+{
+    bytes = roundToAlignment( bytes );
+    if( chunks_.empty() ) {
+        addChunk( max( bytes, default_chunk_size ) );
+    }
+    while( chunks_[current_].used + bytes > chunks_[current_].size ) {
+        if( current_+1 < chunks_.size() && chunks_[current_+1].size >= bytes ) {
+            current_++;
+        } else {
+            addChunk( max( bytes, 2*chunks_[current_].size ) );
+        }
+    }
+    Chunk &chunk = chunks_[current_];
+    void *p = chunk.data + chunk.used;
+    chunk.used += bytes;
+    in_use_ += bytes;
+    high_water_ = max( high_water_, in_use_ );
+    n_allocations_++;
+    return p;
+}
+
+void ScratchArena::addChunk( size_t size )
+{
+    // The chunks after the current one are empty: replace them by the new one
+    size_t next = chunks_.empty() ? 0 : current_+1;
+    for( size_t c = next ; c < chunks_.size() ; c++ ) {
+        free( chunks_[c].data );
+    }
+    chunks_.resize( next );
+    Chunk chunk;
+    void *data = NULL;
+    if( posix_memalign( &data, alignment, size ) != 0 ) {
+        ERROR( "Cannot allocate " << size << " bytes of scratch memory" );
+    }
+    chunk.data = static_cast<char *>( data );
+    chunk.size = size;
+    chunk.used = 0;
+    chunks_.push_back( chunk );
+    current_ = next;
+    n_chunk_allocations_++;
+}
+
+void ScratchArena::freeChunks()
+{
+    for( size_t c = 0 ; c < chunks_.size() ; c++ ) {
+        free( chunks_[c].data );
+    }
+    chunks_.clear();
+    current_ = 0;
+    in_use_ = 0;
+}
@@ -0,0 +1,109 @@
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class ScratchArena
+//! Bump allocator for the temporary arrays of one thread.
+//! Arrays are carved out of 64-byte aligned chunks and released, in the reverse order of their allocation,
+//! when the Scope that surrounds them ends. If a step needs more memory than the first chunk, other chunks are added,
+//! and the next reset() merges them into a single chunk sized on the high-water mark: once the sizes are stable,
+//! no memory is allocated anymore.
+//  --------------------------------------------------------------------------------------------------------------------
+class ScratchArena
+{
+public:
+    //! Alignment of all the arrays (one cache line)
+    static const std::size_t alignment = 64;
+
+    ScratchArena();
+    ScratchArena( ScratchArena &&other ) noexcept;
+    ScratchArena( const ScratchArena & ) = delete;
+    ScratchArena &operator=( const ScratchArena & ) = delete;
+    ~ScratchArena();
+
+    //! Uninitialized array of n elements, valid until the end of the enclosing Scope
+    template<typename T>
+    T *allocate( std::size_t n )
+    {
+        static_assert( std::is_trivially_destructible<T>::value, "the scratch arrays are never destroyed" );
+        return static_cast<T *>( allocateBytes( n*sizeof( T ) ) );
+    }
+
+    //! Top of the arena at a given time
+    struct Mark {
+        std::size_t chunk;
+        std::size_t offset;
+    };
+
+    //! Current top of the arena
+    Mark mark() const;
+
+    //! Release all the arrays allocated since the mark
+    void release( Mark m );
+
+    //! Releases, at its destruction, all the arrays allocated during its lifetime
+    class Scope
+    {
+    public:
+        Scope( ScratchArena &arena ) : arena_( arena ), mark_( arena.mark() ) {}
+        ~Scope()
+        {
+            arena_.release( mark_ );
+        }
+    private:
+        ScratchArena &arena_;
+        Mark mark_;
+    };
+
+    //! Release everything and merge the chunks (once per step, outside of any Scope)
+    void reset();
+
+    //! Largest number of bytes used at once since the beginning
+    std::size_t highWaterMark() const
+    {
+        return high_water_;
+    }
+    //! Number of bytes currently reserved
+    std::size_t capacity() const;
+    //! Number of arrays allocated since the beginning
+    std::size_t allocations() const
+    {
+        return n_allocations_;
+    }
+    //! Number of chunks allocated since the beginning
+    std::size_t chunkAllocations() const
+    {
+        return n_chunk_allocations_;
+    }
+
+private:
+    struct Chunk {
+        char *data;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    //! Bump allocation of a number of bytes, rounded to the alignment
+    void *allocateBytes( std::size_t bytes );
+
+    //! Append a new chunk of a given size after the current one
+    void addChunk( std::size_t size );
+
+    //! Free all the chunks
+    void freeChunks();
+
+    //! Chunks of memory, only the ones up to current_ are in use
+    std::vector<Chunk> chunks_;
+    std::size_t current_;
+    //! Number of bytes in use
+    std::size_t in_use_;
+    std::size_t high_water_;
+    std::size_t n_allocations_;
+    std::size_t n_chunk_allocations_;
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include "SmileiMPI.h"
 #include "Tools.h"
 #include "VectorPatch.h"
+#include "HardwareCounters.h"
 
 using namespace std;
 
@@ -26,6 +27,16 @@ Timer::~Timer()
 void Timer::init( SmileiMPI *smpi )
 {
     smpi_ = smpi;
+    counters_acc_.assign( HardwareCounters::n_events, 0. );
+#ifdef _OPENMP
+    counters_start_.resize( omp_get_max_threads() );
+#else
+    counters_start_.resize( 1 );
+#endif
+    for( unsigned int ithread=0; ithread<counters_start_.size(); ithread++ ) {
+        counters_start_[ithread].assign( HardwareCounters::n_events, 0 );
+    }
+    counters_started_.assign( counters_start_.size(), 0 );
     smpi_->barrier();
     last_start_ = MPI_Wtime();
 }
@@ -34,6 +45,7 @@ void Timer::init( SmileiMPI *smpi )
 void Timer::update( bool store )
 {
     #pragma omp barrier
+    updateCounters();
     #pragma omp master
     {
         time_acc_ +=  MPI_Wtime()-last_start_;
@@ -82,6 +94,7 @@ void Timer::update( VectorPatch &vecPatches, bool store )
 void Timer::restart()
 {
     #pragma omp barrier
+    restartCounters();
     #pragma omp master
     {
         last_start_ = MPI_Wtime();
@@ -94,6 +107,51 @@ void Timer::reboot()
     last_start_ =  MPI_Wtime();
     time_acc_ = 0.;
     register_timers.clear();
+    counters_acc_.assign( HardwareCounters::n_events, 0. );
+    // The other threads start counting from their first read
+    counters_started_.assign( counters_start_.size(), 0 );
+    restartCounters();
+}
+
+void Timer::restartCounters()
+{
+    if( ! HardwareCounters::enabled() ) {
+        return;
+    }
+#ifdef _OPENMP
+    int ithread = omp_get_thread_num();
+#else
+    int ithread = 0;
+#endif
+    HardwareCounters::read( &counters_start_[ithread][0] );
+    counters_started_[ithread] = 1;
+}
+
+void Timer::updateCounters()
+{
+    if( ! HardwareCounters::enabled() ) {
+        return;
+    }
+#ifdef _OPENMP
+    int ithread = omp_get_thread_num();
+#else
+    int ithread = 0;
+#endif
+    uint64_t counters[HardwareCounters::n_events];
+    HardwareCounters::read( counters );
+    if( ! counters_started_[ithread] ) {
+        for( unsigned int i=0; i<HardwareCounters::n_events; i++ ) {
+            counters_start_[ithread][i] = counters[i];
+        }
+        counters_started_[ithread] = 1;
+        return;
+    }
+    for( unsigned int i=0; i<HardwareCounters::n_events; i++ ) {
+        double delta = ( double )( counters[i] - counters_start_[ithread][i] );
+        #pragma omp atomic
+        counters_acc_[i] += delta;
+        counters_start_[ithread][i] = counters[i];
+    }
 }
 
 void Timer::print( double tot )
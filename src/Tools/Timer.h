@@ -52,6 +52,9 @@ public:
     
     std::vector<double> register_timers;
     
+    //! Hardware counters accumulated in current timer, summed over threads (see HardwareCounters)
+    std::vector<double> counters_acc_;
+    
 #ifdef __DETAILED_TIMERS
     //! Id of the associated timer in the patch timer array
     unsigned int patch_timer_id;
@@ -63,6 +66,15 @@ private:
     //! MPI process timer synchronized through MPI
     SmileiMPI *smpi_;
     
+    //! Hardware counters of each thread at the last start
+    std::vector<std::vector<uint64_t> > counters_start_;
+    //! Whether each thread has read its counters at least once since init/reboot
+    std::vector<char> counters_started_;
+    //! Start a new counting period for the hardware counters of the calling thread
+    void restartCounters();
+    //! Accumulate the hardware counters of the calling thread
+    void updateCounters();
+    
 };
 
 
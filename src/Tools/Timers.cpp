@@ -26,7 +26,8 @@ Timers::Timers( SmileiMPI *smpi ) :
     reconfiguration( "Reconfiguration" ),   // Patch reconfiguration
     envelope( "Envelope" ),
     susceptibility( "Sync_Susceptibility" ),
-    grids("Grids")
+    grids("Grids"),
+    numaCopy( "NUMA copy" )                 // Copy of the patches to the NUMA node of their thread
 #ifdef __DETAILED_TIMERS
     // Details of Dynamic
     , interpolator( "Interpolator" ),
@@ -66,6 +67,7 @@ Timers::Timers( SmileiMPI *smpi ) :
     timers.push_back( &envelope );
     timers.push_back( &susceptibility );
     timers.push_back( &grids );
+    timers.push_back( &numaCopy );
     patch_timer_id_start = timers.size()-1;
 #ifdef __DETAILED_TIMERS
     timers.push_back( &interpolator );
@@ -7,6 +7,8 @@
 #include <iomanip>
 #include <unistd.h>
 #include <sstream>
+#include <vector>
+#include <sched.h>
 
 void Tools::printMemFootPrint( std::string tag )
 {
@@ -79,6 +81,51 @@ double Tools::getMemFootPrint()
 }
 
 
+// NUMA node of each core, from the lists of cores of the nodes such as "0-7,16-23"
+static std::vector<int> readNumaNodes()
+{
+    std::vector<int> node_of_cpu;
+    for( int node=0 ; ; node++ ) {
+        std::ostringstream filename( "" );
+        filename << "/sys/devices/system/node/node" << node << "/cpulist";
+        std::ifstream file( filename.str().c_str() );
+        if( !file ) {
+            break;
+        }
+        std::string range;
+        while( std::getline( file, range, ',' ) ) {
+            int first, last;
+            int n = sscanf( range.c_str(), "%d-%d", &first, &last );
+            if( n < 1 ) {
+                continue;
+            }
+            if( n == 1 ) {
+                last = first;
+            }
+            if( last >= ( int )node_of_cpu.size() ) {
+                node_of_cpu.resize( last+1, 0 );
+            }
+            for( int cpu=first ; cpu<=last ; cpu++ ) {
+                node_of_cpu[cpu] = node;
+            }
+        }
+    }
+    return node_of_cpu;
+}
+
+int Tools::getNumaNode()
+{
+#ifdef __linux__
+    static const std::vector<int> node_of_cpu = readNumaNodes();
+    int cpu = sched_getcpu();
+    if( cpu >= 0 && cpu < ( int )node_of_cpu.size() ) {
+        return node_of_cpu[cpu];
+    }
+#endif
+    return 0;
+}
+
+
 std::string Tools::printBytes( uint64_t nbytes )
 {
     std::ostringstream t( "" );
@@ -111,6 +111,9 @@ public:
     static void printMemFootPrint( std::string tag );
     static double getMemFootPrint();
     
+    //! NUMA node of the core which runs the calling thread (0 if unknown)
+    static int getNumaNode();
+    
     //! Converts a number of Bytes in a readable string in KiB, MiB, GiB or TiB
     static std::string printBytes( uint64_t nbytes );
     
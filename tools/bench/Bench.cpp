@@ -0,0 +1,58 @@
+#include "Bench.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include "PatchesFactory.h"
+
+using namespace std;
+
+BenchSimulation::BenchSimulation( SmileiMPI *smpi, string namelist ) :
+    params( smpi, vector<string>( 1, namelist ) ),
+    openPMD( params ),
+    vecPatches( params ),
+    simWindow( params )
+{
+    smpi->init( params, vecPatches.domain_decomposition_ );
+    PatchesFactory::createVector( vecPatches, params, smpi, openPMD, &radiation_tables, 0 );
+    vecPatches.sortAllParticles( params );
+}
+
+void benchHeader( string bench_name, string size_name, string unit_name )
+{
+    cout << endl << " " << bench_name << endl
+         << setw( 24 ) << "kernel"
+         << setw( 12 ) << size_name
+         << setw( 14 ) << "time (us)"
+         << setw( 16 ) << unit_name + "/s"
+         << setw( 12 ) << "GB/s" << endl;
+}
+
+void benchReport( string kernel_name, string size, double seconds, double units, double bytes )
+{
+    cout << setw( 24 ) << kernel_name
+         << setw( 12 ) << size
+         << setw( 14 ) << fixed << setprecision( 2 ) << seconds*1.e6
+         << setw( 16 ) << scientific << setprecision( 3 ) << units/seconds;
+    if( bytes > 0. ) {
+        cout << setw( 12 ) << fixed << setprecision( 2 ) << bytes/seconds*1.e-9 << endl;
+    } else {
+        cout << setw( 12 ) << "-" << endl;
+    }
+}
+
+vector<unsigned int> benchSizes( int argc, char *argv[], vector<unsigned int> default_sizes )
+{
+    vector<unsigned int> sizes;
+    for( int i=2 ; i<argc ; i++ ) {
+        int size = atoi( argv[i] );
+        if( size <= 0 ) {
+            ERROR( "Invalid size " << argv[i] );
+        }
+        sizes.push_back( size );
+    }
+    return sizes.size()>0 ? sizes : default_sizes;
+}
+
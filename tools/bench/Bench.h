@@ -0,0 +1,65 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Bench.h for the tool smilei_bench
+//! Helpers shared by the kernel micro-benchmarks: a minimal simulation built from an inline namelist,
+//! a wall-clock timer and a uniform report line.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <string>
+#include <vector>
+
+#include "SmileiMPI.h"
+#include "Params.h"
+#include "OpenPMDparams.h"
+#include "VectorPatch.h"
+#include "SimWindow.h"
+#include "RadiationTables.h"
+
+//! Patches of a simulation initialized like in Smilei.cpp, without diagnostics nor time loop.
+//! Only one BenchSimulation can exist in a process (the python interpreter is initialized once).
+class BenchSimulation
+{
+public:
+    BenchSimulation( SmileiMPI *smpi, std::string namelist );
+    ~BenchSimulation() {};
+
+    Params params;
+    OpenPMDparams openPMD;
+    VectorPatch vecPatches;
+    SimWindow simWindow;
+    RadiationTables radiation_tables;
+};
+
+//! Measure the average wall-clock time (s) of one call of a kernel, after one warm-up call
+template<typename Kernel>
+double benchTime( Kernel kernel, unsigned int repetitions )
+{
+    kernel();
+    double t0 = MPI_Wtime();
+    for( unsigned int i=0 ; i<repetitions ; i++ ) {
+        kernel();
+    }
+    return ( MPI_Wtime() - t0 ) / repetitions;
+}
+
+//! Print the header of the result table
+void benchHeader( std::string bench_name, std::string size_name, std::string unit_name );
+
+//! Print one result line: time per call, work units per second and effective bandwidth (if bytes > 0)
+void benchReport( std::string kernel_name, std::string size, double seconds, double units, double bytes );
+
+//! Parse the list of sizes given on the command line, or return the default ones
+std::vector<unsigned int> benchSizes( int argc, char *argv[], std::vector<unsigned int> default_sizes );
+
+//! Kernel benchmarks
+int benchMaxwell( SmileiMPI *smpi, std::vector<unsigned int> sizes );
+int benchVectorWidth( SmileiMPI *smpi, std::vector<unsigned int> sizes );
+int benchParticleBlocks( SmileiMPI *smpi, std::vector<unsigned int> sizes );
+int benchCollisions( SmileiMPI *smpi, std::vector<unsigned int> sizes );
+int benchDiagFields( SmileiMPI *smpi, std::vector<unsigned int> sizes );
+int benchDistributions( SmileiMPI *smpi, std::vector<unsigned int> sizes );
+
+#endif
+
@@ -0,0 +1,68 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Benchmark of the binary collisions between electrons and ions in a 2D patch, pair by pair (reference) then in
+//! batches of each given size. The namelist holds one Collisions block per batch size, all between the same species.
+//! The Coulomb logarithm is fixed so that the Debye length is not needed.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+
+#include "Bench.h"
+#include "Species.h"
+#include "Collisions.h"
+
+using namespace std;
+
+int benchCollisions( SmileiMPI *smpi, vector<unsigned int> sizes )
+{
+    sizes.insert( sizes.begin(), 0 );
+
+    ostringstream namelist;
+    namelist << "Main( geometry = '2Dcartesian', interpolation_order = 2,"
+             << " cell_length = [0.5]*2, grid_length = [16.]*2, number_of_patches = [1,1],"
+             << " timestep = 0.25, simulation_time = 1., EM_boundary_conditions = [['periodic']],"
+             << " reference_angular_frequency_SI = 1.88e15 )\n";
+    const char *names[2] = { "electron", "ion" };
+    const double masses[2] = { 1., 100. };
+    for( unsigned int ispec=0 ; ispec<2 ; ispec++ ) {
+        namelist << "Species( name = '" << names[ispec] << "', position_initialization = 'random',"
+                 << " momentum_initialization = 'maxwell-juettner', temperature = [0.001], particles_per_cell = 32,"
+                 << " mass = " << masses[ispec] << ", charge = " << ( ispec==0 ? -1. : 1. ) << ", number_density = 1.,"
+                 << " boundary_conditions = [['periodic']] )\n";
+    }
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        namelist << "Collisions( species1 = ['electron'], species2 = ['ion'], coulomb_log = 5.,"
+                 << " batch_size = " << sizes[isize] << " )\n";
+    }
+    BenchSimulation sim( smpi, namelist.str() );
+    Patch *patch = sim.vecPatches( 0 );
+    vector<Diagnostic *> localDiags;
+
+    unsigned int npairs = patch->vecSpecies[0]->particles->last_index.back();
+    unsigned int repetitions = max( 3., 1.e7 / npairs );
+
+    if( smpi->isMaster() ) {
+        ostringstream title;
+        title << "Electron-ion collisions in 2D (32^2 cells, " << npairs << " pairs)";
+        benchHeader( title.str(), "batch size", "pairs" );
+    }
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        Collisions *collisions = patch->vecCollisions[isize];
+        double t = benchTime( [&]() {
+            collisions->collide( sim.params, smpi, patch, 1, localDiags );
+            smpi->resetScratch();
+        }, repetitions );
+
+        if( smpi->isMaster() ) {
+            ostringstream size;
+            if( sizes[isize] > 0 ) {
+                size << sizes[isize];
+            } else {
+                size << "-";
+            }
+            benchReport( sizes[isize] == 0 ? "pair by pair" : "batches", size.str(), t, npairs, 0. );
+        }
+    }
+
+    return 0;
+}
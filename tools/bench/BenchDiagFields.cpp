@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Benchmark of the 3D field diagnostic, for several compressions of the output and with or without aggregators.
+//! The namelist holds one DiagFields block per configuration. The fields are smooth waves with a small noise, so that
+//! the compression ratios are those of typical simulation outputs rather than those of random data.
+//! The bandwidth is the uncompressed size of the fields divided by the time of one output; the compression ratio is
+//! the uncompressed size divided by the storage size of the final datasets.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Bench.h"
+#include "Field3D.h"
+#include "Timers.h"
+#include "DiagnosticFields3D.h"
+
+using namespace std;
+
+int benchDiagFields( SmileiMPI *smpi, vector<unsigned int> sizes )
+{
+    unsigned int n = sizes[0];
+    const char *fields[3] = { "Ex", "Ey", "Ez" };
+    struct Configuration {
+        string name;
+        int deflate;
+        double absolute_error;
+        int aggregators;
+    };
+    vector<Configuration> configurations = {
+        { "uncompressed", 0, 0., 0 },
+        { "deflate 1", 1, 0., 0 },
+        { "deflate 6", 6, 0., 0 },
+        { "error 1e-4", 0, 1.e-4, 0 },
+        { "error 1e-4 + deflate 1", 1, 1.e-4, 0 },
+        { "1 aggregator", 0, 0., 1 },
+        { "1 aggregator + deflate 1", 1, 0., 1 }
+    };
+
+    ostringstream namelist;
+    namelist << "Main( geometry = '3Dcartesian', interpolation_order = 2,"
+             << " cell_length = [0.5]*3, grid_length = [" << 2.*n << "," << n << "," << n << "], number_of_patches = [4,2,2],"
+             << " timestep = 0.25, simulation_time = 1., EM_boundary_conditions = [['periodic']] )\n";
+    for( unsigned int iconf=0 ; iconf<configurations.size() ; iconf++ ) {
+        namelist << "DiagFields( every = 1, fields = ['Ex', 'Ey', 'Ez'],"
+                 << " deflate = " << configurations[iconf].deflate << ","
+                 << " absolute_error = " << configurations[iconf].absolute_error << ","
+                 << " aggregators = " << configurations[iconf].aggregators << " )\n";
+    }
+    BenchSimulation sim( smpi, namelist.str() );
+    Params &params = sim.params;
+    Timers timers( smpi );
+
+    // Waves along each axis, with a noise of relative amplitude 1e-3
+    srand( 0 );
+    for( unsigned int ipatch=0 ; ipatch<sim.vecPatches.size() ; ipatch++ ) {
+        Patch *patch = sim.vecPatches( ipatch );
+        for( unsigned int ifield=0 ; ifield<3 ; ifield++ ) {
+            Field3D *field = static_cast<Field3D *>( patch->EMfields->allFields[ifield] );
+            for( unsigned int ix=0 ; ix<field->dims_[0] ; ix++ ) {
+                double x = ( patch->Pcoordinates[0]*params.n_space[0] + ix ) * params.cell_length[0];
+                for( unsigned int iy=0 ; iy<field->dims_[1] ; iy++ ) {
+                    double y = ( patch->Pcoordinates[1]*params.n_space[1] + iy ) * params.cell_length[1];
+                    for( unsigned int iz=0 ; iz<field->dims_[2] ; iz++ ) {
+                        double z = ( patch->Pcoordinates[2]*params.n_space[2] + iz ) * params.cell_length[2];
+                        ( *field )( ix, iy, iz ) = sin( 0.7*x + ifield ) * cos( 0.3*y ) * cos( 0.2*z )
+                                                   + 1.e-3 * ( ( double )rand() / RAND_MAX - 0.5 );
+                    }
+                }
+            }
+        }
+    }
+
+    vector<DiagnosticFields3D *> diags( configurations.size() );
+    for( unsigned int iconf=0 ; iconf<configurations.size() ; iconf++ ) {
+        diags[iconf] = new DiagnosticFields3D( params, smpi, sim.vecPatches, iconf, sim.openPMD );
+        diags[iconf]->init( params, smpi, sim.vecPatches );
+    }
+
+    unsigned int repetitions = 5;
+    vector<double> ratios( configurations.size() );
+    if( smpi->isMaster() ) {
+        ostringstream title;
+        title << "Field diagnostic in 3D (4x2x2 patches of " << n << "^3 cells, 3 fields)";
+        benchHeader( title.str(), "cells", "points" );
+    }
+    for( unsigned int iconf=0 ; iconf<configurations.size() ; iconf++ ) {
+        DiagnosticFields3D *diag = diags[iconf];
+        string filename = diag->filename;
+
+        // Each output is a new iteration of the file
+        int itime = 0;
+        double t = benchTime( [&]() {
+            diag->run( smpi, sim.vecPatches, itime, &sim.simWindow, timers );
+            itime++;
+        }, repetitions );
+        delete diag;
+
+        // Storage size of the final datasets
+        if( smpi->isMaster() ) {
+            double points = 0., storage = 0.;
+            hid_t fid = H5Fopen( filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT );
+            for( int i=0 ; i<itime ; i++ ) {
+                for( unsigned int ifield=0 ; ifield<3 ; ifield++ ) {
+                    ostringstream name;
+                    name << "data/" << setfill( '0' ) << setw( 10 ) << i << "/" << fields[ifield];
+                    hid_t did = H5Dopen( fid, name.str().c_str(), H5P_DEFAULT );
+                    hid_t sid = H5Dget_space( did );
+                    points += H5Sget_simple_extent_npoints( sid );
+                    storage += H5Dget_storage_size( did );
+                    H5Sclose( sid );
+                    H5Dclose( did );
+                }
+            }
+            H5Fclose( fid );
+            remove( filename.c_str() );
+            ratios[iconf] = points * sizeof( double ) / storage;
+            points /= itime;
+
+            ostringstream size;
+            size << n;
+            benchReport( configurations[iconf].name, size.str(), t, points, points * sizeof( double ) );
+        }
+    }
+
+    if( smpi->isMaster() ) {
+        cout << endl << setw( 24 ) << "kernel" << setw( 20 ) << "compression ratio" << endl;
+        for( unsigned int iconf=0 ; iconf<configurations.size() ; iconf++ ) {
+            cout << setw( 24 ) << configurations[iconf].name
+                 << setw( 20 ) << fixed << setprecision( 2 ) << ratios[iconf] << endl;
+        }
+    }
+
+    return 0;
+}
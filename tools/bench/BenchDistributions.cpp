@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Benchmark of the kernels whose cost depends on the distribution of the particles in a 3D patch: SpeciesV::sortParticles
+//! and the histogram of a particle binning diagnostic (x, px). One species per number of particles per cell; for each
+//! species, the particles are placed successively in a uniform plasma, a beam along x and a small cluster.
+//! Before each sort, all particles are shifted by 0.15 cell along x (periodic), so that about 15% of them change cell
+//! in a uniform plasma; the time includes this shift and the computation of the cell keys.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+
+#include "Bench.h"
+#include "Species.h"
+#include "DiagnosticParticleBinning.h"
+
+using namespace std;
+
+//! Normal random number (Box-Muller)
+static double normalRandom()
+{
+    double u1 = ( rand() + 1. ) / ( RAND_MAX + 2. );
+    double u2 = ( double )rand() / RAND_MAX;
+    return sqrt( -2.*log( u1 ) ) * cos( 2.*M_PI*u2 );
+}
+
+//! Random position around center with a standard deviation sigma (uniform in [0,length) if sigma is zero)
+static double randomPosition( double center, double sigma, double length )
+{
+    if( sigma == 0. ) {
+        return length * rand() / ( RAND_MAX + 1. );
+    }
+    double x = center + sigma * normalRandom();
+    return min( max( x, 0. ), length * ( 1. - 1.e-9 ) );
+}
+
+int benchDistributions( SmileiMPI *smpi, vector<unsigned int> sizes )
+{
+    const double length = 8., dx = 0.5;
+    ostringstream namelist;
+    namelist << "Main( geometry = '3Dcartesian', interpolation_order = 2,"
+             << " cell_length = [" << dx << "]*3, grid_length = [" << length << "]*3, number_of_patches = [1,1,1],"
+             << " timestep = 0.25, simulation_time = 1., EM_boundary_conditions = [['periodic']] )\n"
+             << "Vectorization( mode = 'on' )\n";
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        namelist << "Species( name = 'ppc" << sizes[isize] << "', position_initialization = 'random',"
+                 << " momentum_initialization = 'cold', particles_per_cell = " << sizes[isize] << ","
+                 << " mass = 1., charge = -1., number_density = 1., boundary_conditions = [['periodic']] )\n"
+                 << "DiagParticleBinning( deposited_quantity = 'weight', every = 1, species = ['ppc" << sizes[isize] << "'],"
+                 << " axes = [['x', 0., " << length << ", 32], ['px', -1., 11., 64]] )\n";
+    }
+    BenchSimulation sim( smpi, namelist.str() );
+    Params &params = sim.params;
+    Patch *patch = sim.vecPatches( 0 );
+
+    // Uniform plasma, beam along x and cluster: transverse and longitudinal sizes, drift and spread of the momentum
+    struct Distribution {
+        string name;
+        double sigma_x, sigma_yz, px, dp;
+    };
+    vector<Distribution> distributions = {
+        { "uniform", 0., 0., 0., 0.01 },
+        { "beam", 0., length/16., 10., 0.01 },
+        { "cluster", length/32., length/32., 0., 0.1 }
+    };
+
+    vector<DiagnosticParticleBinning *> binnings( sizes.size() );
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        binnings[isize] = new DiagnosticParticleBinning( params, smpi, patch, isize );
+        binnings[isize]->prepare( 0 );
+    }
+
+    if( smpi->isMaster() ) {
+        benchHeader( "Particle distributions in 3D (16^3 cells)", "ppc", "particles" );
+    }
+    srand( 0 );
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        Species *species = patch->vecSpecies[isize];
+        Particles *particles = species->particles;
+        unsigned int npart = particles->size();
+        unsigned int repetitions = max( 3., 2.e7 / npart );
+        DiagnosticParticleBinning *binning = binnings[isize];
+
+        for( unsigned int idist=0 ; idist<distributions.size() ; idist++ ) {
+            Distribution &d = distributions[idist];
+            for( unsigned int ip=0 ; ip<npart ; ip++ ) {
+                particles->position( 0, ip ) = randomPosition( length/2., d.sigma_x, length );
+                particles->position( 1, ip ) = randomPosition( length/2., d.sigma_yz, length );
+                particles->position( 2, ip ) = randomPosition( length/2., d.sigma_yz, length );
+                particles->momentum( 0, ip ) = d.px + d.dp * normalRandom();
+                particles->momentum( 1, ip ) = d.dp * normalRandom();
+                particles->momentum( 2, ip ) = d.dp * normalRandom();
+            }
+
+            auto sort = [&]() {
+                fill( species->count.begin(), species->count.end(), 0 );
+                particles->cell_keys.assign( particles->size(), 0 );
+                species->computeParticleCellKeys( params );
+                species->sortParticles( params, patch );
+            };
+            sort();
+            double t_sort = benchTime( [&]() {
+                double *x = &( particles->position( 0, 0 ) );
+                #pragma omp simd
+                for( unsigned int ip=0 ; ip<npart ; ip++ ) {
+                    x[ip] += 0.15*dx;
+                    x[ip] -= ( x[ip] >= length ) ? length : 0.;
+                }
+                sort();
+            }, repetitions );
+
+            double t_binning = benchTime( [&]() {
+                binning->run( smpi, patch, 0, &sim.simWindow );
+                smpi->resetScratch();
+            }, repetitions );
+
+            if( smpi->isMaster() ) {
+                ostringstream size;
+                size << sizes[isize];
+                benchReport( "sort " + d.name, size.str(), t_sort, npart, 0. );
+                benchReport( "binning " + d.name, size.str(), t_binning, npart, 0. );
+            }
+        }
+        delete binning;
+    }
+
+    return 0;
+}
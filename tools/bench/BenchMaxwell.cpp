@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Benchmark of the 3D Yee Maxwell solver: MA_Solver3D_norm + MF_Solver3D_Yee against the fused MAMF_Solver3D_Yee.
+//! A single patch is allocated for the largest size; smaller sizes reuse its field arrays with smaller strides.
+//! The bandwidth assumes that each of the 15 field values of a grid point (E, B, J read, E, B written) moves once.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "Bench.h"
+#include "ElectroMagn.h"
+#include "Field.h"
+#include "MA_Solver3D_norm.h"
+#include "MF_Solver3D_Yee.h"
+#include "MAMF_Solver3D_Yee.h"
+
+using namespace std;
+
+int benchMaxwell( SmileiMPI *smpi, vector<unsigned int> sizes )
+{
+    unsigned int nmax = *max_element( sizes.begin(), sizes.end() );
+
+    ostringstream namelist;
+    namelist << "Main( geometry = '3Dcartesian', interpolation_order = 2,"
+             << " cell_length = [0.5]*3, grid_length = [" << 0.5*nmax << "]*3, number_of_patches = [1,1,1],"
+             << " timestep = 0.25, simulation_time = 1., EM_boundary_conditions = [['periodic']] )";
+    BenchSimulation sim( smpi, namelist.str() );
+    Params &params = sim.params;
+    ElectroMagn *EMfields = sim.vecPatches( 0 )->EMfields;
+
+    vector<Field *> fields = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_,
+                               EMfields->Bx_, EMfields->By_, EMfields->Bz_,
+                               EMfields->Jx_, EMfields->Jy_, EMfields->Jz_
+                             };
+    vector<vector<double> > initial( fields.size() ), reference( 6 );
+    srand( 0 );
+    for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
+        initial[ifield].resize( fields[ifield]->globalDims_ );
+        for( unsigned int i=0 ; i<initial[ifield].size() ; i++ ) {
+            initial[ifield][i] = ( double )rand() / RAND_MAX - 0.5;
+        }
+    }
+    auto reset = [&]() {
+        for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
+            copy( initial[ifield].begin(), initial[ifield].end(), fields[ifield]->data_ );
+        }
+    };
+
+    if( smpi->isMaster() ) {
+        benchHeader( "Maxwell solver (3D Yee)", "cells", "points" );
+    }
+
+    vector<unsigned int> n_space = params.n_space;
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        unsigned int n = sizes[isize];
+        params.n_space = vector<unsigned int>( 3, n );
+        MA_Solver3D_norm MA( params );
+        MF_Solver3D_Yee MF( params );
+        MAMF_Solver3D_Yee MAMF( params );
+        params.n_space = n_space;
+
+        double points = pow( n+1+2*params.oversize[0], 3 );
+        double bytes = 15 * sizeof( double ) * points;
+        unsigned int repetitions = max( 5., 2.e8 / points );
+
+        reset();
+        double t_standard = benchTime( [&]() {
+            MA( EMfields );
+            MF( EMfields );
+        }, repetitions );
+        for( unsigned int ifield=0 ; ifield<6 ; ifield++ ) {
+            reference[ifield].assign( fields[ifield]->data_, fields[ifield]->data_ + fields[ifield]->globalDims_ );
+        }
+
+        reset();
+        double t_fused = benchTime( [&]() {
+            MAMF( EMfields );
+        }, repetitions );
+        double max_diff = 0.;
+        for( unsigned int ifield=0 ; ifield<6 ; ifield++ ) {
+            for( unsigned int i=0 ; i<reference[ifield].size() ; i++ ) {
+                max_diff = max( max_diff, abs( fields[ifield]->data_[i] - reference[ifield][i] ) );
+            }
+        }
+
+        if( smpi->isMaster() ) {
+            ostringstream size;
+            size << n << "^3";
+            benchReport( "standard (MA + MF)", size.str(), t_standard, points, bytes );
+            benchReport( "fused", size.str(), t_fused, points, bytes );
+            cout << setw( 24 ) << "" << "  max |fused - standard| = " << scientific << max_diff
+                 << "  (tile of " << MAMF.ny_tile << " rows)" << endl;
+        }
+    }
+
+    return 0;
+}
+
@@ -0,0 +1,72 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Benchmark of SpeciesV::dynamics in 3D: interpolation, push, boundary conditions and projection of all the particles
+//! of a patch, stage by stage over the whole patch (reference) then pipelined over blocks of each given size.
+//! The plasma is cold and the fields are zero so that particles do not move between repetitions.
+//! When the hardware counters are available, the cache misses per particle and per step are reported too.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include "Bench.h"
+#include "Species.h"
+#include "MultiphotonBreitWheelerTables.h"
+#include "HardwareCounters.h"
+
+using namespace std;
+
+int benchParticleBlocks( SmileiMPI *smpi, vector<unsigned int> sizes )
+{
+    ostringstream namelist;
+    namelist << "Main( geometry = '3Dcartesian', interpolation_order = 2,"
+             << " cell_length = [0.5]*3, grid_length = [8.]*3, number_of_patches = [1,1,1],"
+             << " timestep = 0.25, simulation_time = 1., EM_boundary_conditions = [['periodic']] )\n"
+             << "Vectorization( mode = 'on' )\n"
+             << "Species( name = 'electron', position_initialization = 'random',"
+             << " momentum_initialization = 'cold', particles_per_cell = 16,"
+             << " mass = 1., charge = -1., number_density = 1., boundary_conditions = [['periodic']] )\n";
+    BenchSimulation sim( smpi, namelist.str() );
+    Patch *patch = sim.vecPatches( 0 );
+    Species *species = patch->vecSpecies[0];
+    MultiphotonBreitWheelerTables multiphoton_Breit_Wheeler_tables;
+    vector<Diagnostic *> localDiags;
+
+    unsigned int npart = species->particles->last_index.back();
+    unsigned int repetitions = max( 3., 2.e7 / npart );
+    bool counters = HardwareCounters::enable( HardwareCounters::defaultVectorEvent() );
+
+    if( smpi->isMaster() ) {
+        ostringstream title;
+        title << "Vectorized 3D particle dynamics (16^3 cells, " << npart << " particles)";
+        benchHeader( title.str(), "block size", "particles" );
+    }
+    sizes.insert( sizes.begin(), 0 );
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        sim.params.vectorization_block_size = sizes[isize];
+        uint64_t c0[HardwareCounters::n_events], c1[HardwareCounters::n_events];
+        HardwareCounters::read( c0 );
+        double t = benchTime( [&]() {
+            species->dynamics( 1., 0, patch->EMfields, sim.params, false, patch->partWalls, patch, smpi,
+                               sim.radiation_tables, multiphoton_Breit_Wheeler_tables, localDiags );
+        }, repetitions );
+        HardwareCounters::read( c1 );
+
+        if( smpi->isMaster() ) {
+            ostringstream size;
+            if( sizes[isize] > 0 ) {
+                size << sizes[isize];
+            } else {
+                size << "-";
+            }
+            benchReport( sizes[isize] == 0 ? "whole patch" : "blocks", size.str(), t, npart, 0. );
+            if( counters ) {
+                cout << setw( 24 ) << "cache misses/particle" << setw( 12 ) << size.str()
+                     << setw( 14 ) << fixed << setprecision( 2 )
+                     << ( double )( c1[2]-c0[2] ) / ( ( repetitions+1. )*npart ) << endl;
+            }
+        }
+    }
+
+    return 0;
+}
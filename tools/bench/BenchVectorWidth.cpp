@@ -0,0 +1,86 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Benchmark of the vectorized 3D operators (Interpolator3D2OrderV, PusherBorisV, Projector3D2OrderV) for each
+//! supported vector width. Particles are sorted per cell as in SpeciesV::dynamics. The plasma is cold and the fields
+//! are zero so that particles do not move between repetitions (the cost of the operators does not depend on values).
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+
+#include "Bench.h"
+#include "Species.h"
+#include "Interpolator3D2OrderV.h"
+#include "Projector3D2OrderV.h"
+#include "PusherBorisV.h"
+
+using namespace std;
+
+template<int vecSize>
+static void benchVectorWidthSpecies( SmileiMPI *smpi, Params &params, Patch *patch, unsigned int ispec, unsigned int ppc )
+{
+    Species *species = patch->vecSpecies[ispec];
+    Particles &particles = *species->particles;
+    ElectroMagn *EMfields = patch->EMfields;
+    unsigned int ncells = particles.first_index.size();
+    unsigned int npart = particles.last_index.back();
+
+    Interpolator3D2OrderV<vecSize> interpolator( params, patch );
+    PusherBorisV<vecSize> pusher( params, species );
+    Projector3D2OrderV<vecSize> projector( params, patch );
+
+    smpi->dynamics_resize( 0, 3, npart );
+    unsigned int repetitions = max( 3., 2.e7 / npart );
+
+    double t_interp = benchTime( [&]() {
+        for( unsigned int scell = 0 ; scell < ncells ; scell++ ) {
+            interpolator.fieldsWrapper( EMfields, particles, smpi, &particles.first_index[scell], &particles.last_index[scell], 0, 0 );
+        }
+    }, repetitions );
+    double t_push = benchTime( [&]() {
+        pusher( particles, smpi, 0, npart, 0, 0 );
+    }, repetitions );
+    double t_proj = benchTime( [&]() {
+        for( unsigned int scell = 0 ; scell < ncells ; scell++ ) {
+            projector.currentsAndDensityWrapper( EMfields, particles, smpi, particles.first_index[scell], particles.last_index[scell], 0, false, false, ispec, scell, 0 );
+        }
+    }, repetitions );
+
+    if( smpi->isMaster() ) {
+        ostringstream name, size;
+        name << "width " << vecSize;
+        size << ppc << " ppc";
+        benchReport( name.str() + " interpolate", size.str(), t_interp, npart, 0. );
+        benchReport( name.str() + " push", size.str(), t_push, npart, 0. );
+        benchReport( name.str() + " project", size.str(), t_proj, npart, 0. );
+        benchReport( name.str() + " total", size.str(), t_interp+t_push+t_proj, npart, 0. );
+    }
+}
+
+int benchVectorWidth( SmileiMPI *smpi, vector<unsigned int> sizes )
+{
+    // One species per number of particles per cell
+    ostringstream namelist;
+    namelist << "Main( geometry = '3Dcartesian', interpolation_order = 2,"
+             << " cell_length = [0.5]*3, grid_length = [4.]*3, number_of_patches = [1,1,1],"
+             << " timestep = 0.25, simulation_time = 1., EM_boundary_conditions = [['periodic']] )\n"
+             << "Vectorization( mode = 'on' )\n";
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        namelist << "Species( name = 'ppc" << sizes[isize] << "', position_initialization = 'random',"
+                 << " momentum_initialization = 'cold', particles_per_cell = " << sizes[isize] << ","
+                 << " mass = 1., charge = -1., number_density = 1., boundary_conditions = [['periodic']] )\n";
+    }
+    BenchSimulation sim( smpi, namelist.str() );
+    Patch *patch = sim.vecPatches( 0 );
+
+    if( smpi->isMaster() ) {
+        benchHeader( "Vectorized 3D operators (8^3 cells)", "particles", "particles" );
+    }
+    for( unsigned int isize=0 ; isize<sizes.size() ; isize++ ) {
+        benchVectorWidthSpecies<4>( smpi, sim.params, patch, isize, sizes[isize] );
+        benchVectorWidthSpecies<8>( smpi, sim.params, patch, isize, sizes[isize] );
+        benchVectorWidthSpecies<16>( smpi, sim.params, patch, isize, sizes[isize] );
+    }
+
+    return 0;
+}
+
@@ -0,0 +1,58 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Main.cpp for the tool smilei_bench
+//! This tool measures the performance of individual Smilei kernels on a single patch
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+
+#include "Bench.h"
+
+int main( int argc, char *argv[] )
+{
+    SmileiMPI smpi( &argc, &argv );
+
+    std::string help_message;
+    help_message =  "\n Usage: smilei_bench kernel [size1 size2 ...]\n";
+    help_message += " The sizes are the numbers of cells of the patch in each dimension.\n";
+    help_message += " Available kernels:\n";
+    help_message += " - 'maxwell': 3D Yee solver, standard and fused kernels\n";
+    help_message += " - 'vector_width': vectorized 3D interpolator, pusher and projector for each vector width\n";
+    help_message += "   (sizes are numbers of particles per cell)\n";
+    help_message += " - 'particle_blocks': 3D vectorized species dynamics, whole patch or pipelined by blocks\n";
+    help_message += "   (sizes are numbers of particles per block)\n";
+    help_message += " - 'collisions': 2D electron-ion collisions, pair by pair or in batches\n";
+    help_message += "   (sizes are numbers of pairs per batch)\n";
+    help_message += " - 'distributions': 3D particle sorting and binning for uniform, beam-like and clustered particles\n";
+    help_message += "   (sizes are numbers of particles per cell)\n";
+    help_message += " - 'diag_fields': 3D field output for several compressions and aggregations\n";
+    help_message += "   (size is the number of cells per patch side)\n";
+
+    if( argc < 2 ) {
+        ERROR( "Please, specify which kernel to benchmark.\n" << help_message );
+    }
+    std::string kernel = argv[1];
+
+    if( kernel == "-h" ) {
+        if( smpi.isMaster() ) {
+            std::cout << help_message << std::endl;
+        }
+        return 0;
+    } else if( kernel == "maxwell" ) {
+        return benchMaxwell( &smpi, benchSizes( argc, argv, { 8, 16, 32, 64 } ) );
+    } else if( kernel == "vector_width" ) {
+        return benchVectorWidth( &smpi, benchSizes( argc, argv, { 16, 64 } ) );
+    } else if( kernel == "particle_blocks" ) {
+        return benchParticleBlocks( &smpi, benchSizes( argc, argv, { 256, 1024, 4096 } ) );
+    } else if( kernel == "collisions" ) {
+        return benchCollisions( &smpi, benchSizes( argc, argv, { 64, 256, 1024 } ) );
+    } else if( kernel == "distributions" ) {
+        return benchDistributions( &smpi, benchSizes( argc, argv, { 8, 32 } ) );
+    } else if( kernel == "diag_fields" ) {
+        return benchDiagFields( &smpi, benchSizes( argc, argv, { 32 } ) );
+    } else {
+        ERROR( "Unknown kernel " << kernel << "\n" << help_message );
+    }
+
+    return 0;
+}
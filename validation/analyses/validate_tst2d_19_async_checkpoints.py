@@ -0,0 +1,13 @@
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# SCALARS RELATED TO THE ENERGY, OVER THE RESTARTS
+for scalar in ["Utot", "Ukin", "Uelm", "Ukin_electron", "Uelm_Ex", "Uelm_Ey"]:
+	Validate("Scalar "+scalar, S.Scalar(scalar).getData(), 1e-10)
+
+# ELECTRON PHASE SPACE
+P = S.ParticleBinning(0)
+Validate("Timesteps of the electron phase space", P.getTimesteps())
+Validate("Electron phase space", np.array(P.getData()), 1e-8)
@@ -0,0 +1,30 @@
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# SCALARS, INCLUDING THE ENERGY BALANCE OF THE MOVING WINDOW
+# (the locations of the extrema are not unique while the fields are zero)
+for scalar in S.namelist.DiagScalar[0].vars:
+	if scalar.endswith("Cell"):
+		continue
+	data = np.array(S.Scalar(scalar).getData())
+	Validate("Scalar "+scalar, data, 1e-6*np.max(np.abs(data))+1e-12)
+
+# SPECTRA IN THE MOVING WINDOW
+for i,d in enumerate(S.namelist.DiagParticleBinning):
+	last = S.ParticleBinning(i).getTimesteps()[-1]
+	Validate("Spectrum of "+d.species[0], S.ParticleBinning(i, timesteps=last).getData()[-1], 1e-8)
+
+# PERFORMANCES OF THE NUMA-AWARE MODE
+# The timers and memory differ between runs: only their consistency is checked
+numa = S.namelist.Main.numa_first_touch
+P = {q: np.array(S.Performances(raw=q).getData()) for q in [
+	"timer_particles", "timer_maxwell", "timer_densities", "timer_collisions", "timer_movWindow",
+	"timer_loadBal", "timer_syncPart", "timer_syncField", "timer_syncDens", "timer_diags",
+	"timer_grids", "timer_numaCopy", "timer_total", "memory_total", "memory_remote"
+]}
+parts = sum(P[q] for q in P if q.startswith("timer_") and q != "timer_total")
+Validate("NUMA copy timer included in the total time", bool(np.allclose(parts, P["timer_total"], rtol=1e-9)))
+Validate("NUMA copy timer running only in the NUMA-aware mode", bool(np.all((P["timer_numaCopy"][1:]>0.) == numa)))
+Validate("Remote memory within the process memory", bool(np.all((P["memory_remote"]>=0.) & (P["memory_remote"]<=P["memory_total"]))))
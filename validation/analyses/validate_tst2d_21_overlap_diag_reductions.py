@@ -0,0 +1,15 @@
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# ALL THE OUTPUTS OF THE PARTICLE BINNING DIAGNOSTICS
+# (the first one is output at every timestep: only its density profile is kept)
+for i in range(len(S.namelist.DiagParticleBinning)):
+	P = S.ParticleBinning(i, sum={"px":"all"} if i==0 else None)
+	Validate("Timesteps of particle binning "+str(i), P.getTimesteps())
+	Validate("Particle binning "+str(i), np.array(P.getData()), 1e-8)
+
+# SCALARS RELATED TO THE ENERGY
+Validate("Scalar Ukin", S.Scalar("Ukin").getData(), 1e-8)
+Validate("Scalar Uelm", S.Scalar("Uelm").getData(), 1e-8)
@@ -0,0 +1,16 @@
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference was generated with aggregate_mpi_messages = overlap_field_exchange = False
+# (4 MPI processes, 1 thread)
+
+# SCALARS RELATED TO THE ENERGY AND THE FIELDS
+for scalar in ["Utot", "Ukin", "Uelm", "Uelm_Ex", "Uelm_Bx", "Uelm_By", "Uelm_Bz"]:
+	Validate("Scalar "+scalar, S.Scalar(scalar).getData(), 1e-10)
+for field in ["Ex", "Ey", "Ez", "Bx_m", "By_m", "Bz_m", "Jx", "Rho"]:
+	Validate("Maximum of scalar "+field, S.Scalar(field+"Max").getData()[-1], 1e-8)
+
+# ELECTRON DENSITY
+Validate("Electron density", S.ParticleBinning(0, timesteps=60).getData()[-1], 1e-8)
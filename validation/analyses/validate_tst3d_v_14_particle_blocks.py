@@ -0,0 +1,12 @@
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# SCALARS RELATED TO THE ENERGY
+for scalar in ["Utot", "Ukin", "Uelm", "Ukin_proton", "Ukin_electron", "Ukin_positron", "Ukin_electron_nr"]:
+	Validate("Scalar "+scalar, S.Scalar(scalar).getData(), 1e-10)
+
+# ENERGY DISTRIBUTION OF EACH SPECIES
+for i,d in enumerate(S.namelist.DiagParticleBinning):
+	Validate("Energy distribution of "+d.species[0], S.ParticleBinning(i, timesteps=60).getData()[-1], 1e-8)
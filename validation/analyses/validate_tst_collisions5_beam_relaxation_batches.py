@@ -0,0 +1,30 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+
+
+for i in range(3):
+	ion = "ion"+str(i)
+	eon = "eon"+str(i)
+	
+	times = np.double(S.ParticleBinning(0).getAvailableTimesteps())
+	ones = np.ones_like(times)
+	
+	eon_vx = S.ParticleBinning(i*3+0, sum={"x":"all"}).get()
+	eon_mean_vx = np.array(eon_vx["data"])
+	eon_mean_vx = (np.outer(ones, eon_vx["vx"])*eon_mean_vx).sum(axis=1) / eon_mean_vx.sum(axis=1)
+	
+	eon_vp2 = S.ParticleBinning(i*3+1, sum={"x":"all"}).get()
+	eon_mean_vp2 = np.array(eon_vp2["data"])
+	eon_mean_vp2 = (np.outer(ones, eon_vp2["vperp2"])*eon_mean_vp2).sum(axis=1) / eon_mean_vp2.sum(axis=1)
+	
+	ion_vx = S.ParticleBinning(i*3+2, sum={"x":"all"}).get()
+	ion_vxd = np.array(ion_vx["data"])
+	ion_mean_vx = (np.outer(ones, ion_vx["vx"])*ion_vxd).sum(axis=1) / ion_vxd.sum(axis=1)
+	
+	# The batches use the random numbers in another order: only the relaxation is compared
+	Validate(eon+" mean vx", eon_mean_vx, 0.001)
+	Validate(eon+" mean vperp", np.sqrt(eon_mean_vp2), 0.001)
+	Validate(ion+" mean vx", ion_mean_vx, 0.001)